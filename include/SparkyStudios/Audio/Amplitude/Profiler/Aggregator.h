@@ -0,0 +1,116 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_AGGREGATOR_H
+#define _AM_PROFILER_AGGREGATOR_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Histogram.h>
+
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Computes windowed statistics of numeric message fields.
+     *
+     * Each aggregated field, named as in filter expressions (e.g. `performance.cpu`), is
+     * recorded into a ring of histograms, one per step. Every step, the histograms covering
+     * the window are merged and a ProfilerAggregateData message with the count, min, max,
+     * mean and percentiles of the field is produced. The window is tumbling when the step
+     * equals the window, and sliding when the step is shorter.
+     *
+     * Fields no message had during a window produce no aggregate.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerAggregator
+    {
+    public:
+        /**
+         * @brief Maximum number of steps in a window.
+         */
+        static constexpr AmUInt32 kMaxSteps = 60;
+
+        ProfilerAggregator();
+        ~ProfilerAggregator();
+
+        // Non-copyable
+        ProfilerAggregator(const ProfilerAggregator&) = delete;
+        ProfilerAggregator& operator=(const ProfilerAggregator&) = delete;
+
+        /**
+         * @brief Set the aggregated fields and the window, discarding the current windows.
+         *
+         * @param fields The names of the numeric fields to aggregate.
+         * @param windowMs The duration covered by each aggregate.
+         * @param stepMs The interval between two aggregates. Must divide the window.
+         * @return true if every field exists and the window is valid, false otherwise.
+         */
+        bool Configure(const std::vector<AmString>& fields, AmUInt32 windowMs, AmUInt32 stepMs);
+
+        /**
+         * @brief Stop aggregating any field.
+         */
+        void Clear();
+
+        /**
+         * @brief Check if no field is aggregated.
+         */
+        [[nodiscard]] bool IsEmpty() const;
+
+        /**
+         * @brief Record the aggregated fields of a batch of messages into the current step.
+         *
+         * @param messages The messages to record.
+         */
+        void Observe(const std::vector<ProfilerDataVariant>& messages);
+
+        /**
+         * @brief Close the steps which ended, and produce the aggregates of their windows.
+         *
+         * @param now The current time.
+         * @param output [out] The aggregate messages are appended to this list.
+         */
+        void Update(ProfilerTime now, std::vector<ProfilerDataVariant>& output);
+
+    private:
+        struct Stream
+        {
+            AmString mName;
+            AmInt32 mField;
+            std::vector<ProfilerHistogram> mSteps;
+        };
+
+        void _emit(std::vector<ProfilerDataVariant>& output);
+
+        std::vector<Stream> _streams;
+        ProfilerHistogram _merged; // Scratch histogram the steps of a window are merged into
+
+        ProfilerTime::duration _step;
+        AmUInt32 _stepCount;
+        AmUInt32 _currentStep;
+        AmUInt32 _filledSteps; // Closed steps in the window, less than _stepCount while the first window fills
+        ProfilerTime _stepEnd;
+        bool _started;
+
+        AmMutexHandle _mutex;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_AGGREGATOR_H
@@ -0,0 +1,108 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_ALERT_H
+#define _AM_PROFILER_ALERT_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Config.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+
+#include <functional>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Evaluates alert rules on the stream of processed messages.
+     *
+     * Everything a rule needs is allocated when the rules are configured: evaluating a
+     * message runs each rule's compiled condition, and updates a counter or a ring of the
+     * latest match timestamps. Messages are never copied or stored.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerAlertEvaluator
+    {
+    public:
+        /**
+         * @brief Called when a rule fires, from the thread evaluating messages.
+         *
+         * @param rule The rule which fired.
+         * @param message The message which made the rule fire.
+         * @param fireCount The number of times the rule fired, this one included.
+         */
+        using FireCallback = std::function<void(const ProfilerAlertRule& rule, const ProfilerDataVariant& message, AmUInt64 fireCount)>;
+
+        /**
+         * @brief Name of the events emitted for fired rules. They are not evaluated, so a rule cannot fire on its own event.
+         */
+        static constexpr const char* kEventName = "AlertFired";
+
+        ProfilerAlertEvaluator();
+        ~ProfilerAlertEvaluator();
+
+        // Non-copyable
+        ProfilerAlertEvaluator(const ProfilerAlertEvaluator&) = delete;
+        ProfilerAlertEvaluator& operator=(const ProfilerAlertEvaluator&) = delete;
+
+        /**
+         * @brief Set the rules to evaluate, resetting their state.
+         *
+         * @param rules The rules. Rules whose condition does not compile are skipped.
+         * @param callback Called when a rule fires.
+         * @return true if every rule was compiled, false otherwise.
+         */
+        bool Configure(const std::vector<ProfilerAlertRule>& rules, FireCallback callback);
+
+        /**
+         * @brief Remove every rule.
+         */
+        void Clear();
+
+        /**
+         * @brief Evaluate every rule on a batch of messages.
+         *
+         * @param messages The messages, in the order they were captured.
+         */
+        void Evaluate(const std::vector<ProfilerDataVariant>& messages);
+
+    private:
+        struct CompiledRule
+        {
+            ProfilerAlertRule mRule;
+            ProfilerFilter mCondition;
+            AmSize mRingOffset; // First match timestamp of the rule in _matchTimes, for windowed rules
+
+            AmUInt32 mMatches; // Consecutive matches, or match timestamps in the ring
+            AmUInt32 mRingHead; // Oldest match timestamp in the ring
+            bool mArmed; // Cleared when the rule fires, set back when the condition stops holding
+            AmInt64 mCooldownEndNs;
+            AmUInt64 mFireCount;
+        };
+
+        void _evaluate(CompiledRule& rule, const ProfilerDataVariant& message);
+
+        std::vector<CompiledRule> _rules;
+        std::vector<AmInt64> _matchTimes; // Rings of the windowed rules, one after the other
+        FireCallback _callback;
+
+        AmMutexHandle _mutex;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_ALERT_H
@@ -0,0 +1,145 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_ANOMALY_H
+#define _AM_PROFILER_ANOMALY_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Settings of the anomaly detector.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerAnomalySettings
+    {
+        std::vector<AmString> mFields; ///< Numeric fields whose level is watched
+        std::vector<AmString> mGrowthFields; ///< Numeric fields whose growth per second is watched, e.g. memory for leaks
+        AmString mSceneMarker; ///< Event starting a scene with its own baselines, empty for a single baseline
+        AmReal64 mAlpha = 0.01; ///< Weight of a new sample in the baselines
+        AmUInt32 mWarmupSamples = 100; ///< Samples learned by a baseline before it reports anomalies
+        AmReal64 mSpikeThreshold = 5.0; ///< Deviation from the baseline of a spike, in standard deviations
+        AmReal64 mShiftThreshold = 8.0; ///< Accumulated deviation of a shift, in standard deviations
+    };
+
+    /**
+     * @brief Detects anomalies in numeric series of the message stream.
+     *
+     * Every watched series keeps an exponentially weighted mean and variance as baseline,
+     * and a two-sided CUSUM of its deviations from it:
+     * - a spike is a single sample far from the baseline,
+     * - a shift is a sustained deviation, too small to be a spike, which accumulates in the
+     *   CUSUM until it crosses the threshold. This is how gradual regressions are found.
+     *   A shift is a change point: the baseline then learns the new level from scratch.
+     *
+     * Growth series are the per second slope of a field between two samples. Their CUSUM
+     * is measured from zero instead of the baseline, so a slow but steady growth, like a
+     * leak, is reported even when it was present from the start.
+     *
+     * When a scene marker is set, each scene learns its own baselines, so the expected
+     * differences between scenes are not reported. Baselines are allocated the first time
+     * a scene is seen; processing a sample is O(1) and does not allocate.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerAnomalyDetector
+    {
+    public:
+        /**
+         * @brief Name of the events emitted for anomalies.
+         */
+        static constexpr const char* kEventName = "PerformanceAnomaly";
+
+        /**
+         * @brief Maximum number of scenes with their own baselines, later scenes keep the current baselines.
+         */
+        static constexpr AmSize kMaxScenes = 64;
+
+        ProfilerAnomalyDetector();
+        ~ProfilerAnomalyDetector();
+
+        // Non-copyable
+        ProfilerAnomalyDetector(const ProfilerAnomalyDetector&) = delete;
+        ProfilerAnomalyDetector& operator=(const ProfilerAnomalyDetector&) = delete;
+
+        /**
+         * @brief Set the watched series, discarding the learned baselines.
+         *
+         * @param settings The detector settings.
+         * @return true if every field exists, false otherwise.
+         */
+        bool Configure(const ProfilerAnomalySettings& settings);
+
+        /**
+         * @brief Stop watching any series.
+         */
+        void Clear();
+
+        /**
+         * @brief Update the baselines with a batch of messages.
+         *
+         * @param messages The messages, in the order they were captured.
+         * @param events [out] An event is appended for every anomaly found.
+         */
+        void Observe(const std::vector<ProfilerDataVariant>& messages, std::vector<ProfilerEvent>& events);
+
+    private:
+        struct Series
+        {
+            AmString mName;
+            AmInt32 mField;
+            bool mGrowth;
+
+            // Previous sample, for growth series
+            AmReal64 mLastValue;
+            AmInt64 mLastTimestampNs;
+        };
+
+        struct Baseline
+        {
+            AmUInt64 mSamples = 0;
+            AmReal64 mMean = 0.0;
+            AmReal64 mVariance = 0.0;
+            AmReal64 mHigh = 0.0; // Upward CUSUM
+            AmReal64 mLow = 0.0; // Downward CUSUM
+            bool mSpiking = false; // Set while samples are spikes, so a spike is reported once
+        };
+
+        void _enterScene(const AmString& scene);
+        void _observe(Series& series, Baseline& baseline, AmReal64 value, std::vector<ProfilerEvent>& events);
+        void _report(const Series& series, const Baseline& baseline, const char* kind, AmReal64 value, AmReal64 score,
+                     std::vector<ProfilerEvent>& events) const;
+
+        ProfilerAnomalySettings _settings;
+        std::vector<Series> _series;
+
+        std::unordered_map<AmString, std::vector<Baseline>> _scenes;
+        std::vector<Baseline>* _baselines; // Baselines of the current scene, one per series
+        AmString _scene;
+        std::unordered_map<AmString, AmUInt32> _markerOccurrences;
+
+        AmMutexHandle _mutex;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_ANOMALY_H
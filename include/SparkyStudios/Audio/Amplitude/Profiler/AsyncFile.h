@@ -0,0 +1,191 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_ASYNC_FILE_H
+#define _AM_PROFILER_ASYNC_FILE_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Writes to a file without blocking the calling thread.
+     *
+     * Data is copied into one of a fixed number of page-aligned buffers, and written at
+     * its offset in the file by a background thread. On Linux, writes are submitted through
+     * io_uring when the plugin is built with liburing and the kernel allows it; otherwise
+     * a small pool of threads issues positioned writes. Since every write carries its
+     * offset, writes may complete in any order.
+     *
+     * When every buffer is in flight, a non-waiting acquisition fails and the caller drops
+     * its data: a slow disk never blocks the caller. This class is thread-safe.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerAsyncFileWriter
+    {
+    public:
+        /**
+         * @brief Alignment of the buffers, matching the page size of most systems.
+         */
+        static constexpr AmSize kBufferAlignment = 4096;
+
+        /**
+         * @brief Number of threads issuing writes when io_uring is not used.
+         */
+        static constexpr AmUInt32 kFallbackThreadCount = 2;
+
+        /**
+         * @brief A buffer to fill before submitting it.
+         */
+        struct Buffer
+        {
+            AmUInt8* mData = nullptr;
+            AmSize mSize = 0;
+            AmSize mCapacity = 0;
+            AmUInt64 mOffset = 0;
+        };
+
+        ProfilerAsyncFileWriter();
+        ~ProfilerAsyncFileWriter();
+
+        // Non-copyable
+        ProfilerAsyncFileWriter(const ProfilerAsyncFileWriter&) = delete;
+        ProfilerAsyncFileWriter& operator=(const ProfilerAsyncFileWriter&) = delete;
+
+        /**
+         * @brief Create a file and start the writing threads.
+         *
+         * @param path The path of the file to create. An existing file is overwritten.
+         * @param durability When written data is synced to the disk.
+         * @param syncIntervalMs The interval between two syncs, for the interval durability.
+         * @param bufferCount The number of buffers which can be in flight at once, at least 2.
+         * @return true if the file was created, false otherwise.
+         */
+        bool Open(
+            const AmOsString& path,
+            eProfilerDurability durability = eProfilerDurability_Interval,
+            AmUInt32 syncIntervalMs = 1000,
+            AmUInt32 bufferCount = 4);
+
+        /**
+         * @brief Wait for every write, sync the file if needed, and close it.
+         */
+        void Close();
+
+        /**
+         * @brief Check if a file is open.
+         */
+        [[nodiscard]] bool IsOpen() const;
+
+        /**
+         * @brief Get a free buffer able to hold the given size.
+         *
+         * @param size The number of bytes to write.
+         * @param wait Whether to wait for a buffer to be free. Without waiting, nullptr is returned when every buffer is in flight.
+         * @return The buffer to fill, then to pass to Submit().
+         */
+        Buffer* AcquireBuffer(AmSize size, bool wait);
+
+        /**
+         * @brief Write a filled buffer at the given offset of the file.
+         *
+         * @param buffer A buffer returned by AcquireBuffer(), its size set to the number of bytes to write.
+         * @param offset The offset in the file.
+         */
+        void Submit(Buffer* buffer, AmUInt64 offset);
+
+        /**
+         * @brief Wait for every submitted write to complete.
+         */
+        void Drain();
+
+        /**
+         * @brief Wait for every submitted write, then sync the file to the disk.
+         */
+        void Sync();
+
+        /**
+         * @brief Get the name of the backend in use, "io_uring" or "pwrite".
+         */
+        [[nodiscard]] const char* GetBackendName() const;
+
+        /**
+         * @brief Get the number of acquisitions which failed because every buffer was in flight.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetDroppedCount() const
+        {
+            return _droppedCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the number of writes which failed.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetFailedCount() const
+        {
+            return _failedCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the number of bytes written to the file.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetWrittenBytes() const
+        {
+            return _writtenBytes.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static void _fallbackLoop(AmVoidPtr userData);
+        static void _ioUringLoop(AmVoidPtr userData);
+
+        Buffer* _popSubmitted();
+        void _release(Buffer* buffer, bool success);
+        bool _writeAll(const Buffer& buffer) const;
+        void _syncFile() const;
+        [[nodiscard]] bool _shouldSync();
+
+        std::intptr_t _file; // File descriptor, or file handle on Windows
+        eProfilerDurability _durability;
+        AmUInt32 _syncIntervalMs;
+        std::atomic<AmUInt64> _lastSyncMs;
+        std::atomic<bool> _dirty; // Written since the last sync
+        bool _ioUring;
+        AmVoidPtr _ring;
+
+        std::vector<Buffer> _buffers;
+        std::vector<Buffer*> _free;
+        std::deque<Buffer*> _submitted;
+        std::atomic<AmSize> _inFlight;
+
+        std::vector<AmThreadHandle> _threads;
+        std::atomic<bool> _running;
+
+        std::atomic<AmUInt64> _droppedCount;
+        std::atomic<AmUInt64> _failedCount;
+        std::atomic<AmUInt64> _writtenBytes;
+
+        mutable AmMutexHandle _mutex;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_ASYNC_FILE_H
@@ -20,8 +20,43 @@
 #include <SparkyStudios/Audio/Amplitude/IO/Log.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
 
+#include <vector>
+
 namespace SparkyStudios::Audio::Amplitude
 {
+    /**
+     * @brief A rule evaluated on every processed message.
+     *
+     * The condition is a filter expression. The rule fires when the condition holds for a
+     * number of consecutive messages it applies to, or, when a window is set, for a number of
+     * messages within that window. It then fires again only once the condition stopped
+     * holding and the cooldown elapsed.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerAlertRule
+    {
+        AmString mName;
+        AmString mCondition; // Filter expression, e.g. "performance.mixerCpu > 80"
+        AmUInt32 mCount; // Matching messages needed to fire
+        AmUInt32 mWindowMs; // 0 when the matching messages must be consecutive
+        AmUInt32 mCooldownMs; // Minimum time between two firings
+        AmUInt32 mActions; // Bitmask of eProfilerAlertAction
+        AmReal32 mBoostFrequencyHz; // Update frequency while boosted
+        AmUInt32 mBoostDurationMs;
+
+        ProfilerAlertRule()
+            : mCount(1)
+            , mWindowMs(0)
+            , mCooldownMs(1000)
+            , mActions(eProfilerAlertAction_Event)
+            , mBoostFrequencyHz(120.0f)
+            , mBoostDurationMs(5000)
+        {}
+
+        bool operator==(const ProfilerAlertRule& other) const = default;
+    };
+
     /**
      * @brief Configuration for the profiler system.
      *
@@ -34,6 +69,18 @@ namespace SparkyStudios::Audio::Amplitude
         AmUInt16 mServerPort;
         AmUInt32 mMaxClients;
         AmString mBindAddress;
+        AmUInt32 mClientMaxMessagesPerSecond; // 0 means unlimited
+        AmUInt32 mClientMaxBytesPerSecond; // 0 means unlimited
+        AmUInt32 mNetworkBusyThreshold; // Pending sends before lower QoS classes are shed, 0 disables shedding
+        bool mEnableSharedMemoryTransport; // Publish binary messages to a shared memory ring for same-host consumers
+        AmString mSharedMemoryName;
+        AmUInt32 mSharedMemorySize; // Ring size in bytes, rounded up to a power of two
+        bool mEnableMulticast; // Send every batch once to a UDP multicast group
+        AmString mMulticastGroup;
+        AmUInt16 mMulticastPort;
+        AmUInt8 mMulticastTtl; // 1 keeps datagrams on the local network
+        AmUInt32 mMulticastMtu; // Maximum datagram size, header included
+        AmReal32 mMulticastKeyframeInterval; // Seconds between two keyframes, 0 disables keyframes
 
         // Update settings
         eProfilerUpdateMode mUpdateMode;
@@ -50,9 +97,83 @@ namespace SparkyStudios::Audio::Amplitude
         bool mCaptureEvents;
 
         // Performance settings
-        AmUInt32 mMessageBufferSize;
+        AmUInt32 mMessageBufferSize; // Bytes buffered for each network client before its sends are dropped
         AmUInt32 mMaxQueuedMessages;
         bool mUseCompressionForNetwork;
+        AmUInt32 mSelfStatsIntervalMs; // Interval between two ProfilerStatistics events, 0 to emit none
+
+        // Memory settings, every buffer is sized at initialization
+        AmUInt32 mMemoryResidency; // Bitmask of eProfilerMemoryResidency applied to the rings
+        AmUInt32 mExpectedEntityCount; // Entities tracked without growing the state caches
+        AmUInt32 mExpectedChannelCount;
+        AmUInt32 mExpectedListenerCount;
+        AmUInt32 mRealtimeRingCapacity; // Records buffered for each real-time thread before its captures are dropped
+
+        // Recording settings
+        bool mEnableRecording; // Write every processed message to a recording file
+        AmString mRecordingPath;
+        AmUInt32 mRecordingChunkSize; // Size in bytes above which a chunk is written to the file
+        eProfilerRecordingCompression mRecordingCompression;
+        AmUInt32 mRecordingCompressionThreads; // 0 compresses on the profiler update thread
+        eProfilerDurability mRecordingDurability;
+        AmUInt32 mRecordingSyncIntervalMs; // Interval between two syncs, for the interval durability
+        AmUInt32 mRecordingWriteBuffers; // Chunks in flight to the disk before new ones are dropped
+
+        // Flight recorder settings
+        bool mEnableFlightRecorder; // Keep the latest messages in memory, to be dumped on crash
+        AmUInt32 mFlightRecorderSize; // Size in bytes of the in-memory ring
+        AmString mFlightRecorderCrashPath; // Where the ring is dumped on crash, empty to not install a crash handler
+
+        // Watchdog settings
+        bool mEnableWatchdog; // Report audio threads which stop sending heartbeats
+        AmReal32 mWatchdogStallPeriods; // Buffer periods without heartbeat before a thread is stalled
+        AmUInt32 mWatchdogMaxDumps; // Flight recorder snapshots taken on stalls, 0 to take none
+        AmString mWatchdogDumpPath; // Prefix of the snapshot files, followed by the stall number
+
+        // Aggregation settings
+        bool mEnableAggregation; // Emit windowed statistics of numeric fields as aggregate messages
+        std::vector<AmString> mAggregateFields; // Numeric fields, named as in filter expressions
+        AmUInt32 mAggregateWindowMs; // Duration covered by each aggregate
+        AmUInt32 mAggregateStepMs; // Interval between two aggregates, the window is tumbling when both are equal
+
+        // Alert settings
+        std::vector<ProfilerAlertRule> mAlertRules;
+        AmUInt32 mAlertMaxDumps; // Flight recorder snapshots taken by alerts, 0 to take none
+        AmString mAlertDumpPath; // Prefix of the snapshot files, followed by the rule name and the snapshot number
+
+        // Anomaly detection settings
+        bool mEnableAnomalyDetection; // Emit events for spikes and shifts of numeric fields
+        std::vector<AmString> mAnomalyFields; // Numeric fields whose level is watched
+        std::vector<AmString> mAnomalyGrowthFields; // Numeric fields whose growth per second is watched
+        AmString mAnomalySceneMarker; // Event starting a scene with its own baselines, empty for a single baseline
+        AmReal32 mAnomalyAlpha; // Weight of a new sample in the baselines
+        AmUInt32 mAnomalyWarmupSamples; // Samples learned by a baseline before it reports anomalies
+        AmReal32 mAnomalySpikeThreshold; // In standard deviations
+        AmReal32 mAnomalyShiftThreshold; // Accumulated, in standard deviations
+
+        // Lock profiling settings
+        bool mEnableLockProfiling; // Measure the wait and hold times of the instrumented mutexes
+        AmUInt32 mLockStatsIntervalMs; // Interval between two LockContention reports
+        AmUInt32 mLockStatsTopCount; // Most contended locks in each report
+
+        // Job system settings
+        bool mEnableJobProfiling; // Measure the jobs reported by the job system workers, summarized at each update
+        bool mEnableJobTimeline; // Also send one event per job, buffered in rings of mRealtimeRingCapacity jobs
+
+        // Stack sampling settings
+        bool mEnableStackSampling; // Sample the call stacks of the registered audio threads, Linux only
+        AmUInt32 mStackSamplingRateHz; // Samples per second of CPU time, per thread
+        AmUInt32 mStackSamplingIntervalMs; // Interval between two StackSamples events
+        AmUInt32 mStackSamplingMaxStacks; // Most sampled stacks in each event
+
+        // Performance counters settings
+        bool mEnablePerfCounters; // Read perf counters around the callbacks of the registered audio threads, Linux only
+        AmUInt32 mPerfCountersIntervalMs; // Interval between two PerfCounters events
+
+        // Level metering settings
+        bool mEnableLevelMetering; // Meter the signal of the registered audio buses
+        AmUInt32 mLevelMeteringIntervalMs; // Interval between two AudioLevels events
+        AmUInt32 mLevelMeteringBufferMs; // Audio each bus tap buffers until the update thread measures it
 
         // Filtering settings
         AmReal32 mPositionChangeThreshold; // Minimum position change to trigger update
@@ -63,6 +184,7 @@ namespace SparkyStudios::Audio::Amplitude
         bool mEnableLogging;
         eLogMessageLevel mLoggingLevel;
         AmString mLogFilePath;
+        AmUInt32 mLogRateLimit; // Messages logged per second by each call site, 0 for no limit
 
         /**
          * @brief Default constructor with sensible defaults
@@ -72,6 +194,18 @@ namespace SparkyStudios::Audio::Amplitude
             , mServerPort(kDefaultProfilerPort)
             , mMaxClients(kMaxProfilerClients)
             , mBindAddress("127.0.0.1")
+            , mClientMaxMessagesPerSecond(0)
+            , mClientMaxBytesPerSecond(0)
+            , mNetworkBusyThreshold(256)
+            , mEnableSharedMemoryTransport(false)
+            , mSharedMemoryName("amplitude_profiler")
+            , mSharedMemorySize(4 * 1024 * 1024)
+            , mEnableMulticast(false)
+            , mMulticastGroup("239.255.27.2")
+            , mMulticastPort(kDefaultProfilerPort + 1)
+            , mMulticastTtl(1)
+            , mMulticastMtu(1400)
+            , mMulticastKeyframeInterval(1.0f)
             , mUpdateMode(eProfilerUpdateMode_Timed)
             , mUpdateFrequencyHz(30.0f)
             , mMaxMessagesPerFrame(100)
@@ -85,12 +219,61 @@ namespace SparkyStudios::Audio::Amplitude
             , mMessageBufferSize(kProfilerMessageBufferSize)
             , mMaxQueuedMessages(1000)
             , mUseCompressionForNetwork(false)
+            , mSelfStatsIntervalMs(1000)
+            , mMemoryResidency(eProfilerMemoryResidency_Prefault)
+            , mExpectedEntityCount(256)
+            , mExpectedChannelCount(256)
+            , mExpectedListenerCount(8)
+            , mRealtimeRingCapacity(1024)
+            , mEnableRecording(false)
+            , mRecordingPath("amplitude_profiler.amrec")
+            , mRecordingChunkSize(1024 * 1024)
+            , mRecordingCompression(eProfilerRecordingCompression_Zstd)
+            , mRecordingCompressionThreads(2)
+            , mRecordingDurability(eProfilerDurability_Interval)
+            , mRecordingSyncIntervalMs(1000)
+            , mRecordingWriteBuffers(4)
+            , mEnableFlightRecorder(true)
+            , mFlightRecorderSize(4 * 1024 * 1024)
+            , mFlightRecorderCrashPath("amplitude_profiler_crash.amrec")
+            , mEnableWatchdog(true)
+            , mWatchdogStallPeriods(4.0f)
+            , mWatchdogMaxDumps(8)
+            , mWatchdogDumpPath("amplitude_profiler_stall")
+            , mEnableAggregation(false)
+            , mAggregateFields({ "performance.cpu", "performance.latency", "engine.voices" })
+            , mAggregateWindowMs(1000)
+            , mAggregateStepMs(1000)
+            , mAlertMaxDumps(8)
+            , mAlertDumpPath("amplitude_profiler_alert")
+            , mEnableAnomalyDetection(false)
+            , mAnomalyFields({ "performance.cpu", "engine.voices" })
+            , mAnomalyGrowthFields({ "performance.memory" })
+            , mAnomalyAlpha(0.01f)
+            , mAnomalyWarmupSamples(100)
+            , mAnomalySpikeThreshold(5.0f)
+            , mAnomalyShiftThreshold(8.0f)
+            , mEnableLockProfiling(false)
+            , mLockStatsIntervalMs(1000)
+            , mLockStatsTopCount(5)
+            , mEnableJobProfiling(false)
+            , mEnableJobTimeline(false)
+            , mEnableStackSampling(false)
+            , mStackSamplingRateHz(1000)
+            , mStackSamplingIntervalMs(1000)
+            , mStackSamplingMaxStacks(200)
+            , mEnablePerfCounters(false)
+            , mPerfCountersIntervalMs(1000)
+            , mEnableLevelMetering(false)
+            , mLevelMeteringIntervalMs(200)
+            , mLevelMeteringBufferMs(250)
             , mPositionChangeThreshold(0.01f) // 1cm
             , mOrientationChangeThreshold(0.017453f) // ~1 degree
             , mParameterChangeThreshold(0.01f) // 1%
             , mEnableLogging(false)
             , mLoggingLevel(eLogMessageLevel_Debug)
             , mLogFilePath("amplitude_profiler.log")
+            , mLogRateLimit(10)
         {}
 
         /**
@@ -21,6 +21,8 @@
 #include <SparkyStudios/Audio/Amplitude/Core/Event.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
 
+#include <array>
+
 namespace SparkyStudios::Audio::Amplitude
 {
     /**
@@ -34,6 +36,7 @@ namespace SparkyStudios::Audio::Amplitude
         ProfilerMessageID mMessageId;
         eProfilerCategory mCategory;
         eProfilerPriority mPriority;
+        AmUInt32 mSourceId; ///< Process the message comes from when streams are merged, 0 for the local process
 
         ProfilerDataSnapshot();
 
@@ -188,6 +191,53 @@ namespace SparkyStudios::Audio::Amplitude
         ProfilerListenerData();
     };
 
+    /**
+     * @brief Scheduling of an audio thread since the previous performance snapshot.
+     *
+     * The wakeup latency is how much later than one buffer period after the previous
+     * callback the thread called back. A thread which is scheduled late shows a high
+     * latency with a normal mixer CPU time, while slow processing shows the opposite.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerThreadScheduling
+    {
+        /**
+         * @brief Number of buckets of the wakeup latency histogram.
+         *
+         * The first bucket counts latencies below 1 microsecond, each next bucket doubles
+         * the bound of the previous one, and the last bucket counts every longer latency.
+         */
+        static constexpr AmSize kLatencyBucketCount = 20;
+
+        AmUInt32 mWakeups = 0; ///< Callbacks measured in the interval
+        AmReal32 mLatencyP50Ms = 0.0f;
+        AmReal32 mLatencyP99Ms = 0.0f;
+        AmReal32 mLatencyMaxMs = 0.0f;
+        AmUInt32 mVoluntarySwitches = 0; ///< Times the thread blocked, e.g. waiting for the next buffer
+        AmUInt32 mInvoluntarySwitches = 0; ///< Times the thread was preempted, 0 where the OS does not report it
+        std::array<AmUInt32, kLatencyBucketCount> mLatencyBuckets = {};
+
+        /**
+         * @brief Get the bucket of a wakeup latency.
+         */
+        [[nodiscard]] static AmSize GetLatencyBucket(AmUInt64 latencyNs);
+
+        /**
+         * @brief Get the highest wakeup latency counted in a bucket, in milliseconds.
+         */
+        [[nodiscard]] static AmReal64 GetLatencyBucketUpperBoundMs(AmSize bucket);
+
+        /**
+         * @brief Get the wakeup latency below which the given percentage of callbacks fall.
+         *
+         * The value is the upper bound of a bucket, so it is at most twice the exact percentile.
+         *
+         * @param percentile The percentile, between 0 and 100.
+         */
+        [[nodiscard]] AmReal64 GetLatencyPercentileMs(AmReal64 percentile) const;
+    };
+
     /**
      * @brief Performance metrics snapshot.
      *
@@ -217,6 +267,9 @@ namespace SparkyStudios::Audio::Amplitude
         AmUInt32 mActiveThreadCount;
         std::unordered_map<AmString, AmReal32> mThreadCpuUsage;
 
+        // Audio thread scheduling, by thread name
+        std::unordered_map<AmString, ProfilerThreadScheduling> mThreadScheduling;
+
         ProfilerPerformanceData();
     };
 
@@ -244,11 +297,38 @@ namespace SparkyStudios::Audio::Amplitude
         }
     };
 
+    /**
+     * @brief Statistics of a numeric field over a time window.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerAggregateData : public ProfilerDataSnapshot
+    {
+        AmString mField; ///< Name of the aggregated field, as used in filters
+        AmReal64 mWindowSeconds; ///< Duration covered by the statistics
+
+        AmUInt64 mCount;
+        AmReal64 mMin;
+        AmReal64 mMax;
+        AmReal64 mMean;
+        AmReal64 mP50;
+        AmReal64 mP95;
+        AmReal64 mP99;
+
+        ProfilerAggregateData();
+    };
+
     /**
      * @brief Variant type that can hold any profiler data
      */
-    using ProfilerDataVariant = std::
-        variant<ProfilerEngineData, ProfilerEntityData, ProfilerChannelData, ProfilerListenerData, ProfilerPerformanceData, ProfilerEvent>;
+    using ProfilerDataVariant = std::variant<
+        ProfilerEngineData,
+        ProfilerEntityData,
+        ProfilerChannelData,
+        ProfilerListenerData,
+        ProfilerPerformanceData,
+        ProfilerEvent,
+        ProfilerAggregateData>;
 } // namespace SparkyStudios::Audio::Amplitude
 
 #endif // _AM_PROFILER_DATA_H
@@ -0,0 +1,187 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_FILTER_H
+#define _AM_PROFILER_FILTER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Operation codes of a compiled filter program.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerFilterOpCode : AmUInt8
+    {
+        eProfilerFilterOpCode_LoadNumber = 0,
+        eProfilerFilterOpCode_LoadString,
+        eProfilerFilterOpCode_PushNumber,
+        eProfilerFilterOpCode_PushString,
+        eProfilerFilterOpCode_Equal,
+        eProfilerFilterOpCode_NotEqual,
+        eProfilerFilterOpCode_Less,
+        eProfilerFilterOpCode_LessEqual,
+        eProfilerFilterOpCode_Greater,
+        eProfilerFilterOpCode_GreaterEqual,
+        eProfilerFilterOpCode_StringEqual,
+        eProfilerFilterOpCode_StringNotEqual,
+        eProfilerFilterOpCode_Match,
+        eProfilerFilterOpCode_NotMatch,
+        eProfilerFilterOpCode_And,
+        eProfilerFilterOpCode_Or,
+        eProfilerFilterOpCode_Not
+    };
+
+    /**
+     * @brief A single instruction of a compiled filter program.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerFilterInstruction
+    {
+        eProfilerFilterOpCode mOpCode;
+        AmUInt16 mOperand; ///< Field, constant or string index depending on the operation.
+    };
+
+    /**
+     * @brief Server-side predicate compiled from a filter expression.
+     *
+     * Expressions combine comparisons on message fields with `&&`, `||` and `!`:
+     *
+     * @code
+     * channel.gain > 0.1 && entity.distance < 50
+     * event.name ~ "Footstep*" || priority >= 3
+     * @endcode
+     *
+     * Fields are prefixed by the message type they belong to (`engine`, `entity`, `channel`,
+     * `listener`, `performance`, `event`, `aggregate`), except `type`, `category`, `priority`, `source`,
+     * `timestamp` and `messageId` which apply to every message. A comparison on a field the
+     * message does not have is neutral: it is dropped from the surrounding `&&` or `||`. A
+     * message passes only if at least one comparison applies to it and the result is true.
+     *
+     * The expression is compiled once into a flat postfix program. It can be evaluated
+     * one message at a time, or column by column over a batch of messages so that each
+     * instruction runs as a tight loop over all rows.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerFilter
+    {
+    public:
+        /**
+         * @brief Maximum depth of the evaluation stack of a filter program.
+         */
+        static constexpr AmSize kMaxStackDepth = 32;
+
+        /**
+         * @brief Default constructor. Creates an empty filter which accepts every message.
+         */
+        ProfilerFilter();
+
+        /**
+         * @brief Compile a filter expression.
+         *
+         * @param expression The expression to compile.
+         * @param error [out] Optional description of the compilation error.
+         * @return true if the expression was compiled successfully, false otherwise.
+         */
+        bool Compile(const AmString& expression, AmString* error = nullptr);
+
+        /**
+         * @brief Reset the filter so it accepts every message.
+         */
+        void Clear();
+
+        /**
+         * @brief Check if the filter has no compiled program.
+         *
+         * @return true if the filter accepts every message, false otherwise.
+         */
+        [[nodiscard]] bool IsEmpty() const;
+
+        /**
+         * @brief Get the expression the filter was compiled from.
+         *
+         * @return The source expression.
+         */
+        [[nodiscard]] const AmString& GetExpression() const;
+
+        /**
+         * @brief Evaluate the filter on a single message.
+         *
+         * @param message The message to test.
+         * @return true if the message matches the filter, false otherwise.
+         */
+        [[nodiscard]] bool Evaluate(const ProfilerDataVariant& message) const;
+
+        /**
+         * @brief Check if the filter has a comparison on a field the message can have.
+         *
+         * Evaluate() returns false both when such a comparison fails and when the message has
+         * none of the compared fields. This tells the two cases apart without evaluating.
+         *
+         * @param message The message to test.
+         * @return true if the filter applies to the message type, false otherwise.
+         */
+        [[nodiscard]] bool AppliesTo(const ProfilerDataVariant& message) const;
+
+        /**
+         * @brief Evaluate the filter on a batch of messages, one column at a time.
+         *
+         * The columns are kept in the filter between calls, so a filter evaluates one batch at a time.
+         *
+         * @param messages The messages to test.
+         * @param results [out] One entry per message, set to 1 if the message matches and 0 otherwise.
+         */
+        void EvaluateBatch(const std::vector<ProfilerDataVariant>& messages, std::vector<AmUInt8>& results);
+
+        /**
+         * @brief Find a numeric field usable in filter expressions, e.g. `performance.cpu`.
+         *
+         * @param name The name of the field.
+         * @return The index of the field, or -1 if there is no numeric field with this name.
+         */
+        [[nodiscard]] static AmInt32 FindNumberField(const AmString& name);
+
+        /**
+         * @brief Read a numeric field of a message.
+         *
+         * @param field The index returned by FindNumberField().
+         * @param message The message to read.
+         * @return The value of the field, or NaN if the message does not have it.
+         */
+        [[nodiscard]] static AmReal64 GetNumberField(AmInt32 field, const ProfilerDataVariant& message);
+
+    private:
+        AmString _expression;
+        std::vector<ProfilerFilterInstruction> _program;
+        std::vector<AmReal64> _numbers;
+        std::vector<AmString> _strings;
+        AmUInt32 _typeMask; // Bit per ProfilerDataVariant alternative the program can match
+
+        // Columns of EvaluateBatch, one per stack slot, reused between batches
+        std::vector<std::vector<AmReal64>> _numberColumns;
+        std::vector<std::vector<const AmString*>> _stringColumns;
+        std::vector<std::vector<AmUInt8>> _truthColumns;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_FILTER_H
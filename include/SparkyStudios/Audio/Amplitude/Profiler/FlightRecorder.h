@@ -0,0 +1,171 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_FLIGHT_RECORDER_H
+#define _AM_PROFILER_FLIGHT_RECORDER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Recording.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Keeps the most recent profiler messages in memory, to be dumped when the application crashes.
+     *
+     * Messages are encoded into a fixed ring of slots, each laid out as a recording chunk, and
+     * the oldest slot is overwritten once the ring is full. A dump is the recording header
+     * followed by the slots in order: a recording without footer, which the recording reader
+     * and tools open by scanning its chunks.
+     *
+     * Dumping neither allocates nor locks, so it runs from a crash handler. Once installed, the
+     * crash handler dumps the ring to a file opened beforehand on SIGSEGV, SIGABRT, SIGBUS, SIGILL
+     * and SIGFPE, or on unhandled exceptions on Windows, then hands the crash over to the handlers
+     * which were installed before it. A stack overflow is only caught on threads with an
+     * alternate signal stack.
+     *
+     * Messages are recorded by a single thread at a time.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerFlightRecorder
+    {
+    public:
+        /**
+         * @brief Default size of the ring, in bytes.
+         */
+        static constexpr AmSize kDefaultSize = 4 * 1024 * 1024;
+
+        /**
+         * @brief Number of slots in the ring. A dump holds between kSlotCount - 1 and kSlotCount slots of messages.
+         */
+        static constexpr AmUInt32 kSlotCount = 16;
+
+        ProfilerFlightRecorder();
+        ~ProfilerFlightRecorder();
+
+        // Non-copyable
+        ProfilerFlightRecorder(const ProfilerFlightRecorder&) = delete;
+        ProfilerFlightRecorder& operator=(const ProfilerFlightRecorder&) = delete;
+
+        /**
+         * @brief Allocate the ring.
+         *
+         * @param size The size of the ring, in bytes.
+         * @return true if the ring was allocated, false otherwise.
+         */
+        bool Initialize(AmSize size = kDefaultSize);
+
+        /**
+         * @brief Uninstall the crash handler and free the ring.
+         */
+        void Deinitialize();
+
+        /**
+         * @brief Make the ring resident in memory, so recording never faults. Undone when the ring is freed.
+         *
+         * @param residency Bitmask of eProfilerMemoryResidency.
+         */
+        void Prefault(AmUInt32 residency);
+
+        /**
+         * @brief Check if the ring is allocated.
+         */
+        [[nodiscard]] AM_INLINE bool IsInitialized() const
+        {
+            return _memory != nullptr;
+        }
+
+        /**
+         * @brief Add a message to the ring, overwriting the oldest messages if needed.
+         *
+         * @param data The message to record.
+         */
+        void Record(const ProfilerDataVariant& data);
+
+        /**
+         * @brief Write the content of the ring to an open file.
+         *
+         * This function is async-signal-safe: it does not allocate nor lock.
+         *
+         * @param file A file descriptor, or a file handle on Windows, opened for writing.
+         * @return true if the whole ring was written, false otherwise.
+         */
+        bool Dump(std::intptr_t file) const;
+
+        /**
+         * @brief Write the content of the ring to a recording file.
+         *
+         * @param path The path of the file to create. An existing file is overwritten.
+         * @return true if the file was written, false otherwise.
+         */
+        bool DumpToFile(const AmOsString& path) const;
+
+        /**
+         * @brief Dump the ring to the given file when the application crashes.
+         *
+         * The file is created now, so nothing needs to be allocated or opened at crash time. It
+         * is removed when the crash handler is uninstalled if no dump was written to it. Only one
+         * flight recorder can have a crash handler installed at a time.
+         *
+         * @param path The path of the crash dump.
+         * @return true if the crash handler was installed, false otherwise.
+         */
+        bool InstallCrashHandler(const AmOsString& path);
+
+        /**
+         * @brief Restore the previous crash handlers and close the crash dump file.
+         */
+        void UninstallCrashHandler();
+
+        /**
+         * @brief Check if this flight recorder has a crash handler installed.
+         */
+        [[nodiscard]] bool IsCrashHandlerInstalled() const;
+
+    private:
+        struct Slot
+        {
+            AmUInt8* mData = nullptr;
+            std::atomic<AmUInt64> mSequence = 0; // Order of the slot in the ring, 0 when never used
+            std::atomic<AmUInt64> mCommitted = 0; // Message count in the high 32 bits, size in bytes in the low 32 bits
+            std::atomic<AmInt64> mFirstTimestamp = 0;
+            std::atomic<AmInt64> mLastTimestamp = 0;
+        };
+
+        static_assert(std::atomic<AmUInt64>::is_always_lock_free, "Flight recorder dumps rely on lock-free atomics");
+
+        AmUInt8* _memory;
+        AmSize _slotCapacity;
+        AmUInt32 _residency;
+        Slot _slots[kSlotCount];
+        AmUInt32 _current;
+        AmUInt64 _nextSequence;
+        AmUInt8 _header[ProfilerRecordingHeader::kSize]; // Encoded once, so dumps do not depend on the clock
+        std::vector<AmUInt8> _scratch;
+
+        AmOsString _crashPath;
+
+        mutable AmMutexHandle _mutex;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_FLIGHT_RECORDER_H
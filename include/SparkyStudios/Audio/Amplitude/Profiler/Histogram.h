@@ -0,0 +1,118 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_HISTOGRAM_H
+#define _AM_PROFILER_HISTOGRAM_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Histogram with logarithmic buckets, used to compute percentiles.
+     *
+     * Values are counted in buckets whose width grows with the value, so every percentile
+     * is known within a fixed relative error. Memory does not depend on the number of
+     * recorded values, and two histograms with the same layout can be merged, which makes
+     * it possible to build partial histograms in parallel and combine them afterwards.
+     * Values below the lowest trackable value are counted in the first bucket, and values
+     * above the highest one in the last bucket. This class is not thread-safe.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerHistogram
+    {
+    public:
+        /**
+         * @brief Create a histogram.
+         *
+         * @param lowestValue The lowest value tracked with the given precision. Must be greater than 0.
+         * @param highestValue The highest value tracked with the given precision.
+         * @param relativeError The maximum relative error of a percentile, for example 0.01 for 1%.
+         */
+        explicit ProfilerHistogram(AmReal64 lowestValue = 1e-3, AmReal64 highestValue = 1e9, AmReal64 relativeError = 0.01);
+
+        /**
+         * @brief Count a value.
+         *
+         * @param value The value to count.
+         * @param count The number of times the value was observed.
+         */
+        void Record(AmReal64 value, AmUInt64 count = 1);
+
+        /**
+         * @brief Add the counts of another histogram to this one.
+         *
+         * @param other The histogram to merge.
+         * @return true if the histograms were merged, false if their layouts differ.
+         */
+        bool Merge(const ProfilerHistogram& other);
+
+        /**
+         * @brief Remove all recorded values.
+         */
+        void Reset();
+
+        /**
+         * @brief Get the value below which the given percentage of values fall.
+         *
+         * @param percentile The percentile to compute, between 0 and 100.
+         * @return The value at the percentile, or 0 if the histogram is empty.
+         */
+        [[nodiscard]] AmReal64 GetPercentile(AmReal64 percentile) const;
+
+        /**
+         * @brief Get the number of recorded values.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetCount() const
+        {
+            return _count;
+        }
+
+        /**
+         * @brief Get the smallest recorded value, or 0 if the histogram is empty.
+         */
+        [[nodiscard]] AmReal64 GetMin() const;
+
+        /**
+         * @brief Get the largest recorded value, or 0 if the histogram is empty.
+         */
+        [[nodiscard]] AmReal64 GetMax() const;
+
+        /**
+         * @brief Get the mean of the recorded values, or 0 if the histogram is empty.
+         */
+        [[nodiscard]] AmReal64 GetMean() const;
+
+    private:
+        [[nodiscard]] AmSize _getBucketIndex(AmReal64 value) const;
+        [[nodiscard]] AmReal64 _getBucketValue(AmSize index) const;
+
+        AmReal64 _lowestValue;
+        AmReal64 _highestValue;
+        AmReal64 _logBase; // Logarithm of the ratio between two consecutive bucket bounds
+        std::vector<AmUInt64> _buckets;
+
+        AmUInt64 _count;
+        AmReal64 _sum;
+        AmReal64 _min;
+        AmReal64 _max;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_HISTOGRAM_H
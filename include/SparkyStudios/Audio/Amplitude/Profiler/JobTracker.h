@@ -0,0 +1,223 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_JOB_TRACKER_H
+#define _AM_PROFILER_JOB_TRACKER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Realtime.h>
+
+#include <atomic>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Activity of a job worker since the previous collection.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerJobWorkerStats
+    {
+        AmString mName;
+        AmUInt64 mJobs = 0;
+        AmUInt64 mSteals = 0; ///< Jobs taken from the queue of another worker
+        AmUInt64 mWaitNs = 0; ///< Time the jobs spent queued before a worker started them
+        AmUInt64 mMaxWaitNs = 0;
+        AmUInt64 mExecNs = 0;
+        AmUInt64 mMaxExecNs = 0;
+        AmReal64 mUtilization = 0.0; ///< Fraction of the interval spent running jobs, between 0 and 1
+    };
+
+    /**
+     * @brief Hooks for a job system to report the jobs its workers run.
+     *
+     * The job system stamps each job when it is queued, and its workers report when they
+     * start and finish it. A queue wait much longer than the execution time means the
+     * workers are starved, while a long execution time means the jobs themselves are slow.
+     *
+     * Each worker registers once and gets its own counters, on their own cache line, so the
+     * hooks are lock-free and only the queued job count is shared between threads. When the
+     * timeline is enabled, every finished job is also copied into a ring owned by its worker,
+     * and drained by the profiler update thread as one event per job.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerJobTracker
+    {
+    public:
+        /**
+         * @brief Maximum number of workers reporting at once.
+         */
+        static constexpr AmUInt32 kMaxWorkers = 32;
+
+        /**
+         * @brief Returned by RegisterWorker() when no more workers can report.
+         */
+        static constexpr AmUInt32 kInvalidWorker = ~0u;
+
+        ProfilerJobTracker();
+        ~ProfilerJobTracker();
+
+        // Non-copyable
+        ProfilerJobTracker(const ProfilerJobTracker&) = delete;
+        ProfilerJobTracker& operator=(const ProfilerJobTracker&) = delete;
+
+        /**
+         * @brief Enable or disable the measurements. When disabled, the hooks return immediately.
+         */
+        AM_INLINE void SetEnabled(bool enabled) noexcept
+        {
+            _enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Check if the measurements are enabled.
+         */
+        [[nodiscard]] AM_INLINE bool IsEnabled() const noexcept
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Enable or disable the capture of one event per job.
+         */
+        AM_INLINE void SetTimelineEnabled(bool enabled) noexcept
+        {
+            _timeline.store(enabled, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Start reporting the jobs of the calling worker. This function allocates.
+         *
+         * @param name The name of the worker.
+         * @param timelineCapacity The number of finished jobs the worker's timeline ring holds.
+         * @param residency The bitmask of eProfilerMemoryResidency applied to the ring.
+         * @return The handle to pass to the hooks, or kInvalidWorker when too many workers report.
+         */
+        AmUInt32 RegisterWorker(const AmString& name, AmUInt32 timelineCapacity, AmUInt32 residency = eProfilerMemoryResidency_Prefault);
+
+        /**
+         * @brief Stop reporting the jobs of a worker, e.g. before it exits.
+         *
+         * @param worker The handle returned by RegisterWorker().
+         */
+        void UnregisterWorker(AmUInt32 worker);
+
+        /**
+         * @brief Stamp a job as it is queued. This function is lock-free.
+         *
+         * @return The time to store with the job and pass to OnJobStarted() and OnJobFinished(), 0 when disabled.
+         */
+        AmInt64 OnJobQueued() noexcept;
+
+        /**
+         * @brief Report that a worker starts a job. This function is lock-free.
+         *
+         * @param worker The handle returned by RegisterWorker().
+         * @param queuedNs The time returned by OnJobQueued().
+         * @param stolen Whether the worker took the job from the queue of another worker.
+         * @return The start time to pass to OnJobFinished().
+         */
+        AmInt64 OnJobStarted(AmUInt32 worker, AmInt64 queuedNs, bool stolen = false) noexcept;
+
+        /**
+         * @brief Report that a worker finished a job. This function is lock-free.
+         *
+         * @param worker The handle returned by RegisterWorker().
+         * @param name The name of the job, a string literal, e.g. "DecodeStream".
+         * @param id The object the job is about, e.g. a channel, 0 for none.
+         * @param queuedNs The time returned by OnJobQueued().
+         * @param startNs The time returned by OnJobStarted().
+         */
+        void OnJobFinished(AmUInt32 worker, const char* name, AmUInt64 id, AmInt64 queuedNs, AmInt64 startNs) noexcept;
+
+        /**
+         * @brief Get the number of jobs queued and not started yet.
+         */
+        [[nodiscard]] AM_INLINE AmInt64 GetQueuedCount() const noexcept
+        {
+            return _queued.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the activity of each worker since the previous collection. Profiler update thread only.
+         *
+         * @param workers [out] The activity of every registered worker.
+         */
+        void Collect(std::vector<ProfilerJobWorkerStats>& workers);
+
+        /**
+         * @brief Turn the jobs finished since the last call into events. Profiler update thread only.
+         *
+         * Workers which were unregistered are released once their last jobs are drained.
+         *
+         * @param events [out] An event is appended for every job.
+         */
+        void DrainTimeline(std::vector<ProfilerEvent>& events);
+
+        /**
+         * @brief Get the current time, as used in the stamps. This function is wait-free.
+         */
+        [[nodiscard]] static AM_INLINE AmInt64 Now() noexcept
+        {
+            return ProfilerRealtimeCapture::Now();
+        }
+
+    private:
+        enum eWorkerState : AmUInt8
+        {
+            eWorkerState_Free = 0,
+            eWorkerState_Active = 1,
+            eWorkerState_Closing = 2, // Unregistered, waiting for its last jobs to be drained
+        };
+
+        struct alignas(64) Worker
+        {
+            std::atomic<eWorkerState> mState = eWorkerState_Free;
+            ProfilerRealtimeRing* mRing = nullptr;
+            AmString mName;
+
+            // Written by the worker only, totals since the registration
+            std::atomic<AmUInt64> mJobs = 0;
+            std::atomic<AmUInt64> mSteals = 0;
+            std::atomic<AmUInt64> mWaitNs = 0;
+            std::atomic<AmUInt64> mExecNs = 0;
+
+            // Raised by the worker, reset by the collection
+            std::atomic<AmUInt64> mMaxWaitNs = 0;
+            std::atomic<AmUInt64> mMaxExecNs = 0;
+
+            // Profiler update thread only, totals at the previous collection
+            ProfilerJobWorkerStats mCollected;
+            AmInt64 mCollectedNs = 0;
+        };
+
+        void _drain(Worker& worker, std::vector<ProfilerEvent>& events);
+
+        Worker _workers[kMaxWorkers];
+        std::atomic<bool> _enabled;
+        std::atomic<bool> _timeline;
+        std::atomic<AmInt64> _queued;
+
+        std::vector<ProfilerRealtimeRecord> _records; // Drained records, reused between drains
+        AmMutexHandle _mutex; // Protects registration, collection and draining
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_JOB_TRACKER_H
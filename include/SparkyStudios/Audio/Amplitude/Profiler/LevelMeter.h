@@ -0,0 +1,223 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_LEVEL_METER_H
+#define _AM_PROFILER_LEVEL_METER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    struct ProfilerAudioTapRing;
+
+    /**
+     * @brief Levels of a bus since the previous collection.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerBusLevels
+    {
+        /**
+         * @brief Level reported for silence, instead of minus infinity.
+         */
+        static constexpr AmReal32 kSilenceDb = -144.0f;
+
+        AmString mName;
+        AmUInt32 mChannels = 0;
+        AmUInt64 mFrames = 0; ///< Frames measured since the previous collection
+        std::vector<AmReal32> mPeakDbfs; ///< Sample peak of each channel
+        std::vector<AmReal32> mRmsDbfs; ///< RMS level of each channel
+        AmReal32 mLoudnessShortTerm = kSilenceDb; ///< Loudness of the last 3 seconds, in LUFS
+        AmUInt64 mClippedSamples = 0; ///< Samples at or above full scale
+        AmUInt64 mDroppedFrames = 0; ///< Frames the tap could not copy because its ring was full
+
+        /**
+         * @brief Get the highest peak of every channel.
+         */
+        [[nodiscard]] AmReal32 GetPeakDbfs() const;
+
+        /**
+         * @brief Get the highest RMS level of every channel.
+         */
+        [[nodiscard]] AmReal32 GetRmsDbfs() const;
+    };
+
+    /**
+     * @brief Meters the signal of the mixer buses: sample peak, RMS level and short-term loudness.
+     *
+     * The audio thread taps the output buffer of each bus: Push() copies the interleaved
+     * samples into a ring owned by the bus, and never waits nor allocates. Buffers which do
+     * not fit are dropped and counted, so a late profiler never slows the mixer down.
+     *
+     * The profiler update thread drains the rings and measures the copies with vectorized
+     * kernels, SSE2 on x86 and NEON on ARM. Loudness follows ITU-R BS.1770: the samples are
+     * K-weighted, their energy is summed in blocks of 100 ms, and the short-term loudness is
+     * the mean of the last 30 blocks, without gating. Surround channels of 5.1 and 7.1 buses
+     * are weighted by 1.41, and the LFE channel is left out.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerLevelMeter
+    {
+    public:
+        /**
+         * @brief Maximum number of buses metered at once.
+         */
+        static constexpr AmUInt32 kMaxBuses = 16;
+
+        /**
+         * @brief Returned by RegisterBus() when no more buses can be metered.
+         */
+        static constexpr AmUInt32 kInvalidBus = ~0u;
+
+        /**
+         * @brief Maximum number of channels of a bus.
+         */
+        static constexpr AmUInt32 kMaxChannels = 8;
+
+        /**
+         * @brief Number of loudness blocks in the short-term window.
+         */
+        static constexpr AmUInt32 kShortTermBlocks = 30;
+
+        ProfilerLevelMeter();
+        ~ProfilerLevelMeter();
+
+        // Non-copyable
+        ProfilerLevelMeter(const ProfilerLevelMeter&) = delete;
+        ProfilerLevelMeter& operator=(const ProfilerLevelMeter&) = delete;
+
+        /**
+         * @brief Enable or disable the taps of every bus.
+         */
+        AM_INLINE void SetEnabled(bool enabled) noexcept
+        {
+            _enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Check if the taps are enabled.
+         */
+        [[nodiscard]] AM_INLINE bool IsEnabled() const noexcept
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Start metering a bus. This function allocates.
+         *
+         * @param name The name of the bus, added to its levels.
+         * @param channels The number of interleaved channels of the bus buffers.
+         * @param sampleRate The sample rate of the bus.
+         * @param capacityFrames The number of frames the tap buffers until the update thread measures them.
+         * @param residency The bitmask of eProfilerMemoryResidency to apply to the tap.
+         * @return The handle to pass to Push(), or kInvalidBus when the bus cannot be metered.
+         */
+        AmUInt32 RegisterBus(const AmString& name, AmUInt32 channels, AmUInt32 sampleRate, AmUInt32 capacityFrames, AmUInt32 residency);
+
+        /**
+         * @brief Stop metering a bus. Its tap is released by the next processing.
+         *
+         * @param bus The handle returned by RegisterBus().
+         */
+        void UnregisterBus(AmUInt32 bus);
+
+        /**
+         * @brief Copy a buffer of a bus into its tap. This function is wait-free.
+         *
+         * @param bus The handle of the bus.
+         * @param samples The interleaved samples of the buffer.
+         * @param frames The number of frames in the buffer.
+         * @return false if the buffer was dropped, because the taps are disabled or the tap is full.
+         */
+        bool Push(AmUInt32 bus, const AmReal32* samples, AmUInt32 frames) noexcept;
+
+        /**
+         * @brief Measure the buffers tapped since the last call. Profiler update thread only.
+         *
+         * Buses which were unregistered are released once their last buffers are measured.
+         */
+        void Process();
+
+        /**
+         * @brief Get the levels of every bus since the previous collection. Profiler update thread only.
+         *
+         * @param buses [out] An entry is appended for every bus which was measured.
+         */
+        void Collect(std::vector<ProfilerBusLevels>& buses);
+
+    private:
+        enum eBusState : AmUInt8
+        {
+            eBusState_Free = 0,
+            eBusState_Active = 1,
+            eBusState_Closing = 2, // Unregistered, waiting for its last buffers to be measured
+        };
+
+        // Direct form II transposed, in double precision so the low cut stays stable at high sample rates
+        struct Biquad
+        {
+            AmReal64 mB0 = 1.0, mB1 = 0.0, mB2 = 0.0, mA1 = 0.0, mA2 = 0.0;
+        };
+
+        struct MeteredBus
+        {
+            std::atomic<eBusState> mState = eBusState_Free;
+            ProfilerAudioTapRing* mRing = nullptr; // Shared with the audio thread
+            AmString mName;
+            AmUInt32 mChannels = 0;
+            AmUInt32 mBlockFrames = 0; // Frames in a loudness block of 100 ms
+
+            // K-weighting filters, and their state per channel
+            Biquad mShelf;
+            Biquad mHighPass;
+            std::array<std::array<AmReal64, 4>, kMaxChannels> mFilterState = {};
+            std::array<AmReal32, kMaxChannels> mChannelWeights = {};
+
+            // Loudness blocks
+            std::array<AmReal64, kMaxChannels> mBlockEnergy = {};
+            AmUInt32 mBlockPosition = 0;
+            std::array<AmReal64, kShortTermBlocks> mBlocks = {}; // Weighted mean square of the last blocks
+            AmUInt32 mBlockCount = 0;
+
+            // Levels since the previous collection
+            std::array<AmReal32, kMaxChannels> mPeak = {};
+            std::array<AmReal64, kMaxChannels> mSquares = {};
+            AmUInt64 mFrames = 0;
+            AmUInt64 mClipped = 0;
+            AmUInt64 mReportedDropped = 0;
+        };
+
+        void _measure(MeteredBus& bus, AmUInt32 frames);
+        void _closeBlock(MeteredBus& bus);
+        static AmReal32 _shortTermLoudness(const MeteredBus& bus);
+
+        MeteredBus _buses[kMaxBuses];
+        std::atomic<bool> _enabled;
+
+        std::vector<AmReal32> _interleaved; // Samples drained from a tap, reused between buses
+        std::vector<AmReal32> _channel; // Samples of one channel, reused between channels
+
+        AmMutexHandle _mutex; // Protects registration, processing and collection
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_LEVEL_METER_H
@@ -0,0 +1,195 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_LOCK_PROFILER_H
+#define _AM_PROFILER_LOCK_PROFILER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Contention statistics of a named lock, summed over every thread.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerLockStats
+    {
+        /**
+         * @brief Number of buckets of the wait time histogram. Each power of two is split in two buckets.
+         */
+        static constexpr AmSize kWaitBucketCount = 64;
+
+        AmString mName;
+        AmUInt64 mAcquisitions = 0;
+        AmUInt64 mContentions = 0; ///< Acquisitions which found the lock held by another thread
+        AmUInt64 mWaitNs = 0;
+        AmUInt64 mMaxWaitNs = 0;
+        AmUInt64 mHoldNs = 0;
+        AmUInt64 mMaxHoldNs = 0;
+        AmUInt64 mTopWaiterThread = 0; ///< Thread which waited the longest for the lock
+        AmUInt64 mTopHolderThread = 0; ///< Thread which made the others wait the longest
+        std::array<AmUInt64, kWaitBucketCount> mWaitBuckets = {};
+
+        /**
+         * @brief Get the bucket of a wait time.
+         */
+        [[nodiscard]] static AmSize GetWaitBucket(AmUInt64 waitNs);
+
+        /**
+         * @brief Get the highest wait time counted in a bucket.
+         */
+        [[nodiscard]] static AmUInt64 GetWaitBucketUpperBoundNs(AmSize bucket);
+
+        /**
+         * @brief Get the wait time below which the given percentage of acquisitions fall.
+         *
+         * The value is the upper bound of a bucket, so it is at most about 1.5 times the exact percentile.
+         *
+         * @param percentile The percentile, between 0 and 100.
+         */
+        [[nodiscard]] AmUInt64 GetWaitPercentileNs(AmReal64 percentile) const;
+    };
+
+    /**
+     * @brief Records contention on instrumented locks.
+     *
+     * Each thread writes its measurements into its own table of counters, indexed by lock,
+     * so instrumenting a lock adds no shared writes besides the lock itself. Tables are
+     * recycled when their thread exits. Collect() sums the tables of every thread.
+     *
+     * Profiling is opt-in: when disabled, instrumented locks only track their owner.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerLockProfiler
+    {
+    public:
+        /**
+         * @brief Maximum number of distinct lock names.
+         */
+        static constexpr AmUInt32 kMaxLocks = 64;
+
+        /**
+         * @brief Returned by RegisterLock() when no more locks can be named.
+         */
+        static constexpr AmUInt32 kInvalidLock = ~0u;
+
+        /**
+         * @brief Enable or disable the measurements.
+         */
+        static void SetEnabled(bool enabled);
+
+        /**
+         * @brief Check if the measurements are enabled.
+         */
+        [[nodiscard]] static bool IsEnabled();
+
+        /**
+         * @brief Get the identifier of a lock name, registering it on first use.
+         *
+         * Locks sharing a name share their statistics, e.g. one mutex per voice.
+         *
+         * @param name The name of the lock.
+         * @return The lock identifier, or kInvalidLock when too many names are registered.
+         */
+        static AmUInt32 RegisterLock(const char* name);
+
+        /**
+         * @brief Record the wait of an acquisition.
+         *
+         * @param lock The lock identifier.
+         * @param waitNs The time spent waiting for the lock.
+         * @param holder The thread which held the lock when the wait started, 0 if it was free.
+         */
+        static void RecordWait(AmUInt32 lock, AmUInt64 waitNs, AmUInt64 holder);
+
+        /**
+         * @brief Record how long a lock was held.
+         *
+         * @param lock The lock identifier.
+         * @param holdNs The time between the acquisition and the release.
+         */
+        static void RecordHold(AmUInt32 lock, AmUInt64 holdNs);
+
+        /**
+         * @brief Sum the statistics of every thread.
+         *
+         * @param stats [out] The statistics, indexed by lock identifier. The counters are totals since the process started.
+         */
+        static void Collect(std::vector<ProfilerLockStats>& stats);
+
+        /**
+         * @brief Get a monotonic time in nanoseconds, as used in the measurements.
+         */
+        [[nodiscard]] static AmUInt64 Now();
+
+        /**
+         * @brief Get an identifier of the calling thread, never 0.
+         */
+        [[nodiscard]] static AmUInt64 GetCurrentThread();
+    };
+
+    /**
+     * @brief A mutex which reports its contention to the lock profiler.
+     *
+     * The mutex records its owner, so a waiting thread knows which thread it waits for. When lock
+     * profiling is enabled, the wait and hold times of each outermost acquisition are recorded.
+     * Nested acquisitions by the owner are counted as the same acquisition.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerMutex
+    {
+    public:
+        /**
+         * @brief Create a mutex.
+         *
+         * @param name The name of the mutex in the lock statistics.
+         */
+        explicit ProfilerMutex(const char* name);
+        ~ProfilerMutex();
+
+        // Non-copyable
+        ProfilerMutex(const ProfilerMutex&) = delete;
+        ProfilerMutex& operator=(const ProfilerMutex&) = delete;
+
+        /**
+         * @brief Lock the mutex, waiting for it if needed.
+         */
+        void Lock();
+
+        /**
+         * @brief Unlock the mutex.
+         */
+        void Unlock();
+
+    private:
+        AmMutexHandle _handle;
+        AmUInt32 _lock;
+
+        std::atomic<AmUInt64> _owner; // 0 when free
+        AmUInt32 _depth; // Owner only
+        AmUInt64 _acquiredNs; // Owner only, 0 when the acquisition was not measured
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_LOCK_PROFILER_H
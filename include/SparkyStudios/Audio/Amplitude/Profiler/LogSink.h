@@ -0,0 +1,263 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_LOG_SINK_H
+#define _AM_PROFILER_LOG_SINK_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Log a message through the profiler log sink, rate limited per call site.
+ *
+ * The format string is printf-style and must be a string literal.
+ */
+#define AM_PROFILER_LOG(_level_, _format_, ...)                                                                                            \
+    do                                                                                                                                     \
+    {                                                                                                                                      \
+        static ::SparkyStudios::Audio::Amplitude::ProfilerLogSite _amProfilerLogSite(_level_, _format_);                                   \
+        ::SparkyStudios::Audio::Amplitude::ProfilerLogSink::Log(_amProfilerLogSite, ##__VA_ARGS__);                                        \
+    } while (false)
+
+#define amProfilerLogDebug(_format_, ...)                                                                                                  \
+    AM_PROFILER_LOG(::SparkyStudios::Audio::Amplitude::eLogMessageLevel_Debug, _format_, ##__VA_ARGS__)
+#define amProfilerLogInfo(_format_, ...) AM_PROFILER_LOG(::SparkyStudios::Audio::Amplitude::eLogMessageLevel_Info, _format_, ##__VA_ARGS__)
+#define amProfilerLogWarning(_format_, ...)                                                                                                \
+    AM_PROFILER_LOG(::SparkyStudios::Audio::Amplitude::eLogMessageLevel_Warning, _format_, ##__VA_ARGS__)
+#define amProfilerLogError(_format_, ...)                                                                                                  \
+    AM_PROFILER_LOG(::SparkyStudios::Audio::Amplitude::eLogMessageLevel_Error, _format_, ##__VA_ARGS__)
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief A call site of the profiler log macros.
+     *
+     * Each site holds its own rate limiting window, and counts the messages it suppressed
+     * so they are reported later as a single line.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerLogSite
+    {
+        ProfilerLogSite(eLogMessageLevel level, const char* format);
+
+        const char* mFormat;
+        eLogMessageLevel mLevel;
+        std::atomic<AmInt64> mWindowStartNs;
+        std::atomic<AmUInt32> mWindowCount;
+        std::atomic<AmUInt64> mSuppressed;
+        ProfilerLogSite* mNext; ///< Next site in the list of all sites
+    };
+
+    /**
+     * @brief A log message with its arguments captured in binary form.
+     *
+     * Strings are copied into the record, truncated if needed, so the caller's memory
+     * can go away before the message is formatted.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerLogRecord
+    {
+        static constexpr AmUInt32 kMaxArguments = 8;
+        static constexpr AmSize kTextSize = 160;
+
+        enum eArgumentType : AmUInt8
+        {
+            eArgumentType_Int = 0,
+            eArgumentType_UInt = 1,
+            eArgumentType_Double = 2,
+            eArgumentType_String = 3,
+            eArgumentType_Pointer = 4,
+        };
+
+        const ProfilerLogSite* mSite;
+        AmInt64 mTimestampNs; ///< Wall clock time, in nanoseconds since the epoch
+        AmUInt64 mThreadId;
+        AmUInt64 mSuppressed; ///< Messages the site suppressed before this one
+        AmUInt64 mPosition; ///< Position of the record in the ring
+        AmUInt32 mArgumentCount;
+        AmUInt32 mTextSize;
+        eArgumentType mTypes[kMaxArguments];
+        AmUInt64 mArguments[kMaxArguments]; ///< Values, or offset and size in mText for strings
+        char mText[kTextSize];
+    };
+
+    /**
+     * @brief Asynchronous sink for the profiler's own logs.
+     *
+     * Messages are captured in binary form into a lock-free ring, then formatted and written
+     * to a file by a background thread, so logging from hot paths costs a few atomic operations
+     * and copies. Each call site logs at most the configured number of messages per second, and
+     * the messages above it are reported as a single "dropped" line.
+     *
+     * When the sink is not started, messages are formatted immediately and forwarded to the
+     * engine logger, still rate limited. When the ring is full, messages are dropped and
+     * counted.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerLogSink
+    {
+    public:
+        /**
+         * @brief Default number of records in the ring.
+         */
+        static constexpr AmUInt32 kDefaultCapacity = 4096;
+
+        /**
+         * @brief Default number of messages logged per second by each call site.
+         */
+        static constexpr AmUInt32 kDefaultRateLimit = 10;
+
+        /**
+         * @brief Start writing the logs to a file.
+         *
+         * @param path The path of the log file. Logs are appended to an existing file.
+         * @param level The lowest level of the messages to write.
+         * @param rateLimit The number of messages logged per second by each call site, 0 for no limit.
+         * @param capacity The number of records in the ring, rounded up to a power of two.
+         * @return true if the sink was started, false otherwise.
+         */
+        static bool Start(
+            const AmOsString& path,
+            eLogMessageLevel level,
+            AmUInt32 rateLimit = kDefaultRateLimit,
+            AmUInt32 capacity = kDefaultCapacity);
+
+        /**
+         * @brief Write the pending messages, and stop the sink.
+         */
+        static void Stop();
+
+        /**
+         * @brief Check if the sink is writing to a file.
+         */
+        [[nodiscard]] static bool IsRunning();
+
+        /**
+         * @brief Set the number of messages logged per second by each call site, 0 for no limit.
+         */
+        static void SetRateLimit(AmUInt32 rateLimit);
+
+        /**
+         * @brief Get the number of messages dropped because the ring was full.
+         */
+        [[nodiscard]] static AmUInt64 GetDroppedCount();
+
+        /**
+         * @brief Log a message from a call site. Use the amProfilerLog macros instead.
+         */
+        template<typename... Args>
+        static void Log(ProfilerLogSite& site, const Args&... args)
+        {
+            static_assert(sizeof...(Args) <= ProfilerLogRecord::kMaxArguments, "Too many arguments for a profiler log message");
+
+            AmUInt64 suppressed = 0;
+            if (!_admit(site, suppressed))
+                return;
+
+            ProfilerLogRecord* record = _acquire();
+            if (record == nullptr)
+            {
+                // Not started: format now for the engine logger
+                if (!IsRunning())
+                    _forward(site, suppressed, _toPrintfArgument(args)...);
+
+                return;
+            }
+
+            record->mSite = &site;
+            record->mSuppressed = suppressed;
+            record->mArgumentCount = 0;
+            record->mTextSize = 0;
+            (_capture(*record, args), ...);
+
+            _publish(record);
+        }
+
+    private:
+        static bool _admit(ProfilerLogSite& site, AmUInt64& suppressed);
+        static ProfilerLogRecord* _acquire();
+        static void _publish(ProfilerLogRecord* record);
+        static void _forward(const ProfilerLogSite& site, AmUInt64 suppressed, ...);
+        static void _writeLoop(AmVoidPtr userData);
+
+        static void _captureString(ProfilerLogRecord& record, std::string_view value);
+
+        template<typename T>
+        static void _capture(ProfilerLogRecord& record, const T& value)
+        {
+            using Type = std::decay_t<T>;
+
+            if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>)
+            {
+                _captureString(record, value != nullptr ? std::string_view(value) : std::string_view("(null)"));
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                _captureString(record, value);
+            }
+            else if constexpr (std::is_enum_v<Type>)
+            {
+                _capture(record, static_cast<std::underlying_type_t<Type>>(value));
+            }
+            else
+            {
+                const AmUInt32 index = record.mArgumentCount++;
+
+                if constexpr (std::is_floating_point_v<Type>)
+                {
+                    const auto converted = static_cast<AmReal64>(value);
+                    record.mTypes[index] = ProfilerLogRecord::eArgumentType_Double;
+                    std::memcpy(&record.mArguments[index], &converted, sizeof(converted));
+                }
+                else if constexpr (std::is_pointer_v<Type>)
+                {
+                    record.mTypes[index] = ProfilerLogRecord::eArgumentType_Pointer;
+                    record.mArguments[index] = reinterpret_cast<std::uintptr_t>(value);
+                }
+                else if constexpr (std::is_signed_v<Type>)
+                {
+                    record.mTypes[index] = ProfilerLogRecord::eArgumentType_Int;
+                    record.mArguments[index] = static_cast<AmUInt64>(static_cast<AmInt64>(value));
+                }
+                else
+                {
+                    record.mTypes[index] = ProfilerLogRecord::eArgumentType_UInt;
+                    record.mArguments[index] = static_cast<AmUInt64>(value);
+                }
+            }
+        }
+
+        template<typename T>
+        static auto _toPrintfArgument(const T& value)
+        {
+            if constexpr (std::is_same_v<std::decay_t<T>, AmString>)
+                return value.c_str();
+            else
+                return value;
+        }
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_LOG_SINK_H
@@ -17,16 +17,30 @@
 #ifndef _AM_PROFILER_MANAGER_H
 #define _AM_PROFILER_MANAGER_H
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <memory>
 
 #include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Aggregator.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Alert.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Anomaly.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Config.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/DataCollector.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/FlightRecorder.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/JobTracker.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LevelMeter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LockProfiler.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Messaging.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/PerfCounters.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/RateMeter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Realtime.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Recording.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Server.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/StackSampler.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Watchdog.h>
 
 namespace SparkyStudios::Audio::Amplitude
 {
@@ -44,6 +58,31 @@ namespace SparkyStudios::Audio::Amplitude
     class AM_API_PUBLIC ProfilerManager
     {
     public:
+        /**
+         * @brief Name of the events periodically emitted with the profiler statistics.
+         */
+        static constexpr const char* kStatisticsEventName = "ProfilerStatistics";
+
+        /**
+         * @brief Name of the events periodically emitted with the most contended locks.
+         */
+        static constexpr const char* kLockContentionEventName = "LockContention";
+
+        /**
+         * @brief Name of the events emitted at each update with the activity of the job system.
+         */
+        static constexpr const char* kJobSystemEventName = "JobSystem";
+
+        /**
+         * @brief Name of the events periodically emitted with the performance counters of each measured scope.
+         */
+        static constexpr const char* kPerfCountersEventName = "PerfCounters";
+
+        /**
+         * @brief Name of the events periodically emitted with the levels of each metered bus.
+         */
+        static constexpr const char* kAudioLevelsEventName = "AudioLevels";
+
         /**
          * @brief Get the singleton instance.
          */
@@ -110,6 +149,54 @@ namespace SparkyStudios::Audio::Amplitude
         bool IsNetworkServerRunning() const;
         AmUInt32 GetConnectedClientCount() const;
 
+        // Recording management
+        bool StartRecording(const AmOsString& path);
+        void StopRecording();
+        bool IsRecording() const;
+
+        // Flight recorder
+        bool DumpFlightRecorder(const AmOsString& path) const;
+
+        // Audio thread monitoring, heartbeats are lock-free. Audio threads are also stack sampled when enabled
+        AmUInt32 RegisterAudioThread(const AmString& name, AmReal64 bufferPeriodMs);
+        void UnregisterAudioThread(AmUInt32 thread);
+        void AudioHeartbeat(AmUInt32 thread);
+        AM_INLINE ProfilerStackSampler* GetStackSampler() const
+        {
+            return _sampler.get();
+        }
+
+        // Performance counters of audio threads, read between heartbeats and around the scopes measured with the returned handle
+        AmUInt32 GetAudioThreadCounters(AmUInt32 thread) const;
+        AM_INLINE ProfilerPerfCounters* GetPerfCounters() const
+        {
+            return _perf.get();
+        }
+
+        // Level metering, the mixer pushes the output buffers of each bus to the wait-free tap of the meter
+        AmUInt32 RegisterAudioBus(const AmString& name, AmUInt32 channels, AmUInt32 sampleRate);
+        void UnregisterAudioBus(AmUInt32 bus);
+        AM_INLINE ProfilerLevelMeter* GetLevelMeter() const
+        {
+            return _levels.get();
+        }
+
+        // Real-time capture, wait-free and allocation-free once the calling thread is registered
+        AmUInt32 RegisterRealtimeThread(const AmString& name);
+        void UnregisterRealtimeThread(AmUInt32 thread);
+        AM_INLINE ProfilerRealtimeCapture* GetRealtimeCapture() const
+        {
+            return _realtime.get();
+        }
+
+        // Job system instrumentation, the hooks of the tracker are lock-free
+        AmUInt32 RegisterJobWorker(const AmString& name);
+        void UnregisterJobWorker(AmUInt32 worker);
+        AM_INLINE ProfilerJobTracker* GetJobTracker() const
+        {
+            return _jobs.get();
+        }
+
         // Statistics
         struct Statistics
         {
@@ -119,6 +206,21 @@ namespace SparkyStudios::Audio::Amplitude
             AmReal32 averageMessageSizeBytes;
             AmReal32 currentUpdateRate;
             AmUInt32 activeClients;
+
+            // Rates over the last second
+            AmReal32 messagesPerSecond;
+            AmReal32 droppedMessagesPerSecond;
+            AmReal32 bytesPerSecond; // Sent to network clients
+            AmReal32 configuredUpdateRate;
+            std::array<AmReal32, kProfilerCategoryCount> categoryMessagesPerSecond; // Indexed by category bit
+            std::array<AmReal32, kProfilerCategoryCount> categoryBytesPerSecond; // Indexed by category bit
+
+            // Queue occupancy
+            AmUInt32 queuedMessages;
+            AmUInt32 queueCapacity;
+
+            // Records dropped because a real-time thread's ring was full
+            AmUInt64 realtimeRecordsDropped;
         };
 
         Statistics GetStatistics() const;
@@ -142,12 +244,66 @@ namespace SparkyStudios::Audio::Amplitude
 
         // Message processing
         void QueueMessage(ProfilerDataVariant&& message);
+        void DrainRealtimeCapture();
         void DistributeMessage(const ProfilerDataVariant& message);
+        void EmitStatistics();
+        void EmitLockStatistics(AmUInt32 topCount);
+        void EmitJobStatistics();
+        void EmitStackSamples(AmUInt32 maxStacks);
+        void EmitPerfCounters();
+        void EmitAudioLevels();
 
         // Threading
         void StartUpdateThread();
         void StopUpdateThread();
 
+        // Flight recorder dumps, written by their own thread so the threads which trigger them never wait for the disk
+        void StartDumpThread();
+        void StopDumpThread();
+        bool QueueFlightRecorderDump(const AmString& path);
+        void DumpLoop();
+
+        // Logging
+        void ConfigureLogging(const ProfilerConfig& config);
+
+        // Real-time capture
+        void UpdateRealtimeCategoryMask();
+
+        // Memory
+        void PreallocateBuffers(const ProfilerConfig& config);
+
+        // Flight recorder
+        void ConfigureFlightRecorder(const ProfilerConfig& config);
+
+        // Watchdog
+        void ConfigureWatchdog(const ProfilerConfig& config);
+        void OnAudioThreadStall(const ProfilerStallReport& report, bool ended);
+
+        // Aggregation
+        void ConfigureAggregator(const ProfilerConfig& config);
+
+        // Alerts
+        void ConfigureAlerts(const ProfilerConfig& config);
+        void OnAlertFired(const ProfilerAlertRule& rule, const ProfilerDataVariant& message, AmUInt64 fireCount);
+
+        // Anomaly detection
+        void ConfigureAnomalyDetector(const ProfilerConfig& config);
+
+        // Lock profiling
+        void ConfigureLockProfiling(const ProfilerConfig& config);
+
+        // Job system
+        void ConfigureJobProfiling(const ProfilerConfig& config);
+
+        // Stack sampling
+        void ConfigureStackSampling(const ProfilerConfig& config);
+
+        // Performance counters
+        void ConfigurePerfCounters(const ProfilerConfig& config);
+
+        // Level metering
+        void ConfigureLevelMetering(const ProfilerConfig& config);
+
         // Member variables
         static AmUniquePtr<ProfilerManager, eMemoryPoolKind_Engine> _sInstance;
         static AmMutexHandle _sInstanceMutex;
@@ -160,19 +316,81 @@ namespace SparkyStudios::Audio::Amplitude
 
         // Threading
         AmThreadHandle _updateThread;
-        AmMutexHandle _configMutex;
+        mutable ProfilerMutex _configMutex;
 
         // Data management
         AmUniquePtr<ProfilerDataCollector, eMemoryPoolKind_IO> _dataCollector;
         AmUniquePtr<ProfilerMessageQueue, eMemoryPoolKind_IO> _messageQueue;
         AmUniquePtr<ProfilerMessagePool, eMemoryPoolKind_IO> _messagePool;
+        std::vector<ProfilerDataVariant> _batch; // Messages processed by the update loop, reused between updates
+
+        // Real-time capture
+        AmUniquePtr<ProfilerRealtimeCapture, eMemoryPoolKind_IO> _realtime;
+        std::vector<ProfilerEvent> _realtimeEvents; // Drained by the update loop, reused between updates
 
         // Network
         AmUniquePtr<ProfilerServer, eMemoryPoolKind_IO> _networkServer;
 
-        // Statistics
-        mutable AmMutexHandle _statisticsMutex;
-        Statistics _statistics;
+        // Recording
+        AmUniquePtr<ProfilerRecordingWriter, eMemoryPoolKind_IO> _recordingWriter;
+        AmUniquePtr<ProfilerFlightRecorder, eMemoryPoolKind_IO> _flightRecorder;
+        AmThreadHandle _dumpThread;
+        std::atomic<bool> _dumpRunning;
+        ProfilerMutex _dumpMutex;
+        std::vector<AmString> _pendingDumps; // Paths of the dumps to write, protected by _dumpMutex
+
+        // Watchdog
+        AmUniquePtr<ProfilerWatchdog, eMemoryPoolKind_IO> _watchdog;
+        std::atomic<AmUInt32> _stallDumpCount;
+
+        // Aggregation
+        AmUniquePtr<ProfilerAggregator, eMemoryPoolKind_IO> _aggregator;
+        std::vector<ProfilerDataVariant> _aggregates; // Produced by the update loop, reused between updates
+
+        // Alerts
+        AmUniquePtr<ProfilerAlertEvaluator, eMemoryPoolKind_IO> _alerts;
+        std::atomic<AmUInt32> _alertDumpCount;
+        std::atomic<AmInt64> _boostEndNs; // Update loop clock time until which the boosted interval is used
+        std::atomic<AmReal32> _boostInterval;
+
+        // Anomaly detection
+        AmUniquePtr<ProfilerAnomalyDetector, eMemoryPoolKind_IO> _anomalyDetector;
+        std::vector<ProfilerEvent> _anomalies; // Detected by the update loop, reused between updates
+
+        // Statistics, lock-free
+        ProfilerRateMeter _messageRate;
+        ProfilerRateMeter _droppedRate;
+        ProfilerRateMeter _updateRate;
+        std::array<ProfilerRateMeter, kProfilerCategoryCount> _categoryRates;
+        ProfilerTime _nextStatisticsEvent;
+
+        // Lock profiling
+        std::vector<ProfilerLockStats> _lockStats; // Totals at the previous report
+        ProfilerTime _nextLockStatsEvent;
+
+        // Job system
+        AmUniquePtr<ProfilerJobTracker, eMemoryPoolKind_IO> _jobs;
+        std::vector<ProfilerJobWorkerStats> _jobStats; // Collected at each update, reused between updates
+
+        // Stack sampling
+        AmUniquePtr<ProfilerStackSampler, eMemoryPoolKind_IO> _sampler;
+        std::array<AmUInt32, ProfilerWatchdog::kMaxThreads> _sampledThreads; // Sampler handle of each audio thread
+        std::vector<ProfilerEvent> _stackEvents; // Flushed by the update loop, reused between flushes
+        ProfilerTime _nextStackSamplesEvent;
+
+        // Performance counters
+        AmUniquePtr<ProfilerPerfCounters, eMemoryPoolKind_IO> _perf;
+        std::array<AmUInt32, ProfilerWatchdog::kMaxThreads> _countedThreads; // Counters handle of each audio thread
+        std::array<ProfilerPerfSample, ProfilerWatchdog::kMaxThreads> _heartbeatCounters; // Audio thread only, read at its last heartbeat
+        std::array<bool, ProfilerWatchdog::kMaxThreads> _heartbeatCountersValid; // Audio thread only
+        AmUInt32 _audioCallbackScope;
+        std::vector<ProfilerPerfScopeStats> _perfStats; // Collected by the update loop, reused between collections
+        ProfilerTime _nextPerfCountersEvent;
+
+        // Level metering
+        AmUniquePtr<ProfilerLevelMeter, eMemoryPoolKind_IO> _levels;
+        std::vector<ProfilerBusLevels> _busLevels; // Collected by the update loop, reused between collections
+        ProfilerTime _nextAudioLevelsEvent;
 
         // Last known states for change detection
         std::unordered_map<AmEntityID, ProfilerEntityData> _lastEntityStates;
@@ -186,7 +404,7 @@ namespace SparkyStudios::Audio::Amplitude
 
         // Local callback
         MessageCallback _localCallback;
-        AmMutexHandle _callbackMutex;
+        ProfilerMutex _callbackMutex;
     };
 
 // Convenience macros
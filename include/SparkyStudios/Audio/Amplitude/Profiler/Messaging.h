@@ -67,13 +67,16 @@ namespace SparkyStudios::Audio::Amplitude
     /**
      * @brief Thread-safe message queue for profiler data.
      *
+     * Messages are stored in a ring of preallocated slots, so queueing a message moves it
+     * into an existing slot instead of allocating.
+     *
      * @ingroup profiling
      */
     class AM_API_PUBLIC ProfilerMessageQueue
     {
     public:
         explicit ProfilerMessageQueue(AmSize maxSize = 1000);
-        ~ProfilerMessageQueue() = default;
+        ~ProfilerMessageQueue();
 
         /**
          * @brief Push a message to the queue (non-blocking)
@@ -94,11 +97,35 @@ namespace SparkyStudios::Audio::Amplitude
          */
         std::vector<ProfilerDataVariant> PopMessages(AmSize maxCount);
 
+        /**
+         * @brief Pop multiple messages at once into a reused vector
+         * @param maxCount Maximum number of messages to pop
+         * @param messages [out] Cleared, then filled with the messages
+         */
+        void PopMessages(AmSize maxCount, std::vector<ProfilerDataVariant>& messages);
+
         /**
          * @brief Get current queue size
          */
         AmSize Size() const;
 
+        /**
+         * @brief Get the maximum number of queued messages
+         */
+        AmSize Capacity() const;
+
+        /**
+         * @brief Change the maximum number of queued messages, reallocating the ring
+         * @note Queued messages are kept, the newest ones are dropped if they don't fit anymore
+         */
+        void SetCapacity(AmSize maxSize);
+
+        /**
+         * @brief Make the ring resident in memory
+         * @param residency Bitmask of eProfilerMemoryResidency
+         */
+        void Prefault(AmUInt32 residency);
+
         /**
          * @brief Check if queue is empty
          */
@@ -111,7 +138,10 @@ namespace SparkyStudios::Audio::Amplitude
 
     private:
         mutable AmMutexHandle _mutex;
-        std::queue<ProfilerDataVariant> _queue;
+        std::vector<ProfilerDataVariant> _ring;
+        AmSize _head; // Oldest queued message
+        AmSize _count;
+        AmUInt32 _residency;
         AmSize _maxSize;
         std::atomic<AmSize> _currentSize;
         std::atomic<AmSize> _droppedMessages;
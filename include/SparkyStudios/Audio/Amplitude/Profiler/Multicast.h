@@ -0,0 +1,254 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_MULTICAST_H
+#define _AM_PROFILER_MULTICAST_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Flags of a multicast datagram.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerMulticastFlags : AmUInt16
+    {
+        eProfilerMulticastFlags_None = 0,
+        eProfilerMulticastFlags_Keyframe = 1 << 0, ///< The batch holds the latest state of every known object
+    };
+
+    /**
+     * @brief Header at the start of every multicast datagram.
+     *
+     * A batch of binary encoded messages, each prefixed by its 32-bit size, is split into
+     * as many datagrams as needed to fit the MTU. Receivers reassemble the fragments of a
+     * batch, and use the datagram sequence number to detect losses.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerMulticastHeader
+    {
+        static constexpr AmUInt32 kMagic = 0x4D50504D; // "MPPM"
+        static constexpr AmUInt16 kVersion = 1;
+        static constexpr AmSize kSize = 20;
+
+        AmUInt32 mMagic;
+        AmUInt16 mVersion;
+        AmUInt16 mFlags;
+        AmUInt32 mSequence; ///< Sequence number of the datagram
+        AmUInt32 mBatchId; ///< Batch the fragment belongs to
+        AmUInt16 mFragmentIndex;
+        AmUInt16 mFragmentCount;
+    };
+
+    /**
+     * @brief Sends profiler data to a UDP multicast group.
+     *
+     * The cost of sending does not depend on the number of listeners. Messages are queued
+     * with `Enqueue()` and sent as one batch by `Flush()`. Since datagrams can be lost, a
+     * keyframe holding the latest engine, performance, entity, channel and listener states
+     * is sent periodically so receivers can recover a complete view.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerMulticastSender
+    {
+    public:
+        ProfilerMulticastSender();
+        ~ProfilerMulticastSender();
+
+        // Non-copyable
+        ProfilerMulticastSender(const ProfilerMulticastSender&) = delete;
+        ProfilerMulticastSender& operator=(const ProfilerMulticastSender&) = delete;
+
+        /**
+         * @brief Open the sending socket.
+         *
+         * @param group The IPv4 multicast group address.
+         * @param port The destination port.
+         * @param ttl Time to live of the datagrams. 1 keeps them on the local network.
+         * @param mtu Maximum size of a datagram, header included.
+         * @param keyframeIntervalSeconds Delay between two keyframes, or 0 to disable keyframes.
+         * @return true if the socket was opened, false otherwise.
+         */
+        bool Open(const AmString& group, AmUInt16 port, AmUInt8 ttl, AmUInt32 mtu, AmReal32 keyframeIntervalSeconds);
+
+        /**
+         * @brief Close the sending socket.
+         */
+        void Close();
+
+        /**
+         * @brief Check if the sending socket is open.
+         */
+        [[nodiscard]] bool IsOpen() const;
+
+        /**
+         * @brief Add a message to the current batch.
+         *
+         * @param data The message to send.
+         */
+        void Enqueue(const ProfilerDataVariant& data);
+
+        /**
+         * @brief Send the current batch, and a keyframe if one is due.
+         *
+         * @return The number of datagrams sent.
+         */
+        AmUInt32 Flush();
+
+        /**
+         * @brief Get the number of datagrams sent since the socket was opened.
+         */
+        [[nodiscard]] AmUInt64 GetDatagramsSent() const;
+
+        /**
+         * @brief Get the number of datagrams the socket failed to send.
+         */
+        [[nodiscard]] AmUInt64 GetSendFailures() const;
+
+    private:
+        struct KeyframeEntry
+        {
+            std::vector<AmUInt8> mPayload;
+            ProfilerTime mUpdated;
+        };
+
+        void _updateKeyframe(const ProfilerDataVariant& data, const std::vector<AmUInt8>& payload, AmSize offset);
+        AmUInt32 _sendBatch(const std::vector<AmUInt8>& batch, AmUInt16 flags);
+
+        AmUInt64 _socket;
+        AmUInt32 _groupAddress; // Network byte order
+        AmUInt16 _port; // Network byte order
+        AmUInt32 _mtu;
+        AmReal32 _keyframeInterval;
+        ProfilerTime _lastKeyframe;
+
+        AmUInt32 _sequence;
+        AmUInt32 _batchId;
+        std::vector<AmUInt8> _batch;
+        std::vector<AmUInt8> _datagram;
+        std::map<std::pair<AmSize, AmUInt64>, KeyframeEntry> _keyframe;
+
+        AmUInt64 _datagramsSent;
+        AmUInt64 _sendFailures;
+        AmMutexHandle _mutex;
+    };
+
+    /**
+     * @brief Receives profiler data from a UDP multicast group.
+     *
+     * This class is not thread-safe.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerMulticastReceiver
+    {
+    public:
+        using MessageCallback = std::function<void(const ProfilerDataVariant&, bool keyframe)>;
+
+        ProfilerMulticastReceiver();
+        ~ProfilerMulticastReceiver();
+
+        // Non-copyable
+        ProfilerMulticastReceiver(const ProfilerMulticastReceiver&) = delete;
+        ProfilerMulticastReceiver& operator=(const ProfilerMulticastReceiver&) = delete;
+
+        /**
+         * @brief Join a multicast group.
+         *
+         * @param group The IPv4 multicast group address.
+         * @param port The port to listen on.
+         * @param interfaceAddress The address of the local interface to join the group on.
+         * @return true if the group was joined, false otherwise.
+         */
+        bool Open(const AmString& group, AmUInt16 port, const AmString& interfaceAddress = "0.0.0.0");
+
+        /**
+         * @brief Leave the multicast group and close the socket.
+         */
+        void Close();
+
+        /**
+         * @brief Check if the receiver joined a group.
+         */
+        [[nodiscard]] bool IsOpen() const;
+
+        /**
+         * @brief Read the pending datagrams and decode every completed batch.
+         *
+         * @param callback Function called for each decoded message.
+         * @param timeoutMs Time to wait for the first datagram, in milliseconds.
+         * @return The number of messages decoded.
+         */
+        AmUInt32 Poll(const MessageCallback& callback, AmUInt32 timeoutMs = 0);
+
+        /**
+         * @brief Get the number of datagrams detected as lost from sequence gaps.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetLostDatagrams() const
+        {
+            return _lostDatagrams;
+        }
+
+        /**
+         * @brief Get the number of batches dropped because some of their fragments were lost.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetDroppedBatches() const
+        {
+            return _droppedBatches;
+        }
+
+        /**
+         * @brief Get the number of datagrams received.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetDatagramsReceived() const
+        {
+            return _datagramsReceived;
+        }
+
+    private:
+        AmUInt32 _handleDatagram(const AmUInt8* data, AmSize size, const MessageCallback& callback);
+        AmUInt32 _decodeBatch(bool keyframe, const MessageCallback& callback);
+
+        AmUInt64 _socket;
+        AmUInt32 _groupAddress; // Network byte order
+        AmUInt32 _interfaceAddress; // Network byte order
+        std::vector<AmUInt8> _datagram;
+
+        bool _hasSequence;
+        AmUInt32 _expectedSequence;
+        AmUInt32 _batchId;
+        AmUInt16 _batchFlags;
+        AmUInt16 _nextFragment;
+        AmUInt16 _fragmentCount;
+        std::vector<AmUInt8> _batch;
+
+        AmUInt64 _lostDatagrams;
+        AmUInt64 _droppedBatches;
+        AmUInt64 _datagramsReceived;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_MULTICAST_H
@@ -0,0 +1,318 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_PERF_COUNTERS_H
+#define _AM_PROFILER_PERF_COUNTERS_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief The counters read around a measured scope.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerPerfCounter : AmUInt8
+    {
+        eProfilerPerfCounter_Cycles = 0,
+        eProfilerPerfCounter_Instructions = 1,
+        eProfilerPerfCounter_CacheMisses = 2, ///< Misses of the last level cache
+        eProfilerPerfCounter_BranchMisses = 3,
+        eProfilerPerfCounter_TaskClock = 4, ///< CPU time of the thread, in nanoseconds
+        eProfilerPerfCounter_PageFaults = 5,
+        eProfilerPerfCounter_ContextSwitches = 6,
+        eProfilerPerfCounter_Count,
+    };
+
+    /**
+     * @brief Where the counters of a thread are read from.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerPerfSource : AmUInt8
+    {
+        eProfilerPerfSource_None = 0,
+        eProfilerPerfSource_Hardware = 1, ///< Performance monitoring unit, with the software counters of the kernel
+        eProfilerPerfSource_Software = 2, ///< Software counters of the kernel only, when the PMU is not exposed
+        eProfilerPerfSource_Rusage = 3, ///< Resource usage and CPU clock of the thread, when perf events are not allowed
+    };
+
+    /**
+     * @brief A reading of every counter of a thread.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerPerfSample
+    {
+        std::array<AmUInt64, eProfilerPerfCounter_Count> mValues = {};
+    };
+
+    /**
+     * @brief Counters of a scope on a thread since the previous collection.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerPerfScopeStats
+    {
+        AmString mThread;
+        AmString mScope;
+        eProfilerPerfSource mSource = eProfilerPerfSource_None;
+        AmUInt32 mAvailable = 0; ///< One bit per counter read on this thread
+        AmUInt64 mCalls = 0;
+        std::array<AmUInt64, eProfilerPerfCounter_Count> mValues = {};
+
+        /**
+         * @brief Check if a counter was read on this thread.
+         */
+        [[nodiscard]] AM_INLINE bool Has(eProfilerPerfCounter counter) const
+        {
+            return (mAvailable & (1u << counter)) != 0;
+        }
+
+        /**
+         * @brief Get the instructions retired per cycle, or 0 when unavailable.
+         *
+         * A low value with many cache misses per instruction means the code waits for memory.
+         */
+        [[nodiscard]] AmReal64 GetInstructionsPerCycle() const;
+
+        /**
+         * @brief Get the number of occurrences of a counter per thousand instructions, or 0 when unavailable.
+         */
+        [[nodiscard]] AmReal64 GetPerKiloInstructions(eProfilerPerfCounter counter) const;
+
+        /**
+         * @brief Get the name of a counter, as used in the event parameters.
+         */
+        [[nodiscard]] static const char* GetCounterName(eProfilerPerfCounter counter);
+
+        /**
+         * @brief Get the name of a counter source.
+         */
+        [[nodiscard]] static const char* GetSourceName(eProfilerPerfSource source);
+    };
+
+    /**
+     * @brief Reads performance counters around audio callbacks and effects.
+     *
+     * Each thread registers once and opens its counters: on Linux, a group of perf events read
+     * with a single system call, so all counters cover the same instructions. Cycles,
+     * instructions, cache misses and branch misses come from the performance monitoring unit
+     * when the kernel exposes it, otherwise only the software counters of the kernel are
+     * opened. When perf events are not allowed at all, the CPU clock and resource usage of the
+     * thread are read instead.
+     *
+     * A scope is measured by reading the counters of its thread when it starts and ends. Its
+     * thread adds the difference to its own table, indexed by scope, so measuring adds no
+     * shared writes and is lock-free. Counters are read only while enabled, and the kernel
+     * stops counting while disabled.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerPerfCounters
+    {
+    public:
+        /**
+         * @brief Maximum number of threads reading their counters at once.
+         */
+        static constexpr AmUInt32 kMaxThreads = 8;
+
+        /**
+         * @brief Returned by RegisterThread() when no more threads can read their counters.
+         */
+        static constexpr AmUInt32 kInvalidThread = ~0u;
+
+        /**
+         * @brief Maximum number of distinct scope names.
+         */
+        static constexpr AmUInt32 kMaxScopes = 64;
+
+        /**
+         * @brief Returned by RegisterScope() when no more scopes can be named.
+         */
+        static constexpr AmUInt32 kInvalidScope = ~0u;
+
+        /**
+         * @brief Measures a scope of the calling thread, from its construction to its destruction.
+         */
+        class Scope
+        {
+        public:
+            AM_INLINE Scope(ProfilerPerfCounters* counters, AmUInt32 thread, AmUInt32 scope) noexcept
+                : _counters(counters)
+                , _thread(thread)
+                , _scope(scope)
+            {
+                if (_counters != nullptr && !_counters->Read(_thread, _begin))
+                    _counters = nullptr;
+            }
+
+            AM_INLINE ~Scope() noexcept
+            {
+                if (_counters != nullptr)
+                    _counters->Record(_thread, _scope, _begin);
+            }
+
+            // Non-copyable
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            ProfilerPerfCounters* _counters;
+            AmUInt32 _thread;
+            AmUInt32 _scope;
+            ProfilerPerfSample _begin;
+        };
+
+        ProfilerPerfCounters();
+        ~ProfilerPerfCounters();
+
+        // Non-copyable
+        ProfilerPerfCounters(const ProfilerPerfCounters&) = delete;
+        ProfilerPerfCounters& operator=(const ProfilerPerfCounters&) = delete;
+
+        /**
+         * @brief Enable or disable the counters of every registered thread.
+         */
+        void SetEnabled(bool enabled);
+
+        /**
+         * @brief Check if the counters are enabled.
+         */
+        [[nodiscard]] AM_INLINE bool IsEnabled() const noexcept
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Open the counters of the calling thread. This function allocates.
+         *
+         * The thread keeps its counters while they are disabled, and they count again once enabled.
+         *
+         * @param name The name of the thread, added to its statistics.
+         * @return The handle to pass to the other functions, or kInvalidThread when too many threads are registered.
+         */
+        AmUInt32 RegisterThread(const AmString& name);
+
+        /**
+         * @brief Stop reading the counters of a thread. They are closed by the next collection.
+         *
+         * @param thread The handle returned by RegisterThread().
+         */
+        void UnregisterThread(AmUInt32 thread);
+
+        /**
+         * @brief Get the identifier of a scope name, registering it on first use.
+         *
+         * @param name The name of the scope, e.g. the audio callback or an effect.
+         * @return The scope identifier, or kInvalidScope when too many names are registered.
+         */
+        AmUInt32 RegisterScope(const char* name);
+
+        /**
+         * @brief Read the counters of the calling thread. This function is lock-free.
+         *
+         * @param thread The handle of the calling thread.
+         * @param sample [out] The counters. Unavailable counters are 0.
+         * @return false if the counters are disabled or could not be read.
+         */
+        bool Read(AmUInt32 thread, ProfilerPerfSample& sample) noexcept;
+
+        /**
+         * @brief Add the counters between two readings of the calling thread to a scope. This function is lock-free.
+         *
+         * @param thread The handle of the calling thread.
+         * @param scope The scope identifier.
+         * @param begin The reading when the scope started.
+         * @param end The reading when the scope ended.
+         */
+        void Accumulate(AmUInt32 thread, AmUInt32 scope, const ProfilerPerfSample& begin, const ProfilerPerfSample& end) noexcept;
+
+        /**
+         * @brief Read the counters of the calling thread, and add them to a scope. This function is lock-free.
+         *
+         * @param thread The handle of the calling thread.
+         * @param scope The scope identifier.
+         * @param begin The reading when the scope started.
+         */
+        void Record(AmUInt32 thread, AmUInt32 scope, const ProfilerPerfSample& begin) noexcept;
+
+        /**
+         * @brief Get the counters of every measured scope since the previous collection. Profiler update thread only.
+         *
+         * Threads which were unregistered have their counters closed.
+         *
+         * @param stats [out] An entry is appended for every scope measured on a thread.
+         */
+        void Collect(std::vector<ProfilerPerfScopeStats>& stats);
+
+    private:
+        enum eThreadState : AmUInt8
+        {
+            eThreadState_Free = 0,
+            eThreadState_Active = 1,
+            eThreadState_Closing = 2, // Unregistered, waiting for the next collection to close its counters
+        };
+
+        // Written by the counted thread only, totals since the registration
+        struct ScopeTotals
+        {
+            std::atomic<AmUInt64> mCalls = 0;
+            std::atomic<AmUInt64> mValues[eProfilerPerfCounter_Count] = {};
+        };
+
+        // Profiler update thread only, totals at the previous collection
+        struct ScopeCollected
+        {
+            AmUInt64 mCalls = 0;
+            std::array<AmUInt64, eProfilerPerfCounter_Count> mValues = {};
+        };
+
+        struct alignas(64) CountedThread
+        {
+            std::atomic<eThreadState> mState = eThreadState_Free;
+            eProfilerPerfSource mSource = eProfilerPerfSource_None;
+            AmUInt32 mAvailable = 0;
+            AmInt32 mLeader = -1; // Group leader, -1 without perf events
+            AmInt32 mFds[eProfilerPerfCounter_Count] = {};
+            AmInt8 mGroupIndex[eProfilerPerfCounter_Count] = {}; // Position in a group reading, -1 when not in the group
+            AmString mName;
+
+            ScopeTotals mTotals[kMaxScopes];
+            ScopeCollected mCollected[kMaxScopes];
+        };
+
+        bool _open(CountedThread& thread, bool enabled);
+        static void _close(CountedThread& thread);
+        static bool _read(const CountedThread& thread, ProfilerPerfSample& sample) noexcept;
+
+        CountedThread _threads[kMaxThreads];
+        std::atomic<bool> _enabled;
+
+        char _scopeNames[kMaxScopes][64];
+        std::atomic<AmUInt32> _scopeCount;
+
+        AmMutexHandle _mutex; // Protects registration, enabling and collection
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_PERF_COUNTERS_H
@@ -22,12 +22,34 @@
 #ifndef _AM_PROFILER_H
 #define _AM_PROFILER_H
 
+#include <SparkyStudios/Audio/Amplitude/Profiler/Aggregator.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Alert.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Anomaly.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/AsyncFile.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Config.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/DataCollector.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/FlightRecorder.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Histogram.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/JobTracker.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LevelMeter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LockProfiler.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LogSink.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Manager.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Messaging.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Multicast.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/PerfCounters.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/RateLimiter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/RateMeter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Realtime.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Recording.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Residency.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Serialization.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Server.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/SharedMemory.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/StackSampler.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Watchdog.h>
 
 #endif // _AM_PROFILER_H
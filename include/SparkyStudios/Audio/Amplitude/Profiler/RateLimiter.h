@@ -0,0 +1,119 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_RATE_LIMITER_H
+#define _AM_PROFILER_RATE_LIMITER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Token bucket used to limit the rate of messages or bytes sent to a client.
+     *
+     * The bucket refills continuously at the configured rate, up to its capacity. A rate
+     * of zero means the bucket is unlimited. This class is not thread-safe.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerTokenBucket
+    {
+    public:
+        /**
+         * @brief Default constructor. Creates an unlimited bucket.
+         */
+        ProfilerTokenBucket();
+
+        /**
+         * @brief Create a bucket with the given rate and capacity.
+         *
+         * @param ratePerSecond The number of tokens added per second, or 0 for an unlimited bucket.
+         * @param capacity The maximum number of tokens the bucket can hold.
+         */
+        ProfilerTokenBucket(AmReal64 ratePerSecond, AmReal64 capacity);
+
+        /**
+         * @brief Change the rate and capacity of the bucket. The bucket starts full.
+         *
+         * @param ratePerSecond The number of tokens added per second, or 0 for an unlimited bucket.
+         * @param capacity The maximum number of tokens the bucket can hold.
+         */
+        void Configure(AmReal64 ratePerSecond, AmReal64 capacity);
+
+        /**
+         * @brief Add the tokens accumulated since the last refill.
+         *
+         * @param now The current time.
+         */
+        void Refill(ProfilerTime now);
+
+        /**
+         * @brief Check if the given amount of tokens is available.
+         *
+         * Amounts larger than the capacity are accepted when the bucket is full,
+         * so oversized messages are slowed down instead of blocked forever.
+         *
+         * @param amount The amount of tokens to check.
+         * @return true if the amount can be consumed, false otherwise.
+         */
+        [[nodiscard]] bool CanConsume(AmReal64 amount) const;
+
+        /**
+         * @brief Remove tokens from the bucket.
+         *
+         * The bucket may go into debt, down to minus its capacity, when forced
+         * consumptions exceed the available tokens.
+         *
+         * @param amount The amount of tokens to remove.
+         */
+        void Consume(AmReal64 amount);
+
+        /**
+         * @brief Check if the bucket has no rate limit.
+         *
+         * @return true if the bucket is unlimited, false otherwise.
+         */
+        [[nodiscard]] AM_INLINE bool IsUnlimited() const
+        {
+            return _rate <= 0.0;
+        }
+
+        /**
+         * @brief Get the refill rate of the bucket, in tokens per second.
+         */
+        [[nodiscard]] AM_INLINE AmReal64 GetRate() const
+        {
+            return _rate;
+        }
+
+        /**
+         * @brief Get the number of tokens currently available.
+         */
+        [[nodiscard]] AM_INLINE AmReal64 GetAvailable() const
+        {
+            return _tokens;
+        }
+
+    private:
+        AmReal64 _rate;
+        AmReal64 _capacity;
+        AmReal64 _tokens;
+        ProfilerTime _lastRefill;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_RATE_LIMITER_H
@@ -0,0 +1,92 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_RATE_METER_H
+#define _AM_PROFILER_RATE_METER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
+
+#include <atomic>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Measures the rate of an amount, like messages or bytes, over a sliding window.
+     *
+     * The window is split in buckets, each one tagged with the time slice it counts. A bucket
+     * whose slice is over is recycled by the first addition of a later slice, so no thread has
+     * to clear them. Additions and reads are lock-free and can happen from any thread.
+     *
+     * Copies take a snapshot of the counters, so a meter can be part of a copyable structure.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerRateMeter
+    {
+    public:
+        /**
+         * @brief Number of buckets in the window.
+         */
+        static constexpr AmUInt32 kBucketCount = 10;
+
+        /**
+         * @brief Create a meter.
+         *
+         * @param windowMs The duration of the sliding window.
+         */
+        explicit ProfilerRateMeter(AmUInt32 windowMs = 1000);
+
+        ProfilerRateMeter(const ProfilerRateMeter& other);
+        ProfilerRateMeter& operator=(const ProfilerRateMeter& other);
+
+        /**
+         * @brief Count an amount.
+         *
+         * @param amount The amount to count.
+         * @param now The current time.
+         */
+        void Add(AmUInt64 amount, ProfilerTime now);
+
+        /**
+         * @brief Get the rate over the window ending now.
+         *
+         * @param now The current time.
+         * @return The amount counted per second.
+         */
+        [[nodiscard]] AmReal64 GetRate(ProfilerTime now) const;
+
+        /**
+         * @brief Get the amount counted since the meter was created or reset.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetTotal() const
+        {
+            return _total.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Forget every amount counted.
+         */
+        void Reset();
+
+    private:
+        AmUInt64 _bucketNs;
+        std::atomic<AmUInt64> _buckets[kBucketCount]; // Time slice in the high bits, amount in the low bits
+        std::atomic<AmUInt64> _total;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_RATE_METER_H
@@ -0,0 +1,449 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_REALTIME_H
+#define _AM_PROFILER_REALTIME_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Check that the calling thread is not a registered real-time thread.
+ *
+ * Placed at the top of every capture function which locks or allocates. It does nothing
+ * unless AM_PROFILER_REALTIME_GUARD is defined, which debug builds do.
+ */
+#if defined(AM_PROFILER_REALTIME_GUARD)
+#define AM_PROFILER_ASSERT_NOT_REALTIME() ::SparkyStudios::Audio::Amplitude::ProfilerRealtimeGuard::Check(__func__)
+#else
+#define AM_PROFILER_ASSERT_NOT_REALTIME()                                                                                                  \
+    do                                                                                                                                     \
+    {                                                                                                                                      \
+    } while (false)
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Kind of a record captured from a real-time thread.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerRealtimeRecordKind : AmUInt8
+    {
+        eProfilerRealtimeRecordKind_Event = 0, ///< An instant with up to four values
+        eProfilerRealtimeRecordKind_Counter = 1, ///< The current value of a named quantity
+        eProfilerRealtimeRecordKind_Span = 2, ///< A duration ending at the timestamp, the first value holds it in nanoseconds
+    };
+
+    /**
+     * @brief A record captured from a real-time thread.
+     *
+     * Records have a fixed size and are trivially copyable, so capturing one is a copy into a
+     * preallocated ring. Names point to string literals, which live for the whole program.
+     *
+     * @ingroup profiling
+     */
+    struct alignas(64) ProfilerRealtimeRecord
+    {
+        static constexpr AmUInt32 kMaxValues = 4;
+
+        AmInt64 mTimestampNs; ///< High resolution clock time, in nanoseconds since its epoch
+        const char* mName;
+        AmUInt64 mId; ///< Object the record is about, e.g. a channel, 0 for none
+        AmReal64 mValues[kMaxValues];
+        eProfilerCategory mCategory;
+        eProfilerRealtimeRecordKind mKind;
+        AmUInt8 mValueCount;
+    };
+
+    static_assert(std::is_trivially_copyable_v<ProfilerRealtimeRecord>, "Real-time records must be copied without side effects");
+    static_assert(std::is_trivially_destructible_v<ProfilerRealtimeRecord>, "Real-time records must not own resources");
+    static_assert(sizeof(ProfilerRealtimeRecord) == 64, "Real-time records must fill exactly one cache line");
+    static_assert(std::atomic<AmUInt64>::is_always_lock_free, "Real-time rings need lock-free 64-bit atomics");
+
+    /**
+     * @brief Debug check of the real-time contract.
+     *
+     * Threads registered for real-time capture are flagged, and the capture functions which lock
+     * or allocate assert that they are not called from a flagged thread. The flag can also be set
+     * explicitly around an audio callback with a Scope.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerRealtimeGuard
+    {
+    public:
+        /**
+         * @brief Flags the calling thread as real-time while in scope.
+         */
+        class Scope
+        {
+        public:
+            Scope() noexcept
+                : _previous(ProfilerRealtimeGuard::Enter())
+            {
+            }
+
+            ~Scope() noexcept
+            {
+                ProfilerRealtimeGuard::Leave(_previous);
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            bool _previous;
+        };
+
+        /**
+         * @brief Flag the calling thread as real-time.
+         *
+         * @return Whether the thread was already flagged, to pass to Leave().
+         */
+        static bool Enter() noexcept;
+
+        /**
+         * @brief Restore the flag of the calling thread.
+         *
+         * @param previous The value returned by the matching Enter().
+         */
+        static void Leave(bool previous) noexcept;
+
+        /**
+         * @brief Check if the calling thread is flagged as real-time.
+         */
+        [[nodiscard]] static bool IsRealtimeThread() noexcept;
+
+        /**
+         * @brief Report a call which is not real-time safe from a real-time thread.
+         *
+         * @param function The name of the function which was called.
+         */
+        static void Check(const char* function);
+    };
+
+    /**
+     * @brief Single-producer single-consumer ring of real-time records.
+     *
+     * The producer is the real-time thread, the consumer the profiler update thread. Pushing
+     * is wait-free: it copies the record and publishes it with a single release store, and a
+     * record which does not fit is dropped and counted. The read and write positions live on
+     * their own cache lines, and the producer caches the read position so it only touches the
+     * consumer's line when the ring looks full.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerRealtimeRing
+    {
+    public:
+        /**
+         * @brief Allocate the ring, and make it resident so pushing never page-faults.
+         *
+         * @param capacity The number of records, rounded up to a power of two.
+         * @param residency The bitmask of eProfilerMemoryResidency to apply.
+         */
+        ProfilerRealtimeRing(AmUInt32 capacity, AmUInt32 residency);
+        ~ProfilerRealtimeRing();
+
+        // Non-copyable
+        ProfilerRealtimeRing(const ProfilerRealtimeRing&) = delete;
+        ProfilerRealtimeRing& operator=(const ProfilerRealtimeRing&) = delete;
+
+        /**
+         * @brief Append a record. Producer only.
+         *
+         * @return false if the ring was full and the record was dropped.
+         */
+        AM_INLINE bool Push(const ProfilerRealtimeRecord& record) noexcept
+        {
+            const AmUInt64 write = _write.load(std::memory_order_relaxed);
+
+            if (write - _cachedRead > _mask)
+            {
+                _cachedRead = _read.load(std::memory_order_acquire);
+                if (write - _cachedRead > _mask)
+                {
+                    _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+
+            _records[write & _mask] = record;
+            _write.store(write + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Move the published records out of the ring. Consumer only.
+         *
+         * @param records [out] The records are appended to it.
+         * @return The number of records read.
+         */
+        AmSize Pop(std::vector<ProfilerRealtimeRecord>& records);
+
+        /**
+         * @brief Get the number of records dropped because the ring was full.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetDroppedCount() const noexcept
+        {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the number of records the ring holds.
+         */
+        [[nodiscard]] AM_INLINE AmUInt32 Capacity() const noexcept
+        {
+            return static_cast<AmUInt32>(_mask + 1);
+        }
+
+    private:
+        ProfilerRealtimeRecord* _records;
+        AmUInt64 _mask;
+        AmUInt32 _residency;
+
+        alignas(64) std::atomic<AmUInt64> _write;
+        AmUInt64 _cachedRead; // Producer's copy of _read
+        std::atomic<AmUInt64> _dropped; // Written by the producer only
+
+        alignas(64) std::atomic<AmUInt64> _read;
+    };
+
+    /**
+     * @brief Capture surface for real-time threads, like the audio callback.
+     *
+     * Each real-time thread registers once, outside of its callback, and gets its own ring.
+     * From then on, capturing a record is wait-free, lock-free and does not allocate: the
+     * category mask is read from an atomic, the record is built on the stack and copied into
+     * the thread's ring. Names must be string literals, which is enforced at compile time.
+     *
+     * The profiler update thread drains the rings and turns the records into events, which then
+     * go through the regular message pipeline.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerRealtimeCapture
+    {
+    public:
+        /**
+         * @brief Maximum number of threads capturing at once.
+         */
+        static constexpr AmUInt32 kMaxThreads = 8;
+
+        /**
+         * @brief Returned by RegisterThread() when no more threads can capture.
+         */
+        static constexpr AmUInt32 kInvalidThread = ~0u;
+
+        ProfilerRealtimeCapture();
+        ~ProfilerRealtimeCapture();
+
+        // Non-copyable
+        ProfilerRealtimeCapture(const ProfilerRealtimeCapture&) = delete;
+        ProfilerRealtimeCapture& operator=(const ProfilerRealtimeCapture&) = delete;
+
+        /**
+         * @brief Give the calling thread a ring to capture into. This function allocates.
+         *
+         * The calling thread is flagged for the real-time guard, so it should be the thread which captures.
+         *
+         * @param name The name of the thread, added to its events.
+         * @param capacity The number of records in the ring.
+         * @param residency The bitmask of eProfilerMemoryResidency applied to the ring.
+         * @return The handle to pass to the capture functions, or kInvalidThread when too many threads capture.
+         */
+        AmUInt32 RegisterThread(const AmString& name, AmUInt32 capacity, AmUInt32 residency = eProfilerMemoryResidency_Prefault);
+
+        /**
+         * @brief Release the ring of a thread, once it stopped capturing.
+         *
+         * Records still in the ring are drained first. When called from the registered thread, its
+         * real-time flag is restored to what it was before RegisterThread().
+         *
+         * @param thread The handle returned by RegisterThread().
+         */
+        void UnregisterThread(AmUInt32 thread);
+
+        /**
+         * @brief Set the categories which are captured, 0 to capture nothing.
+         */
+        AM_INLINE void SetCategoryMask(AmUInt32 categoryMask) noexcept
+        {
+            _categoryMask.store(categoryMask, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Check if a category is captured. This function is wait-free.
+         */
+        [[nodiscard]] AM_INLINE bool ShouldCapture(eProfilerCategory category) const noexcept
+        {
+            return (_categoryMask.load(std::memory_order_relaxed) & static_cast<AmUInt32>(category)) != 0;
+        }
+
+        /**
+         * @brief Capture an event. This function is wait-free.
+         *
+         * @param thread The handle returned by RegisterThread().
+         * @param name The name of the event, a string literal.
+         * @param id The object the event is about, 0 for none.
+         * @param values Up to four numeric values.
+         */
+        template<AmSize N, typename... Values>
+        AM_INLINE void Event(AmUInt32 thread, const char (&name)[N], AmUInt64 id = 0, Values... values) noexcept
+        {
+            static_assert(sizeof...(Values) <= ProfilerRealtimeRecord::kMaxValues, "Too many values for a real-time record");
+            static_assert((std::is_arithmetic_v<Values> && ...), "Real-time records only hold numeric values");
+
+            if (!ShouldCapture(eProfilerCategory_Events))
+                return;
+
+            ProfilerRealtimeRecord record;
+            record.mTimestampNs = Now();
+            record.mName = name;
+            record.mId = id;
+            record.mCategory = eProfilerCategory_Events;
+            record.mKind = eProfilerRealtimeRecordKind_Event;
+            record.mValueCount = 0;
+            ((record.mValues[record.mValueCount++] = static_cast<AmReal64>(values)), ...);
+
+            _push(thread, record);
+        }
+
+        /**
+         * @brief Capture the current value of a quantity. This function is wait-free.
+         *
+         * @param thread The handle returned by RegisterThread().
+         * @param name The name of the quantity, a string literal.
+         * @param value The value.
+         * @param category The category the value belongs to.
+         */
+        template<AmSize N, typename Value>
+        AM_INLINE void Counter(
+            AmUInt32 thread, const char (&name)[N], Value value, eProfilerCategory category = eProfilerCategory_Performance) noexcept
+        {
+            static_assert(std::is_arithmetic_v<Value>, "Real-time records only hold numeric values");
+
+            if (!ShouldCapture(category))
+                return;
+
+            ProfilerRealtimeRecord record;
+            record.mTimestampNs = Now();
+            record.mName = name;
+            record.mId = 0;
+            record.mCategory = category;
+            record.mKind = eProfilerRealtimeRecordKind_Counter;
+            record.mValueCount = 1;
+            record.mValues[0] = static_cast<AmReal64>(value);
+
+            _push(thread, record);
+        }
+
+        /**
+         * @brief Capture a duration which started at the given time. This function is wait-free.
+         *
+         * @param thread The handle returned by RegisterThread().
+         * @param name The name of the span, a string literal.
+         * @param startNs The start of the span, as returned by Now().
+         * @param id The object the span is about, 0 for none.
+         */
+        template<AmSize N>
+        AM_INLINE void Span(AmUInt32 thread, const char (&name)[N], AmInt64 startNs, AmUInt64 id = 0) noexcept
+        {
+            if (!ShouldCapture(eProfilerCategory_Performance))
+                return;
+
+            ProfilerRealtimeRecord record;
+            record.mTimestampNs = Now();
+            record.mName = name;
+            record.mId = id;
+            record.mCategory = eProfilerCategory_Performance;
+            record.mKind = eProfilerRealtimeRecordKind_Span;
+            record.mValueCount = 1;
+            record.mValues[0] = static_cast<AmReal64>(record.mTimestampNs - startNs);
+
+            _push(thread, record);
+        }
+
+        /**
+         * @brief Get the current time, as used in records. This function is wait-free.
+         */
+        [[nodiscard]] static AM_INLINE AmInt64 Now() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch())
+                .count();
+        }
+
+        /**
+         * @brief Turn the records captured since the last call into events. Profiler update thread only.
+         *
+         * @param events [out] An event is appended for every record.
+         */
+        void Drain(std::vector<ProfilerEvent>& events);
+
+        /**
+         * @brief Get the number of records dropped because a ring was full, over every thread registered so far.
+         */
+        [[nodiscard]] AmUInt64 GetDroppedCount() const;
+
+    private:
+        enum eSlotState : AmUInt8
+        {
+            eSlotState_Free = 0,
+            eSlotState_Active = 1,
+            eSlotState_Closing = 2, // Unregistered, waiting for its last records to be drained
+        };
+
+        struct Slot
+        {
+            std::atomic<eSlotState> mState = eSlotState_Free;
+            ProfilerRealtimeRing* mRing = nullptr;
+            AmString mName;
+            AmThreadID mThreadId = 0; // The registered thread, its guard flag is restored when it unregisters itself
+            bool mWasRealtime = false; // The guard flag of the thread before it registered
+        };
+
+        AM_INLINE void _push(AmUInt32 thread, const ProfilerRealtimeRecord& record) noexcept
+        {
+            if (thread >= kMaxThreads)
+                return;
+
+            Slot& slot = _slots[thread];
+            if (slot.mState.load(std::memory_order_acquire) != eSlotState_Active)
+                return;
+
+            slot.mRing->Push(record);
+        }
+
+        void _drain(Slot& slot, std::vector<ProfilerEvent>& events);
+
+        Slot _slots[kMaxThreads];
+        std::atomic<AmUInt32> _categoryMask;
+        AmUInt64 _releasedDropped; // Dropped by the rings which were released
+
+        std::vector<ProfilerRealtimeRecord> _records; // Drained records, reused between drains
+        AmMutexHandle _mutex; // Protects registration and draining
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_REALTIME_H
@@ -0,0 +1,501 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_RECORDING_H
+#define _AM_PROFILER_RECORDING_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/AsyncFile.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Header at the start of a recording file.
+     *
+     * A recording is made of this header, a sequence of chunks, and a footer. Each chunk
+     * is a chunk header followed by binary encoded messages, each prefixed by its 32-bit
+     * size. The footer holds a table of all the chunks and the secondary indexes, and ends
+     * with a fixed-size trailer pointing at them, so readers can seek to any chunk without
+     * scanning the file.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerRecordingHeader
+    {
+        static constexpr AmUInt32 kMagic = 0x52504D41; // "AMPR"
+        static constexpr AmUInt16 kVersion = 2; ///< Version 1 recordings have a 16 bytes trailer and no indexes
+        static constexpr AmSize kSize = 32;
+        static constexpr AmUInt32 kFlagFlightRecorder = 1u << 0; ///< The recording was dumped from a flight recorder
+
+        AmUInt32 mMagic;
+        AmUInt16 mVersion;
+        AmUInt16 mFormatVersion; ///< Version of the binary serializer used for messages
+        AmUInt32 mFlags;
+        AmInt64 mStartTime; ///< Time the recording was started, in nanoseconds
+
+        /**
+         * @brief Write the header as stored in the file. This function is async-signal-safe.
+         *
+         * @param data The destination, at least kSize bytes.
+         */
+        void Encode(AmUInt8* data) const;
+    };
+
+    /**
+     * @brief Description of a chunk of a recording.
+     *
+     * The same information is written before each chunk, so a recording which was never
+     * closed can still be read by scanning its chunks.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerRecordingChunkInfo
+    {
+        static constexpr AmUInt32 kMagic = 0x4B4E4843; // "CHNK"
+        static constexpr AmSize kHeaderSize = 48;
+        static constexpr AmSize kTableEntrySize = 48;
+
+        AmUInt64 mOffset; ///< Offset of the chunk data in the file, after the chunk header
+        AmUInt64 mStoredSize; ///< Size of the chunk data in the file
+        AmUInt64 mUncompressedSize; ///< Size of the chunk data once decompressed
+        AmUInt32 mMessageCount;
+        AmUInt8 mCompression; ///< Compression of the chunk data, 0 when stored as-is
+        AmInt64 mFirstTimestamp; ///< Timestamp of the first message, in nanoseconds
+        AmInt64 mLastTimestamp; ///< Timestamp of the last message, in nanoseconds
+
+        /**
+         * @brief Write the header stored before the chunk data. This function is async-signal-safe.
+         *
+         * @param data The destination, at least kHeaderSize bytes.
+         */
+        void EncodeHeader(AmUInt8* data) const;
+    };
+
+    /**
+     * @brief Trailer at the very end of a recording file.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerRecordingTrailer
+    {
+        static constexpr AmUInt32 kMagic = 0x46504D41; // "AMPF"
+        static constexpr AmSize kSize = 32;
+        static constexpr AmSize kVersion1Size = 16;
+
+        AmUInt64 mTableOffset; ///< Offset of the chunk table in the file
+        AmUInt64 mIndexOffset; ///< Offset of the secondary indexes in the file
+        AmUInt32 mChunkCount;
+        AmUInt32 mMagic;
+    };
+
+    /**
+     * @brief Layout of the secondary indexes of a recording.
+     *
+     * The indexes list the chunks holding the messages of each entity, channel and listener,
+     * the chunks holding each event name, and the time range of each chunk. Object and event
+     * entries have a fixed size and are sorted, so they are binary searched directly in the
+     * mapped file. They point at lists of chunk runs, which stay short for objects present
+     * over long periods.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerRecordingIndex
+    {
+        static constexpr AmUInt32 kMagic = 0x58444E49; // "INDX"
+        static constexpr AmSize kHeaderSize = 64;
+        static constexpr AmSize kObjectEntrySize = 24;
+        static constexpr AmSize kEventEntrySize = 16;
+        static constexpr AmSize kRunSize = 8;
+        static constexpr AmSize kTimeEntrySize = 16;
+
+        /**
+         * @brief Inclusive range of consecutive chunk indices.
+         */
+        using ChunkRun = std::pair<AmUInt32, AmUInt32>;
+
+        /**
+         * @brief Identifies an object: its category, the source it comes from, and its ID.
+         */
+        using ObjectKey = std::tuple<AmUInt32, AmUInt32, AmObjectID>;
+    };
+
+    /**
+     * @brief Writes profiler data to a recording file.
+     *
+     * Messages are buffered into a chunk, which is written once it reaches the configured
+     * size. Chunks can be compressed independently, so the file stays seekable: compression
+     * runs on a pool of worker threads, and chunks are written in order as they complete.
+     * When every worker is busy, the thread filling the chunk compresses it itself so memory
+     * stays bounded. Chunks are written asynchronously: when the disk cannot keep up and every
+     * write buffer is in flight, the chunk is dropped and recorded as empty in the chunk table,
+     * rather than blocking the caller. The footer is written when the recording is closed.
+     * This class is thread-safe.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerRecordingWriter
+    {
+    public:
+        /**
+         * @brief Default size of a chunk, in bytes.
+         */
+        static constexpr AmSize kDefaultChunkSize = 1024 * 1024;
+
+        /**
+         * @brief Default number of compression threads.
+         */
+        static constexpr AmUInt32 kDefaultCompressionThreads = 2;
+
+        /**
+         * @brief Zstandard compression level, a good balance of speed and ratio for profiler data.
+         */
+        static constexpr AmInt32 kZstdLevel = 3;
+
+        /**
+         * @brief Default interval between two syncs of the file, in milliseconds.
+         */
+        static constexpr AmUInt32 kDefaultSyncIntervalMs = 1000;
+
+        /**
+         * @brief Default number of chunks which can be in flight to the disk at once.
+         */
+        static constexpr AmUInt32 kDefaultWriteBuffers = 4;
+
+        ProfilerRecordingWriter();
+        ~ProfilerRecordingWriter();
+
+        // Non-copyable
+        ProfilerRecordingWriter(const ProfilerRecordingWriter&) = delete;
+        ProfilerRecordingWriter& operator=(const ProfilerRecordingWriter&) = delete;
+
+        /**
+         * @brief Create a recording file.
+         *
+         * @param path The path of the file to create. An existing file is overwritten.
+         * @param chunkSize The size above which a chunk is written to the file.
+         * @param compression The compression of the chunks.
+         * @param compressionThreads The number of threads compressing chunks, 0 compresses on the writing thread.
+         * @param durability When written chunks are synced to the disk.
+         * @param syncIntervalMs The interval between two syncs, for the interval durability.
+         * @param writeBuffers The number of chunks which can be in flight to the disk at once, at least 2.
+         * @return true if the file was created, false otherwise.
+         */
+        bool Open(
+            const AmOsString& path,
+            AmSize chunkSize = kDefaultChunkSize,
+            eProfilerRecordingCompression compression = eProfilerRecordingCompression_None,
+            AmUInt32 compressionThreads = kDefaultCompressionThreads,
+            eProfilerDurability durability = eProfilerDurability_Interval,
+            AmUInt32 syncIntervalMs = kDefaultSyncIntervalMs,
+            AmUInt32 writeBuffers = kDefaultWriteBuffers);
+
+        /**
+         * @brief Write the pending chunks and the footer, and close the file.
+         */
+        void Close();
+
+        /**
+         * @brief Check if a recording file is open.
+         */
+        [[nodiscard]] bool IsOpen() const;
+
+        /**
+         * @brief Add a message to the recording.
+         *
+         * @param data The message to record.
+         */
+        void Write(const ProfilerDataVariant& data);
+
+        /**
+         * @brief Write the pending chunks to the file, even if the last one is not full.
+         */
+        void Flush();
+
+        /**
+         * @brief Get the number of messages recorded since the file was opened.
+         */
+        [[nodiscard]] AmUInt64 GetMessageCount() const;
+
+        /**
+         * @brief Get the number of bytes written to the file, and the number of bytes the chunks take once decompressed.
+         */
+        void GetSizes(AmUInt64& storedBytes, AmUInt64& uncompressedBytes) const;
+
+        /**
+         * @brief Get the number of chunks dropped because the disk could not keep up.
+         */
+        [[nodiscard]] AmUInt64 GetDroppedChunkCount() const;
+
+    private:
+        struct PendingChunk
+        {
+            AmUInt64 mSequence;
+            ProfilerRecordingChunkInfo mInfo;
+            std::vector<AmUInt8> mData;
+            std::vector<AmUInt8> mCompressed;
+        };
+
+        using PendingChunkPtr = AmUniquePtr<PendingChunk, eMemoryPoolKind_IO>;
+
+        static void _workerLoop(AmVoidPtr userData);
+
+        void _flushChunk();
+        void _compressChunk(PendingChunk& chunk, AmVoidPtr context) const;
+        void _completeChunk(PendingChunkPtr chunk);
+        void _waitForPendingChunks() const;
+        void _stopWorkers();
+        void _writeFooter();
+        void _encodeIndex(std::vector<AmUInt8>& output, AmUInt64 indexOffset) const;
+        void _indexMessage(const ProfilerDataVariant& data, AmInt64 timestamp);
+
+        // Chunk being filled, protected by _mutex
+        bool _open;
+        AmSize _chunkSize;
+        std::vector<AmUInt8> _chunk;
+        ProfilerRecordingChunkInfo _currentChunk;
+        AmUInt64 _nextSequence;
+        AmUInt64 _messageCount;
+        eProfilerRecordingCompression _compression;
+        AmVoidPtr _compressionContext; // Used when the writing thread compresses a chunk itself
+
+        // Secondary indexes, protected by _mutex
+        std::set<ProfilerRecordingIndex::ObjectKey> _chunkObjects;
+        std::set<AmString> _chunkEvents;
+        AmInt64 _chunkMinTimestamp;
+        AmInt64 _chunkMaxTimestamp;
+        std::map<ProfilerRecordingIndex::ObjectKey, std::vector<ProfilerRecordingIndex::ChunkRun>> _objectRuns;
+        std::map<AmString, std::vector<ProfilerRecordingIndex::ChunkRun>> _eventRuns;
+        std::vector<std::pair<AmInt64, AmInt64>> _chunkTimes;
+
+        // Compression pool, protected by _queueMutex
+        std::vector<AmThreadHandle> _workers;
+        std::atomic<bool> _workersRunning;
+        std::deque<PendingChunkPtr> _queue;
+        std::atomic<AmSize> _pendingChunks; // Submitted but not yet written
+
+        // File, protected by _fileMutex
+        ProfilerAsyncFileWriter _file;
+        AmUInt64 _fileOffset;
+        AmUInt64 _uncompressedBytes;
+        AmUInt64 _droppedChunks;
+        std::vector<ProfilerRecordingChunkInfo> _chunks;
+        std::map<AmUInt64, PendingChunkPtr> _completed; // Compressed chunks waiting for the previous ones
+        AmUInt64 _nextToWrite;
+
+        mutable AmMutexHandle _mutex;
+        mutable AmMutexHandle _queueMutex;
+        mutable AmMutexHandle _fileMutex;
+    };
+
+    /**
+     * @brief Reads profiler data from a recording file.
+     *
+     * The file is memory-mapped, and chunks are decoded on demand. Reading chunks is
+     * thread-safe, so large recordings can be processed in parallel, one chunk per thread.
+     * Recordings which were never closed have no footer: their chunks are found by
+     * scanning the file, and a partially written last chunk is ignored.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerRecordingReader
+    {
+    public:
+        using MessageCallback = std::function<void(const ProfilerDataVariant&)>;
+
+        ProfilerRecordingReader();
+        ~ProfilerRecordingReader();
+
+        // Non-copyable
+        ProfilerRecordingReader(const ProfilerRecordingReader&) = delete;
+        ProfilerRecordingReader& operator=(const ProfilerRecordingReader&) = delete;
+
+        /**
+         * @brief Map a recording file.
+         *
+         * @param path The path of the recording.
+         * @return true if the file is a valid recording, false otherwise.
+         */
+        bool Open(const AmOsString& path);
+
+        /**
+         * @brief Unmap the recording file.
+         */
+        void Close();
+
+        /**
+         * @brief Check if a recording is mapped.
+         */
+        [[nodiscard]] AM_INLINE bool IsOpen() const
+        {
+            return _data != nullptr;
+        }
+
+        /**
+         * @brief Check if the recording had no footer and its chunks were found by scanning.
+         */
+        [[nodiscard]] AM_INLINE bool IsRecovered() const
+        {
+            return _recovered;
+        }
+
+        /**
+         * @brief Get the header of the recording.
+         */
+        [[nodiscard]] AM_INLINE const ProfilerRecordingHeader& GetHeader() const
+        {
+            return _header;
+        }
+
+        /**
+         * @brief Get the chunks of the recording, in file order.
+         */
+        [[nodiscard]] AM_INLINE const std::vector<ProfilerRecordingChunkInfo>& GetChunks() const
+        {
+            return _chunks;
+        }
+
+        /**
+         * @brief Get the total number of messages in the recording.
+         */
+        [[nodiscard]] AmUInt64 GetMessageCount() const;
+
+        /**
+         * @brief Decode the messages of a chunk.
+         *
+         * @param index The index of the chunk.
+         * @param callback Function called for each decoded message, in recording order.
+         * @return true if the whole chunk was decoded, false if it is invalid.
+         */
+        bool ReadChunk(AmSize index, const MessageCallback& callback) const;
+
+        /**
+         * @brief Check if the recording has secondary indexes.
+         *
+         * Without indexes, the queries below return every chunk, and reading an object or
+         * an event scans the whole recording.
+         */
+        [[nodiscard]] AM_INLINE bool HasIndex() const
+        {
+            return _index.mObjects != nullptr;
+        }
+
+        /**
+         * @brief Find the chunks which may hold messages in a time range.
+         *
+         * @param fromNs The start of the range, in nanoseconds.
+         * @param toNs The end of the range, in nanoseconds.
+         * @return The indices of the chunks, in file order.
+         */
+        [[nodiscard]] std::vector<AmSize> FindChunks(AmInt64 fromNs, AmInt64 toNs) const;
+
+        /**
+         * @brief Find the chunks which may hold messages of an object in a time range.
+         *
+         * @param category The category of the object: entity, channel or listener.
+         * @param id The ID of the object.
+         * @param sourceId The source of the object, 0 for recordings of a single process.
+         * @param fromNs The start of the range, in nanoseconds.
+         * @param toNs The end of the range, in nanoseconds.
+         * @return The indices of the chunks, in file order.
+         */
+        [[nodiscard]] std::vector<AmSize> FindObjectChunks(
+            eProfilerCategory category,
+            AmObjectID id,
+            AmUInt32 sourceId = 0,
+            AmInt64 fromNs = std::numeric_limits<AmInt64>::lowest(),
+            AmInt64 toNs = std::numeric_limits<AmInt64>::max()) const;
+
+        /**
+         * @brief Find the chunks which may hold an event in a time range.
+         *
+         * @param name The name of the event.
+         * @param fromNs The start of the range, in nanoseconds.
+         * @param toNs The end of the range, in nanoseconds.
+         * @return The indices of the chunks, in file order.
+         */
+        [[nodiscard]] std::vector<AmSize> FindEventChunks(
+            const AmString& name,
+            AmInt64 fromNs = std::numeric_limits<AmInt64>::lowest(),
+            AmInt64 toNs = std::numeric_limits<AmInt64>::max()) const;
+
+        /**
+         * @brief Decode the messages of an object in a time range.
+         *
+         * Only the chunks listed by the indexes are read.
+         *
+         * @return true if every read chunk was decoded, false otherwise.
+         */
+        bool ReadObject(
+            eProfilerCategory category,
+            AmObjectID id,
+            AmUInt32 sourceId,
+            AmInt64 fromNs,
+            AmInt64 toNs,
+            const MessageCallback& callback) const;
+
+        /**
+         * @brief Decode the occurrences of an event in a time range.
+         *
+         * Only the chunks listed by the indexes are read.
+         *
+         * @return true if every read chunk was decoded, false otherwise.
+         */
+        bool ReadEvents(const AmString& name, AmInt64 fromNs, AmInt64 toNs, const MessageCallback& callback) const;
+
+    private:
+        struct IndexView
+        {
+            const AmUInt8* mObjects = nullptr;
+            AmUInt32 mObjectCount = 0;
+            const AmUInt8* mEvents = nullptr;
+            AmUInt32 mEventCount = 0;
+            const AmUInt8* mNames = nullptr;
+            AmUInt64 mNamesSize = 0;
+            const AmUInt8* mRuns = nullptr;
+            AmUInt32 mRunCount = 0;
+            const AmUInt8* mTimes = nullptr;
+        };
+
+        bool _readFooter();
+        bool _readIndex(AmUInt64 offset, AmUInt64 end);
+        void _scanChunks();
+        [[nodiscard]] bool _isChunkInRange(AmSize index, AmInt64 fromNs, AmInt64 toNs) const;
+        [[nodiscard]] std::vector<AmSize> _expandRuns(AmUInt32 runOffset, AmUInt32 runCount, AmInt64 fromNs, AmInt64 toNs) const;
+
+        AmVoidPtr _handle;
+        const AmUInt8* _data;
+        AmSize _size;
+
+        ProfilerRecordingHeader _header;
+        std::vector<ProfilerRecordingChunkInfo> _chunks;
+        IndexView _index;
+        bool _recovered;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_RECORDING_H
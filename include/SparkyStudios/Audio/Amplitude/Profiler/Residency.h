@@ -0,0 +1,66 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_RESIDENCY_H
+#define _AM_PROFILER_RESIDENCY_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Makes profiler buffers resident in memory before they are used.
+     *
+     * A fresh allocation is only backed by physical pages when it is first written. When that
+     * first write happens while capturing, possibly from the audio thread, the page fault
+     * shows up as a glitch. Buffers sized at initialization are made resident right away,
+     * so capturing in the steady state never faults.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerMemoryResidency
+    {
+    public:
+        /**
+         * @brief Make a buffer resident.
+         *
+         * The buffer contents are preserved. It must not be written by another thread meanwhile.
+         *
+         * @param data The buffer.
+         * @param size The size of the buffer in bytes.
+         * @param residency Bitmask of eProfilerMemoryResidency.
+         * @return false if the buffer could not be locked, its pages are still touched.
+         */
+        static bool Acquire(void* data, AmSize size, AmUInt32 residency);
+
+        /**
+         * @brief Unlock a buffer made resident with Acquire, before it is freed.
+         *
+         * @param data The buffer.
+         * @param size The size of the buffer in bytes.
+         * @param residency The bitmask given to Acquire.
+         */
+        static void Release(void* data, AmSize size, AmUInt32 residency);
+
+        /**
+         * @brief Get the size of a memory page.
+         */
+        [[nodiscard]] static AmSize GetPageSize();
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_RESIDENCY_H
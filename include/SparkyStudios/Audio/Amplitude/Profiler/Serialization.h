@@ -0,0 +1,68 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_SERIALIZATION_H
+#define _AM_PROFILER_SERIALIZATION_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Compact binary encoding of profiler data.
+     *
+     * Messages are encoded as a type tag followed by their fields in declaration order,
+     * little-endian, with strings and containers prefixed by their element count. The
+     * format carries every field of the data snapshots, unlike the JSON stream which only
+     * carries a summary, and is used by local and offline transports.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerBinarySerializer
+    {
+    public:
+        /**
+         * @brief Version of the binary format, bumped on every incompatible change.
+         */
+        static constexpr AmUInt16 kFormatVersion = 3;
+
+        /**
+         * @brief Append the binary encoding of a message to a buffer.
+         *
+         * @param data The message to encode.
+         * @param buffer [out] The buffer to append the encoded message to.
+         */
+        static void Encode(const ProfilerDataVariant& data, std::vector<AmUInt8>& buffer);
+
+        /**
+         * @brief Decode a message from its binary encoding.
+         *
+         * The decoder never reads outside of the given range, so it can safely be used
+         * on data which may have been overwritten by a concurrent producer.
+         *
+         * @param data Pointer to the encoded message.
+         * @param size Size of the encoded message, in bytes.
+         * @param message [out] The decoded message.
+         * @return true if the message was decoded successfully, false if the data is invalid.
+         */
+        static bool Decode(const AmUInt8* data, AmSize size, ProfilerDataVariant& message);
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_SERIALIZATION_H
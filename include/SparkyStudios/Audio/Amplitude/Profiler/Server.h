@@ -19,9 +19,17 @@
 
 #include <SparkyStudios/Audio/Amplitude/Core/Common.h>
 #include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LockProfiler.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Multicast.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/RateLimiter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/RateMeter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/SharedMemory.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Types.h>
 
+#include <array>
 #include <atomic>
 #include <functional>
 #include <unordered_map>
@@ -47,8 +55,22 @@ namespace SparkyStudios::Audio::Amplitude
         ProfilerTime mConnectedTime;
         AmUInt64 mMessagesSent;
         AmUInt64 mBytesTransmitted;
+        AmUInt64 mMessagesFiltered;
+        AmString mFilterExpression;
         bool mIsConnected;
 
+        // Quality of service
+        eProfilerQoSClass mQoSClass;
+        ProfilerTokenBucket mMessageBucket; ///< Messages per second allowed for this client
+        ProfilerTokenBucket mByteBucket; ///< Bytes per second allowed for this client
+        AmUInt64 mMessagesThrottled; ///< Messages dropped because a token bucket was empty
+        AmUInt64 mBytesThrottled; ///< Bytes dropped because a token bucket was empty
+        AmUInt64 mMessagesShed; ///< Messages dropped because the event loop was busy serving higher classes
+
+        // Throughput
+        ProfilerRateMeter mMessageRate; ///< Messages sent to this client over the last second
+        ProfilerRateMeter mByteRate; ///< Bytes sent to this client over the last second
+
         ProfilerClientInfo()
             : mClientId(0)
             , mSocket(AM_INVALID_SOCKET)
@@ -56,7 +78,12 @@ namespace SparkyStudios::Audio::Amplitude
             , mConnectedTime(std::chrono::high_resolution_clock::now())
             , mMessagesSent(0)
             , mBytesTransmitted(0)
+            , mMessagesFiltered(0)
             , mIsConnected(false)
+            , mQoSClass(eProfilerQoSClass_Interactive)
+            , mMessagesThrottled(0)
+            , mBytesThrottled(0)
+            , mMessagesShed(0)
         {}
     };
 
@@ -101,6 +128,12 @@ namespace SparkyStudios::Audio::Amplitude
             AmUInt32 mFailedSends;
             AmReal32 mAverageMessageSize;
             ProfilerTime mServerStartTime;
+
+            // Rates over the last second, computed when the statistics are read
+            AmReal32 mMessagesPerSecond;
+            AmReal32 mBytesPerSecond;
+            std::array<AmReal32, kProfilerCategoryCount> mCategoryMessagesPerSecond; ///< Indexed by category bit
+            std::array<AmReal32, kProfilerCategoryCount> mCategoryBytesPerSecond; ///< Indexed by category bit
         };
 
         /**
@@ -194,6 +227,143 @@ namespace SparkyStudios::Audio::Amplitude
          */
         AmUInt32 BroadcastProfilerData(const ProfilerDataVariant& data);
 
+        /**
+         * @brief Broadcast a batch of profiler data to all connected clients.
+         *
+         * Client filters are evaluated column by column over the whole batch, and each
+         * message is serialized at most once, only if at least one client accepts it.
+         *
+         * @param messages The profiler data to serialize and broadcast.
+         * @return Number of messages sent, summed over all clients.
+         */
+        AmUInt32 BroadcastProfilerData(const std::vector<ProfilerDataVariant>& messages);
+
+        /**
+         * @brief Start publishing profiler data to a shared memory ring.
+         *
+         * Consumers on the same host attach to the ring with a `ProfilerSharedMemoryReader`
+         * and receive every broadcast message in binary form, without going through the
+         * WebSocket stack. Client filters and rate limits do not apply to the ring.
+         *
+         * @param name The name of the shared memory region.
+         * @param capacity The size of the ring, in bytes.
+         * @return true if the ring was created, false otherwise.
+         */
+        bool StartSharedMemoryTransport(const AmString& name, AmSize capacity);
+
+        /**
+         * @brief Stop publishing to the shared memory ring, and remove it.
+         */
+        void StopSharedMemoryTransport();
+
+        /**
+         * @brief Check if the shared memory transport is running.
+         *
+         * @return true if messages are published to a shared memory ring, false otherwise.
+         */
+        bool IsSharedMemoryTransportRunning() const;
+
+        /**
+         * @brief Start sending profiler data to a UDP multicast group.
+         *
+         * Every broadcast batch is sent once to the group, whatever the number of listeners.
+         * Client filters and rate limits do not apply to multicast.
+         *
+         * @param group The IPv4 multicast group address.
+         * @param port The destination port.
+         * @param ttl Time to live of the datagrams.
+         * @param mtu Maximum size of a datagram.
+         * @param keyframeIntervalSeconds Delay between two keyframes, or 0 to disable keyframes.
+         * @return true if the multicast socket was opened, false otherwise.
+         *
+         * @see ProfilerMulticastSender
+         */
+        bool StartMulticastTransport(const AmString& group, AmUInt16 port, AmUInt8 ttl, AmUInt32 mtu, AmReal32 keyframeIntervalSeconds);
+
+        /**
+         * @brief Stop sending profiler data to the multicast group.
+         */
+        void StopMulticastTransport();
+
+        /**
+         * @brief Check if the multicast transport is running.
+         *
+         * @return true if messages are sent to a multicast group, false otherwise.
+         */
+        bool IsMulticastTransportRunning() const;
+
+        /**
+         * @brief Set the filter expression applied to messages sent to a client.
+         *
+         * Clients can also set their own filter by sending a `set_filter` command:
+         * `{"command": "set_filter", "expression": "channel.gain > 0.1"}`.
+         *
+         * @param clientId The client ID to filter messages for.
+         * @param expression The filter expression. An empty expression removes the filter.
+         * @param error [out] Optional description of the compilation error.
+         * @return true if the filter was compiled and applied, false otherwise.
+         *
+         * @see ProfilerFilter
+         */
+        bool SetClientFilter(ProfilerClientID clientId, const AmString& expression, AmString* error = nullptr);
+
+        /**
+         * @brief Remove the filter of a client, so it receives every message.
+         *
+         * @param clientId The client ID to remove the filter for.
+         */
+        void ClearClientFilter(ProfilerClientID clientId);
+
+        /**
+         * @brief Set the quality of service class of a client.
+         *
+         * Clients can also lower their own class and rates by sending a `set_qos` command:
+         * `{"command": "set_qos", "class": "bulk", "max_messages_per_second": 10}`. Raising
+         * them is only possible from the host, with this function and SetClientRateLimits().
+         *
+         * @param clientId The client ID to update.
+         * @param qosClass The new quality of service class.
+         * @return true if the client was found, false otherwise.
+         */
+        bool SetClientQoSClass(ProfilerClientID clientId, eProfilerQoSClass qosClass);
+
+        /**
+         * @brief Set the token bucket rates of a client.
+         *
+         * @param clientId The client ID to update.
+         * @param maxMessagesPerSecond Maximum messages per second, or 0 for no limit.
+         * @param maxBytesPerSecond Maximum bytes per second, or 0 for no limit.
+         * @return true if the client was found, false otherwise.
+         */
+        bool SetClientRateLimits(ProfilerClientID clientId, AmReal64 maxMessagesPerSecond, AmReal64 maxBytesPerSecond);
+
+        /**
+         * @brief Set the token bucket rates given to newly connected clients.
+         *
+         * @param maxMessagesPerSecond Maximum messages per second, or 0 for no limit.
+         * @param maxBytesPerSecond Maximum bytes per second, or 0 for no limit.
+         */
+        void SetDefaultRateLimits(AmReal64 maxMessagesPerSecond, AmReal64 maxBytesPerSecond);
+
+        /**
+         * @brief Set the number of pending sends above which the event loop is considered busy.
+         *
+         * When busy, bulk clients are shed. Above twice this threshold, interactive clients
+         * are shed as well. Critical priority messages are never shed.
+         *
+         * @param pendingSends The busy threshold, or 0 to disable load shedding.
+         */
+        void SetBusyThreshold(AmUInt32 pendingSends);
+
+        /**
+         * @brief Set the bytes buffered for each client before its sends are dropped.
+         *
+         * Takes effect the next time the server is started.
+         *
+         * @param bytes The size of the send buffer of each client.
+         */
+        void SetMaxBackpressure(AmUInt32 bytes);
+
         /**
          * @brief Disconnect a specific client.
          *
@@ -281,10 +451,17 @@ namespace SparkyStudios::Audio::Amplitude
         bool _sendToSocket(SocketHandle socket, const AmString& message);
         AmString _receiveFromSocket(SocketHandle socket);
         AmString _serializeProfilerData(const ProfilerDataVariant& data);
+        void _handleClientCommand(ProfilerClientID clientId, const AmString& message);
+        bool _restrictClientQoS(
+            ProfilerClientID clientId, const eProfilerQoSClass* qosClass, AmReal64 maxMessagesPerSecond, AmReal64 maxBytesPerSecond);
+        void _insertClientByQoSClass(ProfilerClientInfo* client);
+        void _eraseClientByQoSClass(const ProfilerClientInfo* client);
+        bool _shouldShed(ProfilerClientInfo& client, eProfilerPriority priority, AmUInt32 pendingSends);
+        bool _consumeTokens(ProfilerClientInfo& client, eProfilerPriority priority, AmSize messageSize, ProfilerTime now);
 
         // Utility functions
         AmString _getSocketAddress(SocketHandle socket, AmUInt16& port);
-        void _updateStatistics(ProfilerClientID clientId, AmSize messageSize);
+        void _updateStatistics(ProfilerClientInfo& client, AmSize messageSize, eProfilerCategory category, ProfilerTime now);
         void _triggerEvent(const std::function<void()>& eventFunction);
 
         // Member variables
@@ -298,17 +475,36 @@ namespace SparkyStudios::Audio::Amplitude
 
         // Threading
         AmThreadHandle _acceptThread;
-        mutable AmMutexHandle _clientsMutex;
-        mutable AmMutexHandle _statisticsMutex;
-        mutable AmMutexHandle _callbacksMutex;
+        mutable ProfilerMutex _clientsMutex;
+        mutable ProfilerMutex _statisticsMutex;
+        mutable ProfilerMutex _callbacksMutex;
 
         // Client management
         std::unordered_map<ProfilerClientID, ProfilerClientInfo> _clients;
+        std::vector<ProfilerClientInfo*> _clientsByQoSClass; // Connected clients, highest class first, kept sorted as they change
         std::unordered_map<ProfilerClientID, AmThreadHandle> _clientThreads;
+        std::unordered_map<ProfilerClientID, AmUniquePtr<ProfilerFilter, eMemoryPoolKind_IO>> _clientFilters;
         std::atomic<ProfilerClientID> _nextClientId;
 
+        // Quality of service
+        std::atomic<AmUInt32> _pendingSends;
+        AmUInt32 _busyThreshold;
+        AmUInt32 _maxBackpressure;
+        AmReal64 _defaultMessagesPerSecond;
+        AmReal64 _defaultBytesPerSecond;
+
+        // Same-host transport
+        AmUniquePtr<ProfilerSharedMemoryWriter, eMemoryPoolKind_IO> _sharedMemoryWriter;
+
+        // Lab-wide transport
+        AmUniquePtr<ProfilerMulticastSender, eMemoryPoolKind_IO> _multicastSender;
+
         // Statistics
         Statistics _statistics;
+        ProfilerRateMeter _messageRate;
+        ProfilerRateMeter _byteRate;
+        std::array<ProfilerRateMeter, kProfilerCategoryCount> _categoryMessageRates;
+        std::array<ProfilerRateMeter, kProfilerCategoryCount> _categoryByteRates;
 
         // Event callbacks
         ClientEventCallback _onClientConnected;
@@ -318,6 +514,7 @@ namespace SparkyStudios::Audio::Amplitude
 
         // Constants
         static constexpr AmSize kMaxMessageSize = 1024 * 1024; // 1MB max message size
+        static constexpr AmSize kMaxFilterLength = 4096; // Longest filter expression a client can send
         static constexpr AmInt32 kSocketReceiveTimeout = 5000; // 5 seconds
         static constexpr AmInt32 kSocketSendTimeout = 5000; // 5 seconds
         static constexpr AmInt32 kListenBacklog = 10;
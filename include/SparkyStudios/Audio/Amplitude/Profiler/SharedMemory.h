@@ -0,0 +1,228 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_SHARED_MEMORY_H
+#define _AM_PROFILER_SHARED_MEMORY_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Header placed at the start of a shared memory ring.
+     *
+     * The ring data follows the header. Each record is made of a 32-bit payload size,
+     * a 32-bit sequence number and the binary encoded message, padded to 8 bytes. A record
+     * with a size of `kPaddingRecord` tells readers to skip to the start of the ring.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerSharedMemoryHeader
+    {
+        static constexpr AmUInt32 kMagic = 0x50504D41; // "AMPP"
+        static constexpr AmUInt16 kVersion = 1;
+        static constexpr AmUInt32 kPaddingRecord = 0xFFFFFFFF;
+        static constexpr AmSize kRecordHeaderSize = 8;
+
+        AmUInt32 mMagic;
+        AmUInt16 mVersion;
+        AmUInt16 mFormatVersion; ///< Version of the binary serializer used for payloads
+        AmUInt64 mCapacity; ///< Size of the ring data, always a power of two
+
+        alignas(64) std::atomic<AmUInt64> mReserveCursor; ///< End of the region the producer may be writing to
+        alignas(64) std::atomic<AmUInt64> mWriteCursor; ///< End of the region fully written by the producer
+        std::atomic<AmUInt64> mMessageCount;
+    };
+
+    /**
+     * @brief Producer side of a shared memory ring read by consumers on the same host.
+     *
+     * The producer never waits for readers: old records are overwritten when the ring is
+     * full, and readers detect the overwrite and resynchronize. Each message is copied once
+     * into the ring, with no system call on the publishing path.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerSharedMemoryWriter
+    {
+    public:
+        ProfilerSharedMemoryWriter();
+        ~ProfilerSharedMemoryWriter();
+
+        // Non-copyable
+        ProfilerSharedMemoryWriter(const ProfilerSharedMemoryWriter&) = delete;
+        ProfilerSharedMemoryWriter& operator=(const ProfilerSharedMemoryWriter&) = delete;
+
+        /**
+         * @brief Create the shared memory region and map it.
+         *
+         * @param name The name of the region, shared with readers.
+         * @param capacity The size of the ring, rounded up to a power of two.
+         * @return true if the region was created, false otherwise.
+         */
+        bool Open(const AmString& name, AmSize capacity);
+
+        /**
+         * @brief Unmap and remove the shared memory region.
+         */
+        void Close();
+
+        /**
+         * @brief Check if the region is mapped.
+         */
+        [[nodiscard]] AM_INLINE bool IsOpen() const
+        {
+            return _header != nullptr;
+        }
+
+        /**
+         * @brief Encode a message and publish it to the ring.
+         *
+         * @param data The message to publish.
+         * @return true if the message was published, false if it is too large for the ring.
+         */
+        bool Publish(const ProfilerDataVariant& data);
+
+        /**
+         * @brief Publish an already encoded message to the ring.
+         *
+         * @param payload Pointer to the binary encoded message.
+         * @param size Size of the encoded message, in bytes.
+         * @return true if the message was published, false if it is too large for the ring.
+         */
+        bool Publish(const AmUInt8* payload, AmSize size);
+
+        /**
+         * @brief Get the number of messages published since the region was opened.
+         */
+        [[nodiscard]] AmUInt64 GetPublishedCount() const;
+
+    private:
+        bool _write(const AmUInt8* payload, AmSize size);
+
+        AmString _name;
+        AmVoidPtr _handle;
+        AmSize _mappedSize;
+        ProfilerSharedMemoryHeader* _header;
+        AmUInt8* _data;
+        AmUInt32 _sequence;
+        std::vector<AmUInt8> _encodeBuffer;
+        AmMutexHandle _mutex;
+    };
+
+    /**
+     * @brief Consumer side of a shared memory ring.
+     *
+     * Each reader keeps its own cursor, so any number of readers can attach to the same
+     * ring. Readers never write to the shared region. This class is not thread-safe.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerSharedMemoryReader
+    {
+    public:
+        using MessageCallback = std::function<void(const ProfilerDataVariant&)>;
+
+        ProfilerSharedMemoryReader();
+        ~ProfilerSharedMemoryReader();
+
+        // Non-copyable
+        ProfilerSharedMemoryReader(const ProfilerSharedMemoryReader&) = delete;
+        ProfilerSharedMemoryReader& operator=(const ProfilerSharedMemoryReader&) = delete;
+
+        /**
+         * @brief Attach to an existing shared memory region.
+         *
+         * The reader starts at the current write position of the producer.
+         *
+         * @param name The name of the region.
+         * @return true if the region was found and is compatible, false otherwise.
+         */
+        bool Open(const AmString& name);
+
+        /**
+         * @brief Detach from the shared memory region.
+         */
+        void Close();
+
+        /**
+         * @brief Check if the reader is attached to a region.
+         */
+        [[nodiscard]] AM_INLINE bool IsOpen() const
+        {
+            return _header != nullptr;
+        }
+
+        /**
+         * @brief Read the messages published since the last call.
+         *
+         * @param callback Function called for each decoded message.
+         * @param maxMessages Maximum number of messages to read, or 0 for no limit.
+         * @return The number of messages read.
+         */
+        AmUInt32 Poll(const MessageCallback& callback, AmUInt32 maxMessages = 0);
+
+        /**
+         * @brief Get the number of messages the reader missed because they were overwritten.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetLostCount() const
+        {
+            return _lostMessages;
+        }
+
+        /**
+         * @brief Get the number of times the reader had to resynchronize with the producer.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetResyncCount() const
+        {
+            return _resyncCount;
+        }
+
+        /**
+         * @brief Check if the producer recreated the ring since the reader attached.
+         *
+         * The write cursor of a recreated ring starts over, so it moves backwards. The reader
+         * stops reading once this happens, and should be opened again.
+         */
+        [[nodiscard]] AM_INLINE bool HasProducerRestarted() const
+        {
+            return _producerRestarted;
+        }
+
+    private:
+        void _resync();
+
+        AmVoidPtr _handle;
+        AmSize _mappedSize;
+        const ProfilerSharedMemoryHeader* _header;
+        const AmUInt8* _data;
+        AmUInt64 _readCursor;
+        AmUInt32 _expectedSequence;
+        bool _hasSequence;
+        AmUInt64 _lostMessages;
+        AmUInt64 _resyncCount;
+        bool _producerRestarted;
+        std::vector<AmUInt8> _recordBuffer;
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_SHARED_MEMORY_H
@@ -0,0 +1,174 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_STACK_SAMPLER_H
+#define _AM_PROFILER_STACK_SAMPLER_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    struct ProfilerStackSampleRing;
+
+    /**
+     * @brief Statistical CPU profiler of registered threads, like the audio and mixer threads.
+     *
+     * A timer per thread interrupts it at a fixed rate with a signal, whose handler walks the
+     * frame pointers of the interrupted code and copies the return addresses into a ring owned
+     * by the thread. The handler is async-signal-safe: it does not lock, allocate or call into
+     * the C library, and only reads stack memory within the bounds recorded at registration.
+     *
+     * The profiler update thread drains the rings, symbolizes the addresses and counts each
+     * distinct call stack. Flush() turns the counts into events holding folded stacks, one
+     * "root;caller;callee count" line per stack, the input format of flame graph tools.
+     *
+     * Timers count the CPU time of their thread, so a thread waiting for its next buffer is
+     * neither sampled nor woken up. Sampling needs code compiled with frame pointers, and is
+     * only available on Linux.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerStackSampler
+    {
+    public:
+        /**
+         * @brief Maximum number of threads sampled at once.
+         */
+        static constexpr AmUInt32 kMaxThreads = 8;
+
+        /**
+         * @brief Returned by RegisterThread() when no more threads can be sampled.
+         */
+        static constexpr AmUInt32 kInvalidThread = ~0u;
+
+        /**
+         * @brief Maximum depth of a sampled stack. Deeper frames are not captured.
+         */
+        static constexpr AmUInt32 kMaxFrames = 64;
+
+        /**
+         * @brief Number of samples each thread buffers until the update thread drains them.
+         */
+        static constexpr AmUInt32 kRingCapacity = 256;
+
+        /**
+         * @brief Name of the events emitted by Flush().
+         */
+        static constexpr const char* kEventName = "StackSamples";
+
+        ProfilerStackSampler();
+        ~ProfilerStackSampler();
+
+        // Non-copyable
+        ProfilerStackSampler(const ProfilerStackSampler&) = delete;
+        ProfilerStackSampler& operator=(const ProfilerStackSampler&) = delete;
+
+        /**
+         * @brief Install the signal handler and start sampling the registered threads.
+         *
+         * @param rateHz The number of samples per second and per thread.
+         * @return true if sampling was started, false otherwise.
+         */
+        bool Start(AmUInt32 rateHz);
+
+        /**
+         * @brief Stop sampling, and restore the previous signal handler.
+         */
+        void Stop();
+
+        /**
+         * @brief Check if the sampler is running.
+         */
+        [[nodiscard]] AM_INLINE bool IsRunning() const
+        {
+            return _rateHz.load(std::memory_order_relaxed) != 0;
+        }
+
+        /**
+         * @brief Start sampling the calling thread. This function allocates.
+         *
+         * The thread keeps its registration while the sampler is stopped, and is sampled again once it restarts.
+         *
+         * @param name The name of the thread, added to its events.
+         * @return The handle to pass to UnregisterThread(), or kInvalidThread when too many threads are sampled.
+         */
+        AmUInt32 RegisterThread(const AmString& name);
+
+        /**
+         * @brief Stop sampling a thread. Its ring is released by the next collection.
+         *
+         * @param thread The handle returned by RegisterThread().
+         */
+        void UnregisterThread(AmUInt32 thread);
+
+        /**
+         * @brief Drain the samples of every thread and count their stacks. Profiler update thread only.
+         */
+        void Collect();
+
+        /**
+         * @brief Turn the stacks counted since the last flush into events. Profiler update thread only.
+         *
+         * @param maxStacks The number of stacks in each event, the most sampled first. Others are counted as "[other]".
+         * @param events [out] An event is appended for every thread which was sampled.
+         */
+        void Flush(AmUInt32 maxStacks, std::vector<ProfilerEvent>& events);
+
+    private:
+        enum eThreadState : AmUInt8
+        {
+            eThreadState_Free = 0,
+            eThreadState_Active = 1,
+            eThreadState_Closing = 2, // Unregistered, waiting for its last samples to be drained
+        };
+
+        struct SampledThread
+        {
+            eThreadState mState = eThreadState_Free;
+            ProfilerStackSampleRing* mRing = nullptr; // Shared with the signal handler
+            AmVoidPtr mTimer = nullptr; // timer_t, null while not sampled
+            AmUInt64 mThreadId = 0;
+            AmInt32 mClockId = 0; // CPU time clock of the thread, so idle threads are not interrupted
+            AmString mName;
+
+            std::unordered_map<AmString, AmUInt64> mStacks; // Sample count of each folded stack since the last flush
+            AmUInt64 mSampleCount = 0;
+            AmUInt64 mDroppedCount = 0; // Copied from the ring at each collection
+            AmUInt64 mReportedDropped = 0;
+        };
+
+        bool _startTimer(SampledThread& thread);
+        static void _stopTimer(SampledThread& thread);
+        void _drain(SampledThread& thread);
+        const AmString& _symbolize(AmUInt64 address, bool returnAddress);
+
+        SampledThread _threads[kMaxThreads];
+        std::atomic<AmUInt32> _rateHz; // 0 while stopped
+
+        std::unordered_map<AmUInt64, AmString> _symbols; // Symbol of each address, profiler update thread only
+        AmString _stack; // Folded stack being built, reused between samples
+
+        AmMutexHandle _mutex; // Protects the threads
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_STACK_SAMPLER_H
@@ -20,6 +20,8 @@
 #include <SparkyStudios/Audio/Amplitude/Core/Common.h>
 #include <SparkyStudios/Audio/Amplitude/Math/Utils.h>
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
 
 namespace SparkyStudios::Audio::Amplitude
@@ -151,12 +153,41 @@ namespace SparkyStudios::Audio::Amplitude
          */
         eProfilerCategory_Events = 1 << 7,
 
+        /**
+         * @brief Windowed statistics of numeric fields
+         */
+        eProfilerCategory_Aggregate = 1 << 8,
+
         /**
          * @brief All categories combined
          */
         eProfilerCategory_All = 0xFFFFFFFF
     };
 
+    /**
+     * @brief Number of single categories, the index of a category is the index of its bit.
+     *
+     * @ingroup profiling
+     */
+    constexpr AmUInt32 kProfilerCategoryCount = 9;
+
+    /**
+     * @brief Get the index of a single category.
+     *
+     * @param category The category.
+     * @return The index of the category, or kProfilerCategoryCount if it is not a single category.
+     *
+     * @ingroup profiling
+     */
+    constexpr AmUInt32 GetProfilerCategoryIndex(eProfilerCategory category)
+    {
+        const auto bits = static_cast<AmUInt32>(category);
+        if (!std::has_single_bit(bits))
+            return kProfilerCategoryCount;
+
+        return std::min<AmUInt32>(std::countr_zero(bits), kProfilerCategoryCount);
+    }
+
     /**
      * @brief Profiler message priority levels
      *
@@ -184,6 +215,134 @@ namespace SparkyStudios::Audio::Amplitude
          */
         eProfilerPriority_Critical = 3
     };
+
+    /**
+     * @brief Quality of service classes of profiler clients.
+     *
+     * When the network event loop falls behind, clients are served in class order
+     * and lower classes are shed first.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerQoSClass : AmUInt8
+    {
+        /**
+         * @brief Lightweight clients which must always be served first (alerts, overlays)
+         */
+        eProfilerQoSClass_Realtime = 0,
+
+        /**
+         * @brief Interactive clients, shed only when the event loop is overloaded
+         */
+        eProfilerQoSClass_Interactive = 1,
+
+        /**
+         * @brief Heavy consumers, shed as soon as the event loop is busy
+         */
+        eProfilerQoSClass_Bulk = 2
+    };
+
+    /**
+     * @brief Compression of the chunks of a recording.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerRecordingCompression : AmUInt8
+    {
+        /**
+         * @brief Chunks are stored as-is
+         */
+        eProfilerRecordingCompression_None = 0,
+
+        /**
+         * @brief Chunks are compressed with Zstandard, for the best ratio
+         */
+        eProfilerRecordingCompression_Zstd = 1,
+
+        /**
+         * @brief Chunks are compressed with LZ4, for the lowest CPU cost
+         */
+        eProfilerRecordingCompression_LZ4 = 2
+    };
+
+    /**
+     * @brief When written data is flushed to the storage device.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerDurability : AmUInt8
+    {
+        /**
+         * @brief The operating system decides when data reaches the disk
+         */
+        eProfilerDurability_None = 0,
+
+        /**
+         * @brief Data is synced at a fixed interval, bounding what a power loss can lose
+         */
+        eProfilerDurability_Interval = 1,
+
+        /**
+         * @brief Data is synced after every write
+         */
+        eProfilerDurability_Always = 2
+    };
+
+    /**
+     * @brief What the profiler does when an alert rule fires. Values can be combined.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerAlertAction : AmUInt32
+    {
+        /**
+         * @brief Nothing is done, the rule is only counted
+         */
+        eProfilerAlertAction_None = 0,
+
+        /**
+         * @brief A critical priority event is emitted
+         */
+        eProfilerAlertAction_Event = 1 << 0,
+
+        /**
+         * @brief The flight recorder is dumped to a file
+         */
+        eProfilerAlertAction_Dump = 1 << 1,
+
+        /**
+         * @brief The update frequency is raised for a while
+         */
+        eProfilerAlertAction_Boost = 1 << 2
+    };
+
+    /**
+     * @brief How the profiler buffers are made resident in memory. Values can be combined.
+     *
+     * @ingroup profiling
+     */
+    enum eProfilerMemoryResidency : AmUInt32
+    {
+        /**
+         * @brief Pages are mapped when they are first written
+         */
+        eProfilerMemoryResidency_None = 0,
+
+        /**
+         * @brief Every page is touched up front, so later writes do not fault
+         */
+        eProfilerMemoryResidency_Prefault = 1 << 0,
+
+        /**
+         * @brief Pages are locked in physical memory, so they are never swapped out
+         */
+        eProfilerMemoryResidency_Lock = 1 << 1,
+
+        /**
+         * @brief Large buffers ask for transparent huge pages, where the platform supports them
+         */
+        eProfilerMemoryResidency_HugePages = 1 << 2
+    };
 } // namespace SparkyStudios::Audio::Amplitude
 
 #endif // _AM_PROFILER_TYPES_H
@@ -0,0 +1,200 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef _AM_PROFILER_WATCHDOG_H
+#define _AM_PROFILER_WATCHDOG_H
+
+#include <SparkyStudios/Audio/Amplitude/Core/Common.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief State of a thread when it was detected as stalled.
+     *
+     * @ingroup profiling
+     */
+    struct AM_API_PUBLIC ProfilerStallReport
+    {
+        AmString mThreadName;
+        AmUInt64 mThreadId; ///< Kernel thread ID, 0 when unknown
+        AmReal64 mLateMs; ///< Time since the last heartbeat
+        AmReal64 mBufferPeriodMs;
+        AmString mState; ///< Scheduler state, e.g. "R" running, "S" sleeping, "D" waiting on I/O
+        AmString mWaitChannel; ///< Kernel function the thread is blocked in, if any
+        AmString mSyscall; ///< System call the thread is blocked in, if any
+        AmString mStack; ///< Kernel stack of the thread, when readable
+    };
+
+    /**
+     * @brief Detects audio threads which stop calling back in time.
+     *
+     * Each monitored thread calls Heartbeat() once per audio buffer. A watchdog thread
+     * checks the heartbeats every millisecond, and reports a thread once when its last
+     * heartbeat is late by more than the configured number of buffer periods. On Linux,
+     * the report includes the state of the stalled thread read from /proc. A second report,
+     * with the total duration of the stall, is made when the thread calls back again.
+     *
+     * Each heartbeat also measures the wakeup latency of its thread, the time between one
+     * buffer period after the previous heartbeat and this one, into a histogram the thread
+     * owns. CollectScheduling() reads these histograms with the context switches of each
+     * thread, so late scheduling can be told apart from slow processing.
+     *
+     * Heartbeat() is lock-free and can be called from real-time threads.
+     *
+     * @ingroup profiling
+     */
+    class AM_API_PUBLIC ProfilerWatchdog
+    {
+    public:
+        /**
+         * @brief Called from the watchdog thread when a stall starts, and when it ends.
+         *
+         * @param report The state of the thread.
+         * @param ended false when the stall is detected, true once the thread called back again.
+         */
+        using StallCallback = std::function<void(const ProfilerStallReport& report, bool ended)>;
+
+        /**
+         * @brief Maximum number of threads monitored at once.
+         */
+        static constexpr AmUInt32 kMaxThreads = 8;
+
+        /**
+         * @brief Returned by RegisterThread() when no more threads can be monitored.
+         */
+        static constexpr AmUInt32 kInvalidThread = ~0u;
+
+        ProfilerWatchdog();
+        ~ProfilerWatchdog();
+
+        // Non-copyable
+        ProfilerWatchdog(const ProfilerWatchdog&) = delete;
+        ProfilerWatchdog& operator=(const ProfilerWatchdog&) = delete;
+
+        /**
+         * @brief Start the watchdog thread.
+         *
+         * @param stallPeriods The number of buffer periods after which a missing heartbeat is a stall.
+         * @param callback Called from the watchdog thread when a stall starts and ends, without any lock held.
+         * @return true if the watchdog was started, false otherwise.
+         */
+        bool Start(AmReal64 stallPeriods, StallCallback callback);
+
+        /**
+         * @brief Stop the watchdog thread.
+         */
+        void Stop();
+
+        /**
+         * @brief Check if the watchdog thread is running.
+         */
+        [[nodiscard]] AM_INLINE bool IsRunning() const
+        {
+            return _running.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Start monitoring the calling thread.
+         *
+         * Monitoring starts with the first heartbeat, so a thread can be registered before its audio starts.
+         *
+         * @param name The name of the thread, used in reports.
+         * @param bufferPeriodMs The duration of an audio buffer, the expected interval between two heartbeats.
+         * @return The handle to pass to Heartbeat(), or kInvalidThread when too many threads are monitored.
+         */
+        AmUInt32 RegisterThread(const AmString& name, AmReal64 bufferPeriodMs);
+
+        /**
+         * @brief Stop monitoring a thread, e.g. before its audio stops.
+         *
+         * @param thread The handle returned by RegisterThread().
+         */
+        void UnregisterThread(AmUInt32 thread);
+
+        /**
+         * @brief Signal that a thread is alive. This function is lock-free.
+         *
+         * @param thread The handle returned by RegisterThread().
+         */
+        void Heartbeat(AmUInt32 thread);
+
+        /**
+         * @brief Collect the scheduling of each monitored thread since the previous collection.
+         *
+         * Heartbeats are measured whether the watchdog thread runs or not. Context switches
+         * are read from /proc on Linux only.
+         *
+         * @param scheduling [out] The scheduling statistics, by thread name.
+         */
+        void CollectScheduling(std::unordered_map<AmString, ProfilerThreadScheduling>& scheduling);
+
+        /**
+         * @brief Get the number of stalls detected since the watchdog was started.
+         */
+        [[nodiscard]] AM_INLINE AmUInt64 GetStallCount() const
+        {
+            return _stallCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct MonitoredThread
+        {
+            std::atomic<bool> mActive = false;
+            std::atomic<AmInt64> mLastHeartbeatNs = 0; // 0 until the first heartbeat
+            AmReal64 mBufferPeriodMs = 0.0;
+            AmInt64 mBufferPeriodNs = 0;
+            AmUInt64 mThreadId = 0;
+            AmString mName;
+
+            // Written by the monitored thread only, totals since the registration
+            std::atomic<AmUInt32> mLatencyBuckets[ProfilerThreadScheduling::kLatencyBucketCount] = {};
+            std::atomic<AmUInt64> mMaxLatencyNs = 0; // Since the previous collection
+
+            // Watchdog thread only
+            AmInt64 mStalledHeartbeatNs = 0; // Heartbeat after which a stall was reported, 0 when not stalled
+            AmReal64 mStallLateMs = 0.0;
+
+            // Collecting thread only, totals at the previous collection
+            std::array<AmUInt32, ProfilerThreadScheduling::kLatencyBucketCount> mCollectedBuckets = {};
+            AmUInt64 mCollectedVoluntarySwitches = 0;
+            AmUInt64 mCollectedInvoluntarySwitches = 0;
+        };
+
+        static void _watchLoop(AmVoidPtr userData);
+
+        bool _check(MonitoredThread& thread, AmInt64 nowNs, ProfilerStallReport& report, bool& ended);
+        static void _readThreadState(ProfilerStallReport& report);
+        static void _readContextSwitches(AmUInt64 threadId, AmUInt64& voluntary, AmUInt64& involuntary);
+
+        MonitoredThread _threads[kMaxThreads];
+        AmReal64 _stallPeriods;
+        StallCallback _callback;
+
+        AmThreadHandle _thread;
+        std::atomic<bool> _running;
+        std::atomic<AmUInt64> _stallCount;
+
+        AmMutexHandle _mutex; // Protects registration and collection
+    };
+} // namespace SparkyStudios::Audio::Amplitude
+
+#endif // _AM_PROFILER_WATCHDOG_H
@@ -0,0 +1,191 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Aggregator.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+
+#include <cmath>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    ProfilerAggregator::ProfilerAggregator()
+        : _step(std::chrono::seconds(1))
+        , _stepCount(1)
+        , _currentStep(0)
+        , _filledSteps(0)
+        , _started(false)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerAggregator::~ProfilerAggregator()
+    {
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerAggregator::Configure(const std::vector<AmString>& fields, AmUInt32 windowMs, AmUInt32 stepMs)
+    {
+        if (stepMs == 0 || windowMs < stepMs || windowMs % stepMs != 0 || windowMs / stepMs > kMaxSteps)
+        {
+            amLogError(
+                "[ProfilerAggregator] Invalid window of %u ms with steps of %u ms (the step must divide the window, at most %u times)",
+                windowMs, stepMs, kMaxSteps);
+            return false;
+        }
+
+        std::vector<Stream> streams;
+        streams.reserve(fields.size());
+
+        for (const AmString& name : fields)
+        {
+            const AmInt32 field = ProfilerFilter::FindNumberField(name);
+            if (field < 0)
+            {
+                amLogError("[ProfilerAggregator] Unknown numeric field: %s", name.c_str());
+                return false;
+            }
+
+            Stream& stream = streams.emplace_back();
+            stream.mName = name;
+            stream.mField = field;
+            stream.mSteps.resize(windowMs / stepMs);
+        }
+
+        Thread::LockMutex(_mutex);
+
+        _streams = std::move(streams);
+        _step = std::chrono::duration_cast<ProfilerTime::duration>(std::chrono::milliseconds(stepMs));
+        _stepCount = windowMs / stepMs;
+        _currentStep = 0;
+        _filledSteps = 0;
+        _started = false;
+
+        Thread::UnlockMutex(_mutex);
+        return true;
+    }
+
+    void ProfilerAggregator::Clear()
+    {
+        Thread::LockMutex(_mutex);
+        _streams.clear();
+        _started = false;
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerAggregator::IsEmpty() const
+    {
+        Thread::LockMutex(_mutex);
+        const bool empty = _streams.empty();
+        Thread::UnlockMutex(_mutex);
+
+        return empty;
+    }
+
+    void ProfilerAggregator::Observe(const std::vector<ProfilerDataVariant>& messages)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (Stream& stream : _streams)
+        {
+            ProfilerHistogram& histogram = stream.mSteps[_currentStep];
+
+            for (const ProfilerDataVariant& message : messages)
+            {
+                // Aggregates are not aggregated again
+                if (std::holds_alternative<ProfilerAggregateData>(message))
+                    continue;
+
+                const AmReal64 value = ProfilerFilter::GetNumberField(stream.mField, message);
+                if (!std::isnan(value))
+                    histogram.Record(value);
+            }
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerAggregator::Update(ProfilerTime now, std::vector<ProfilerDataVariant>& output)
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_streams.empty())
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+        if (!_started)
+        {
+            _stepEnd = now + _step;
+            _started = true;
+        }
+
+        AmUInt32 closedSteps = 0;
+        while (now >= _stepEnd)
+        {
+            // After a whole window without updates every step is empty, skip the remaining idle time
+            if (closedSteps++ > _stepCount)
+            {
+                _stepEnd = now + _step;
+                break;
+            }
+
+            if (_filledSteps < _stepCount)
+                _filledSteps++;
+
+            _emit(output);
+
+            // The oldest step leaves the window and receives the next values
+            _currentStep = (_currentStep + 1) % _stepCount;
+            for (Stream& stream : _streams)
+                stream.mSteps[_currentStep].Reset();
+
+            _stepEnd += _step;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerAggregator::_emit(std::vector<ProfilerDataVariant>& output)
+    {
+        const AmReal64 windowSeconds = std::chrono::duration<AmReal64>(_step).count() * _filledSteps;
+
+        for (const Stream& stream : _streams)
+        {
+            _merged.Reset();
+
+            // The window is made of the current step and the ones closed before it
+            for (AmUInt32 i = 0; i < _filledSteps; ++i)
+                _merged.Merge(stream.mSteps[(_currentStep + _stepCount - i) % _stepCount]);
+
+            if (_merged.GetCount() == 0)
+                continue;
+
+            ProfilerAggregateData data;
+            data.mField = stream.mName;
+            data.mWindowSeconds = windowSeconds;
+            data.mCount = _merged.GetCount();
+            data.mMin = _merged.GetMin();
+            data.mMax = _merged.GetMax();
+            data.mMean = _merged.GetMean();
+            data.mP50 = _merged.GetPercentile(50.0);
+            data.mP95 = _merged.GetPercentile(95.0);
+            data.mP99 = _merged.GetPercentile(99.0);
+
+            output.emplace_back(std::move(data));
+        }
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,170 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Alert.h>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        AmInt64 GetTimestampNs(const ProfilerDataVariant& message)
+        {
+            return std::visit(
+                [](const auto& arg) -> AmInt64
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(arg.mTimestamp.time_since_epoch()).count();
+                },
+                message);
+        }
+    } // namespace
+
+    ProfilerAlertEvaluator::ProfilerAlertEvaluator()
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerAlertEvaluator::~ProfilerAlertEvaluator()
+    {
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerAlertEvaluator::Configure(const std::vector<ProfilerAlertRule>& rules, FireCallback callback)
+    {
+        std::vector<CompiledRule> compiled;
+        compiled.reserve(rules.size());
+
+        AmSize ringSize = 0;
+        bool success = true;
+
+        for (const ProfilerAlertRule& rule : rules)
+        {
+            CompiledRule& entry = compiled.emplace_back();
+
+            AmString error;
+            if (rule.mCount == 0 || !entry.mCondition.Compile(rule.mCondition, &error) || entry.mCondition.IsEmpty())
+            {
+                amLogError("[ProfilerAlertEvaluator] Skipping alert rule '%s': %s", rule.mName.c_str(), error.c_str());
+                compiled.pop_back();
+                success = false;
+                continue;
+            }
+
+            entry.mRule = rule;
+            entry.mRingOffset = ringSize;
+            entry.mMatches = 0;
+            entry.mRingHead = 0;
+            entry.mArmed = true;
+            entry.mCooldownEndNs = 0;
+            entry.mFireCount = 0;
+
+            if (rule.mWindowMs > 0)
+                ringSize += rule.mCount;
+        }
+
+        Thread::LockMutex(_mutex);
+
+        _rules = std::move(compiled);
+        _matchTimes.assign(ringSize, 0);
+        _callback = std::move(callback);
+
+        Thread::UnlockMutex(_mutex);
+        return success;
+    }
+
+    void ProfilerAlertEvaluator::Clear()
+    {
+        Thread::LockMutex(_mutex);
+
+        _rules.clear();
+        _matchTimes.clear();
+        _callback = nullptr;
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerAlertEvaluator::Evaluate(const std::vector<ProfilerDataVariant>& messages)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (const ProfilerDataVariant& message : messages)
+        {
+            if (const auto* event = std::get_if<ProfilerEvent>(&message); event != nullptr && event->mEventName == kEventName)
+                continue;
+
+            for (CompiledRule& rule : _rules)
+                _evaluate(rule, message);
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerAlertEvaluator::_evaluate(CompiledRule& rule, const ProfilerDataVariant& message)
+    {
+        // Messages without the compared fields neither match nor break a sequence of matches
+        if (!rule.mCondition.AppliesTo(message))
+            return;
+
+        const AmUInt32 count = rule.mRule.mCount;
+
+        if (!rule.mCondition.Evaluate(message))
+        {
+            rule.mArmed = true;
+            if (rule.mRule.mWindowMs == 0)
+                rule.mMatches = 0;
+
+            return;
+        }
+
+        const AmInt64 timestamp = GetTimestampNs(message);
+        bool triggered;
+
+        if (rule.mRule.mWindowMs == 0)
+        {
+            if (rule.mMatches < count)
+                rule.mMatches++;
+
+            triggered = rule.mMatches == count;
+        }
+        else
+        {
+            // Keep the timestamps of the latest matches, the rule triggers when the oldest one is still in the window
+            AmInt64* ring = _matchTimes.data() + rule.mRingOffset;
+
+            if (rule.mMatches < count)
+            {
+                ring[(rule.mRingHead + rule.mMatches) % count] = timestamp;
+                rule.mMatches++;
+            }
+            else
+            {
+                ring[rule.mRingHead] = timestamp;
+                rule.mRingHead = (rule.mRingHead + 1) % count;
+            }
+
+            triggered = rule.mMatches == count && timestamp - ring[rule.mRingHead] <= static_cast<AmInt64>(rule.mRule.mWindowMs) * 1000000;
+        }
+
+        if (!triggered || !rule.mArmed || timestamp < rule.mCooldownEndNs)
+            return;
+
+        rule.mArmed = false;
+        rule.mCooldownEndNs = timestamp + static_cast<AmInt64>(rule.mRule.mCooldownMs) * 1000000;
+        rule.mFireCount++;
+
+        if (_callback)
+            _callback(rule.mRule, message, rule.mFireCount);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
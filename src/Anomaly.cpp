@@ -0,0 +1,270 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Anomaly.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        // Deviations smaller than the slack do not accumulate in the CUSUM, in standard deviations
+        constexpr AmReal64 kCusumSlack = 0.5;
+
+        // Lower bounds of the standard deviation, so a series which was flat while learning is not
+        // reported on its first change. Levels are relative to the mean, growths to the level per second.
+        constexpr AmReal64 kMinLevelDeviation = 0.05;
+        constexpr AmReal64 kMinGrowthDeviation = 1e-4;
+
+        // Growth is measured between samples at least this far apart, so bursts are averaged out
+        constexpr AmInt64 kGrowthIntervalNs = 1000000000;
+
+        AmInt64 GetTimestampNs(const ProfilerDataVariant& message)
+        {
+            return std::visit(
+                [](const auto& arg) -> AmInt64
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(arg.mTimestamp.time_since_epoch()).count();
+                },
+                message);
+        }
+
+        AmString GetSceneName(const ProfilerEvent& event, std::unordered_map<AmString, AmUInt32>& occurrences)
+        {
+            if (const auto it = event.mParameters.find("scenario"); it != event.mParameters.end())
+                return it->second;
+
+            if (!event.mDescription.empty())
+                return event.mDescription;
+
+            return event.mEventName + "#" + std::to_string(occurrences[event.mEventName]++);
+        }
+    } // namespace
+
+    ProfilerAnomalyDetector::ProfilerAnomalyDetector()
+        : _baselines(nullptr)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerAnomalyDetector::~ProfilerAnomalyDetector()
+    {
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerAnomalyDetector::Configure(const ProfilerAnomalySettings& settings)
+    {
+        std::vector<Series> series;
+
+        const auto addSeries = [&series](const std::vector<AmString>& fields, bool growth)
+        {
+            for (const AmString& name : fields)
+            {
+                const AmInt32 field = ProfilerFilter::FindNumberField(name);
+                if (field < 0)
+                {
+                    amLogError("[ProfilerAnomalyDetector] Unknown numeric field: %s", name.c_str());
+                    return false;
+                }
+
+                series.push_back({ name, field, growth, 0.0, 0 });
+            }
+
+            return true;
+        };
+
+        if (!addSeries(settings.mFields, false) || !addSeries(settings.mGrowthFields, true))
+            return false;
+
+        Thread::LockMutex(_mutex);
+
+        _settings = settings;
+        _series = std::move(series);
+        _scenes.clear();
+        _markerOccurrences.clear();
+        _scene.clear();
+        _baselines = &_scenes[_scene];
+        _baselines->resize(_series.size());
+
+        Thread::UnlockMutex(_mutex);
+        return true;
+    }
+
+    void ProfilerAnomalyDetector::Clear()
+    {
+        Thread::LockMutex(_mutex);
+
+        _series.clear();
+        _scenes.clear();
+        _baselines = nullptr;
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerAnomalyDetector::Observe(const std::vector<ProfilerDataVariant>& messages, std::vector<ProfilerEvent>& events)
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_series.empty())
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+        for (const ProfilerDataVariant& message : messages)
+        {
+            if (const auto* event = std::get_if<ProfilerEvent>(&message))
+            {
+                if (!_settings.mSceneMarker.empty() && event->mEventName == _settings.mSceneMarker)
+                    _enterScene(GetSceneName(*event, _markerOccurrences));
+
+                continue;
+            }
+
+            for (AmSize i = 0, l = _series.size(); i < l; ++i)
+            {
+                Series& series = _series[i];
+
+                AmReal64 value = ProfilerFilter::GetNumberField(series.mField, message);
+                if (std::isnan(value))
+                    continue;
+
+                if (series.mGrowth)
+                {
+                    const AmInt64 timestamp = GetTimestampNs(message);
+
+                    if (series.mLastTimestampNs == 0)
+                    {
+                        series.mLastValue = value;
+                        series.mLastTimestampNs = timestamp;
+                        continue;
+                    }
+
+                    if (timestamp - series.mLastTimestampNs < kGrowthIntervalNs)
+                        continue;
+
+                    const AmReal64 level = value;
+                    value = (value - series.mLastValue) * 1e9 / static_cast<AmReal64>(timestamp - series.mLastTimestampNs);
+
+                    series.mLastValue = level;
+                    series.mLastTimestampNs = timestamp;
+                }
+
+                _observe(series, (*_baselines)[i], value, events);
+            }
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerAnomalyDetector::_enterScene(const AmString& scene)
+    {
+        if (scene == _scene)
+            return;
+
+        auto it = _scenes.find(scene);
+        if (it == _scenes.end())
+        {
+            if (_scenes.size() >= kMaxScenes)
+                return;
+
+            it = _scenes.emplace(scene, std::vector<Baseline>(_series.size())).first;
+        }
+
+        _scene = scene;
+        _baselines = &it->second;
+    }
+
+    void ProfilerAnomalyDetector::_observe(Series& series, Baseline& baseline, AmReal64 value, std::vector<ProfilerEvent>& events)
+    {
+        if (baseline.mSamples >= _settings.mWarmupSamples)
+        {
+            const AmReal64 floor =
+                series.mGrowth ? kMinGrowthDeviation * std::abs(series.mLastValue) : kMinLevelDeviation * std::abs(baseline.mMean);
+            const AmReal64 deviation = std::max({ std::sqrt(baseline.mVariance), floor, 1e-9 });
+
+            // Growth is expected to be zero, a steady growth is a leak even if it was there from the start
+            const AmReal64 score = (value - (series.mGrowth ? 0.0 : baseline.mMean)) / deviation;
+
+            if (!series.mGrowth)
+            {
+                const bool spiking = std::abs(score) > _settings.mSpikeThreshold;
+                if (spiking && !baseline.mSpiking)
+                    _report(series, baseline, "spike", value, score, events);
+
+                baseline.mSpiking = spiking;
+            }
+
+            // A single spike is clamped so it does not pass for a shift on its own
+            const AmReal64 clamped = std::clamp(score, -_settings.mSpikeThreshold, _settings.mSpikeThreshold);
+            baseline.mHigh = std::max(0.0, baseline.mHigh + clamped - kCusumSlack);
+            baseline.mLow = std::max(0.0, baseline.mLow - clamped - kCusumSlack);
+
+            // A shift is a change point, the baseline learns the new level from scratch instead of reporting it again
+            if (baseline.mHigh > _settings.mShiftThreshold)
+            {
+                _report(series, baseline, series.mGrowth ? "growth" : "shift_up", value, baseline.mHigh, events);
+                baseline = Baseline();
+            }
+            else if (baseline.mLow > _settings.mShiftThreshold)
+            {
+                // Memory going back down is not an anomaly
+                if (!series.mGrowth)
+                    _report(series, baseline, "shift_down", value, -baseline.mLow, events);
+
+                baseline = Baseline();
+            }
+
+            // Spikes are kept out of the baseline
+            if (baseline.mSpiking)
+                return;
+        }
+
+        // Exponentially weighted mean and variance, updated after the tests so an anomaly is measured against the past
+        if (baseline.mSamples++ == 0)
+        {
+            baseline.mMean = value;
+            baseline.mVariance = 0.0;
+        }
+        else
+        {
+            const AmReal64 difference = value - baseline.mMean;
+            const AmReal64 increment = _settings.mAlpha * difference;
+            baseline.mMean += increment;
+            baseline.mVariance = (1.0 - _settings.mAlpha) * (baseline.mVariance + difference * increment);
+        }
+    }
+
+    void ProfilerAnomalyDetector::_report(
+        const Series& series, const Baseline& baseline, const char* kind, AmReal64 value, AmReal64 score,
+        std::vector<ProfilerEvent>& events) const
+    {
+        ProfilerEvent& event = events.emplace_back(kEventName, series.mName + " " + kind);
+        event.mPriority = eProfilerPriority_High;
+        event.mParameters["field"] = series.mName;
+        event.mParameters["kind"] = kind;
+        event.mParameters["value"] = std::to_string(value);
+        event.mParameters["baseline_mean"] = std::to_string(baseline.mMean);
+        event.mParameters["baseline_stddev"] = std::to_string(std::sqrt(baseline.mVariance));
+        event.mParameters["score"] = std::to_string(score);
+
+        if (!_scene.empty())
+            event.mParameters["scene"] = _scene;
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,517 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/AsyncFile.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#if AM_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(AM_PROFILER_HAS_IO_URING)
+#include <liburing.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        constexpr std::intptr_t kInvalidFile = -1;
+
+        AmUInt64 GetSteadyTimeMs()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        AmSize AlignSize(AmSize size)
+        {
+            const AmSize alignment = ProfilerAsyncFileWriter::kBufferAlignment;
+            return std::max(alignment, (size + alignment - 1) / alignment * alignment);
+        }
+
+        void FreeBufferData(ProfilerAsyncFileWriter::Buffer& buffer)
+        {
+            if (buffer.mData != nullptr)
+                ::operator delete(buffer.mData, std::align_val_t(ProfilerAsyncFileWriter::kBufferAlignment));
+
+            buffer.mData = nullptr;
+            buffer.mCapacity = 0;
+        }
+    } // namespace
+
+    ProfilerAsyncFileWriter::ProfilerAsyncFileWriter()
+        : _file(kInvalidFile)
+        , _durability(eProfilerDurability_Interval)
+        , _syncIntervalMs(1000)
+        , _lastSyncMs(0)
+        , _dirty(false)
+        , _ioUring(false)
+        , _ring(nullptr)
+        , _inFlight(0)
+        , _running(false)
+        , _droppedCount(0)
+        , _failedCount(0)
+        , _writtenBytes(0)
+        , _mutex(Thread::CreateMutex())
+    {}
+
+    ProfilerAsyncFileWriter::~ProfilerAsyncFileWriter()
+    {
+        Close();
+        Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerAsyncFileWriter::Open(const AmOsString& path, eProfilerDurability durability, AmUInt32 syncIntervalMs, AmUInt32 bufferCount)
+    {
+        Close();
+
+#if AM_PLATFORM_WINDOWS
+        HANDLE handle = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            amLogError("[ProfilerAsyncFileWriter] Failed to create file (error %lu).", GetLastError());
+            return false;
+        }
+
+        _file = reinterpret_cast<std::intptr_t>(handle);
+#else
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            amLogError("[ProfilerAsyncFileWriter] Failed to create file '%s': %s.", path.c_str(), std::strerror(errno));
+            return false;
+        }
+
+        _file = fd;
+#endif
+
+        _durability = durability;
+        _syncIntervalMs = std::max<AmUInt32>(syncIntervalMs, 1);
+        _lastSyncMs.store(GetSteadyTimeMs(), std::memory_order_relaxed);
+        _dirty.store(false, std::memory_order_relaxed);
+
+        _droppedCount.store(0, std::memory_order_relaxed);
+        _failedCount.store(0, std::memory_order_relaxed);
+        _writtenBytes.store(0, std::memory_order_relaxed);
+        _inFlight.store(0, std::memory_order_relaxed);
+
+        // Buffer memory is allocated on first use, and then kept for the lifetime of the file
+        _buffers.resize(std::max<AmUInt32>(bufferCount, 2));
+        _free.clear();
+        _free.reserve(_buffers.size());
+        for (auto& buffer : _buffers)
+            _free.push_back(&buffer);
+
+        _running.store(true, std::memory_order_release);
+
+#if defined(AM_PROFILER_HAS_IO_URING)
+        auto* ring = new io_uring();
+        if (const int result = io_uring_queue_init(static_cast<unsigned>(_buffers.size()), ring, 0); result == 0)
+        {
+            _ring = ring;
+            _ioUring = true;
+            _threads.push_back(Thread::CreateThread(_ioUringLoop, this));
+        }
+        else
+        {
+            // io_uring may be disabled by the kernel or a seccomp policy
+            amLogWarning("[ProfilerAsyncFileWriter] io_uring is not available (%s), using positioned writes.", std::strerror(-result));
+            delete ring;
+        }
+#endif
+
+        if (!_ioUring)
+        {
+            for (AmUInt32 i = 0; i < kFallbackThreadCount; ++i)
+                _threads.push_back(Thread::CreateThread(_fallbackLoop, this));
+        }
+
+        return true;
+    }
+
+    void ProfilerAsyncFileWriter::Close()
+    {
+        if (!IsOpen())
+            return;
+
+        Drain();
+
+        _running.store(false, std::memory_order_release);
+        for (auto& thread : _threads)
+        {
+            Thread::Wait(thread);
+            Thread::Release(thread);
+        }
+
+        _threads.clear();
+
+        if (_durability != eProfilerDurability_None)
+            _syncFile();
+
+#if defined(AM_PROFILER_HAS_IO_URING)
+        if (_ioUring)
+        {
+            auto* ring = static_cast<io_uring*>(_ring);
+            io_uring_queue_exit(ring);
+            delete ring;
+        }
+#endif
+
+        _ring = nullptr;
+        _ioUring = false;
+
+#if AM_PLATFORM_WINDOWS
+        CloseHandle(reinterpret_cast<HANDLE>(_file));
+#else
+        ::close(static_cast<int>(_file));
+#endif
+
+        _file = kInvalidFile;
+
+        for (auto& buffer : _buffers)
+            FreeBufferData(buffer);
+
+        _buffers.clear();
+        _free.clear();
+        _submitted.clear();
+    }
+
+    bool ProfilerAsyncFileWriter::IsOpen() const
+    {
+        return _file != kInvalidFile;
+    }
+
+    ProfilerAsyncFileWriter::Buffer* ProfilerAsyncFileWriter::AcquireBuffer(AmSize size, bool wait)
+    {
+        if (!IsOpen())
+            return nullptr;
+
+        Buffer* buffer = nullptr;
+
+        while (true)
+        {
+            Thread::LockMutex(_mutex);
+            if (!_free.empty())
+            {
+                buffer = _free.back();
+                _free.pop_back();
+            }
+            Thread::UnlockMutex(_mutex);
+
+            if (buffer != nullptr)
+                break;
+
+            if (!wait)
+            {
+                _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Thread::Sleep(1);
+        }
+
+        if (buffer->mCapacity < size)
+        {
+            FreeBufferData(*buffer);
+
+            buffer->mCapacity = AlignSize(size);
+            buffer->mData = static_cast<AmUInt8*>(::operator new(buffer->mCapacity, std::align_val_t(kBufferAlignment)));
+        }
+
+        buffer->mSize = size;
+        buffer->mOffset = 0;
+
+        return buffer;
+    }
+
+    void ProfilerAsyncFileWriter::Submit(Buffer* buffer, AmUInt64 offset)
+    {
+        if (buffer == nullptr)
+            return;
+
+        buffer->mOffset = offset;
+        _inFlight.fetch_add(1, std::memory_order_acq_rel);
+
+        Thread::LockMutex(_mutex);
+        _submitted.push_back(buffer);
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerAsyncFileWriter::Drain()
+    {
+        while (_inFlight.load(std::memory_order_acquire) > 0)
+            Thread::Sleep(1);
+    }
+
+    void ProfilerAsyncFileWriter::Sync()
+    {
+        if (!IsOpen())
+            return;
+
+        Drain();
+        _syncFile();
+    }
+
+    const char* ProfilerAsyncFileWriter::GetBackendName() const
+    {
+        return _ioUring ? "io_uring" : "pwrite";
+    }
+
+    void ProfilerAsyncFileWriter::_fallbackLoop(AmVoidPtr userData)
+    {
+        auto* writer = static_cast<ProfilerAsyncFileWriter*>(userData);
+
+        while (true)
+        {
+            if (Buffer* buffer = writer->_popSubmitted(); buffer != nullptr)
+            {
+                const bool success = writer->_writeAll(*buffer);
+                if (success && writer->_durability == eProfilerDurability_Always)
+                    writer->_syncFile();
+
+                writer->_release(buffer, success);
+                continue;
+            }
+
+            if (writer->_shouldSync())
+                writer->_syncFile();
+
+            if (!writer->_running.load(std::memory_order_acquire))
+                break;
+
+            Thread::Sleep(1);
+        }
+    }
+
+    void ProfilerAsyncFileWriter::_ioUringLoop(AmVoidPtr userData)
+    {
+#if defined(AM_PROFILER_HAS_IO_URING)
+        auto* writer = static_cast<ProfilerAsyncFileWriter*>(userData);
+        auto* ring = static_cast<io_uring*>(writer->_ring);
+        const int fd = static_cast<int>(writer->_file);
+
+        // The ring has as many entries as there are buffers, so a submission queue entry is always available
+        AmSize pending = 0;
+        bool failed = false; // Set when the ring cannot submit anymore, writes are then made synchronously
+        std::vector<Buffer*> unsubmitted; // Prepared entries the kernel has not consumed yet, in submission order
+        std::vector<std::pair<Buffer*, bool>> completed;
+        unsubmitted.reserve(writer->_buffers.size());
+        completed.reserve(writer->_buffers.size());
+
+        while (true)
+        {
+            while (Buffer* buffer = writer->_popSubmitted())
+            {
+                io_uring_sqe* sqe = failed ? nullptr : io_uring_get_sqe(ring);
+                if (sqe == nullptr)
+                {
+                    writer->_release(buffer, writer->_writeAll(*buffer));
+                    continue;
+                }
+
+                io_uring_prep_write(sqe, fd, buffer->mData, static_cast<unsigned>(buffer->mSize), buffer->mOffset);
+                io_uring_sqe_set_data(sqe, buffer);
+
+                ++pending;
+                unsubmitted.push_back(buffer);
+            }
+
+            if (!unsubmitted.empty())
+            {
+                // Entries the kernel did not consume stay in the submission queue, and are submitted again by the next call
+                const int submitted = io_uring_submit(ring);
+                if (submitted >= 0)
+                {
+                    unsubmitted.erase(unsubmitted.begin(), unsubmitted.begin() + std::min<AmSize>(submitted, unsubmitted.size()));
+                }
+                else if (submitted != -EAGAIN && submitted != -EBUSY && submitted != -EINTR)
+                {
+                    // The ring is never submitted again, so its remaining entries can be written here without being written twice
+                    amLogError(
+                        "[ProfilerAsyncFileWriter] Failed to submit to io_uring (%s), using positioned writes.", std::strerror(-submitted));
+
+                    for (Buffer* buffer : unsubmitted)
+                        writer->_release(buffer, writer->_writeAll(*buffer));
+
+                    pending -= unsubmitted.size();
+                    unsubmitted.clear();
+                    failed = true;
+                }
+            }
+
+            if (pending == 0)
+            {
+                if (writer->_shouldSync())
+                    writer->_syncFile();
+
+                if (!writer->_running.load(std::memory_order_acquire))
+                    break;
+
+                Thread::Sleep(1);
+                continue;
+            }
+
+            io_uring_cqe* cqe = nullptr;
+            __kernel_timespec timeout = { 0, 1000000 };
+            io_uring_wait_cqe_timeout(ring, &cqe, &timeout);
+
+            completed.clear();
+            while (io_uring_peek_cqe(ring, &cqe) == 0)
+            {
+                auto* buffer = static_cast<Buffer*>(io_uring_cqe_get_data(cqe));
+                const int result = cqe->res;
+                io_uring_cqe_seen(ring, cqe);
+                --pending;
+
+                bool success = result >= 0;
+                if (success && static_cast<AmSize>(result) < buffer->mSize)
+                {
+                    // Short write, finish the remaining bytes synchronously
+                    Buffer remaining;
+                    remaining.mData = buffer->mData + result;
+                    remaining.mSize = buffer->mSize - result;
+                    remaining.mOffset = buffer->mOffset + result;
+                    success = writer->_writeAll(remaining);
+                }
+
+                completed.emplace_back(buffer, success);
+            }
+
+            // Completions are synced in groups, one sync covers every write completed before it
+            if (writer->_durability == eProfilerDurability_Always && !completed.empty())
+                writer->_syncFile();
+            else if (writer->_shouldSync())
+                writer->_syncFile();
+
+            for (const auto& [buffer, success] : completed)
+                writer->_release(buffer, success);
+        }
+#else
+        AM_UNUSED(userData);
+#endif
+    }
+
+    ProfilerAsyncFileWriter::Buffer* ProfilerAsyncFileWriter::_popSubmitted()
+    {
+        Buffer* buffer = nullptr;
+
+        Thread::LockMutex(_mutex);
+        if (!_submitted.empty())
+        {
+            buffer = _submitted.front();
+            _submitted.pop_front();
+        }
+        Thread::UnlockMutex(_mutex);
+
+        return buffer;
+    }
+
+    void ProfilerAsyncFileWriter::_release(Buffer* buffer, bool success)
+    {
+        if (success)
+        {
+            _writtenBytes.fetch_add(buffer->mSize, std::memory_order_relaxed);
+            _dirty.store(true, std::memory_order_release);
+        }
+        else
+        {
+            _failedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Thread::LockMutex(_mutex);
+        _free.push_back(buffer);
+        Thread::UnlockMutex(_mutex);
+
+        _inFlight.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    bool ProfilerAsyncFileWriter::_writeAll(const Buffer& buffer) const
+    {
+        const AmUInt8* data = buffer.mData;
+        AmUInt64 offset = buffer.mOffset;
+        AmSize remaining = buffer.mSize;
+
+        while (remaining > 0)
+        {
+#if AM_PLATFORM_WINDOWS
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFull);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            DWORD written = 0;
+            const auto toWrite = static_cast<DWORD>(std::min<AmSize>(remaining, 1u << 30));
+            if (!WriteFile(reinterpret_cast<HANDLE>(_file), data, toWrite, &written, &overlapped) || written == 0)
+            {
+                amLogError("[ProfilerAsyncFileWriter] Failed to write to file (error %lu).", GetLastError());
+                return false;
+            }
+#else
+            const ssize_t written = ::pwrite(static_cast<int>(_file), data, remaining, static_cast<off_t>(offset));
+            if (written < 0 && errno == EINTR)
+                continue;
+
+            if (written <= 0)
+            {
+                amLogError("[ProfilerAsyncFileWriter] Failed to write to file: %s.", std::strerror(errno));
+                return false;
+            }
+#endif
+
+            data += written;
+            offset += written;
+            remaining -= written;
+        }
+
+        return true;
+    }
+
+    void ProfilerAsyncFileWriter::_syncFile() const
+    {
+#if AM_PLATFORM_WINDOWS
+        FlushFileBuffers(reinterpret_cast<HANDLE>(_file));
+#elif AM_PLATFORM_LINUX
+        fdatasync(static_cast<int>(_file));
+#else
+        fsync(static_cast<int>(_file));
+#endif
+    }
+
+    bool ProfilerAsyncFileWriter::_shouldSync()
+    {
+        if (_durability != eProfilerDurability_Interval || !_dirty.load(std::memory_order_acquire))
+            return false;
+
+        const AmUInt64 now = GetSteadyTimeMs();
+        AmUInt64 last = _lastSyncMs.load(std::memory_order_relaxed);
+        if (now - last < _syncIntervalMs)
+            return false;
+
+        // Only one of the writing threads claims the sync
+        if (!_lastSyncMs.compare_exchange_strong(last, now, std::memory_order_acq_rel))
+            return false;
+
+        _dirty.store(false, std::memory_order_release);
+        return true;
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -15,6 +15,8 @@
 #include <SparkyStudios/Audio/Amplitude/IO/File.h>
 #include <SparkyStudios/Audio/Amplitude/IO/Log.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Config.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LockProfiler.h>
 
 #include <json/reader.h>
 #include <json/writer.h>
@@ -55,6 +57,143 @@ namespace SparkyStudios::Audio::Amplitude
             return eProfilerUpdateMode_Timed;
         }
 
+        AmString CompressionToString(eProfilerRecordingCompression compression)
+        {
+            switch (compression)
+            {
+            case eProfilerRecordingCompression_None:
+                return "none";
+            case eProfilerRecordingCompression_Zstd:
+                return "zstd";
+            case eProfilerRecordingCompression_LZ4:
+                return "lz4";
+            default:
+                return "none";
+            }
+        }
+
+        eProfilerRecordingCompression StringToCompression(const AmString& str)
+        {
+            if (str == "zstd")
+                return eProfilerRecordingCompression_Zstd;
+            if (str == "lz4")
+                return eProfilerRecordingCompression_LZ4;
+            return eProfilerRecordingCompression_None;
+        }
+
+        AmString DurabilityToString(eProfilerDurability durability)
+        {
+            switch (durability)
+            {
+            case eProfilerDurability_None:
+                return "none";
+            case eProfilerDurability_Interval:
+                return "interval";
+            case eProfilerDurability_Always:
+                return "always";
+            default:
+                return "interval";
+            }
+        }
+
+        eProfilerDurability StringToDurability(const AmString& str)
+        {
+            if (str == "none")
+                return eProfilerDurability_None;
+            if (str == "always")
+                return eProfilerDurability_Always;
+            return eProfilerDurability_Interval;
+        }
+
+        Json::Value AlertActionsToJson(AmUInt32 actions)
+        {
+            Json::Value json(Json::arrayValue);
+            if (actions & eProfilerAlertAction_Event)
+                json.append("event");
+            if (actions & eProfilerAlertAction_Dump)
+                json.append("dump");
+            if (actions & eProfilerAlertAction_Boost)
+                json.append("boost");
+            return json;
+        }
+
+        AmUInt32 JsonToAlertActions(const Json::Value& json)
+        {
+            AmUInt32 actions = eProfilerAlertAction_None;
+            for (const Json::Value& action : json)
+            {
+                const AmString name = action.asString();
+                if (name == "event")
+                    actions |= eProfilerAlertAction_Event;
+                else if (name == "dump")
+                    actions |= eProfilerAlertAction_Dump;
+                else if (name == "boost")
+                    actions |= eProfilerAlertAction_Boost;
+                else
+                    amLogWarning("[ProfilerConfig] Unknown alert action: %s", name.c_str());
+            }
+            return actions;
+        }
+
+        Json::Value MemoryResidencyToJson(AmUInt32 residency)
+        {
+            Json::Value json(Json::arrayValue);
+            if (residency & eProfilerMemoryResidency_Prefault)
+                json.append("prefault");
+            if (residency & eProfilerMemoryResidency_Lock)
+                json.append("lock");
+            if (residency & eProfilerMemoryResidency_HugePages)
+                json.append("huge_pages");
+            return json;
+        }
+
+        AmUInt32 JsonToMemoryResidency(const Json::Value& json)
+        {
+            AmUInt32 residency = eProfilerMemoryResidency_None;
+            for (const Json::Value& mode : json)
+            {
+                const AmString name = mode.asString();
+                if (name == "prefault")
+                    residency |= eProfilerMemoryResidency_Prefault;
+                else if (name == "lock")
+                    residency |= eProfilerMemoryResidency_Lock;
+                else if (name == "huge_pages")
+                    residency |= eProfilerMemoryResidency_HugePages;
+                else
+                    amLogWarning("[ProfilerConfig] Unknown memory residency: %s", name.c_str());
+            }
+            return residency;
+        }
+
+        ProfilerAlertRule JsonToAlertRule(const Json::Value& json)
+        {
+            ProfilerAlertRule rule;
+            rule.mName = json.get("name", rule.mName).asString();
+            rule.mCondition = json.get("condition", rule.mCondition).asString();
+            rule.mCount = json.get("count", rule.mCount).asUInt();
+            rule.mWindowMs = json.get("window_ms", rule.mWindowMs).asUInt();
+            rule.mCooldownMs = json.get("cooldown_ms", rule.mCooldownMs).asUInt();
+            if (json.isMember("actions"))
+                rule.mActions = JsonToAlertActions(json["actions"]);
+            rule.mBoostFrequencyHz = json.get("boost_frequency_hz", rule.mBoostFrequencyHz).asFloat();
+            rule.mBoostDurationMs = json.get("boost_duration_ms", rule.mBoostDurationMs).asUInt();
+            return rule;
+        }
+
+        Json::Value AlertRuleToJson(const ProfilerAlertRule& rule)
+        {
+            Json::Value json(Json::objectValue);
+            json["name"] = rule.mName;
+            json["condition"] = rule.mCondition;
+            json["count"] = rule.mCount;
+            json["window_ms"] = rule.mWindowMs;
+            json["cooldown_ms"] = rule.mCooldownMs;
+            json["actions"] = AlertActionsToJson(rule.mActions);
+            json["boost_frequency_hz"] = rule.mBoostFrequencyHz;
+            json["boost_duration_ms"] = rule.mBoostDurationMs;
+            return json;
+        }
+
         AmString LogLevelToString(eLogMessageLevel level)
         {
             switch (level)
@@ -122,6 +261,18 @@ namespace SparkyStudios::Audio::Amplitude
         mServerPort = static_cast<AmUInt16>(json.get("server_port", mServerPort).asUInt());
         mMaxClients = static_cast<AmUInt32>(json.get("max_clients", mMaxClients).asUInt());
         mBindAddress = json.get("bind_address", mBindAddress).asString();
+        mClientMaxMessagesPerSecond = static_cast<AmUInt32>(json.get("client_max_messages_per_second", mClientMaxMessagesPerSecond).asUInt());
+        mClientMaxBytesPerSecond = static_cast<AmUInt32>(json.get("client_max_bytes_per_second", mClientMaxBytesPerSecond).asUInt());
+        mNetworkBusyThreshold = static_cast<AmUInt32>(json.get("network_busy_threshold", mNetworkBusyThreshold).asUInt());
+        mEnableSharedMemoryTransport = json.get("enable_shared_memory_transport", mEnableSharedMemoryTransport).asBool();
+        mSharedMemoryName = json.get("shared_memory_name", mSharedMemoryName).asString();
+        mSharedMemorySize = static_cast<AmUInt32>(json.get("shared_memory_size", mSharedMemorySize).asUInt());
+        mEnableMulticast = json.get("enable_multicast", mEnableMulticast).asBool();
+        mMulticastGroup = json.get("multicast_group", mMulticastGroup).asString();
+        mMulticastPort = static_cast<AmUInt16>(json.get("multicast_port", mMulticastPort).asUInt());
+        mMulticastTtl = static_cast<AmUInt8>(json.get("multicast_ttl", mMulticastTtl).asUInt());
+        mMulticastMtu = static_cast<AmUInt32>(json.get("multicast_mtu", mMulticastMtu).asUInt());
+        mMulticastKeyframeInterval = json.get("multicast_keyframe_interval", mMulticastKeyframeInterval).asFloat();
 
         // Load update settings
         mUpdateMode = StringToUpdateMode(json.get("update_mode", UpdateModeToString(mUpdateMode)).asString());
@@ -141,6 +292,102 @@ namespace SparkyStudios::Audio::Amplitude
         mMessageBufferSize = static_cast<AmUInt32>(json.get("message_buffer_size", mMessageBufferSize).asUInt());
         mMaxQueuedMessages = static_cast<AmUInt32>(json.get("max_queued_messages", mMaxQueuedMessages).asUInt());
         mUseCompressionForNetwork = json.get("use_compression_for_network", mUseCompressionForNetwork).asBool();
+        mSelfStatsIntervalMs = json.get("self_stats_interval_ms", mSelfStatsIntervalMs).asUInt();
+
+        // Load memory settings
+        if (const Json::Value& residency = json["memory_residency"]; residency.isArray())
+            mMemoryResidency = JsonToMemoryResidency(residency);
+        mExpectedEntityCount = json.get("expected_entity_count", mExpectedEntityCount).asUInt();
+        mExpectedChannelCount = json.get("expected_channel_count", mExpectedChannelCount).asUInt();
+        mExpectedListenerCount = json.get("expected_listener_count", mExpectedListenerCount).asUInt();
+        mRealtimeRingCapacity = json.get("realtime_ring_capacity", mRealtimeRingCapacity).asUInt();
+
+        // Load recording settings
+        mEnableRecording = json.get("enable_recording", mEnableRecording).asBool();
+        mRecordingPath = json.get("recording_path", mRecordingPath).asString();
+        mRecordingChunkSize = static_cast<AmUInt32>(json.get("recording_chunk_size", mRecordingChunkSize).asUInt());
+        mRecordingCompression = StringToCompression(json.get("recording_compression", CompressionToString(mRecordingCompression)).asString());
+        mRecordingCompressionThreads =
+            static_cast<AmUInt32>(json.get("recording_compression_threads", mRecordingCompressionThreads).asUInt());
+        mRecordingDurability = StringToDurability(json.get("recording_durability", DurabilityToString(mRecordingDurability)).asString());
+        mRecordingSyncIntervalMs = static_cast<AmUInt32>(json.get("recording_sync_interval_ms", mRecordingSyncIntervalMs).asUInt());
+        mRecordingWriteBuffers = static_cast<AmUInt32>(json.get("recording_write_buffers", mRecordingWriteBuffers).asUInt());
+
+        // Load flight recorder settings
+        mEnableFlightRecorder = json.get("enable_flight_recorder", mEnableFlightRecorder).asBool();
+        mFlightRecorderSize = static_cast<AmUInt32>(json.get("flight_recorder_size", mFlightRecorderSize).asUInt());
+        mFlightRecorderCrashPath = json.get("flight_recorder_crash_path", mFlightRecorderCrashPath).asString();
+
+        // Load watchdog settings
+        mEnableWatchdog = json.get("enable_watchdog", mEnableWatchdog).asBool();
+        mWatchdogStallPeriods = json.get("watchdog_stall_periods", mWatchdogStallPeriods).asFloat();
+        mWatchdogMaxDumps = static_cast<AmUInt32>(json.get("watchdog_max_dumps", mWatchdogMaxDumps).asUInt());
+        mWatchdogDumpPath = json.get("watchdog_dump_path", mWatchdogDumpPath).asString();
+
+        // Load aggregation settings
+        mEnableAggregation = json.get("enable_aggregation", mEnableAggregation).asBool();
+        if (const Json::Value& fields = json["aggregate_fields"]; fields.isArray())
+        {
+            mAggregateFields.clear();
+            for (const Json::Value& field : fields)
+                mAggregateFields.push_back(field.asString());
+        }
+        mAggregateWindowMs = json.get("aggregate_window_ms", mAggregateWindowMs).asUInt();
+        mAggregateStepMs = json.get("aggregate_step_ms", mAggregateStepMs).asUInt();
+
+        // Load alert settings
+        if (const Json::Value& rules = json["alert_rules"]; rules.isArray())
+        {
+            mAlertRules.clear();
+            for (const Json::Value& rule : rules)
+                mAlertRules.push_back(JsonToAlertRule(rule));
+        }
+        mAlertMaxDumps = json.get("alert_max_dumps", mAlertMaxDumps).asUInt();
+        mAlertDumpPath = json.get("alert_dump_path", mAlertDumpPath).asString();
+
+        // Load anomaly detection settings
+        mEnableAnomalyDetection = json.get("enable_anomaly_detection", mEnableAnomalyDetection).asBool();
+        if (const Json::Value& fields = json["anomaly_fields"]; fields.isArray())
+        {
+            mAnomalyFields.clear();
+            for (const Json::Value& field : fields)
+                mAnomalyFields.push_back(field.asString());
+        }
+        if (const Json::Value& fields = json["anomaly_growth_fields"]; fields.isArray())
+        {
+            mAnomalyGrowthFields.clear();
+            for (const Json::Value& field : fields)
+                mAnomalyGrowthFields.push_back(field.asString());
+        }
+        mAnomalySceneMarker = json.get("anomaly_scene_marker", mAnomalySceneMarker).asString();
+        mAnomalyAlpha = json.get("anomaly_alpha", mAnomalyAlpha).asFloat();
+        mAnomalyWarmupSamples = json.get("anomaly_warmup_samples", mAnomalyWarmupSamples).asUInt();
+        mAnomalySpikeThreshold = json.get("anomaly_spike_threshold", mAnomalySpikeThreshold).asFloat();
+        mAnomalyShiftThreshold = json.get("anomaly_shift_threshold", mAnomalyShiftThreshold).asFloat();
+
+        // Load lock profiling settings
+        mEnableLockProfiling = json.get("enable_lock_profiling", mEnableLockProfiling).asBool();
+        mLockStatsIntervalMs = json.get("lock_stats_interval_ms", mLockStatsIntervalMs).asUInt();
+        mLockStatsTopCount = json.get("lock_stats_top_count", mLockStatsTopCount).asUInt();
+
+        // Load job system settings
+        mEnableJobProfiling = json.get("enable_job_profiling", mEnableJobProfiling).asBool();
+        mEnableJobTimeline = json.get("enable_job_timeline", mEnableJobTimeline).asBool();
+
+        // Load stack sampling settings
+        mEnableStackSampling = json.get("enable_stack_sampling", mEnableStackSampling).asBool();
+        mStackSamplingRateHz = json.get("stack_sampling_rate_hz", mStackSamplingRateHz).asUInt();
+        mStackSamplingIntervalMs = json.get("stack_sampling_interval_ms", mStackSamplingIntervalMs).asUInt();
+        mStackSamplingMaxStacks = json.get("stack_sampling_max_stacks", mStackSamplingMaxStacks).asUInt();
+
+        // Load performance counters settings
+        mEnablePerfCounters = json.get("enable_perf_counters", mEnablePerfCounters).asBool();
+        mPerfCountersIntervalMs = json.get("perf_counters_interval_ms", mPerfCountersIntervalMs).asUInt();
+
+        // Load level metering settings
+        mEnableLevelMetering = json.get("enable_level_metering", mEnableLevelMetering).asBool();
+        mLevelMeteringIntervalMs = json.get("level_metering_interval_ms", mLevelMeteringIntervalMs).asUInt();
+        mLevelMeteringBufferMs = json.get("level_metering_buffer_ms", mLevelMeteringBufferMs).asUInt();
 
         // Load filtering settings
         mPositionChangeThreshold = json.get("position_change_threshold", mPositionChangeThreshold).asFloat();
@@ -151,6 +398,7 @@ namespace SparkyStudios::Audio::Amplitude
         mEnableLogging = json.get("enable_logging", mEnableLogging).asBool();
         mLoggingLevel = StringToLogLevel(json.get("logging_level", LogLevelToString(mLoggingLevel)).asString());
         mLogFilePath = json.get("log_file_path", mLogFilePath).asString();
+        mLogRateLimit = json.get("log_rate_limit", mLogRateLimit).asUInt();
 
         amLogInfo("[ProfilerConfig] Configuration loaded successfully from: %s", configFile.c_str());
         return true;
@@ -165,6 +413,18 @@ namespace SparkyStudios::Audio::Amplitude
         json["server_port"] = mServerPort;
         json["max_clients"] = mMaxClients;
         json["bind_address"] = mBindAddress;
+        json["client_max_messages_per_second"] = mClientMaxMessagesPerSecond;
+        json["client_max_bytes_per_second"] = mClientMaxBytesPerSecond;
+        json["network_busy_threshold"] = mNetworkBusyThreshold;
+        json["enable_shared_memory_transport"] = mEnableSharedMemoryTransport;
+        json["shared_memory_name"] = mSharedMemoryName;
+        json["shared_memory_size"] = mSharedMemorySize;
+        json["enable_multicast"] = mEnableMulticast;
+        json["multicast_group"] = mMulticastGroup;
+        json["multicast_port"] = mMulticastPort;
+        json["multicast_ttl"] = mMulticastTtl;
+        json["multicast_mtu"] = mMulticastMtu;
+        json["multicast_keyframe_interval"] = mMulticastKeyframeInterval;
 
         // Save update settings
         json["update_mode"] = UpdateModeToString(mUpdateMode);
@@ -184,6 +444,88 @@ namespace SparkyStudios::Audio::Amplitude
         json["message_buffer_size"] = mMessageBufferSize;
         json["max_queued_messages"] = mMaxQueuedMessages;
         json["use_compression_for_network"] = mUseCompressionForNetwork;
+        json["self_stats_interval_ms"] = mSelfStatsIntervalMs;
+
+        // Save memory settings
+        json["memory_residency"] = MemoryResidencyToJson(mMemoryResidency);
+        json["expected_entity_count"] = mExpectedEntityCount;
+        json["expected_channel_count"] = mExpectedChannelCount;
+        json["expected_listener_count"] = mExpectedListenerCount;
+        json["realtime_ring_capacity"] = mRealtimeRingCapacity;
+
+        // Save recording settings
+        json["enable_recording"] = mEnableRecording;
+        json["recording_path"] = mRecordingPath;
+        json["recording_chunk_size"] = mRecordingChunkSize;
+        json["recording_compression"] = CompressionToString(mRecordingCompression);
+        json["recording_compression_threads"] = mRecordingCompressionThreads;
+        json["recording_durability"] = DurabilityToString(mRecordingDurability);
+        json["recording_sync_interval_ms"] = mRecordingSyncIntervalMs;
+        json["recording_write_buffers"] = mRecordingWriteBuffers;
+
+        // Save flight recorder settings
+        json["enable_flight_recorder"] = mEnableFlightRecorder;
+        json["flight_recorder_size"] = mFlightRecorderSize;
+        json["flight_recorder_crash_path"] = mFlightRecorderCrashPath;
+
+        // Save watchdog settings
+        json["enable_watchdog"] = mEnableWatchdog;
+        json["watchdog_stall_periods"] = mWatchdogStallPeriods;
+        json["watchdog_max_dumps"] = mWatchdogMaxDumps;
+        json["watchdog_dump_path"] = mWatchdogDumpPath;
+
+        // Save aggregation settings
+        json["enable_aggregation"] = mEnableAggregation;
+        json["aggregate_fields"] = Json::arrayValue;
+        for (const AmString& field : mAggregateFields)
+            json["aggregate_fields"].append(field);
+        json["aggregate_window_ms"] = mAggregateWindowMs;
+        json["aggregate_step_ms"] = mAggregateStepMs;
+
+        // Save alert settings
+        json["alert_rules"] = Json::arrayValue;
+        for (const ProfilerAlertRule& rule : mAlertRules)
+            json["alert_rules"].append(AlertRuleToJson(rule));
+        json["alert_max_dumps"] = mAlertMaxDumps;
+        json["alert_dump_path"] = mAlertDumpPath;
+
+        // Save anomaly detection settings
+        json["enable_anomaly_detection"] = mEnableAnomalyDetection;
+        json["anomaly_fields"] = Json::arrayValue;
+        for (const AmString& field : mAnomalyFields)
+            json["anomaly_fields"].append(field);
+        json["anomaly_growth_fields"] = Json::arrayValue;
+        for (const AmString& field : mAnomalyGrowthFields)
+            json["anomaly_growth_fields"].append(field);
+        json["anomaly_scene_marker"] = mAnomalySceneMarker;
+        json["anomaly_alpha"] = mAnomalyAlpha;
+        json["anomaly_warmup_samples"] = mAnomalyWarmupSamples;
+        json["anomaly_spike_threshold"] = mAnomalySpikeThreshold;
+        json["anomaly_shift_threshold"] = mAnomalyShiftThreshold;
+
+        // Save lock profiling settings
+        json["enable_lock_profiling"] = mEnableLockProfiling;
+        json["lock_stats_interval_ms"] = mLockStatsIntervalMs;
+        json["lock_stats_top_count"] = mLockStatsTopCount;
+
+        // Save job system settings
+        json["enable_job_profiling"] = mEnableJobProfiling;
+        json["enable_job_timeline"] = mEnableJobTimeline;
+
+        // Save stack sampling settings
+        json["enable_stack_sampling"] = mEnableStackSampling;
+        json["stack_sampling_rate_hz"] = mStackSamplingRateHz;
+        json["stack_sampling_interval_ms"] = mStackSamplingIntervalMs;
+        json["stack_sampling_max_stacks"] = mStackSamplingMaxStacks;
+
+        // Save performance counters settings
+        json["enable_perf_counters"] = mEnablePerfCounters;
+        json["perf_counters_interval_ms"] = mPerfCountersIntervalMs;
+
+        // Save level metering settings
+        json["enable_level_metering"] = mEnableLevelMetering;
+        json["level_metering_interval_ms"] = mLevelMeteringIntervalMs;
+        json["level_metering_buffer_ms"] = mLevelMeteringBufferMs;
 
         // Save filtering settings
         json["position_change_threshold"] = mPositionChangeThreshold;
@@ -194,6 +536,7 @@ namespace SparkyStudios::Audio::Amplitude
         json["enable_logging"] = mEnableLogging;
         json["logging_level"] = LogLevelToString(mLoggingLevel);
         json["log_file_path"] = mLogFilePath;
+        json["log_rate_limit"] = mLogRateLimit;
 
         // Write to file
         std::ofstream file(configFile);
@@ -263,6 +606,186 @@ namespace SparkyStudios::Audio::Amplitude
             return false;
         }
 
+        if (mRealtimeRingCapacity < 16 || mRealtimeRingCapacity > 65536)
+        {
+            amLogError("[ProfilerConfig] Invalid real-time ring capacity: %d (must be 16-65536)", mRealtimeRingCapacity);
+            return false;
+        }
+
+        // Validate recording settings
+        if (mEnableRecording && mRecordingPath.empty())
+        {
+            amLogError("[ProfilerConfig] Recording path cannot be empty when recording is enabled");
+            return false;
+        }
+
+        if (mEnableRecording && mRecordingChunkSize < 4096)
+        {
+            amLogError("[ProfilerConfig] Recording chunk size too small: %d (minimum 4096 bytes)", mRecordingChunkSize);
+            return false;
+        }
+
+        if (mEnableRecording && mRecordingWriteBuffers < 2)
+        {
+            amLogError("[ProfilerConfig] Invalid recording write buffers: %d (minimum 2)", mRecordingWriteBuffers);
+            return false;
+        }
+
+        if (mEnableRecording && mRecordingDurability == eProfilerDurability_Interval && mRecordingSyncIntervalMs == 0)
+        {
+            amLogError("[ProfilerConfig] Recording sync interval cannot be 0 with the interval durability");
+            return false;
+        }
+
+        // Validate flight recorder settings
+        if (mEnableFlightRecorder && mFlightRecorderSize < 64 * 1024)
+        {
+            amLogError("[ProfilerConfig] Flight recorder size too small: %d (minimum 65536 bytes)", mFlightRecorderSize);
+            return false;
+        }
+
+        // Validate watchdog settings
+        if (mEnableWatchdog && (mWatchdogStallPeriods < 1.0f || mWatchdogStallPeriods > 1000.0f))
+        {
+            amLogError("[ProfilerConfig] Invalid watchdog stall periods: %f (must be 1-1000)", mWatchdogStallPeriods);
+            return false;
+        }
+
+        // Validate aggregation settings
+        if (mEnableAggregation)
+        {
+            if (mAggregateStepMs == 0 || mAggregateWindowMs < mAggregateStepMs || mAggregateWindowMs % mAggregateStepMs != 0 ||
+                mAggregateWindowMs / mAggregateStepMs > 60)
+            {
+                amLogError(
+                    "[ProfilerConfig] Invalid aggregate window: %u ms with steps of %u ms (the step must divide it, at most 60 times)",
+                    mAggregateWindowMs, mAggregateStepMs);
+                return false;
+            }
+
+            for (const AmString& field : mAggregateFields)
+            {
+                if (ProfilerFilter::FindNumberField(field) < 0)
+                {
+                    amLogError("[ProfilerConfig] Unknown aggregate field: %s", field.c_str());
+                    return false;
+                }
+            }
+        }
+
+        // Validate alert settings
+        for (const ProfilerAlertRule& rule : mAlertRules)
+        {
+            if (rule.mName.empty())
+            {
+                amLogError("[ProfilerConfig] Alert rules must have a name");
+                return false;
+            }
+
+            AmString error = "empty expression";
+            if (ProfilerFilter filter; rule.mCondition.empty() || !filter.Compile(rule.mCondition, &error))
+            {
+                amLogError("[ProfilerConfig] Invalid condition for alert rule '%s': %s", rule.mName.c_str(), error.c_str());
+                return false;
+            }
+
+            if (rule.mCount == 0 || rule.mCount > 1024)
+            {
+                amLogError("[ProfilerConfig] Invalid count for alert rule '%s': %u (must be 1-1024)", rule.mName.c_str(), rule.mCount);
+                return false;
+            }
+
+            if ((rule.mActions & eProfilerAlertAction_Boost) && rule.mBoostFrequencyHz <= 0.0f)
+            {
+                amLogError(
+                    "[ProfilerConfig] Invalid boost frequency for alert rule '%s': %f", rule.mName.c_str(), rule.mBoostFrequencyHz);
+                return false;
+            }
+        }
+
+        // Validate anomaly detection settings
+        if (mEnableAnomalyDetection)
+        {
+            if (mAnomalyAlpha <= 0.0f || mAnomalyAlpha > 1.0f)
+            {
+                amLogError("[ProfilerConfig] Invalid anomaly alpha: %f (must be in ]0, 1])", mAnomalyAlpha);
+                return false;
+            }
+
+            if (mAnomalySpikeThreshold <= 0.0f || mAnomalyShiftThreshold <= 0.0f)
+            {
+                amLogError(
+                    "[ProfilerConfig] Invalid anomaly thresholds: spike %f, shift %f (must be positive)", mAnomalySpikeThreshold,
+                    mAnomalyShiftThreshold);
+                return false;
+            }
+
+            for (const auto* fields : { &mAnomalyFields, &mAnomalyGrowthFields })
+            {
+                for (const AmString& field : *fields)
+                {
+                    if (ProfilerFilter::FindNumberField(field) < 0)
+                    {
+                        amLogError("[ProfilerConfig] Unknown anomaly field: %s", field.c_str());
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // Validate lock profiling settings
+        if (mEnableLockProfiling && (mLockStatsTopCount == 0 || mLockStatsTopCount > ProfilerLockProfiler::kMaxLocks))
+        {
+            amLogError(
+                "[ProfilerConfig] Invalid lock stats top count: %d (must be 1-%d)", mLockStatsTopCount, ProfilerLockProfiler::kMaxLocks);
+            return false;
+        }
+
+        // Validate stack sampling settings
+        if (mEnableStackSampling)
+        {
+            if (mStackSamplingRateHz == 0 || mStackSamplingRateHz > 10000)
+            {
+                amLogError("[ProfilerConfig] Invalid stack sampling rate: %d Hz (must be 1-10000)", mStackSamplingRateHz);
+                return false;
+            }
+
+            if (mStackSamplingIntervalMs == 0)
+            {
+                amLogError("[ProfilerConfig] Invalid stack sampling interval: %d ms (must be greater than 0)", mStackSamplingIntervalMs);
+                return false;
+            }
+
+            if (mStackSamplingMaxStacks == 0)
+            {
+                amLogError("[ProfilerConfig] Invalid stack sampling max stacks: %d (must be greater than 0)", mStackSamplingMaxStacks);
+                return false;
+            }
+        }
+
+        // Validate performance counters settings
+        if (mEnablePerfCounters && mPerfCountersIntervalMs == 0)
+        {
+            amLogError("[ProfilerConfig] Invalid perf counters interval: %d ms (must be greater than 0)", mPerfCountersIntervalMs);
+            return false;
+        }
+
+        // Validate level metering settings
+        if (mEnableLevelMetering)
+        {
+            if (mLevelMeteringIntervalMs == 0)
+            {
+                amLogError("[ProfilerConfig] Invalid level metering interval: %d ms (must be greater than 0)", mLevelMeteringIntervalMs);
+                return false;
+            }
+
+            if (mLevelMeteringBufferMs == 0 || mLevelMeteringBufferMs > 10000)
+            {
+                amLogError("[ProfilerConfig] Invalid level metering buffer: %d ms (must be 1-10000)", mLevelMeteringBufferMs);
+                return false;
+            }
+        }
+
         // Validate filtering settings
         if (mPositionChangeThreshold < 0.0f || mPositionChangeThreshold > 1000.0f)
         {
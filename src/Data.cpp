@@ -13,6 +13,8 @@
 
 #include <SparkyStudios/Audio/Amplitude/Profiler/Data.h>
 
+#include <cmath>
+
 namespace SparkyStudios::Audio::Amplitude
 {
     std::atomic<ProfilerMessageID> ProfilerDataSnapshot::_sMessageIdCounter{ 0 };
@@ -22,6 +24,7 @@ namespace SparkyStudios::Audio::Amplitude
         , mMessageId(GenerateMessageId())
         , mCategory(eProfilerCategory_Engine)
         , mPriority(eProfilerPriority_Normal)
+        , mSourceId(0)
     {}
 
     ProfilerMessageID ProfilerDataSnapshot::GenerateMessageId()
@@ -96,4 +99,48 @@ namespace SparkyStudios::Audio::Amplitude
         mActiveThreadCount = 0;
     }
 
+    AmSize ProfilerThreadScheduling::GetLatencyBucket(AmUInt64 latencyNs)
+    {
+        const AmUInt64 latencyUs = latencyNs / 1000;
+        return std::min<AmSize>(std::bit_width(latencyUs), kLatencyBucketCount - 1);
+    }
+
+    AmReal64 ProfilerThreadScheduling::GetLatencyBucketUpperBoundMs(AmSize bucket)
+    {
+        // Bucket b counts latencies below 2^b microseconds
+        return static_cast<AmReal64>(AmUInt64(1) << std::min(bucket, kLatencyBucketCount - 1)) / 1000.0;
+    }
+
+    AmReal64 ProfilerThreadScheduling::GetLatencyPercentileMs(AmReal64 percentile) const
+    {
+        AmUInt64 total = 0;
+        for (const AmUInt32 count : mLatencyBuckets)
+            total += count;
+
+        if (total == 0)
+            return 0.0;
+
+        const AmReal64 clamped = std::clamp(percentile, 0.0, 100.0);
+        const auto rank = std::max<AmUInt64>(1, static_cast<AmUInt64>(std::ceil(clamped / 100.0 * static_cast<AmReal64>(total))));
+
+        AmUInt64 cumulative = 0;
+        for (AmSize i = 0; i < kLatencyBucketCount; ++i)
+        {
+            cumulative += mLatencyBuckets[i];
+            if (cumulative >= rank)
+                return std::min(GetLatencyBucketUpperBoundMs(i), static_cast<AmReal64>(mLatencyMaxMs));
+        }
+
+        return mLatencyMaxMs;
+    }
+
+    ProfilerAggregateData::ProfilerAggregateData()
+    {
+        mCategory = eProfilerCategory_Aggregate;
+        mWindowSeconds = 0.0;
+        mCount = 0;
+        mMin = mMax = mMean = 0.0;
+        mP50 = mP95 = mP99 = 0.0;
+    }
+
 } // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,968 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        constexpr AmReal64 kMissingNumber = std::numeric_limits<AmReal64>::quiet_NaN();
+
+        // Three-valued truth used while evaluating: a comparison on a field the message does not have is neutral.
+        constexpr AmUInt8 kFalse = 0;
+        constexpr AmUInt8 kTrue = 1;
+        constexpr AmUInt8 kNeutral = 2;
+
+        constexpr AmUInt8 kAndTable[3][3] = { { kFalse, kFalse, kFalse }, { kFalse, kTrue, kTrue }, { kFalse, kTrue, kNeutral } };
+        constexpr AmUInt8 kOrTable[3][3] = { { kFalse, kTrue, kFalse }, { kTrue, kTrue, kTrue }, { kFalse, kTrue, kNeutral } };
+        constexpr AmUInt8 kNotTable[3] = { kTrue, kFalse, kNeutral };
+
+        template<typename T, typename... Ts>
+        constexpr AmInt32 VariantIndexOf(const std::variant<Ts...>*)
+        {
+            AmInt32 index = 0;
+            AmInt32 result = -1;
+            ((std::is_same_v<T, Ts> ? (result = index, ++index) : ++index), ...);
+            return result;
+        }
+
+        template<typename T>
+        constexpr AmInt32 kTypeIndex = VariantIndexOf<T>(static_cast<const ProfilerDataVariant*>(nullptr));
+
+        const std::array<AmString, 7> kTypeNames = { "engine", "entity", "channel", "listener", "performance", "event", "aggregate" };
+        static_assert(std::variant_size_v<ProfilerDataVariant> == 7, "Update kTypeNames when adding profiler data types");
+
+        // Scheduling fields are reported for the worst audio thread, so one late thread is enough to match
+        AmReal64 GetWorstScheduling(const ProfilerPerformanceData& data, AmReal32 ProfilerThreadScheduling::*field)
+        {
+            AmReal64 worst = 0.0;
+            for (const auto& [thread, scheduling] : data.mThreadScheduling)
+                worst = std::max(worst, static_cast<AmReal64>(scheduling.*field));
+
+            return worst;
+        }
+
+        AmReal64 GetInvoluntarySwitches(const ProfilerPerformanceData& data)
+        {
+            AmReal64 total = 0.0;
+            for (const auto& [thread, scheduling] : data.mThreadScheduling)
+                total += scheduling.mInvoluntarySwitches;
+
+            return total;
+        }
+
+        enum eFieldKind : AmUInt8
+        {
+            eFieldKind_Number,
+            eFieldKind_String
+        };
+
+        struct FieldDescriptor
+        {
+            const char* mName;
+            AmInt32 mTypeIndex; // -1 when the field exists on every message
+            eFieldKind mKind;
+            AmReal64 (*mNumber)(const ProfilerDataVariant&);
+            const AmString* (*mString)(const ProfilerDataVariant&);
+        };
+
+#define AM_FILTER_COMMON_NUMBER(name, expr)                                                                                                \
+    FieldDescriptor                                                                                                                        \
+    {                                                                                                                                      \
+        name, -1, eFieldKind_Number,                                                                                                       \
+            [](const ProfilerDataVariant& v) -> AmReal64                                                                                   \
+        {                                                                                                                                  \
+            return std::visit(                                                                                                             \
+                [](const auto& d) -> AmReal64                                                                                              \
+                {                                                                                                                          \
+                    return static_cast<AmReal64>(expr);                                                                                    \
+                },                                                                                                                         \
+                v);                                                                                                                        \
+        },                                                                                                                                 \
+            nullptr                                                                                                                        \
+    }
+
+#define AM_FILTER_NUMBER(name, T, expr)                                                                                                    \
+    FieldDescriptor                                                                                                                        \
+    {                                                                                                                                      \
+        name, kTypeIndex<T>, eFieldKind_Number,                                                                                            \
+            [](const ProfilerDataVariant& v) -> AmReal64                                                                                   \
+        {                                                                                                                                  \
+            const T* d = std::get_if<T>(&v);                                                                                               \
+            return d ? static_cast<AmReal64>(expr) : kMissingNumber;                                                                       \
+        },                                                                                                                                 \
+            nullptr                                                                                                                        \
+    }
+
+#define AM_FILTER_STRING(name, T, expr)                                                                                                    \
+    FieldDescriptor                                                                                                                        \
+    {                                                                                                                                      \
+        name, kTypeIndex<T>, eFieldKind_String, nullptr, [](const ProfilerDataVariant& v) -> const AmString*                               \
+        {                                                                                                                                  \
+            const T* d = std::get_if<T>(&v);                                                                                               \
+            return d ? &(expr) : nullptr;                                                                                                  \
+        }                                                                                                                                  \
+    }
+
+        const FieldDescriptor kFields[] = {
+            // Common fields
+            AM_FILTER_COMMON_NUMBER(
+                "timestamp", std::chrono::duration_cast<std::chrono::microseconds>(d.mTimestamp.time_since_epoch()).count()),
+            AM_FILTER_COMMON_NUMBER("messageId", d.mMessageId),
+            AM_FILTER_COMMON_NUMBER("category", d.mCategory),
+            AM_FILTER_COMMON_NUMBER("priority", d.mPriority),
+            AM_FILTER_COMMON_NUMBER("source", d.mSourceId),
+            FieldDescriptor{ "type", -1, eFieldKind_String, nullptr,
+                             [](const ProfilerDataVariant& v) -> const AmString*
+                             {
+                                 return &kTypeNames[v.index()];
+                             } },
+
+            // Engine fields
+            AM_FILTER_NUMBER("engine.uptime", ProfilerEngineData, d->mEngineUptime),
+            AM_FILTER_NUMBER("engine.cpu", ProfilerEngineData, d->mCpuUsagePercent),
+            AM_FILTER_NUMBER("engine.memory", ProfilerEngineData, d->mMemoryUsageBytes),
+            AM_FILTER_NUMBER("engine.voices", ProfilerEngineData, d->mActiveVoiceCount),
+            AM_FILTER_NUMBER("engine.maxVoices", ProfilerEngineData, d->mMaxVoiceCount),
+            AM_FILTER_NUMBER("engine.entities", ProfilerEngineData, d->mActiveEntityCount),
+            AM_FILTER_NUMBER("engine.channels", ProfilerEngineData, d->mActiveChannelCount),
+            AM_FILTER_NUMBER("engine.listeners", ProfilerEngineData, d->mActiveListenerCount),
+            AM_FILTER_NUMBER("engine.sampleRate", ProfilerEngineData, d->mSampleRate),
+            AM_FILTER_NUMBER("engine.masterGain", ProfilerEngineData, d->mMasterGain),
+
+            // Entity fields
+            AM_FILTER_NUMBER("entity.id", ProfilerEntityData, d->mEntityId),
+            AM_FILTER_NUMBER("entity.x", ProfilerEntityData, d->mPosition[0]),
+            AM_FILTER_NUMBER("entity.y", ProfilerEntityData, d->mPosition[1]),
+            AM_FILTER_NUMBER("entity.z", ProfilerEntityData, d->mPosition[2]),
+            AM_FILTER_NUMBER("entity.channels", ProfilerEntityData, d->mActiveChannelCount),
+            AM_FILTER_NUMBER("entity.distance", ProfilerEntityData, d->mDistanceToListener),
+            AM_FILTER_NUMBER("entity.obstruction", ProfilerEntityData, d->mObstruction),
+            AM_FILTER_NUMBER("entity.occlusion", ProfilerEntityData, d->mOcclusion),
+            AM_FILTER_NUMBER("entity.directivity", ProfilerEntityData, d->mDirectivity),
+            AM_FILTER_NUMBER("entity.azimuth", ProfilerEntityData, d->mAzimuth),
+            AM_FILTER_NUMBER("entity.elevation", ProfilerEntityData, d->mElevation),
+            AM_FILTER_NUMBER("entity.attenuation", ProfilerEntityData, d->mAttenuationFactor),
+
+            // Channel fields
+            AM_FILTER_NUMBER("channel.id", ProfilerChannelData, d->mChannelId),
+            AM_FILTER_NUMBER("channel.state", ProfilerChannelData, d->mPlaybackState),
+            AM_FILTER_NUMBER("channel.entity", ProfilerChannelData, d->mSourceEntityId),
+            AM_FILTER_STRING("channel.sound", ProfilerChannelData, d->mSoundName),
+            AM_FILTER_STRING("channel.soundBank", ProfilerChannelData, d->mSoundBankName),
+            AM_FILTER_STRING("channel.collection", ProfilerChannelData, d->mCollectionName),
+            AM_FILTER_NUMBER("channel.position", ProfilerChannelData, d->mPlaybackPosition),
+            AM_FILTER_NUMBER("channel.duration", ProfilerChannelData, d->mTotalDuration),
+            AM_FILTER_NUMBER("channel.gain", ProfilerChannelData, d->mGain),
+            AM_FILTER_NUMBER("channel.x", ProfilerChannelData, d->mPosition[0]),
+            AM_FILTER_NUMBER("channel.y", ProfilerChannelData, d->mPosition[1]),
+            AM_FILTER_NUMBER("channel.z", ProfilerChannelData, d->mPosition[2]),
+            AM_FILTER_NUMBER("channel.distance", ProfilerChannelData, d->mDistanceToListener),
+            AM_FILTER_NUMBER("channel.doppler", ProfilerChannelData, d->mDopplerFactor),
+            AM_FILTER_NUMBER("channel.occlusion", ProfilerChannelData, d->mOcclusionFactor),
+            AM_FILTER_NUMBER("channel.obstruction", ProfilerChannelData, d->mObstructionFactor),
+
+            // Listener fields
+            AM_FILTER_NUMBER("listener.id", ProfilerListenerData, d->mListenerId),
+            AM_FILTER_NUMBER("listener.x", ProfilerListenerData, d->mPosition[0]),
+            AM_FILTER_NUMBER("listener.y", ProfilerListenerData, d->mPosition[1]),
+            AM_FILTER_NUMBER("listener.z", ProfilerListenerData, d->mPosition[2]),
+            AM_FILTER_NUMBER("listener.gain", ProfilerListenerData, d->mGain),
+            AM_FILTER_STRING("listener.environment", ProfilerListenerData, d->mCurrentEnvironment),
+
+            // Performance fields
+            AM_FILTER_NUMBER("performance.cpu", ProfilerPerformanceData, d->mTotalCpuUsage),
+            AM_FILTER_NUMBER("performance.mixerCpu", ProfilerPerformanceData, d->mMixerCpuUsage),
+            AM_FILTER_NUMBER("performance.dspCpu", ProfilerPerformanceData, d->mDspCpuUsage),
+            AM_FILTER_NUMBER("performance.streamingCpu", ProfilerPerformanceData, d->mStreamingCpuUsage),
+            AM_FILTER_NUMBER("performance.memory", ProfilerPerformanceData, d->mTotalAllocatedMemory),
+            AM_FILTER_NUMBER("performance.underruns", ProfilerPerformanceData, d->mUnderruns),
+            AM_FILTER_NUMBER("performance.overruns", ProfilerPerformanceData, d->mOverruns),
+            AM_FILTER_NUMBER("performance.latency", ProfilerPerformanceData, d->mLatencyMs),
+            AM_FILTER_NUMBER("performance.threads", ProfilerPerformanceData, d->mActiveThreadCount),
+            AM_FILTER_NUMBER("performance.wakeupLatencyP50", ProfilerPerformanceData,
+                             GetWorstScheduling(*d, &ProfilerThreadScheduling::mLatencyP50Ms)),
+            AM_FILTER_NUMBER("performance.wakeupLatencyP99", ProfilerPerformanceData,
+                             GetWorstScheduling(*d, &ProfilerThreadScheduling::mLatencyP99Ms)),
+            AM_FILTER_NUMBER("performance.wakeupLatencyMax", ProfilerPerformanceData,
+                             GetWorstScheduling(*d, &ProfilerThreadScheduling::mLatencyMaxMs)),
+            AM_FILTER_NUMBER("performance.involuntarySwitches", ProfilerPerformanceData, GetInvoluntarySwitches(*d)),
+
+            // Event fields
+            AM_FILTER_STRING("event.name", ProfilerEvent, d->mEventName),
+            AM_FILTER_STRING("event.description", ProfilerEvent, d->mDescription),
+
+            // Aggregate fields
+            AM_FILTER_STRING("aggregate.field", ProfilerAggregateData, d->mField),
+            AM_FILTER_NUMBER("aggregate.window", ProfilerAggregateData, d->mWindowSeconds),
+            AM_FILTER_NUMBER("aggregate.count", ProfilerAggregateData, d->mCount),
+            AM_FILTER_NUMBER("aggregate.min", ProfilerAggregateData, d->mMin),
+            AM_FILTER_NUMBER("aggregate.max", ProfilerAggregateData, d->mMax),
+            AM_FILTER_NUMBER("aggregate.mean", ProfilerAggregateData, d->mMean),
+            AM_FILTER_NUMBER("aggregate.p50", ProfilerAggregateData, d->mP50),
+            AM_FILTER_NUMBER("aggregate.p95", ProfilerAggregateData, d->mP95),
+            AM_FILTER_NUMBER("aggregate.p99", ProfilerAggregateData, d->mP99),
+        };
+
+#undef AM_FILTER_COMMON_NUMBER
+#undef AM_FILTER_NUMBER
+#undef AM_FILTER_STRING
+
+        constexpr AmSize kFieldCount = sizeof(kFields) / sizeof(kFields[0]);
+
+        AmInt32 FindField(std::string_view name)
+        {
+            for (AmSize i = 0; i < kFieldCount; ++i)
+            {
+                if (name == kFields[i].mName)
+                    return static_cast<AmInt32>(i);
+            }
+
+            return -1;
+        }
+
+        bool GlobMatch(const AmString& text, const AmString& pattern)
+        {
+            AmSize t = 0, p = 0;
+            AmSize starPattern = AmString::npos, starText = 0;
+
+            while (t < text.size())
+            {
+                if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+                {
+                    ++t;
+                    ++p;
+                }
+                else if (p < pattern.size() && pattern[p] == '*')
+                {
+                    starPattern = p++;
+                    starText = t;
+                }
+                else if (starPattern != AmString::npos)
+                {
+                    p = starPattern + 1;
+                    t = ++starText;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            while (p < pattern.size() && pattern[p] == '*')
+                ++p;
+
+            return p == pattern.size();
+        }
+
+        AmUInt8 CompareNumbers(eProfilerFilterOpCode op, AmReal64 a, AmReal64 b)
+        {
+            if (std::isnan(a) || std::isnan(b))
+                return kNeutral;
+
+            switch (op)
+            {
+            case eProfilerFilterOpCode_Equal:
+                return a == b;
+            case eProfilerFilterOpCode_NotEqual:
+                return a != b;
+            case eProfilerFilterOpCode_Less:
+                return a < b;
+            case eProfilerFilterOpCode_LessEqual:
+                return a <= b;
+            case eProfilerFilterOpCode_Greater:
+                return a > b;
+            case eProfilerFilterOpCode_GreaterEqual:
+                return a >= b;
+            default:
+                return kNeutral;
+            }
+        }
+
+        AmUInt8 CompareStrings(eProfilerFilterOpCode op, const AmString* a, const AmString* b)
+        {
+            if (a == nullptr || b == nullptr)
+                return kNeutral;
+
+            switch (op)
+            {
+            case eProfilerFilterOpCode_StringEqual:
+                return *a == *b;
+            case eProfilerFilterOpCode_StringNotEqual:
+                return *a != *b;
+            case eProfilerFilterOpCode_Match:
+                return GlobMatch(*a, *b);
+            case eProfilerFilterOpCode_NotMatch:
+                return !GlobMatch(*a, *b);
+            default:
+                return kNeutral;
+            }
+        }
+
+        enum eTokenType : AmUInt8
+        {
+            eTokenType_End,
+            eTokenType_Identifier,
+            eTokenType_Number,
+            eTokenType_String,
+            eTokenType_Operator,
+            eTokenType_LeftParen,
+            eTokenType_RightParen
+        };
+
+        struct Token
+        {
+            eTokenType mType = eTokenType_End;
+            AmString mText;
+            AmReal64 mNumber = 0.0;
+        };
+
+        class Compiler
+        {
+        public:
+            Compiler(
+                const AmString& source,
+                std::vector<ProfilerFilterInstruction>& program,
+                std::vector<AmReal64>& numbers,
+                std::vector<AmString>& strings,
+                AmUInt32& typeMask)
+                : _source(source)
+                , _program(program)
+                , _numbers(numbers)
+                , _strings(strings)
+                , _typeMask(typeMask)
+            {}
+
+            bool Run(AmString& error)
+            {
+                if (!Next() || !ParseOr())
+                {
+                    error = _error;
+                    return false;
+                }
+
+                if (_token.mType != eTokenType_End)
+                {
+                    error = "Unexpected token '" + _token.mText + "' at offset " + std::to_string(_tokenStart);
+                    return false;
+                }
+
+                return true;
+            }
+
+        private:
+            struct Operand
+            {
+                bool mIsField = false;
+                eFieldKind mKind = eFieldKind_Number;
+                AmInt32 mField = -1;
+                AmReal64 mNumber = 0.0;
+                AmString mString;
+            };
+
+            bool Fail(const AmString& message)
+            {
+                if (_error.empty())
+                    _error = message + " at offset " + std::to_string(_tokenStart);
+
+                return false;
+            }
+
+            bool Next()
+            {
+                while (_position < _source.size() && std::isspace(static_cast<unsigned char>(_source[_position])))
+                    ++_position;
+
+                _tokenStart = _position;
+                _token = Token();
+
+                if (_position >= _source.size())
+                    return true;
+
+                const char c = _source[_position];
+
+                if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+                {
+                    const AmSize start = _position;
+                    while (_position < _source.size() &&
+                           (std::isalnum(static_cast<unsigned char>(_source[_position])) || _source[_position] == '_' ||
+                            _source[_position] == '.'))
+                        ++_position;
+
+                    _token.mText = _source.substr(start, _position - start);
+
+                    if (_token.mText == "and")
+                        _token = { eTokenType_Operator, "&&" };
+                    else if (_token.mText == "or")
+                        _token = { eTokenType_Operator, "||" };
+                    else if (_token.mText == "not")
+                        _token = { eTokenType_Operator, "!" };
+                    else
+                        _token.mType = eTokenType_Identifier;
+
+                    return true;
+                }
+
+                if (std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && _position + 1 < _source.size()))
+                {
+                    const char* begin = _source.c_str() + _position;
+                    char* end = nullptr;
+                    _token.mNumber = std::strtod(begin, &end);
+
+                    if (end == begin)
+                        return Fail("Invalid number");
+
+                    _position += static_cast<AmSize>(end - begin);
+                    _token.mType = eTokenType_Number;
+                    _token.mText = AmString(begin, static_cast<AmSize>(end - begin));
+                    return true;
+                }
+
+                if (c == '"' || c == '\'')
+                {
+                    ++_position;
+                    while (_position < _source.size() && _source[_position] != c)
+                    {
+                        if (_source[_position] == '\\' && _position + 1 < _source.size())
+                            ++_position;
+
+                        _token.mText += _source[_position++];
+                    }
+
+                    if (_position >= _source.size())
+                        return Fail("Unterminated string");
+
+                    ++_position;
+                    _token.mType = eTokenType_String;
+                    return true;
+                }
+
+                if (c == '(' || c == ')')
+                {
+                    ++_position;
+                    _token.mType = c == '(' ? eTokenType_LeftParen : eTokenType_RightParen;
+                    _token.mText = AmString(1, c);
+                    return true;
+                }
+
+                static const char* kOperators[] = { "&&", "||", "==", "!=", "<=", ">=", "!~", "<", ">", "~", "!", "-" };
+                for (const char* op : kOperators)
+                {
+                    if (_source.compare(_position, std::strlen(op), op) == 0)
+                    {
+                        _position += std::strlen(op);
+                        _token.mType = eTokenType_Operator;
+                        _token.mText = op;
+                        return true;
+                    }
+                }
+
+                return Fail("Unexpected character '" + AmString(1, c) + "'");
+            }
+
+            bool IsOperator(const char* op) const
+            {
+                return _token.mType == eTokenType_Operator && _token.mText == op;
+            }
+
+            bool Emit(eProfilerFilterOpCode op, AmSize operand, AmInt32 stackDelta)
+            {
+                if (operand > std::numeric_limits<AmUInt16>::max())
+                    return Fail("Filter expression is too large");
+
+                _depth += stackDelta;
+                if (_depth > static_cast<AmInt32>(ProfilerFilter::kMaxStackDepth))
+                    return Fail("Filter expression is nested too deeply");
+
+                _program.push_back({ op, static_cast<AmUInt16>(operand) });
+                return true;
+            }
+
+            // Parsing recurses once per parenthesis and negation, which the stack depth of the program does not bound
+            bool EnterNesting()
+            {
+                if (++_nesting > ProfilerFilter::kMaxStackDepth)
+                    return Fail("Expression nested too deeply");
+
+                return true;
+            }
+
+            bool ParseOr()
+            {
+                if (!EnterNesting() || !ParseAnd())
+                    return false;
+
+                while (IsOperator("||"))
+                {
+                    if (!Next() || !ParseAnd() || !Emit(eProfilerFilterOpCode_Or, 0, -1))
+                        return false;
+                }
+
+                --_nesting;
+                return true;
+            }
+
+            bool ParseAnd()
+            {
+                if (!ParseUnary())
+                    return false;
+
+                while (IsOperator("&&"))
+                {
+                    if (!Next() || !ParseUnary() || !Emit(eProfilerFilterOpCode_And, 0, -1))
+                        return false;
+                }
+
+                return true;
+            }
+
+            bool ParseUnary()
+            {
+                if (!EnterNesting())
+                    return false;
+
+                if (IsOperator("!"))
+                {
+                    if (!Next() || !ParseUnary() || !Emit(eProfilerFilterOpCode_Not, 0, 0))
+                        return false;
+                }
+                else if (_token.mType == eTokenType_LeftParen)
+                {
+                    if (!Next() || !ParseOr())
+                        return false;
+
+                    if (_token.mType != eTokenType_RightParen)
+                        return Fail("Expected ')'");
+
+                    if (!Next())
+                        return false;
+                }
+                else if (!ParseComparison())
+                {
+                    return false;
+                }
+
+                --_nesting;
+                return true;
+            }
+
+            bool ParseOperand(Operand& operand)
+            {
+                bool negate = false;
+                if (IsOperator("-"))
+                {
+                    negate = true;
+                    if (!Next())
+                        return false;
+
+                    if (_token.mType != eTokenType_Number)
+                        return Fail("Expected a number after '-'");
+                }
+
+                switch (_token.mType)
+                {
+                case eTokenType_Identifier:
+                    {
+                        operand.mField = FindField(_token.mText);
+                        if (operand.mField < 0)
+                            return Fail("Unknown field '" + _token.mText + "'");
+
+                        const FieldDescriptor& field = kFields[operand.mField];
+                        operand.mIsField = true;
+                        operand.mKind = field.mKind;
+                        _typeMask |= field.mTypeIndex < 0 ? ~0u : (1u << field.mTypeIndex);
+                        break;
+                    }
+                case eTokenType_Number:
+                    operand.mKind = eFieldKind_Number;
+                    operand.mNumber = negate ? -_token.mNumber : _token.mNumber;
+                    break;
+                case eTokenType_String:
+                    operand.mKind = eFieldKind_String;
+                    operand.mString = _token.mText;
+                    break;
+                default:
+                    return Fail("Expected a field, a number or a string");
+                }
+
+                return Next();
+            }
+
+            bool EmitOperand(const Operand& operand)
+            {
+                if (operand.mIsField)
+                {
+                    return Emit(
+                        operand.mKind == eFieldKind_Number ? eProfilerFilterOpCode_LoadNumber : eProfilerFilterOpCode_LoadString,
+                        static_cast<AmSize>(operand.mField), 1);
+                }
+
+                if (operand.mKind == eFieldKind_Number)
+                {
+                    _numbers.push_back(operand.mNumber);
+                    return Emit(eProfilerFilterOpCode_PushNumber, _numbers.size() - 1, 1);
+                }
+
+                _strings.push_back(operand.mString);
+                return Emit(eProfilerFilterOpCode_PushString, _strings.size() - 1, 1);
+            }
+
+            bool ParseComparison()
+            {
+                Operand lhs, rhs;
+                if (!ParseOperand(lhs))
+                    return false;
+
+                if (_token.mType != eTokenType_Operator)
+                    return Fail("Expected a comparison operator");
+
+                const AmString op = _token.mText;
+                if (!Next() || !ParseOperand(rhs))
+                    return false;
+
+                if (!lhs.mIsField && !rhs.mIsField)
+                    return Fail("Comparison must reference at least one field");
+
+                if (lhs.mKind != rhs.mKind)
+                    return Fail("Cannot compare a number with a string");
+
+                eProfilerFilterOpCode code;
+                if (lhs.mKind == eFieldKind_Number)
+                {
+                    if (op == "==")
+                        code = eProfilerFilterOpCode_Equal;
+                    else if (op == "!=")
+                        code = eProfilerFilterOpCode_NotEqual;
+                    else if (op == "<")
+                        code = eProfilerFilterOpCode_Less;
+                    else if (op == "<=")
+                        code = eProfilerFilterOpCode_LessEqual;
+                    else if (op == ">")
+                        code = eProfilerFilterOpCode_Greater;
+                    else if (op == ">=")
+                        code = eProfilerFilterOpCode_GreaterEqual;
+                    else
+                        return Fail("Operator '" + op + "' is not valid on numbers");
+                }
+                else
+                {
+                    if (op == "==")
+                        code = eProfilerFilterOpCode_StringEqual;
+                    else if (op == "!=")
+                        code = eProfilerFilterOpCode_StringNotEqual;
+                    else if ((op == "~" || op == "!~") && lhs.mIsField && !rhs.mIsField)
+                        code = op == "~" ? eProfilerFilterOpCode_Match : eProfilerFilterOpCode_NotMatch;
+                    else
+                        return Fail("Operator '" + op + "' is not valid on strings");
+                }
+
+                return EmitOperand(lhs) && EmitOperand(rhs) && Emit(code, 0, -1);
+            }
+
+            const AmString& _source;
+            std::vector<ProfilerFilterInstruction>& _program;
+            std::vector<AmReal64>& _numbers;
+            std::vector<AmString>& _strings;
+            AmUInt32& _typeMask;
+
+            AmSize _position = 0;
+            AmSize _tokenStart = 0;
+            AmInt32 _depth = 0;
+            AmSize _nesting = 0;
+            Token _token;
+            AmString _error;
+        };
+    } // namespace
+
+    ProfilerFilter::ProfilerFilter()
+        : _typeMask(~0u)
+    {}
+
+    bool ProfilerFilter::Compile(const AmString& expression, AmString* error)
+    {
+        std::vector<ProfilerFilterInstruction> program;
+        std::vector<AmReal64> numbers;
+        std::vector<AmString> strings;
+        AmUInt32 typeMask = 0;
+
+        AmString compileError;
+        Compiler compiler(expression, program, numbers, strings, typeMask);
+
+        if (!compiler.Run(compileError))
+        {
+            amLogWarning("[ProfilerFilter] Failed to compile filter '%s': %s", expression.c_str(), compileError.c_str());
+
+            if (error)
+                *error = compileError;
+
+            return false;
+        }
+
+        _expression = expression;
+        _program = std::move(program);
+        _numbers = std::move(numbers);
+        _strings = std::move(strings);
+        _typeMask = _program.empty() ? ~0u : typeMask;
+
+        return true;
+    }
+
+    void ProfilerFilter::Clear()
+    {
+        _expression.clear();
+        _program.clear();
+        _numbers.clear();
+        _strings.clear();
+        _typeMask = ~0u;
+    }
+
+    bool ProfilerFilter::IsEmpty() const
+    {
+        return _program.empty();
+    }
+
+    const AmString& ProfilerFilter::GetExpression() const
+    {
+        return _expression;
+    }
+
+    bool ProfilerFilter::AppliesTo(const ProfilerDataVariant& message) const
+    {
+        return (_typeMask & (1u << message.index())) != 0;
+    }
+
+    bool ProfilerFilter::Evaluate(const ProfilerDataVariant& message) const
+    {
+        if (_program.empty())
+            return true;
+
+        if ((_typeMask & (1u << message.index())) == 0)
+            return false;
+
+        AmReal64 numbers[kMaxStackDepth];
+        const AmString* strings[kMaxStackDepth];
+        AmUInt8 truths[kMaxStackDepth];
+        AmSize top = 0;
+
+        for (const ProfilerFilterInstruction& instruction : _program)
+        {
+            switch (instruction.mOpCode)
+            {
+            case eProfilerFilterOpCode_LoadNumber:
+                numbers[top++] = kFields[instruction.mOperand].mNumber(message);
+                break;
+            case eProfilerFilterOpCode_LoadString:
+                strings[top++] = kFields[instruction.mOperand].mString(message);
+                break;
+            case eProfilerFilterOpCode_PushNumber:
+                numbers[top++] = _numbers[instruction.mOperand];
+                break;
+            case eProfilerFilterOpCode_PushString:
+                strings[top++] = &_strings[instruction.mOperand];
+                break;
+            case eProfilerFilterOpCode_Equal:
+            case eProfilerFilterOpCode_NotEqual:
+            case eProfilerFilterOpCode_Less:
+            case eProfilerFilterOpCode_LessEqual:
+            case eProfilerFilterOpCode_Greater:
+            case eProfilerFilterOpCode_GreaterEqual:
+                --top;
+                truths[top - 1] = CompareNumbers(instruction.mOpCode, numbers[top - 1], numbers[top]);
+                break;
+            case eProfilerFilterOpCode_StringEqual:
+            case eProfilerFilterOpCode_StringNotEqual:
+            case eProfilerFilterOpCode_Match:
+            case eProfilerFilterOpCode_NotMatch:
+                --top;
+                truths[top - 1] = CompareStrings(instruction.mOpCode, strings[top - 1], strings[top]);
+                break;
+            case eProfilerFilterOpCode_And:
+                --top;
+                truths[top - 1] = kAndTable[truths[top - 1]][truths[top]];
+                break;
+            case eProfilerFilterOpCode_Or:
+                --top;
+                truths[top - 1] = kOrTable[truths[top - 1]][truths[top]];
+                break;
+            case eProfilerFilterOpCode_Not:
+                truths[top - 1] = kNotTable[truths[top - 1]];
+                break;
+            }
+        }
+
+        return top == 1 && truths[0] == kTrue;
+    }
+
+    void ProfilerFilter::EvaluateBatch(const std::vector<ProfilerDataVariant>& messages, std::vector<AmUInt8>& results)
+    {
+        const AmSize rows = messages.size();
+        results.assign(rows, 1);
+
+        if (_program.empty() || rows == 0)
+            return;
+
+        // One column per stack slot, reused by every instruction touching that slot, and by the next batches.
+        if (_truthColumns.empty())
+        {
+            _numberColumns.resize(kMaxStackDepth);
+            _stringColumns.resize(kMaxStackDepth);
+            _truthColumns.resize(kMaxStackDepth);
+        }
+
+        auto& numbers = _numberColumns;
+        auto& strings = _stringColumns;
+        auto& truths = _truthColumns;
+        AmSize top = 0;
+
+        for (const ProfilerFilterInstruction& instruction : _program)
+        {
+            switch (instruction.mOpCode)
+            {
+            case eProfilerFilterOpCode_LoadNumber:
+                {
+                    auto& column = numbers[top++];
+                    column.resize(rows);
+                    const auto accessor = kFields[instruction.mOperand].mNumber;
+                    for (AmSize i = 0; i < rows; ++i)
+                        column[i] = accessor(messages[i]);
+                    break;
+                }
+            case eProfilerFilterOpCode_LoadString:
+                {
+                    auto& column = strings[top++];
+                    column.resize(rows);
+                    const auto accessor = kFields[instruction.mOperand].mString;
+                    for (AmSize i = 0; i < rows; ++i)
+                        column[i] = accessor(messages[i]);
+                    break;
+                }
+            case eProfilerFilterOpCode_PushNumber:
+                numbers[top++].assign(rows, _numbers[instruction.mOperand]);
+                break;
+            case eProfilerFilterOpCode_PushString:
+                strings[top++].assign(rows, &_strings[instruction.mOperand]);
+                break;
+            case eProfilerFilterOpCode_Equal:
+            case eProfilerFilterOpCode_NotEqual:
+            case eProfilerFilterOpCode_Less:
+            case eProfilerFilterOpCode_LessEqual:
+            case eProfilerFilterOpCode_Greater:
+            case eProfilerFilterOpCode_GreaterEqual:
+                {
+                    --top;
+                    const AmReal64* a = numbers[top - 1].data();
+                    const AmReal64* b = numbers[top].data();
+                    auto& out = truths[top - 1];
+                    out.resize(rows);
+
+                    // Unordered comparisons are false on NaN, so the neutral value can be blended in without branching.
+                    switch (instruction.mOpCode)
+                    {
+                    case eProfilerFilterOpCode_Equal:
+                        for (AmSize i = 0; i < rows; ++i)
+                            out[i] = (a[i] != a[i] || b[i] != b[i]) ? kNeutral : static_cast<AmUInt8>(a[i] == b[i]);
+                        break;
+                    case eProfilerFilterOpCode_NotEqual:
+                        for (AmSize i = 0; i < rows; ++i)
+                            out[i] = (a[i] != a[i] || b[i] != b[i]) ? kNeutral : static_cast<AmUInt8>(a[i] != b[i]);
+                        break;
+                    case eProfilerFilterOpCode_Less:
+                        for (AmSize i = 0; i < rows; ++i)
+                            out[i] = (a[i] != a[i] || b[i] != b[i]) ? kNeutral : static_cast<AmUInt8>(a[i] < b[i]);
+                        break;
+                    case eProfilerFilterOpCode_LessEqual:
+                        for (AmSize i = 0; i < rows; ++i)
+                            out[i] = (a[i] != a[i] || b[i] != b[i]) ? kNeutral : static_cast<AmUInt8>(a[i] <= b[i]);
+                        break;
+                    case eProfilerFilterOpCode_Greater:
+                        for (AmSize i = 0; i < rows; ++i)
+                            out[i] = (a[i] != a[i] || b[i] != b[i]) ? kNeutral : static_cast<AmUInt8>(a[i] > b[i]);
+                        break;
+                    default:
+                        for (AmSize i = 0; i < rows; ++i)
+                            out[i] = (a[i] != a[i] || b[i] != b[i]) ? kNeutral : static_cast<AmUInt8>(a[i] >= b[i]);
+                        break;
+                    }
+                    break;
+                }
+            case eProfilerFilterOpCode_StringEqual:
+            case eProfilerFilterOpCode_StringNotEqual:
+            case eProfilerFilterOpCode_Match:
+            case eProfilerFilterOpCode_NotMatch:
+                {
+                    --top;
+                    auto& out = truths[top - 1];
+                    out.resize(rows);
+                    for (AmSize i = 0; i < rows; ++i)
+                        out[i] = CompareStrings(instruction.mOpCode, strings[top - 1][i], strings[top][i]);
+                    break;
+                }
+            case eProfilerFilterOpCode_And:
+                {
+                    --top;
+                    AmUInt8* a = truths[top - 1].data();
+                    const AmUInt8* b = truths[top].data();
+                    for (AmSize i = 0; i < rows; ++i)
+                        a[i] = kAndTable[a[i]][b[i]];
+                    break;
+                }
+            case eProfilerFilterOpCode_Or:
+                {
+                    --top;
+                    AmUInt8* a = truths[top - 1].data();
+                    const AmUInt8* b = truths[top].data();
+                    for (AmSize i = 0; i < rows; ++i)
+                        a[i] = kOrTable[a[i]][b[i]];
+                    break;
+                }
+            case eProfilerFilterOpCode_Not:
+                {
+                    AmUInt8* a = truths[top - 1].data();
+                    for (AmSize i = 0; i < rows; ++i)
+                        a[i] = kNotTable[a[i]];
+                    break;
+                }
+            }
+        }
+
+        const AmUInt8* truth = truths[0].data();
+        for (AmSize i = 0; i < rows; ++i)
+            results[i] = static_cast<AmUInt8>(truth[i] == kTrue);
+    }
+
+    AmInt32 ProfilerFilter::FindNumberField(const AmString& name)
+    {
+        const AmInt32 field = FindField(name);
+        if (field < 0 || kFields[field].mKind != eFieldKind_Number)
+            return -1;
+
+        return field;
+    }
+
+    AmReal64 ProfilerFilter::GetNumberField(AmInt32 field, const ProfilerDataVariant& message)
+    {
+        if (field < 0 || static_cast<AmSize>(field) >= kFieldCount || kFields[field].mKind != eFieldKind_Number)
+            return kMissingNumber;
+
+        return kFields[field].mNumber(message);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,519 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/FlightRecorder.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Residency.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Serialization.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#if AM_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        constexpr std::intptr_t kInvalidFile = -1;
+
+        // The crash handler state is global, as signal handlers have no user data
+        std::atomic<const ProfilerFlightRecorder*> gCrashRecorder = nullptr;
+        std::atomic<bool> gCrashDumped = false;
+        std::intptr_t gCrashFile = kInvalidFile;
+
+#if AM_PLATFORM_WINDOWS
+        LPTOP_LEVEL_EXCEPTION_FILTER gPreviousExceptionFilter = nullptr;
+        void (*gPreviousAbortHandler)(int) = nullptr;
+#else
+        constexpr int kCrashSignals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGILL, SIGFPE };
+        struct sigaction gPreviousActions[std::size(kCrashSignals)];
+#endif
+
+        bool WriteAll(std::intptr_t file, const void* data, AmSize size)
+        {
+            const auto* bytes = static_cast<const AmUInt8*>(data);
+
+            while (size > 0)
+            {
+#if AM_PLATFORM_WINDOWS
+                DWORD written = 0;
+                const auto toWrite = static_cast<DWORD>(std::min<AmSize>(size, 1u << 30));
+                if (!WriteFile(reinterpret_cast<HANDLE>(file), bytes, toWrite, &written, nullptr) || written == 0)
+                    return false;
+#else
+                const ssize_t written = ::write(static_cast<int>(file), bytes, size);
+                if (written < 0 && errno == EINTR)
+                    continue;
+
+                if (written <= 0)
+                    return false;
+#endif
+
+                bytes += written;
+                size -= written;
+            }
+
+            return true;
+        }
+
+        void SyncFile(std::intptr_t file)
+        {
+#if AM_PLATFORM_WINDOWS
+            FlushFileBuffers(reinterpret_cast<HANDLE>(file));
+#else
+            fsync(static_cast<int>(file));
+#endif
+        }
+
+        void DumpOnCrash()
+        {
+            // Several threads may crash at once, only the first one dumps
+            if (gCrashDumped.exchange(true))
+                return;
+
+            if (const ProfilerFlightRecorder* recorder = gCrashRecorder.load(std::memory_order_acquire); recorder != nullptr)
+            {
+                recorder->Dump(gCrashFile);
+                SyncFile(gCrashFile);
+            }
+        }
+
+#if AM_PLATFORM_WINDOWS
+        LONG WINAPI HandleUnhandledException(EXCEPTION_POINTERS* info)
+        {
+            DumpOnCrash();
+            return gPreviousExceptionFilter != nullptr ? gPreviousExceptionFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+        }
+
+        void HandleAbortSignal(int signal)
+        {
+            DumpOnCrash();
+
+            std::signal(signal, gPreviousAbortHandler);
+            if (gPreviousAbortHandler != SIG_DFL && gPreviousAbortHandler != SIG_IGN && gPreviousAbortHandler != nullptr)
+                gPreviousAbortHandler(signal);
+        }
+#else
+        void HandleCrashSignal(int signal, siginfo_t* info, void* context)
+        {
+            DumpOnCrash();
+
+            // Hand the signal over to the previous handler, so crash reporters still run
+            struct sigaction previous = {};
+            previous.sa_handler = SIG_DFL;
+
+            for (AmSize i = 0; i < std::size(kCrashSignals); ++i)
+            {
+                if (kCrashSignals[i] == signal)
+                    previous = gPreviousActions[i];
+            }
+
+            sigaction(signal, &previous, nullptr);
+
+            if ((previous.sa_flags & SA_SIGINFO) != 0)
+            {
+                if (previous.sa_sigaction != nullptr)
+                    previous.sa_sigaction(signal, info, context);
+            }
+            else if (previous.sa_handler == SIG_DFL)
+            {
+                // The signal is blocked until this handler returns, it is then delivered with the default action
+                raise(signal);
+            }
+            else if (previous.sa_handler != SIG_IGN)
+            {
+                previous.sa_handler(signal);
+            }
+        }
+#endif
+
+        std::intptr_t CreateDumpFile(const AmOsString& path)
+        {
+#if AM_PLATFORM_WINDOWS
+            HANDLE handle = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            return handle != INVALID_HANDLE_VALUE ? reinterpret_cast<std::intptr_t>(handle) : kInvalidFile;
+#else
+            const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            return fd >= 0 ? fd : kInvalidFile;
+#endif
+        }
+
+        void CloseDumpFile(std::intptr_t file)
+        {
+#if AM_PLATFORM_WINDOWS
+            CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+            ::close(static_cast<int>(file));
+#endif
+        }
+    } // namespace
+
+    ProfilerFlightRecorder::ProfilerFlightRecorder()
+        : _memory(nullptr)
+        , _slotCapacity(0)
+        , _residency(eProfilerMemoryResidency_None)
+        , _current(0)
+        , _nextSequence(1)
+        , _header()
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerFlightRecorder::~ProfilerFlightRecorder()
+    {
+        Deinitialize();
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerFlightRecorder::Initialize(AmSize size)
+    {
+        Deinitialize();
+
+        // Slot sizes are stored on 32 bits
+        const AmSize slotCapacity = std::min<AmSize>(size / kSlotCount, std::numeric_limits<AmUInt32>::max());
+        if (slotCapacity < ProfilerRecordingChunkInfo::kHeaderSize)
+        {
+            amLogError("[ProfilerFlightRecorder] Ring size too small: %zu bytes", size);
+            return false;
+        }
+
+        Thread::LockMutex(_mutex);
+
+        _memory = static_cast<AmUInt8*>(ampoolmalloc(eMemoryPoolKind_IO, slotCapacity * kSlotCount));
+        if (_memory == nullptr)
+        {
+            Thread::UnlockMutex(_mutex);
+            amLogError("[ProfilerFlightRecorder] Failed to allocate a ring of %zu bytes", size);
+            return false;
+        }
+
+        _slotCapacity = slotCapacity;
+        for (AmUInt32 i = 0; i < kSlotCount; ++i)
+        {
+            _slots[i].mData = _memory + i * slotCapacity;
+            _slots[i].mSequence.store(0, std::memory_order_relaxed);
+            _slots[i].mCommitted.store(0, std::memory_order_relaxed);
+        }
+
+        _current = 0;
+        _nextSequence = 1;
+        _slots[0].mSequence.store(_nextSequence++, std::memory_order_release);
+
+        ProfilerRecordingHeader header{};
+        header.mMagic = ProfilerRecordingHeader::kMagic;
+        header.mVersion = ProfilerRecordingHeader::kVersion;
+        header.mFormatVersion = ProfilerBinarySerializer::kFormatVersion;
+        header.mFlags = ProfilerRecordingHeader::kFlagFlightRecorder;
+        header.mStartTime =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+        header.Encode(_header);
+
+        Thread::UnlockMutex(_mutex);
+        return true;
+    }
+
+    void ProfilerFlightRecorder::Deinitialize()
+    {
+        UninstallCrashHandler();
+
+        Thread::LockMutex(_mutex);
+
+        if (_memory != nullptr)
+        {
+            ProfilerMemoryResidency::Release(_memory, _slotCapacity * kSlotCount, _residency);
+            ampoolfree(eMemoryPoolKind_IO, _memory);
+            _memory = nullptr;
+        }
+
+        _residency = eProfilerMemoryResidency_None;
+
+        for (auto& slot : _slots)
+        {
+            slot.mData = nullptr;
+            slot.mSequence.store(0, std::memory_order_relaxed);
+            slot.mCommitted.store(0, std::memory_order_relaxed);
+        }
+
+        _slotCapacity = 0;
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerFlightRecorder::Prefault(AmUInt32 residency)
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_memory != nullptr)
+        {
+            ProfilerMemoryResidency::Release(_memory, _slotCapacity * kSlotCount, _residency);
+            ProfilerMemoryResidency::Acquire(_memory, _slotCapacity * kSlotCount, residency);
+            _residency = residency;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerFlightRecorder::Record(const ProfilerDataVariant& data)
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_memory == nullptr)
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+        _scratch.clear();
+        ProfilerBinarySerializer::Encode(data, _scratch);
+
+        const AmSize recordSize = sizeof(AmUInt32) + _scratch.size();
+        if (recordSize > _slotCapacity)
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+        Slot* slot = &_slots[_current];
+        AmUInt64 committed = slot->mCommitted.load(std::memory_order_relaxed);
+
+        if ((committed & 0xFFFFFFFFull) + recordSize > _slotCapacity)
+        {
+            // Reuse the oldest slot: it is emptied before its sequence changes, so a dump skips it
+            _current = (_current + 1) % kSlotCount;
+            slot = &_slots[_current];
+            slot->mCommitted.store(0, std::memory_order_release);
+            slot->mSequence.store(_nextSequence++, std::memory_order_release);
+            committed = 0;
+        }
+
+        const auto size = static_cast<AmUInt32>(committed & 0xFFFFFFFFull);
+        const auto count = static_cast<AmUInt32>(committed >> 32);
+        const auto payloadSize = static_cast<AmUInt32>(_scratch.size());
+
+        std::memcpy(slot->mData + size, &payloadSize, sizeof(AmUInt32));
+        std::memcpy(slot->mData + size + sizeof(AmUInt32), _scratch.data(), _scratch.size());
+
+        const AmInt64 timestamp = std::visit(
+            [](const auto& arg) -> AmInt64
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(arg.mTimestamp.time_since_epoch()).count();
+            },
+            data);
+
+        if (count == 0)
+            slot->mFirstTimestamp.store(timestamp, std::memory_order_relaxed);
+        slot->mLastTimestamp.store(timestamp, std::memory_order_relaxed);
+
+        // Publish the record, count and size at once so a dump never sees one without the other
+        slot->mCommitted.store((static_cast<AmUInt64>(count + 1) << 32) | (size + recordSize), std::memory_order_release);
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerFlightRecorder::Dump(std::intptr_t file) const
+    {
+        if (_memory == nullptr || file == kInvalidFile)
+            return false;
+
+        if (!WriteAll(file, _header, sizeof(_header)))
+            return false;
+
+        // Sort the slots from the oldest, on the stack as nothing can be allocated here
+        AmUInt32 order[kSlotCount];
+        AmUInt64 sequences[kSlotCount];
+        AmUInt32 used = 0;
+
+        for (AmUInt32 i = 0; i < kSlotCount; ++i)
+        {
+            const AmUInt64 sequence = _slots[i].mSequence.load(std::memory_order_acquire);
+            if (sequence == 0)
+                continue;
+
+            AmUInt32 position = used++;
+            for (; position > 0 && sequences[position - 1] > sequence; --position)
+            {
+                order[position] = order[position - 1];
+                sequences[position] = sequences[position - 1];
+            }
+
+            order[position] = i;
+            sequences[position] = sequence;
+        }
+
+        for (AmUInt32 i = 0; i < used; ++i)
+        {
+            const Slot& slot = _slots[order[i]];
+
+            const AmUInt64 committed = slot.mCommitted.load(std::memory_order_acquire);
+            const auto count = static_cast<AmUInt32>(committed >> 32);
+            if (count == 0)
+                continue;
+
+            ProfilerRecordingChunkInfo chunk{};
+            chunk.mStoredSize = committed & 0xFFFFFFFFull;
+            chunk.mUncompressedSize = chunk.mStoredSize;
+            chunk.mMessageCount = count;
+            chunk.mCompression = eProfilerRecordingCompression_None;
+            chunk.mFirstTimestamp = slot.mFirstTimestamp.load(std::memory_order_relaxed);
+            chunk.mLastTimestamp = slot.mLastTimestamp.load(std::memory_order_relaxed);
+
+            AmUInt8 header[ProfilerRecordingChunkInfo::kHeaderSize];
+            chunk.EncodeHeader(header);
+
+            if (!WriteAll(file, header, sizeof(header)) || !WriteAll(file, slot.mData, chunk.mStoredSize))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ProfilerFlightRecorder::DumpToFile(const AmOsString& path) const
+    {
+        const std::intptr_t file = CreateDumpFile(path);
+        if (file == kInvalidFile)
+        {
+            amLogError("[ProfilerFlightRecorder] Failed to create dump file: %s", std::filesystem::path(path).string().c_str());
+            return false;
+        }
+
+        Thread::LockMutex(_mutex);
+        const bool success = Dump(file);
+        Thread::UnlockMutex(_mutex);
+
+        CloseDumpFile(file);
+
+        if (!success)
+            amLogError("[ProfilerFlightRecorder] Failed to write dump file: %s", std::filesystem::path(path).string().c_str());
+
+        return success;
+    }
+
+    bool ProfilerFlightRecorder::InstallCrashHandler(const AmOsString& path)
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_memory == nullptr)
+        {
+            Thread::UnlockMutex(_mutex);
+            amLogError("[ProfilerFlightRecorder] Cannot install a crash handler before the ring is allocated");
+            return false;
+        }
+
+        const ProfilerFlightRecorder* expected = nullptr;
+        if (!gCrashRecorder.compare_exchange_strong(expected, this))
+        {
+            Thread::UnlockMutex(_mutex);
+
+            if (expected != this)
+                amLogError("[ProfilerFlightRecorder] Another flight recorder already has a crash handler installed");
+
+            return expected == this;
+        }
+
+        // A dump left by a previous crash is kept aside rather than overwritten
+        std::error_code error;
+        if (std::filesystem::exists(path, error) && std::filesystem::file_size(path, error) > 0)
+        {
+            AmOsString previousPath = path;
+            previousPath += std::filesystem::path(".previous").native();
+            std::filesystem::rename(path, previousPath, error);
+
+            amLogWarning(
+                "[ProfilerFlightRecorder] A crash dump from a previous run was moved to: %s",
+                std::filesystem::path(previousPath).string().c_str());
+        }
+
+        gCrashFile = CreateDumpFile(path);
+        if (gCrashFile == kInvalidFile)
+        {
+            gCrashRecorder.store(nullptr, std::memory_order_release);
+            Thread::UnlockMutex(_mutex);
+            amLogError("[ProfilerFlightRecorder] Failed to create crash dump file: %s", std::filesystem::path(path).string().c_str());
+            return false;
+        }
+
+        gCrashDumped = false;
+        _crashPath = path;
+
+#if AM_PLATFORM_WINDOWS
+        gPreviousExceptionFilter = SetUnhandledExceptionFilter(HandleUnhandledException);
+        gPreviousAbortHandler = std::signal(SIGABRT, HandleAbortSignal);
+#else
+        struct sigaction action = {};
+        action.sa_sigaction = HandleCrashSignal;
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+
+        for (AmSize i = 0; i < std::size(kCrashSignals); ++i)
+            sigaction(kCrashSignals[i], &action, &gPreviousActions[i]);
+#endif
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogInfo("[ProfilerFlightRecorder] Crash handler installed, dumps go to: %s", std::filesystem::path(path).string().c_str());
+        return true;
+    }
+
+    void ProfilerFlightRecorder::UninstallCrashHandler()
+    {
+        Thread::LockMutex(_mutex);
+
+        if (gCrashRecorder.load(std::memory_order_acquire) != this)
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+#if AM_PLATFORM_WINDOWS
+        SetUnhandledExceptionFilter(gPreviousExceptionFilter);
+        std::signal(SIGABRT, gPreviousAbortHandler);
+#else
+        for (AmSize i = 0; i < std::size(kCrashSignals); ++i)
+            sigaction(kCrashSignals[i], &gPreviousActions[i], nullptr);
+#endif
+
+        gCrashRecorder.store(nullptr, std::memory_order_release);
+
+        CloseDumpFile(gCrashFile);
+        gCrashFile = kInvalidFile;
+
+        // Without a crash, the dump file stays empty and is not worth keeping
+        if (!gCrashDumped.load())
+        {
+            std::error_code error;
+            std::filesystem::remove(_crashPath, error);
+        }
+
+        _crashPath.clear();
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerFlightRecorder::IsCrashHandlerInstalled() const
+    {
+        return gCrashRecorder.load(std::memory_order_acquire) == this;
+    }
+} // namespace SparkyStudios::Audio::Amplitude
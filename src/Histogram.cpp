@@ -0,0 +1,134 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Profiler/Histogram.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    ProfilerHistogram::ProfilerHistogram(AmReal64 lowestValue, AmReal64 highestValue, AmReal64 relativeError)
+        : _lowestValue(lowestValue > 0.0 ? lowestValue : 1e-3)
+        , _highestValue(std::max(highestValue, _lowestValue * 2.0))
+        , _logBase(std::log1p(2.0 * std::clamp(relativeError, 1e-4, 0.5)))
+        , _count(0)
+        , _sum(0.0)
+        , _min(std::numeric_limits<AmReal64>::max())
+        , _max(std::numeric_limits<AmReal64>::lowest())
+    {
+        // One underflow bucket, the tracked range, and one overflow bucket
+        const auto trackedBuckets = static_cast<AmSize>(std::ceil(std::log(_highestValue / _lowestValue) / _logBase));
+        _buckets.resize(trackedBuckets + 2, 0);
+    }
+
+    void ProfilerHistogram::Record(AmReal64 value, AmUInt64 count)
+    {
+        if (count == 0 || std::isnan(value))
+            return;
+
+        _buckets[_getBucketIndex(value)] += count;
+
+        _count += count;
+        _sum += value * static_cast<AmReal64>(count);
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    bool ProfilerHistogram::Merge(const ProfilerHistogram& other)
+    {
+        if (_buckets.size() != other._buckets.size() || _lowestValue != other._lowestValue || _logBase != other._logBase)
+            return false;
+
+        for (AmSize i = 0, l = _buckets.size(); i < l; ++i)
+            _buckets[i] += other._buckets[i];
+
+        _count += other._count;
+        _sum += other._sum;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+
+        return true;
+    }
+
+    void ProfilerHistogram::Reset()
+    {
+        std::fill(_buckets.begin(), _buckets.end(), 0);
+
+        _count = 0;
+        _sum = 0.0;
+        _min = std::numeric_limits<AmReal64>::max();
+        _max = std::numeric_limits<AmReal64>::lowest();
+    }
+
+    AmReal64 ProfilerHistogram::GetPercentile(AmReal64 percentile) const
+    {
+        if (_count == 0)
+            return 0.0;
+
+        const AmReal64 clamped = std::clamp(percentile, 0.0, 100.0);
+        const auto rank = std::max<AmUInt64>(1, static_cast<AmUInt64>(std::ceil(clamped / 100.0 * static_cast<AmReal64>(_count))));
+
+        AmUInt64 cumulative = 0;
+        for (AmSize i = 0, l = _buckets.size(); i < l; ++i)
+        {
+            cumulative += _buckets[i];
+            if (cumulative >= rank)
+                return std::clamp(_getBucketValue(i), _min, _max);
+        }
+
+        return _max;
+    }
+
+    AmReal64 ProfilerHistogram::GetMin() const
+    {
+        return _count > 0 ? _min : 0.0;
+    }
+
+    AmReal64 ProfilerHistogram::GetMax() const
+    {
+        return _count > 0 ? _max : 0.0;
+    }
+
+    AmReal64 ProfilerHistogram::GetMean() const
+    {
+        return _count > 0 ? _sum / static_cast<AmReal64>(_count) : 0.0;
+    }
+
+    AmSize ProfilerHistogram::_getBucketIndex(AmReal64 value) const
+    {
+        if (value < _lowestValue)
+            return 0;
+
+        if (value >= _highestValue)
+            return _buckets.size() - 1;
+
+        const auto index = static_cast<AmSize>(std::log(value / _lowestValue) / _logBase) + 1;
+        return std::min(index, _buckets.size() - 2);
+    }
+
+    AmReal64 ProfilerHistogram::_getBucketValue(AmSize index) const
+    {
+        // Out of range buckets are not tracked precisely, the extremes are the best known values
+        if (index == 0)
+            return _min;
+
+        if (index == _buckets.size() - 1)
+            return _max;
+
+        // Geometric middle of the bucket, within the relative error of both of its bounds
+        return _lowestValue * std::exp((static_cast<AmReal64>(index) - 0.5) * _logBase);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
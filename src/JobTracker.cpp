@@ -0,0 +1,270 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/JobTracker.h>
+
+#include <algorithm>
+#include <string>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        ProfilerTime ToProfilerTime(AmInt64 timestampNs)
+        {
+            return ProfilerTime(std::chrono::duration_cast<ProfilerTime::duration>(std::chrono::nanoseconds(timestampNs)));
+        }
+
+        // Counters have a single writer, so they need no read-modify-write
+        void Increase(std::atomic<AmUInt64>& counter, AmUInt64 amount)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        // The collection resets the maximums, so they are raised with a compare-exchange
+        void Raise(std::atomic<AmUInt64>& maximum, AmUInt64 value)
+        {
+            AmUInt64 current = maximum.load(std::memory_order_relaxed);
+            while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+    } // namespace
+
+    ProfilerJobTracker::ProfilerJobTracker()
+        : _enabled(false)
+        , _timeline(false)
+        , _queued(0)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerJobTracker::~ProfilerJobTracker()
+    {
+        for (Worker& worker : _workers)
+        {
+            if (worker.mRing != nullptr)
+                ampooldelete(eMemoryPoolKind_IO, ProfilerRealtimeRing, worker.mRing);
+        }
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    AmUInt32 ProfilerJobTracker::RegisterWorker(const AmString& name, AmUInt32 timelineCapacity, AmUInt32 residency)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (AmUInt32 i = 0; i < kMaxWorkers; ++i)
+        {
+            Worker& worker = _workers[i];
+            if (worker.mState.load(std::memory_order_relaxed) != eWorkerState_Free)
+                continue;
+
+            worker.mRing = ampoolnew(eMemoryPoolKind_IO, ProfilerRealtimeRing, timelineCapacity, residency);
+            worker.mName = name;
+
+            worker.mJobs.store(0, std::memory_order_relaxed);
+            worker.mSteals.store(0, std::memory_order_relaxed);
+            worker.mWaitNs.store(0, std::memory_order_relaxed);
+            worker.mExecNs.store(0, std::memory_order_relaxed);
+            worker.mMaxWaitNs.store(0, std::memory_order_relaxed);
+            worker.mMaxExecNs.store(0, std::memory_order_relaxed);
+
+            worker.mCollected = ProfilerJobWorkerStats();
+            worker.mCollectedNs = Now();
+
+            _records.reserve(worker.mRing->Capacity());
+
+            amLogDebug("[ProfilerJobTracker] Registered worker '%s'", name.c_str());
+
+            worker.mState.store(eWorkerState_Active, std::memory_order_release);
+            Thread::UnlockMutex(_mutex);
+            return i;
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogWarning("[ProfilerJobTracker] Cannot register worker '%s': %u workers already report", name.c_str(), kMaxWorkers);
+        return kInvalidWorker;
+    }
+
+    void ProfilerJobTracker::UnregisterWorker(AmUInt32 worker)
+    {
+        if (worker >= kMaxWorkers)
+            return;
+
+        Thread::LockMutex(_mutex);
+
+        // The ring is released by the next drain, once its last jobs are read
+        eWorkerState expected = eWorkerState_Active;
+        _workers[worker].mState.compare_exchange_strong(expected, eWorkerState_Closing, std::memory_order_acq_rel);
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    AmInt64 ProfilerJobTracker::OnJobQueued() noexcept
+    {
+        if (!IsEnabled())
+            return 0;
+
+        _queued.fetch_add(1, std::memory_order_relaxed);
+        return Now();
+    }
+
+    AmInt64 ProfilerJobTracker::OnJobStarted(AmUInt32 worker, AmInt64 queuedNs, bool stolen) noexcept
+    {
+        // Jobs queued while disabled were not counted
+        if (queuedNs == 0)
+            return 0;
+
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+
+        if (!IsEnabled() || worker >= kMaxWorkers)
+            return 0;
+
+        Worker& state = _workers[worker];
+        if (state.mState.load(std::memory_order_acquire) != eWorkerState_Active)
+            return 0;
+
+        const AmInt64 startNs = Now();
+        const auto waitNs = static_cast<AmUInt64>(std::max<AmInt64>(0, startNs - queuedNs));
+
+        Increase(state.mWaitNs, waitNs);
+        Raise(state.mMaxWaitNs, waitNs);
+
+        if (stolen)
+            Increase(state.mSteals, 1);
+
+        return startNs;
+    }
+
+    void ProfilerJobTracker::OnJobFinished(AmUInt32 worker, const char* name, AmUInt64 id, AmInt64 queuedNs, AmInt64 startNs) noexcept
+    {
+        if (startNs == 0 || worker >= kMaxWorkers)
+            return;
+
+        Worker& state = _workers[worker];
+        if (state.mState.load(std::memory_order_acquire) != eWorkerState_Active)
+            return;
+
+        const AmInt64 endNs = Now();
+        const auto execNs = static_cast<AmUInt64>(std::max<AmInt64>(0, endNs - startNs));
+
+        Increase(state.mJobs, 1);
+        Increase(state.mExecNs, execNs);
+        Raise(state.mMaxExecNs, execNs);
+
+        if (!_timeline.load(std::memory_order_relaxed))
+            return;
+
+        ProfilerRealtimeRecord record;
+        record.mTimestampNs = endNs;
+        record.mName = name;
+        record.mId = id;
+        record.mCategory = eProfilerCategory_Events;
+        record.mKind = eProfilerRealtimeRecordKind_Span;
+        record.mValueCount = 2;
+        record.mValues[0] = static_cast<AmReal64>(execNs);
+        record.mValues[1] = static_cast<AmReal64>(startNs - queuedNs);
+
+        state.mRing->Push(record);
+    }
+
+    void ProfilerJobTracker::Collect(std::vector<ProfilerJobWorkerStats>& workers)
+    {
+        Thread::LockMutex(_mutex);
+
+        const AmInt64 now = Now();
+        for (Worker& worker : _workers)
+        {
+            if (worker.mState.load(std::memory_order_acquire) != eWorkerState_Active)
+                continue;
+
+            ProfilerJobWorkerStats totals;
+            totals.mJobs = worker.mJobs.load(std::memory_order_relaxed);
+            totals.mSteals = worker.mSteals.load(std::memory_order_relaxed);
+            totals.mWaitNs = worker.mWaitNs.load(std::memory_order_relaxed);
+            totals.mExecNs = worker.mExecNs.load(std::memory_order_relaxed);
+
+            ProfilerJobWorkerStats& stats = workers.emplace_back();
+            stats.mName = worker.mName;
+            stats.mJobs = totals.mJobs - worker.mCollected.mJobs;
+            stats.mSteals = totals.mSteals - worker.mCollected.mSteals;
+            stats.mWaitNs = totals.mWaitNs - worker.mCollected.mWaitNs;
+            stats.mExecNs = totals.mExecNs - worker.mCollected.mExecNs;
+            stats.mMaxWaitNs = worker.mMaxWaitNs.exchange(0, std::memory_order_relaxed);
+            stats.mMaxExecNs = worker.mMaxExecNs.exchange(0, std::memory_order_relaxed);
+
+            // Jobs are counted when they finish, so a job longer than the interval can exceed it
+            if (const AmInt64 elapsedNs = now - worker.mCollectedNs; elapsedNs > 0)
+                stats.mUtilization = std::min(1.0, static_cast<AmReal64>(stats.mExecNs) / static_cast<AmReal64>(elapsedNs));
+
+            worker.mCollected = totals;
+            worker.mCollectedNs = now;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerJobTracker::DrainTimeline(std::vector<ProfilerEvent>& events)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (Worker& worker : _workers)
+        {
+            const eWorkerState state = worker.mState.load(std::memory_order_acquire);
+            if (state == eWorkerState_Free)
+                continue;
+
+            _drain(worker, events);
+
+            if (state == eWorkerState_Closing)
+            {
+                ampooldelete(eMemoryPoolKind_IO, ProfilerRealtimeRing, worker.mRing);
+
+                worker.mRing = nullptr;
+                worker.mName.clear();
+                worker.mState.store(eWorkerState_Free, std::memory_order_release);
+            }
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerJobTracker::_drain(Worker& worker, std::vector<ProfilerEvent>& events)
+    {
+        _records.clear();
+        worker.mRing->Pop(_records);
+
+        for (const ProfilerRealtimeRecord& record : _records)
+        {
+            const AmReal64 execNs = record.mValues[0];
+
+            // Jobs are placed at their start
+            ProfilerEvent& event = events.emplace_back(record.mName);
+            event.mTimestamp = ToProfilerTime(record.mTimestampNs - static_cast<AmInt64>(execNs));
+            event.mCategory = record.mCategory;
+            event.mParameters["kind"] = "job";
+            event.mParameters["worker"] = worker.mName;
+            event.mParameters["duration_ms"] = std::to_string(execNs / 1e6);
+            event.mParameters["queue_wait_ms"] = std::to_string(record.mValues[1] / 1e6);
+
+            if (record.mId != 0)
+                event.mParameters["id"] = std::to_string(record.mId);
+        }
+    }
+} // namespace SparkyStudios::Audio::Amplitude
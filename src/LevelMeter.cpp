@@ -0,0 +1,539 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LevelMeter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Residency.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AM_PROFILER_LEVELS_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define AM_PROFILER_LEVELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Samples of a bus, written by the audio thread and read by the update thread.
+     */
+    struct ProfilerAudioTapRing
+    {
+        ProfilerAudioTapRing(AmUInt32 channels, AmUInt32 capacityFrames, AmUInt32 residency)
+            : mSamples(nullptr)
+            , mMask(0)
+            , mChannels(channels)
+            , mResidency(residency)
+        {
+            AmUInt64 size = 2;
+            while (size < capacityFrames)
+                size <<= 1;
+
+            mMask = size - 1;
+            mSamples = static_cast<AmReal32*>(ampoolmalign(eMemoryPoolKind_IO, GetSize(), 64));
+
+            // Touched even without residency settings, so the first pushes do not page-fault
+            std::memset(mSamples, 0, GetSize());
+            ProfilerMemoryResidency::Acquire(mSamples, GetSize(), mResidency);
+        }
+
+        ~ProfilerAudioTapRing()
+        {
+            ProfilerMemoryResidency::Release(mSamples, GetSize(), mResidency);
+            ampoolfree(eMemoryPoolKind_IO, mSamples);
+        }
+
+        [[nodiscard]] AmUInt64 GetCapacity() const
+        {
+            return mMask + 1;
+        }
+
+        [[nodiscard]] AmSize GetSize() const
+        {
+            return static_cast<AmSize>(GetCapacity() * mChannels * sizeof(AmReal32));
+        }
+
+        // Producer only. Buffers are copied whole or not at all, so the meters never see half a buffer.
+        bool Push(const AmReal32* samples, AmUInt32 frames) noexcept
+        {
+            const AmUInt64 write = mWrite.load(std::memory_order_relaxed);
+
+            if (write + frames - mCachedRead > GetCapacity())
+            {
+                mCachedRead = mRead.load(std::memory_order_acquire);
+                if (write + frames - mCachedRead > GetCapacity())
+                {
+                    mDropped.store(mDropped.load(std::memory_order_relaxed) + frames, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+
+            const AmUInt64 start = write & mMask;
+            const AmUInt64 first = std::min<AmUInt64>(frames, GetCapacity() - start);
+
+            std::memcpy(mSamples + start * mChannels, samples, first * mChannels * sizeof(AmReal32));
+            std::memcpy(mSamples, samples + first * mChannels, (frames - first) * mChannels * sizeof(AmReal32));
+
+            mWrite.store(write + frames, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only
+        AmUInt32 Pop(std::vector<AmReal32>& samples)
+        {
+            const AmUInt64 read = mRead.load(std::memory_order_relaxed);
+            const AmUInt64 write = mWrite.load(std::memory_order_acquire);
+            const AmUInt64 frames = write - read;
+
+            samples.resize(frames * mChannels);
+
+            const AmUInt64 start = read & mMask;
+            const AmUInt64 first = std::min<AmUInt64>(frames, GetCapacity() - start);
+
+            std::memcpy(samples.data(), mSamples + start * mChannels, first * mChannels * sizeof(AmReal32));
+            std::memcpy(samples.data() + first * mChannels, mSamples, (frames - first) * mChannels * sizeof(AmReal32));
+
+            mRead.store(write, std::memory_order_release);
+            return static_cast<AmUInt32>(frames);
+        }
+
+        AmReal32* mSamples;
+        AmUInt64 mMask; // In frames
+        AmUInt32 mChannels;
+        AmUInt32 mResidency;
+
+        alignas(64) std::atomic<AmUInt64> mWrite = 0;
+        AmUInt64 mCachedRead = 0; // Producer's copy of mRead
+        std::atomic<AmUInt64> mDropped = 0; // In frames, written by the producer only
+
+        alignas(64) std::atomic<AmUInt64> mRead = 0;
+    };
+
+    namespace
+    {
+        constexpr AmReal64 kPi = 3.14159265358979323846;
+
+        AmReal32 ToDecibels(AmReal64 amplitude)
+        {
+            if (amplitude <= 0.0)
+                return ProfilerBusLevels::kSilenceDb;
+
+            return std::max(static_cast<AmReal32>(20.0 * std::log10(amplitude)), ProfilerBusLevels::kSilenceDb);
+        }
+
+        // Sample peak, sum of squares and full scale samples of a channel
+        void MeasureLevels(const AmReal32* samples, AmSize count, AmReal32& peak, AmReal64& squares, AmUInt64& clipped)
+        {
+            AmSize i = 0;
+            AmReal32 maximum = 0.0f;
+            AmReal32 sum = 0.0f;
+
+#if AM_PROFILER_LEVELS_SSE2
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            const __m128 fullScale = _mm_set1_ps(1.0f);
+            __m128 peaks = _mm_setzero_ps();
+            __m128 sums = _mm_setzero_ps();
+
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 values = _mm_loadu_ps(samples + i);
+                const __m128 magnitudes = _mm_andnot_ps(signMask, values);
+
+                peaks = _mm_max_ps(peaks, magnitudes);
+                sums = _mm_add_ps(sums, _mm_mul_ps(values, values));
+                clipped += std::popcount(static_cast<AmUInt32>(_mm_movemask_ps(_mm_cmpge_ps(magnitudes, fullScale))));
+            }
+
+            alignas(16) AmReal32 lanes[4];
+            _mm_store_ps(lanes, peaks);
+            maximum = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+            _mm_store_ps(lanes, sums);
+            sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif AM_PROFILER_LEVELS_NEON
+            const float32x4_t fullScale = vdupq_n_f32(1.0f);
+            float32x4_t peaks = vdupq_n_f32(0.0f);
+            float32x4_t sums = vdupq_n_f32(0.0f);
+            uint32x4_t clips = vdupq_n_u32(0);
+
+            for (; i + 4 <= count; i += 4)
+            {
+                const float32x4_t values = vld1q_f32(samples + i);
+                const float32x4_t magnitudes = vabsq_f32(values);
+
+                peaks = vmaxq_f32(peaks, magnitudes);
+                sums = vmlaq_f32(sums, values, values);
+                clips = vsubq_u32(clips, vcgeq_f32(magnitudes, fullScale)); // Set lanes are all ones, so -1
+            }
+
+            AmReal32 lanes[4];
+            AmUInt32 clipLanes[4];
+            vst1q_f32(lanes, peaks);
+            maximum = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+            vst1q_f32(lanes, sums);
+            sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            vst1q_u32(clipLanes, clips);
+            clipped += static_cast<AmUInt64>(clipLanes[0]) + clipLanes[1] + clipLanes[2] + clipLanes[3];
+#endif
+
+            for (; i < count; ++i)
+            {
+                const AmReal32 magnitude = std::fabs(samples[i]);
+                maximum = std::max(maximum, magnitude);
+                sum += samples[i] * samples[i];
+                clipped += magnitude >= 1.0f ? 1 : 0;
+            }
+
+            peak = std::max(peak, maximum);
+            squares += sum;
+        }
+
+        AmReal64 SumSquares(const AmReal32* samples, AmSize count)
+        {
+            AmSize i = 0;
+            AmReal32 sum = 0.0f;
+
+#if AM_PROFILER_LEVELS_SSE2
+            __m128 sums = _mm_setzero_ps();
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 values = _mm_loadu_ps(samples + i);
+                sums = _mm_add_ps(sums, _mm_mul_ps(values, values));
+            }
+
+            alignas(16) AmReal32 lanes[4];
+            _mm_store_ps(lanes, sums);
+            sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif AM_PROFILER_LEVELS_NEON
+            float32x4_t sums = vdupq_n_f32(0.0f);
+            for (; i + 4 <= count; i += 4)
+            {
+                const float32x4_t values = vld1q_f32(samples + i);
+                sums = vmlaq_f32(sums, values, values);
+            }
+
+            AmReal32 lanes[4];
+            vst1q_f32(lanes, sums);
+            sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+            for (; i < count; ++i)
+                sum += samples[i] * samples[i];
+
+            return sum;
+        }
+    } // namespace
+
+    AmReal32 ProfilerBusLevels::GetPeakDbfs() const
+    {
+        return mPeakDbfs.empty() ? kSilenceDb : *std::max_element(mPeakDbfs.begin(), mPeakDbfs.end());
+    }
+
+    AmReal32 ProfilerBusLevels::GetRmsDbfs() const
+    {
+        return mRmsDbfs.empty() ? kSilenceDb : *std::max_element(mRmsDbfs.begin(), mRmsDbfs.end());
+    }
+
+    ProfilerLevelMeter::ProfilerLevelMeter()
+        : _enabled(false)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerLevelMeter::~ProfilerLevelMeter()
+    {
+        for (MeteredBus& bus : _buses)
+        {
+            if (bus.mRing != nullptr)
+                ampooldelete(eMemoryPoolKind_IO, ProfilerAudioTapRing, bus.mRing);
+        }
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    AmUInt32 ProfilerLevelMeter::RegisterBus(
+        const AmString& name, AmUInt32 channels, AmUInt32 sampleRate, AmUInt32 capacityFrames, AmUInt32 residency)
+    {
+        if (channels == 0 || channels > kMaxChannels || sampleRate == 0)
+        {
+            amLogWarning(
+                "[ProfilerLevelMeter] Cannot register bus '%s': %u channels at %u Hz (must be 1-%u channels)", name.c_str(), channels,
+                sampleRate, kMaxChannels);
+            return kInvalidBus;
+        }
+
+        Thread::LockMutex(_mutex);
+
+        for (AmUInt32 i = 0; i < kMaxBuses; ++i)
+        {
+            MeteredBus& bus = _buses[i];
+            if (bus.mState.load(std::memory_order_relaxed) != eBusState_Free)
+                continue;
+
+            bus.mRing = ampoolnew(eMemoryPoolKind_IO, ProfilerAudioTapRing, channels, std::max(capacityFrames, 1u), residency);
+            bus.mName = name;
+            bus.mChannels = channels;
+            bus.mBlockFrames = std::max(sampleRate / 10, 1u);
+
+            // K-weighting of ITU-R BS.1770, a high shelf modelling the head followed by a low cut, at the bus sample rate
+            const auto rate = static_cast<AmReal64>(sampleRate);
+            {
+                const AmReal64 k = std::tan(kPi * 1681.974450955533 / rate);
+                const AmReal64 q = 0.7071752369554196;
+                const AmReal64 vh = std::pow(10.0, 3.999843853973347 / 20.0);
+                const AmReal64 vb = std::pow(vh, 0.4996667741545416);
+                const AmReal64 a0 = 1.0 + k / q + k * k;
+
+                bus.mShelf.mB0 = (vh + vb * k / q + k * k) / a0;
+                bus.mShelf.mB1 = 2.0 * (k * k - vh) / a0;
+                bus.mShelf.mB2 = (vh - vb * k / q + k * k) / a0;
+                bus.mShelf.mA1 = 2.0 * (k * k - 1.0) / a0;
+                bus.mShelf.mA2 = (1.0 - k / q + k * k) / a0;
+            }
+            {
+                const AmReal64 k = std::tan(kPi * 38.13547087602444 / rate);
+                const AmReal64 q = 0.5003270373238773;
+                const AmReal64 a0 = 1.0 + k / q + k * k;
+
+                bus.mHighPass.mB0 = 1.0;
+                bus.mHighPass.mB1 = -2.0;
+                bus.mHighPass.mB2 = 1.0;
+                bus.mHighPass.mA1 = 2.0 * (k * k - 1.0) / a0;
+                bus.mHighPass.mA2 = (1.0 - k / q + k * k) / a0;
+            }
+
+            // Channels of 5.1 and 7.1 buses are L, R, C, LFE, then the surrounds
+            for (AmUInt32 c = 0; c < kMaxChannels; ++c)
+                bus.mChannelWeights[c] = channels >= 6 && c == 3 ? 0.0f : (channels >= 6 && c > 3 ? 1.41f : 1.0f);
+
+            bus.mFilterState = {};
+            bus.mBlockEnergy = {};
+            bus.mBlockPosition = 0;
+            bus.mBlocks = {};
+            bus.mBlockCount = 0;
+            bus.mPeak = {};
+            bus.mSquares = {};
+            bus.mFrames = 0;
+            bus.mClipped = 0;
+            bus.mReportedDropped = 0;
+
+            // Taps are drained one at a time, so draining does not allocate either
+            const AmUInt64 capacity = bus.mRing->GetCapacity();
+            _interleaved.reserve(std::max<AmSize>(_interleaved.capacity(), capacity * channels));
+            _channel.reserve(std::max<AmSize>(_channel.capacity(), std::min<AmUInt64>(capacity, bus.mBlockFrames)));
+
+            amLogDebug(
+                "[ProfilerLevelMeter] Registered bus '%s' with %u channels at %u Hz, buffering %llu frames", name.c_str(), channels,
+                sampleRate, static_cast<unsigned long long>(capacity));
+
+            bus.mState.store(eBusState_Active, std::memory_order_release);
+            Thread::UnlockMutex(_mutex);
+            return i;
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogWarning("[ProfilerLevelMeter] Cannot register bus '%s': %u buses already metered", name.c_str(), kMaxBuses);
+        return kInvalidBus;
+    }
+
+    void ProfilerLevelMeter::UnregisterBus(AmUInt32 bus)
+    {
+        if (bus >= kMaxBuses)
+            return;
+
+        Thread::LockMutex(_mutex);
+
+        // The tap is released by the next processing, once its last buffers are measured
+        eBusState expected = eBusState_Active;
+        _buses[bus].mState.compare_exchange_strong(expected, eBusState_Closing, std::memory_order_acq_rel);
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerLevelMeter::Push(AmUInt32 bus, const AmReal32* samples, AmUInt32 frames) noexcept
+    {
+        if (bus >= kMaxBuses || frames == 0 || !IsEnabled())
+            return false;
+
+        MeteredBus& metered = _buses[bus];
+        if (metered.mState.load(std::memory_order_acquire) != eBusState_Active)
+            return false;
+
+        return metered.mRing->Push(samples, frames);
+    }
+
+    void ProfilerLevelMeter::Process()
+    {
+        Thread::LockMutex(_mutex);
+
+        for (MeteredBus& bus : _buses)
+        {
+            const eBusState state = bus.mState.load(std::memory_order_acquire);
+            if (state == eBusState_Free)
+                continue;
+
+            const AmUInt32 frames = bus.mRing->Pop(_interleaved);
+            if (frames > 0)
+                _measure(bus, frames);
+
+            if (state == eBusState_Closing)
+            {
+                ampooldelete(eMemoryPoolKind_IO, ProfilerAudioTapRing, bus.mRing);
+
+                bus.mRing = nullptr;
+                bus.mName.clear();
+                bus.mState.store(eBusState_Free, std::memory_order_release);
+            }
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerLevelMeter::Collect(std::vector<ProfilerBusLevels>& buses)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (MeteredBus& bus : _buses)
+        {
+            if (bus.mState.load(std::memory_order_acquire) != eBusState_Active)
+                continue;
+
+            const AmUInt64 dropped = bus.mRing->mDropped.load(std::memory_order_relaxed);
+            if (bus.mFrames == 0 && dropped == bus.mReportedDropped)
+                continue;
+
+            ProfilerBusLevels& levels = buses.emplace_back();
+            levels.mName = bus.mName;
+            levels.mChannels = bus.mChannels;
+            levels.mFrames = bus.mFrames;
+            levels.mPeakDbfs.resize(bus.mChannels);
+            levels.mRmsDbfs.resize(bus.mChannels);
+            levels.mLoudnessShortTerm = _shortTermLoudness(bus);
+            levels.mClippedSamples = bus.mClipped;
+            levels.mDroppedFrames = dropped - bus.mReportedDropped;
+
+            for (AmUInt32 c = 0; c < bus.mChannels; ++c)
+            {
+                levels.mPeakDbfs[c] = ToDecibels(bus.mPeak[c]);
+                levels.mRmsDbfs[c] = ToDecibels(std::sqrt(bus.mSquares[c] / static_cast<AmReal64>(std::max<AmUInt64>(bus.mFrames, 1))));
+            }
+
+            bus.mPeak = {};
+            bus.mSquares = {};
+            bus.mFrames = 0;
+            bus.mClipped = 0;
+            bus.mReportedDropped = dropped;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerLevelMeter::_measure(MeteredBus& bus, AmUInt32 frames)
+    {
+        const AmUInt32 channels = bus.mChannels;
+
+        // Split at the loudness block boundaries, so each block sums exactly 100 ms
+        for (AmUInt32 offset = 0; offset < frames;)
+        {
+            const AmUInt32 count = std::min(frames - offset, bus.mBlockFrames - bus.mBlockPosition);
+            _channel.resize(count);
+
+            for (AmUInt32 c = 0; c < channels; ++c)
+            {
+                const AmReal32* source = _interleaved.data() + static_cast<AmSize>(offset) * channels + c;
+                for (AmUInt32 i = 0; i < count; ++i)
+                    _channel[i] = source[static_cast<AmSize>(i) * channels];
+
+                MeasureLevels(_channel.data(), count, bus.mPeak[c], bus.mSquares[c], bus.mClipped);
+
+                if (bus.mChannelWeights[c] == 0.0f)
+                    continue;
+
+                // The filters are recursive, so they run sample by sample, and the energy of their output is vectorized
+                std::array<AmReal64, 4>& state = bus.mFilterState[c];
+                const Biquad& shelf = bus.mShelf;
+                const Biquad& highPass = bus.mHighPass;
+
+                for (AmUInt32 i = 0; i < count; ++i)
+                {
+                    const AmReal64 input = _channel[i];
+                    const AmReal64 shelved = shelf.mB0 * input + state[0];
+                    state[0] = shelf.mB1 * input - shelf.mA1 * shelved + state[1];
+                    state[1] = shelf.mB2 * input - shelf.mA2 * shelved;
+
+                    const AmReal64 output = highPass.mB0 * shelved + state[2];
+                    state[2] = highPass.mB1 * shelved - highPass.mA1 * output + state[3];
+                    state[3] = highPass.mB2 * shelved - highPass.mA2 * output;
+
+                    _channel[i] = static_cast<AmReal32>(output);
+                }
+
+                // Flush the decaying state of silent buses before it turns denormal
+                for (AmReal64& value : state)
+                {
+                    if (std::fabs(value) < 1e-30)
+                        value = 0.0;
+                }
+
+                bus.mBlockEnergy[c] += SumSquares(_channel.data(), count);
+            }
+
+            bus.mFrames += count;
+            bus.mBlockPosition += count;
+            offset += count;
+
+            if (bus.mBlockPosition == bus.mBlockFrames)
+                _closeBlock(bus);
+        }
+    }
+
+    void ProfilerLevelMeter::_closeBlock(MeteredBus& bus)
+    {
+        AmReal64 energy = 0.0;
+        for (AmUInt32 c = 0; c < bus.mChannels; ++c)
+            energy += bus.mChannelWeights[c] * bus.mBlockEnergy[c];
+
+        bus.mBlocks[bus.mBlockCount % kShortTermBlocks] = energy / static_cast<AmReal64>(bus.mBlockFrames);
+        bus.mBlockCount++;
+
+        bus.mBlockEnergy = {};
+        bus.mBlockPosition = 0;
+    }
+
+    AmReal32 ProfilerLevelMeter::_shortTermLoudness(const MeteredBus& bus)
+    {
+        // Until 3 seconds are measured, the window is the blocks measured so far
+        const AmUInt32 count = std::min(bus.mBlockCount, kShortTermBlocks);
+        if (count == 0)
+            return ProfilerBusLevels::kSilenceDb;
+
+        AmReal64 energy = 0.0;
+        for (AmUInt32 i = 0; i < count; ++i)
+            energy += bus.mBlocks[i];
+
+        energy /= static_cast<AmReal64>(count);
+        if (energy <= 0.0)
+            return ProfilerBusLevels::kSilenceDb;
+
+        return std::max(static_cast<AmReal32>(-0.691 + 10.0 * std::log10(energy)), ProfilerBusLevels::kSilenceDb);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
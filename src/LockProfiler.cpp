@@ -0,0 +1,372 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LockProfiler.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        constexpr AmSize kMaxNameSize = 64;
+
+        // Counters of a lock in a thread's table. Written by that thread only, read by Collect().
+        struct LockCounters
+        {
+            std::atomic<AmUInt64> mAcquisitions;
+            std::atomic<AmUInt64> mContentions;
+            std::atomic<AmUInt64> mWaitNs;
+            std::atomic<AmUInt64> mMaxWaitNs;
+            std::atomic<AmUInt64> mHoldNs;
+            std::atomic<AmUInt64> mMaxHoldNs;
+
+            // Holder which made this thread wait the longest, tracked as a majority vote weighted by wait time
+            std::atomic<AmUInt64> mHolder;
+            std::atomic<AmUInt64> mHolderWeight;
+
+            std::atomic<AmUInt64> mWaitBuckets[ProfilerLockStats::kWaitBucketCount];
+        };
+
+        struct ThreadTable
+        {
+            std::atomic<bool> mInUse;
+            std::atomic<AmUInt64> mThread;
+            LockCounters mLocks[ProfilerLockProfiler::kMaxLocks];
+            ThreadTable* mNext;
+        };
+
+        // Returns the calling thread's table to the free list when the thread exits
+        struct ThreadTableOwner
+        {
+            ThreadTable* mTable = nullptr;
+
+            ~ThreadTableOwner()
+            {
+                if (mTable != nullptr)
+                    mTable->mInUse.store(false, std::memory_order_release);
+            }
+        };
+
+        std::atomic<bool> gEnabled = false;
+
+        // Every table ever allocated, they are reused but never freed
+        std::atomic<ThreadTable*> gTables = nullptr;
+
+        char gLockNames[ProfilerLockProfiler::kMaxLocks][kMaxNameSize] = {};
+        std::atomic<AmUInt32> gLockCount = 0;
+
+        thread_local ThreadTableOwner gThreadTable;
+
+        AmMutexHandle GetRegistryMutex()
+        {
+            static AmMutexHandle mutex = Thread::CreateMutex();
+            return mutex;
+        }
+
+        void Add(std::atomic<AmUInt64>& counter, AmUInt64 value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void Max(std::atomic<AmUInt64>& counter, AmUInt64 value)
+        {
+            if (value > counter.load(std::memory_order_relaxed))
+                counter.store(value, std::memory_order_relaxed);
+        }
+
+        ThreadTable* AcquireTable()
+        {
+            const AmUInt64 thread = ProfilerLockProfiler::GetCurrentThread();
+
+            for (ThreadTable* table = gTables.load(std::memory_order_acquire); table != nullptr; table = table->mNext)
+            {
+                bool inUse = false;
+                if (table->mInUse.compare_exchange_strong(inUse, true, std::memory_order_acq_rel))
+                {
+                    table->mThread.store(thread, std::memory_order_relaxed);
+                    return table;
+                }
+            }
+
+            // Zero-initialized, the counters of a recycled table keep adding up since the totals are cumulative
+            auto* table = new ThreadTable();
+            table->mInUse.store(true, std::memory_order_relaxed);
+            table->mThread.store(thread, std::memory_order_relaxed);
+            table->mNext = gTables.load(std::memory_order_relaxed);
+
+            while (!gTables.compare_exchange_weak(table->mNext, table, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+
+            return table;
+        }
+
+        LockCounters& GetCounters(AmUInt32 lock)
+        {
+            if (gThreadTable.mTable == nullptr)
+                gThreadTable.mTable = AcquireTable();
+
+            return gThreadTable.mTable->mLocks[lock];
+        }
+    } // namespace
+
+    AmSize ProfilerLockStats::GetWaitBucket(AmUInt64 waitNs)
+    {
+        if (waitNs < 2)
+            return static_cast<AmSize>(waitNs);
+
+        const auto exponent = static_cast<AmSize>(std::bit_width(waitNs) - 1);
+        const AmSize half = (waitNs >> (exponent - 1)) & 1;
+        return std::min(exponent * 2 + half, kWaitBucketCount - 1);
+    }
+
+    AmUInt64 ProfilerLockStats::GetWaitBucketUpperBoundNs(AmSize bucket)
+    {
+        if (bucket < 2)
+            return bucket;
+
+        const AmSize exponent = bucket / 2;
+        const AmUInt64 lower = (1ull << exponent) + (bucket % 2) * (1ull << (exponent - 1));
+        return lower + (1ull << (exponent - 1)) - 1;
+    }
+
+    AmUInt64 ProfilerLockStats::GetWaitPercentileNs(AmReal64 percentile) const
+    {
+        AmUInt64 total = 0;
+        for (const AmUInt64 count : mWaitBuckets)
+            total += count;
+
+        if (total == 0)
+            return 0;
+
+        const auto rank = static_cast<AmUInt64>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<AmReal64>(total)));
+
+        AmUInt64 seen = 0;
+        for (AmSize i = 0; i < kWaitBucketCount; ++i)
+        {
+            seen += mWaitBuckets[i];
+            if (seen >= std::max<AmUInt64>(rank, 1))
+                return std::min(GetWaitBucketUpperBoundNs(i), mMaxWaitNs);
+        }
+
+        return mMaxWaitNs;
+    }
+
+    void ProfilerLockProfiler::SetEnabled(bool enabled)
+    {
+        gEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool ProfilerLockProfiler::IsEnabled()
+    {
+        return gEnabled.load(std::memory_order_relaxed);
+    }
+
+    AmUInt32 ProfilerLockProfiler::RegisterLock(const char* name)
+    {
+        AmMutexHandle mutex = GetRegistryMutex();
+        Thread::LockMutex(mutex);
+
+        const AmUInt32 count = gLockCount.load(std::memory_order_relaxed);
+        for (AmUInt32 i = 0; i < count; ++i)
+        {
+            if (std::strncmp(gLockNames[i], name, kMaxNameSize - 1) == 0)
+            {
+                Thread::UnlockMutex(mutex);
+                return i;
+            }
+        }
+
+        if (count >= kMaxLocks)
+        {
+            Thread::UnlockMutex(mutex);
+            amLogWarning("[ProfilerLockProfiler] Cannot register lock '%s': %u locks already registered", name, kMaxLocks);
+            return kInvalidLock;
+        }
+
+        std::strncpy(gLockNames[count], name, kMaxNameSize - 1);
+        gLockCount.store(count + 1, std::memory_order_release);
+
+        Thread::UnlockMutex(mutex);
+        return count;
+    }
+
+    void ProfilerLockProfiler::RecordWait(AmUInt32 lock, AmUInt64 waitNs, AmUInt64 holder)
+    {
+        if (lock >= kMaxLocks)
+            return;
+
+        LockCounters& counters = GetCounters(lock);
+        Add(counters.mAcquisitions, 1);
+        Add(counters.mWaitNs, waitNs);
+        Max(counters.mMaxWaitNs, waitNs);
+        Add(counters.mWaitBuckets[ProfilerLockStats::GetWaitBucket(waitNs)], 1);
+
+        if (holder == 0)
+            return;
+
+        Add(counters.mContentions, 1);
+
+        const AmUInt64 weight = counters.mHolderWeight.load(std::memory_order_relaxed);
+        if (counters.mHolder.load(std::memory_order_relaxed) == holder)
+        {
+            counters.mHolderWeight.store(weight + waitNs, std::memory_order_relaxed);
+        }
+        else if (weight <= waitNs)
+        {
+            counters.mHolder.store(holder, std::memory_order_relaxed);
+            counters.mHolderWeight.store(waitNs - weight, std::memory_order_relaxed);
+        }
+        else
+        {
+            counters.mHolderWeight.store(weight - waitNs, std::memory_order_relaxed);
+        }
+    }
+
+    void ProfilerLockProfiler::RecordHold(AmUInt32 lock, AmUInt64 holdNs)
+    {
+        if (lock >= kMaxLocks)
+            return;
+
+        LockCounters& counters = GetCounters(lock);
+        Add(counters.mHoldNs, holdNs);
+        Max(counters.mMaxHoldNs, holdNs);
+    }
+
+    void ProfilerLockProfiler::Collect(std::vector<ProfilerLockStats>& stats)
+    {
+        const AmUInt32 count = gLockCount.load(std::memory_order_acquire);
+
+        stats.assign(count, ProfilerLockStats());
+        for (AmUInt32 i = 0; i < count; ++i)
+            stats[i].mName = gLockNames[i];
+
+        std::vector<AmUInt64> waiterWaitNs(count, 0);
+        std::vector<AmUInt64> holderWeights(count, 0);
+
+        for (ThreadTable* table = gTables.load(std::memory_order_acquire); table != nullptr; table = table->mNext)
+        {
+            const AmUInt64 thread = table->mThread.load(std::memory_order_relaxed);
+
+            for (AmUInt32 i = 0; i < count; ++i)
+            {
+                const LockCounters& counters = table->mLocks[i];
+                ProfilerLockStats& lock = stats[i];
+
+                const AmUInt64 waitNs = counters.mWaitNs.load(std::memory_order_relaxed);
+                lock.mAcquisitions += counters.mAcquisitions.load(std::memory_order_relaxed);
+                lock.mContentions += counters.mContentions.load(std::memory_order_relaxed);
+                lock.mWaitNs += waitNs;
+                lock.mMaxWaitNs = std::max(lock.mMaxWaitNs, counters.mMaxWaitNs.load(std::memory_order_relaxed));
+                lock.mHoldNs += counters.mHoldNs.load(std::memory_order_relaxed);
+                lock.mMaxHoldNs = std::max(lock.mMaxHoldNs, counters.mMaxHoldNs.load(std::memory_order_relaxed));
+
+                for (AmSize b = 0; b < ProfilerLockStats::kWaitBucketCount; ++b)
+                    lock.mWaitBuckets[b] += counters.mWaitBuckets[b].load(std::memory_order_relaxed);
+
+                if (waitNs > waiterWaitNs[i])
+                {
+                    waiterWaitNs[i] = waitNs;
+                    lock.mTopWaiterThread = thread;
+                }
+
+                if (const AmUInt64 weight = counters.mHolderWeight.load(std::memory_order_relaxed); weight > holderWeights[i])
+                {
+                    holderWeights[i] = weight;
+                    lock.mTopHolderThread = counters.mHolder.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    AmUInt64 ProfilerLockProfiler::Now()
+    {
+        return static_cast<AmUInt64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    AmUInt64 ProfilerLockProfiler::GetCurrentThread()
+    {
+        thread_local const AmUInt64 thread = static_cast<AmUInt64>(Thread::GetCurrentThreadId()) + 1;
+        return thread;
+    }
+
+    ProfilerMutex::ProfilerMutex(const char* name)
+        : _handle(Thread::CreateMutex())
+        , _lock(ProfilerLockProfiler::RegisterLock(name))
+        , _owner(0)
+        , _depth(0)
+        , _acquiredNs(0)
+    {
+    }
+
+    ProfilerMutex::~ProfilerMutex()
+    {
+        if (_handle)
+            Thread::DestroyMutex(_handle);
+    }
+
+    void ProfilerMutex::Lock()
+    {
+        const AmUInt64 self = ProfilerLockProfiler::GetCurrentThread();
+
+        // Nested acquisition, measured as part of the outermost one
+        if (_owner.load(std::memory_order_relaxed) == self)
+        {
+            Thread::LockMutex(_handle);
+            ++_depth;
+            return;
+        }
+
+        if (!ProfilerLockProfiler::IsEnabled())
+        {
+            Thread::LockMutex(_handle);
+            _owner.store(self, std::memory_order_relaxed);
+            _depth = 1;
+            _acquiredNs = 0;
+            return;
+        }
+
+        const AmUInt64 holder = _owner.load(std::memory_order_relaxed);
+        const AmUInt64 start = ProfilerLockProfiler::Now();
+
+        Thread::LockMutex(_handle);
+
+        const AmUInt64 acquired = ProfilerLockProfiler::Now();
+        _owner.store(self, std::memory_order_relaxed);
+        _depth = 1;
+        _acquiredNs = acquired;
+
+        ProfilerLockProfiler::RecordWait(_lock, acquired - start, holder);
+    }
+
+    void ProfilerMutex::Unlock()
+    {
+        if (--_depth == 0)
+        {
+            if (_acquiredNs != 0)
+                ProfilerLockProfiler::RecordHold(_lock, ProfilerLockProfiler::Now() - _acquiredNs);
+
+            _owner.store(0, std::memory_order_relaxed);
+        }
+
+        Thread::UnlockMutex(_handle);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,532 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/Core/Thread.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LogSink.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        constexpr AmInt64 kRateWindowNs = 1000000000;
+
+        struct Cell
+        {
+            std::atomic<AmUInt64> mSequence;
+            ProfilerLogRecord mRecord;
+        };
+
+        // Every site ever used, so suppressed messages can be reported even if the site never logs again
+        std::atomic<ProfilerLogSite*> gSites = nullptr;
+
+        std::atomic<bool> gRunning = false;
+        std::atomic<AmUInt32> gActiveWriters = 0; // Producers between _acquire() and _publish()
+        std::atomic<eLogMessageLevel> gLevel = eLogMessageLevel_Debug;
+        std::atomic<AmUInt32> gRateLimit = ProfilerLogSink::kDefaultRateLimit;
+        std::atomic<AmUInt64> gDropped = 0;
+
+        // Ring, written by producers and read by the writing thread only
+        Cell* gCells = nullptr;
+        AmUInt64 gMask = 0;
+        std::atomic<AmUInt64> gTail = 0;
+        AmUInt64 gHead = 0;
+
+        AmThreadHandle gThread = nullptr;
+        std::atomic<bool> gThreadRunning = false;
+        std::ofstream gFile;
+
+        AmInt64 GetSteadyTimeNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        const char* LevelToString(eLogMessageLevel level)
+        {
+            switch (level)
+            {
+            case eLogMessageLevel_Debug:
+                return "DEBUG";
+            case eLogMessageLevel_Info:
+                return "INFO";
+            case eLogMessageLevel_Warning:
+                return "WARNING";
+            case eLogMessageLevel_Error:
+                return "ERROR";
+            case eLogMessageLevel_Critical:
+                return "CRITICAL";
+            case eLogMessageLevel_Success:
+                return "SUCCESS";
+            default:
+                return "INFO";
+            }
+        }
+
+        void AppendLinePrefix(std::string& output, AmInt64 timestampNs, eLogMessageLevel level, AmUInt64 threadId)
+        {
+            const auto seconds = static_cast<std::time_t>(timestampNs / 1000000000);
+            const auto milliseconds = static_cast<int>((timestampNs / 1000000) % 1000);
+
+            std::tm time = {};
+#if AM_PLATFORM_WINDOWS
+            localtime_s(&time, &seconds);
+#else
+            localtime_r(&seconds, &time);
+#endif
+
+            char buffer[96];
+            const AmSize length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &time);
+            std::snprintf(
+                buffer + length, sizeof(buffer) - length, ".%03d [%s] [%llu] ", milliseconds, LevelToString(level),
+                static_cast<unsigned long long>(threadId));
+
+            output += buffer;
+        }
+
+        template<typename T>
+        void AppendFormatted(std::string& output, const std::string& spec, T value)
+        {
+            char buffer[128];
+            const int length = std::snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+            if (length > 0)
+                output.append(buffer, std::min<AmSize>(length, sizeof(buffer) - 1));
+        }
+
+        // Formats a printf-style message from captured arguments, one conversion at a time
+        void AppendMessage(std::string& output, const ProfilerLogRecord& record)
+        {
+            const char* format = record.mSite->mFormat;
+            AmUInt32 argument = 0;
+
+            while (*format != '\0')
+            {
+                if (*format != '%')
+                {
+                    output += *format++;
+                    continue;
+                }
+
+                if (format[1] == '%')
+                {
+                    output += '%';
+                    format += 2;
+                    continue;
+                }
+
+                // Keep flags, width and precision, and replace the length modifier to match the captured type
+                std::string spec = "%";
+                ++format;
+                while (*format != '\0' && std::strchr("-+ #0123456789.", *format) != nullptr)
+                    spec += *format++;
+                while (*format != '\0' && std::strchr("hljztL", *format) != nullptr)
+                    ++format;
+
+                const char conversion = *format;
+                if (conversion == '\0')
+                    break;
+
+                ++format;
+
+                if (argument >= record.mArgumentCount)
+                {
+                    output += "(missing)";
+                    continue;
+                }
+
+                const AmUInt32 index = argument++;
+                const auto type = record.mTypes[index];
+                const AmUInt64 value = record.mArguments[index];
+
+                AmReal64 real = 0.0;
+                std::memcpy(&real, &value, sizeof(real));
+
+                switch (conversion)
+                {
+                case 'd':
+                case 'i':
+                    if (type == ProfilerLogRecord::eArgumentType_Double)
+                        AppendFormatted(output, spec + "lld", static_cast<long long>(real));
+                    else
+                        AppendFormatted(output, spec + "lld", static_cast<long long>(value));
+                    break;
+                case 'u':
+                case 'x':
+                case 'X':
+                case 'o':
+                    AppendFormatted(output, spec + "ll" + conversion, static_cast<unsigned long long>(value));
+                    break;
+                case 'c':
+                    AppendFormatted(output, spec + "c", static_cast<int>(value));
+                    break;
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                    if (type == ProfilerLogRecord::eArgumentType_Double)
+                        AppendFormatted(output, spec + conversion, real);
+                    else if (type == ProfilerLogRecord::eArgumentType_Int)
+                        AppendFormatted(output, spec + conversion, static_cast<AmReal64>(static_cast<AmInt64>(value)));
+                    else
+                        AppendFormatted(output, spec + conversion, static_cast<AmReal64>(value));
+                    break;
+                case 's':
+                    if (type == ProfilerLogRecord::eArgumentType_String)
+                        output.append(record.mText + (value >> 32), value & 0xFFFFFFFFull);
+                    else
+                        output += "(?)";
+                    break;
+                case 'p':
+                    AppendFormatted(output, spec + "p", reinterpret_cast<const void*>(static_cast<std::uintptr_t>(value)));
+                    break;
+                default:
+                    output += spec;
+                    output += conversion;
+                    break;
+                }
+            }
+        }
+
+        void AppendSuppressed(std::string& output, const ProfilerLogSite& site, AmUInt64 count, AmInt64 timestampNs)
+        {
+            AppendLinePrefix(output, timestampNs, site.mLevel, 0);
+            output += "dropped ";
+            output += std::to_string(count);
+            output += " messages: ";
+            output += site.mFormat;
+            output += '\n';
+        }
+
+        AmInt64 GetWallTimeNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        // Reports the messages suppressed by sites which did not log since their window ended
+        void SweepSites(std::string& output, bool all)
+        {
+            const AmInt64 now = GetSteadyTimeNs();
+            const AmInt64 wallTime = GetWallTimeNs();
+
+            for (ProfilerLogSite* site = gSites.load(std::memory_order_acquire); site != nullptr; site = site->mNext)
+            {
+                if (site->mSuppressed.load(std::memory_order_relaxed) == 0)
+                    continue;
+
+                if (!all && now - site->mWindowStartNs.load(std::memory_order_relaxed) < kRateWindowNs)
+                    continue;
+
+                if (const AmUInt64 count = site->mSuppressed.exchange(0, std::memory_order_relaxed); count > 0)
+                    AppendSuppressed(output, *site, count, wallTime);
+            }
+        }
+
+        // Formats every published record, returns the number of records read
+        AmSize DrainRing(std::string& output)
+        {
+            AmSize count = 0;
+
+            while (true)
+            {
+                Cell& cell = gCells[gHead & gMask];
+                if (cell.mSequence.load(std::memory_order_acquire) != gHead + 1)
+                    break;
+
+                const ProfilerLogRecord& record = cell.mRecord;
+                if (record.mSuppressed > 0)
+                    AppendSuppressed(output, *record.mSite, record.mSuppressed, record.mTimestampNs);
+
+                AppendLinePrefix(output, record.mTimestampNs, record.mSite->mLevel, record.mThreadId);
+                AppendMessage(output, record);
+                output += '\n';
+
+                cell.mSequence.store(gHead + gMask + 1, std::memory_order_release);
+                gHead++;
+                count++;
+            }
+
+            return count;
+        }
+    } // namespace
+
+    ProfilerLogSite::ProfilerLogSite(eLogMessageLevel level, const char* format)
+        : mFormat(format)
+        , mLevel(level)
+        , mWindowStartNs(0)
+        , mWindowCount(0)
+        , mSuppressed(0)
+        , mNext(gSites.load(std::memory_order_relaxed))
+    {
+        while (!gSites.compare_exchange_weak(mNext, this, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    bool ProfilerLogSink::Start(const AmOsString& path, eLogMessageLevel level, AmUInt32 rateLimit, AmUInt32 capacity)
+    {
+        Stop();
+
+        gFile.open(std::filesystem::path(path), std::ios::out | std::ios::app);
+        if (!gFile.is_open())
+        {
+            amLogError("[ProfilerLogSink] Failed to open log file: %s", std::filesystem::path(path).string().c_str());
+            return false;
+        }
+
+        AmUInt64 size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        gCells = static_cast<Cell*>(ampoolmalign(eMemoryPoolKind_IO, size * sizeof(Cell), alignof(Cell)));
+        for (AmUInt64 i = 0; i < size; ++i)
+        {
+            new (&gCells[i]) Cell();
+            gCells[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+
+        gMask = size - 1;
+        gTail.store(0, std::memory_order_relaxed);
+        gHead = 0;
+        gDropped.store(0, std::memory_order_relaxed);
+        gLevel.store(level, std::memory_order_relaxed);
+        gRateLimit.store(rateLimit, std::memory_order_relaxed);
+
+        gThreadRunning = true;
+        gThread = Thread::CreateThread(&ProfilerLogSink::_writeLoop);
+
+        gRunning.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void ProfilerLogSink::Stop()
+    {
+        if (!gRunning.exchange(false))
+            return;
+
+        // Let producers which already claimed a record publish it
+        while (gActiveWriters.load(std::memory_order_acquire) > 0)
+            Thread::Sleep(1);
+
+        gThreadRunning = false;
+        Thread::Wait(gThread);
+        Thread::Release(gThread);
+        gThread = nullptr;
+
+        gFile.close();
+
+        for (AmUInt64 i = 0; i <= gMask; ++i)
+            gCells[i].~Cell();
+
+        ampoolfree(eMemoryPoolKind_IO, gCells);
+        gCells = nullptr;
+        gLevel.store(eLogMessageLevel_Debug, std::memory_order_relaxed);
+    }
+
+    bool ProfilerLogSink::IsRunning()
+    {
+        return gRunning.load(std::memory_order_acquire);
+    }
+
+    void ProfilerLogSink::SetRateLimit(AmUInt32 rateLimit)
+    {
+        gRateLimit.store(rateLimit, std::memory_order_relaxed);
+    }
+
+    AmUInt64 ProfilerLogSink::GetDroppedCount()
+    {
+        return gDropped.load(std::memory_order_relaxed);
+    }
+
+    bool ProfilerLogSink::_admit(ProfilerLogSite& site, AmUInt64& suppressed)
+    {
+        if (site.mLevel < gLevel.load(std::memory_order_relaxed))
+            return false;
+
+        if (const AmUInt32 limit = gRateLimit.load(std::memory_order_relaxed); limit > 0)
+        {
+            const AmInt64 now = GetSteadyTimeNs();
+            AmInt64 windowStart = site.mWindowStartNs.load(std::memory_order_relaxed);
+
+            if (now - windowStart >= kRateWindowNs &&
+                site.mWindowStartNs.compare_exchange_strong(windowStart, now, std::memory_order_relaxed))
+                site.mWindowCount.store(0, std::memory_order_relaxed);
+
+            if (site.mWindowCount.fetch_add(1, std::memory_order_relaxed) >= limit)
+            {
+                site.mSuppressed.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        // The first message of a new window carries the count of the ones suppressed before it
+        if (site.mSuppressed.load(std::memory_order_relaxed) > 0)
+            suppressed = site.mSuppressed.exchange(0, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    ProfilerLogRecord* ProfilerLogSink::_acquire()
+    {
+        gActiveWriters.fetch_add(1, std::memory_order_acq_rel);
+
+        if (!gRunning.load(std::memory_order_acquire))
+        {
+            gActiveWriters.fetch_sub(1, std::memory_order_release);
+            return nullptr;
+        }
+
+        AmUInt64 position = gTail.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        while (true)
+        {
+            cell = &gCells[position & gMask];
+            const AmUInt64 sequence = cell->mSequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<AmInt64>(sequence - position);
+
+            if (difference == 0)
+            {
+                if (gTail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                gDropped.fetch_add(1, std::memory_order_relaxed);
+                gActiveWriters.fetch_sub(1, std::memory_order_release);
+                return nullptr;
+            }
+            else
+            {
+                position = gTail.load(std::memory_order_relaxed);
+            }
+        }
+
+        thread_local const AmUInt64 threadId = static_cast<AmUInt64>(Thread::GetCurrentThreadId());
+
+        ProfilerLogRecord* record = &cell->mRecord;
+        record->mPosition = position;
+        record->mTimestampNs = GetWallTimeNs();
+        record->mThreadId = threadId;
+
+        return record;
+    }
+
+    void ProfilerLogSink::_publish(ProfilerLogRecord* record)
+    {
+        gCells[record->mPosition & gMask].mSequence.store(record->mPosition + 1, std::memory_order_release);
+        gActiveWriters.fetch_sub(1, std::memory_order_release);
+    }
+
+    void ProfilerLogSink::_forward(const ProfilerLogSite& site, AmUInt64 suppressed, ...)
+    {
+        char buffer[1024];
+
+        va_list args;
+        va_start(args, suppressed);
+        std::vsnprintf(buffer, sizeof(buffer), site.mFormat, args);
+        va_end(args);
+
+        if (suppressed > 0)
+        {
+            const AmSize length = std::strlen(buffer);
+            std::snprintf(
+                buffer + length, sizeof(buffer) - length, " (dropped %llu similar messages)", static_cast<unsigned long long>(suppressed));
+        }
+
+        switch (site.mLevel)
+        {
+        case eLogMessageLevel_Debug:
+            amLogDebug("%s", buffer);
+            break;
+        case eLogMessageLevel_Warning:
+            amLogWarning("%s", buffer);
+            break;
+        case eLogMessageLevel_Error:
+            amLogError("%s", buffer);
+            break;
+        case eLogMessageLevel_Critical:
+            amLogCritical("%s", buffer);
+            break;
+        default:
+            amLogInfo("%s", buffer);
+            break;
+        }
+    }
+
+    void ProfilerLogSink::_writeLoop([[maybe_unused]] AmVoidPtr userData)
+    {
+        std::string output;
+        AmInt64 lastSweep = GetSteadyTimeNs();
+        AmUInt64 reportedDropped = 0;
+
+        while (true)
+        {
+            const bool running = gThreadRunning.load(std::memory_order_acquire);
+
+            output.clear();
+            const AmSize count = DrainRing(output);
+
+            const AmInt64 now = GetSteadyTimeNs();
+            if (!running || now - lastSweep >= kRateWindowNs)
+            {
+                SweepSites(output, !running);
+                lastSweep = now;
+
+                if (const AmUInt64 dropped = gDropped.load(std::memory_order_relaxed); dropped > reportedDropped)
+                {
+                    AppendLinePrefix(output, GetWallTimeNs(), eLogMessageLevel_Warning, 0);
+                    output += "dropped " + std::to_string(dropped - reportedDropped) + " messages: the log buffer is full\n";
+                    reportedDropped = dropped;
+                }
+            }
+
+            if (!output.empty())
+            {
+                gFile.write(output.data(), static_cast<std::streamsize>(output.size()));
+                gFile.flush();
+            }
+
+            if (!running)
+                break;
+
+            if (count == 0)
+                Thread::Sleep(1);
+        }
+    }
+
+    void ProfilerLogSink::_captureString(ProfilerLogRecord& record, std::string_view value)
+    {
+        const AmUInt32 index = record.mArgumentCount++;
+        const AmSize size = std::min<AmSize>(value.size(), ProfilerLogRecord::kTextSize - record.mTextSize);
+
+        std::memcpy(record.mText + record.mTextSize, value.data(), size);
+
+        record.mTypes[index] = ProfilerLogRecord::eArgumentType_String;
+        record.mArguments[index] = (static_cast<AmUInt64>(record.mTextSize) << 32) | size;
+        record.mTextSize += static_cast<AmUInt32>(size);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
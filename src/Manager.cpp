@@ -14,11 +14,50 @@
 
 #include <SparkyStudios/Audio/Amplitude/Core/Engine.h>
 #include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LogSink.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Manager.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Server.h>
 
+#include <algorithm>
+#include <filesystem>
+
 namespace SparkyStudios::Audio::Amplitude
 {
+    namespace
+    {
+        constexpr std::array<const char*, kProfilerCategoryCount> kCategoryNames = {
+            "engine", "entity", "channel", "listener", "environment", "performance", "memory", "events", "aggregate",
+        };
+
+        // Statistics of a lock since the previous totals, maximums stay totals
+        ProfilerLockStats GetLockInterval(const ProfilerLockStats& current, const ProfilerLockStats* previous)
+        {
+            ProfilerLockStats interval = current;
+            if (previous == nullptr)
+                return interval;
+
+            interval.mAcquisitions -= previous->mAcquisitions;
+            interval.mContentions -= previous->mContentions;
+            interval.mWaitNs -= previous->mWaitNs;
+            interval.mHoldNs -= previous->mHoldNs;
+
+            for (AmSize i = 0; i < ProfilerLockStats::kWaitBucketCount; ++i)
+                interval.mWaitBuckets[i] -= previous->mWaitBuckets[i];
+
+            return interval;
+        }
+
+        eProfilerCategory GetMessageCategory(const ProfilerDataVariant& data)
+        {
+            return std::visit(
+                [](const auto& arg)
+                {
+                    return arg.mCategory;
+                },
+                data);
+        }
+    } // namespace
+
     // Static member definitions
     AmUniquePtr<ProfilerManager, eMemoryPoolKind_Engine> ProfilerManager::_sInstance = nullptr;
     AmMutexHandle ProfilerManager::_sInstanceMutex = nullptr;
@@ -51,32 +90,47 @@ namespace SparkyStudios::Audio::Amplitude
         , _enabled(false)
         , _running(false)
         , _updateThread(nullptr)
+        , _configMutex("ProfilerManager::Config")
+        , _dumpThread(nullptr)
+        , _dumpRunning(false)
+        , _dumpMutex("ProfilerManager::Dumps")
         , _updateInterval(1.0f / 30.0f) // 30 FPS default
+        , _nextStatisticsEvent(std::chrono::high_resolution_clock::now())
+        , _nextLockStatsEvent(std::chrono::high_resolution_clock::now())
+        , _nextStackSamplesEvent(std::chrono::high_resolution_clock::now())
+        , _nextPerfCountersEvent(std::chrono::high_resolution_clock::now())
+        , _nextAudioLevelsEvent(std::chrono::high_resolution_clock::now())
         , _lastUpdate(std::chrono::high_resolution_clock::now())
+        , _callbackMutex("ProfilerManager::Callback")
     {
-        _configMutex = Thread::CreateMutex();
-        _statisticsMutex = Thread::CreateMutex();
-        _callbackMutex = Thread::CreateMutex();
-
         _messageQueue = AmUniquePtr<ProfilerMessageQueue, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerMessageQueue));
         _messagePool = AmUniquePtr<ProfilerMessagePool, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerMessagePool));
-
-        // Initialize statistics
-        Thread::LockMutex(_statisticsMutex);
-        _statistics = {};
-        Thread::UnlockMutex(_statisticsMutex);
+        _realtime = AmUniquePtr<ProfilerRealtimeCapture, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerRealtimeCapture));
+        _jobs = AmUniquePtr<ProfilerJobTracker, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerJobTracker));
+        _sampler = AmUniquePtr<ProfilerStackSampler, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerStackSampler));
+        _sampledThreads.fill(ProfilerStackSampler::kInvalidThread);
+        _perf = AmUniquePtr<ProfilerPerfCounters, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerPerfCounters));
+        _countedThreads.fill(ProfilerPerfCounters::kInvalidThread);
+        _heartbeatCountersValid.fill(false);
+        _audioCallbackScope = _perf->RegisterScope("AudioCallback");
+        _levels = AmUniquePtr<ProfilerLevelMeter, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerLevelMeter));
+        _recordingWriter =
+            AmUniquePtr<ProfilerRecordingWriter, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerRecordingWriter));
+        _flightRecorder = AmUniquePtr<ProfilerFlightRecorder, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerFlightRecorder));
+        _watchdog = AmUniquePtr<ProfilerWatchdog, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerWatchdog));
+        _stallDumpCount = 0;
+        _aggregator = AmUniquePtr<ProfilerAggregator, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerAggregator));
+        _alerts = AmUniquePtr<ProfilerAlertEvaluator, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerAlertEvaluator));
+        _anomalyDetector =
+            AmUniquePtr<ProfilerAnomalyDetector, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerAnomalyDetector));
+        _alertDumpCount = 0;
+        _boostEndNs = 0;
+        _boostInterval = 0.0f;
     }
 
     ProfilerManager::~ProfilerManager()
     {
         Deinitialize();
-
-        if (_configMutex)
-            Thread::DestroyMutex(_configMutex);
-        if (_statisticsMutex)
-            Thread::DestroyMutex(_statisticsMutex);
-        if (_callbackMutex)
-            Thread::DestroyMutex(_callbackMutex);
     }
 
     bool ProfilerManager::Initialize(const ProfilerConfig& config)
@@ -88,21 +142,28 @@ namespace SparkyStudios::Audio::Amplitude
         }
 
         {
-            Thread::LockMutex(_configMutex);
+            _configMutex.Lock();
             _config = config;
 
             // Validate configuration
             if (!_config.Validate())
             {
                 amLogError("[ProfilerManager] Invalid profiler configuration");
-                Thread::UnlockMutex(_configMutex);
+                _configMutex.Unlock();
                 return false;
             }
 
             _updateInterval = 1.0f / _config.mUpdateFrequencyHz;
-            Thread::UnlockMutex(_configMutex);
+            _configMutex.Unlock();
         }
 
+        // Start logging first, so the rest of the initialization is logged to the file
+        ConfigureLogging(_config);
+        ConfigureLockProfiling(_config);
+        ConfigureJobProfiling(_config);
+        ConfigurePerfCounters(_config);
+        ConfigureLevelMetering(_config);
+
         // Initialize data collector
         _dataCollector = AmUniquePtr<ProfilerDataCollector, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerDataCollector));
 
@@ -116,11 +177,25 @@ namespace SparkyStudios::Audio::Amplitude
             }
         }
 
+        // Start recording if enabled, a failure here does not prevent live profiling
+        if (_config.mEnableRecording)
+            StartRecording(std::filesystem::path(_config.mRecordingPath).native());
+
+        ConfigureFlightRecorder(_config);
+        PreallocateBuffers(_config);
+        ConfigureWatchdog(_config);
+        ConfigureStackSampling(_config);
+        ConfigureAggregator(_config);
+        ConfigureAlerts(_config);
+        ConfigureAnomalyDetector(_config);
+
         // Start update thread
+        StartDumpThread();
         StartUpdateThread();
 
         _initialized = true;
         _enabled = true;
+        UpdateRealtimeCategoryMask();
 
         amLogInfo("[ProfilerManager] Profiler system initialized successfully");
         return true;
@@ -144,6 +219,7 @@ namespace SparkyStudios::Audio::Amplitude
             return;
 
         _enabled = false;
+        UpdateRealtimeCategoryMask();
 
         // Stop update thread
         StopUpdateThread();
@@ -151,8 +227,28 @@ namespace SparkyStudios::Audio::Amplitude
         // Stop network server
         StopNetworkServer();
 
-        // Clear queued messages
+        // Write the footer of the recording
+        StopRecording();
+
+        // Stop watching audio threads before the flight recorder goes away
+        _watchdog->Stop();
+        _sampler->Stop();
+
+        // Write the dumps they queued
+        StopDumpThread();
+
+        // Restore the previous crash handlers
+        _flightRecorder->Deinitialize();
+
+        // Clear queued messages and pending windows
         _messageQueue->Clear();
+        _aggregator->Clear();
+        _alerts->Clear();
+        _anomalyDetector->Clear();
+        ProfilerLockProfiler::SetEnabled(false);
+        _jobs->SetEnabled(false);
+        _perf->SetEnabled(false);
+        _levels->SetEnabled(false);
 
         // Clean up
         _dataCollector.reset();
@@ -168,6 +264,9 @@ namespace SparkyStudios::Audio::Amplitude
         _initialized = false;
 
         amLogInfo("[ProfilerManager] Profiler system deinitialized");
+
+        // Write the pending log messages
+        ProfilerLogSink::Stop();
     }
 
     bool ProfilerManager::UpdateConfig(const ProfilerConfig& newConfig)
@@ -178,11 +277,21 @@ namespace SparkyStudios::Audio::Amplitude
             return false;
         }
 
-        Thread::LockMutex(_configMutex);
+        _configMutex.Lock();
         ProfilerConfig oldConfig = _config;
         _config = newConfig;
         _updateInterval = 1.0f / _config.mUpdateFrequencyHz;
-        Thread::UnlockMutex(_configMutex);
+        _configMutex.Unlock();
+
+        if (oldConfig.mEnableLogging != newConfig.mEnableLogging || oldConfig.mLoggingLevel != newConfig.mLoggingLevel ||
+            oldConfig.mLogFilePath != newConfig.mLogFilePath)
+        {
+            ConfigureLogging(newConfig);
+        }
+        else
+        {
+            ProfilerLogSink::SetRateLimit(newConfig.mLogRateLimit);
+        }
 
         // Restart network server if network settings changed
         if (oldConfig.mEnableNetworking != newConfig.mEnableNetworking || oldConfig.mServerPort != newConfig.mServerPort ||
@@ -194,6 +303,103 @@ namespace SparkyStudios::Audio::Amplitude
                 StartNetworkServer();
             }
         }
+        else if (_networkServer)
+        {
+            _networkServer->SetDefaultRateLimits(newConfig.mClientMaxMessagesPerSecond, newConfig.mClientMaxBytesPerSecond);
+            _networkServer->SetBusyThreshold(newConfig.mNetworkBusyThreshold);
+
+            if (oldConfig.mEnableSharedMemoryTransport != newConfig.mEnableSharedMemoryTransport ||
+                oldConfig.mSharedMemoryName != newConfig.mSharedMemoryName || oldConfig.mSharedMemorySize != newConfig.mSharedMemorySize)
+            {
+                _networkServer->StopSharedMemoryTransport();
+                if (newConfig.mEnableSharedMemoryTransport)
+                    _networkServer->StartSharedMemoryTransport(newConfig.mSharedMemoryName, newConfig.mSharedMemorySize);
+            }
+
+            if (oldConfig.mEnableMulticast != newConfig.mEnableMulticast || oldConfig.mMulticastGroup != newConfig.mMulticastGroup ||
+                oldConfig.mMulticastPort != newConfig.mMulticastPort || oldConfig.mMulticastTtl != newConfig.mMulticastTtl ||
+                oldConfig.mMulticastMtu != newConfig.mMulticastMtu ||
+                oldConfig.mMulticastKeyframeInterval != newConfig.mMulticastKeyframeInterval)
+            {
+                _networkServer->StopMulticastTransport();
+                if (newConfig.mEnableMulticast)
+                {
+                    _networkServer->StartMulticastTransport(
+                        newConfig.mMulticastGroup, newConfig.mMulticastPort, newConfig.mMulticastTtl, newConfig.mMulticastMtu,
+                        newConfig.mMulticastKeyframeInterval);
+                }
+            }
+        }
+
+        if (oldConfig.mEnableRecording != newConfig.mEnableRecording || oldConfig.mRecordingPath != newConfig.mRecordingPath ||
+            oldConfig.mRecordingChunkSize != newConfig.mRecordingChunkSize ||
+            oldConfig.mRecordingCompression != newConfig.mRecordingCompression ||
+            oldConfig.mRecordingCompressionThreads != newConfig.mRecordingCompressionThreads ||
+            oldConfig.mRecordingDurability != newConfig.mRecordingDurability ||
+            oldConfig.mRecordingSyncIntervalMs != newConfig.mRecordingSyncIntervalMs ||
+            oldConfig.mRecordingWriteBuffers != newConfig.mRecordingWriteBuffers)
+        {
+            StopRecording();
+            if (newConfig.mEnableRecording)
+                StartRecording(std::filesystem::path(newConfig.mRecordingPath).native());
+        }
+
+        if (oldConfig.mEnableFlightRecorder != newConfig.mEnableFlightRecorder ||
+            oldConfig.mFlightRecorderSize != newConfig.mFlightRecorderSize ||
+            oldConfig.mFlightRecorderCrashPath != newConfig.mFlightRecorderCrashPath)
+        {
+            ConfigureFlightRecorder(newConfig);
+        }
+
+        if (_messageQueue &&
+            (oldConfig.mMaxQueuedMessages != newConfig.mMaxQueuedMessages || oldConfig.mMemoryResidency != newConfig.mMemoryResidency))
+        {
+            _messageQueue->SetCapacity(newConfig.mMaxQueuedMessages);
+            _messageQueue->Prefault(newConfig.mMemoryResidency);
+            _flightRecorder->Prefault(newConfig.mMemoryResidency);
+        }
+
+        if (oldConfig.mEnableWatchdog != newConfig.mEnableWatchdog || oldConfig.mWatchdogStallPeriods != newConfig.mWatchdogStallPeriods)
+            ConfigureWatchdog(newConfig);
+
+        if (oldConfig.mEnableStackSampling != newConfig.mEnableStackSampling ||
+            oldConfig.mStackSamplingRateHz != newConfig.mStackSamplingRateHz)
+        {
+            ConfigureStackSampling(newConfig);
+        }
+
+        if (oldConfig.mEnableAggregation != newConfig.mEnableAggregation || oldConfig.mAggregateFields != newConfig.mAggregateFields ||
+            oldConfig.mAggregateWindowMs != newConfig.mAggregateWindowMs || oldConfig.mAggregateStepMs != newConfig.mAggregateStepMs)
+        {
+            ConfigureAggregator(newConfig);
+        }
+
+        if (oldConfig.mAlertRules != newConfig.mAlertRules)
+            ConfigureAlerts(newConfig);
+
+        if (oldConfig.mEnableAnomalyDetection != newConfig.mEnableAnomalyDetection ||
+            oldConfig.mAnomalyFields != newConfig.mAnomalyFields || oldConfig.mAnomalyGrowthFields != newConfig.mAnomalyGrowthFields ||
+            oldConfig.mAnomalySceneMarker != newConfig.mAnomalySceneMarker || oldConfig.mAnomalyAlpha != newConfig.mAnomalyAlpha ||
+            oldConfig.mAnomalyWarmupSamples != newConfig.mAnomalyWarmupSamples ||
+            oldConfig.mAnomalySpikeThreshold != newConfig.mAnomalySpikeThreshold ||
+            oldConfig.mAnomalyShiftThreshold != newConfig.mAnomalyShiftThreshold)
+        {
+            ConfigureAnomalyDetector(newConfig);
+        }
+
+        if (oldConfig.mEnableLockProfiling != newConfig.mEnableLockProfiling)
+            ConfigureLockProfiling(newConfig);
+
+        if (oldConfig.mEnableJobProfiling != newConfig.mEnableJobProfiling)
+            ConfigureJobProfiling(newConfig);
+
+        if (oldConfig.mEnablePerfCounters != newConfig.mEnablePerfCounters)
+            ConfigurePerfCounters(newConfig);
+
+        if (oldConfig.mEnableLevelMetering != newConfig.mEnableLevelMetering)
+            ConfigureLevelMetering(newConfig);
+
+        UpdateRealtimeCategoryMask();
 
         amLogInfo("[ProfilerManager] Configuration updated successfully");
         return true;
@@ -202,29 +408,32 @@ namespace SparkyStudios::Audio::Amplitude
     void ProfilerManager::SetEnabled(bool enabled)
     {
         _enabled = enabled;
+        UpdateRealtimeCategoryMask();
         amLogInfo("[ProfilerManager] Profiler %s", enabled ? "enabled" : "disabled");
     }
 
     void ProfilerManager::SetCategoryMask(AmUInt32 categoryMask)
     {
-        Thread::LockMutex(_configMutex);
+        _configMutex.Lock();
         _config.mCategoryMask = categoryMask;
-        Thread::UnlockMutex(_configMutex);
+        _configMutex.Unlock();
+
+        UpdateRealtimeCategoryMask();
     }
 
     void ProfilerManager::SetUpdateMode(eProfilerUpdateMode mode)
     {
-        Thread::LockMutex(_configMutex);
+        _configMutex.Lock();
         _config.mUpdateMode = mode;
-        Thread::UnlockMutex(_configMutex);
+        _configMutex.Unlock();
     }
 
     void ProfilerManager::SetUpdateFrequency(AmReal32 frequencyHz)
     {
-        Thread::LockMutex(_configMutex);
+        _configMutex.Lock();
         _config.mUpdateFrequencyHz = frequencyHz;
         _updateInterval = 1.0f / frequencyHz;
-        Thread::UnlockMutex(_configMutex);
+        _configMutex.Unlock();
     }
 
     void ProfilerManager::CaptureEngineState()
@@ -283,12 +492,15 @@ namespace SparkyStudios::Audio::Amplitude
         if (_dataCollector)
         {
             ProfilerPerformanceData data = _dataCollector->CollectPerformanceData();
+            _watchdog->CollectScheduling(data.mThreadScheduling);
             QueueMessage(std::move(data));
         }
     }
 
     void ProfilerManager::CaptureEvent(const ProfilerEvent& event)
     {
+        AM_PROFILER_ASSERT_NOT_REALTIME();
+
         if (!_enabled.load() || !ShouldCaptureCategory(eProfilerCategory_Events))
             return;
 
@@ -361,6 +573,7 @@ namespace SparkyStudios::Audio::Amplitude
         }
 
         _networkServer = AmUniquePtr<ProfilerServer, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerServer));
+        _networkServer->SetMaxBackpressure(_config.mMessageBufferSize);
 
         if (!_networkServer->Start(_config.mServerPort, _config.mBindAddress, _config.mMaxClients))
         {
@@ -369,6 +582,21 @@ namespace SparkyStudios::Audio::Amplitude
             return false;
         }
 
+        // Set up quality of service
+        _networkServer->SetDefaultRateLimits(_config.mClientMaxMessagesPerSecond, _config.mClientMaxBytesPerSecond);
+        _networkServer->SetBusyThreshold(_config.mNetworkBusyThreshold);
+
+        // Same-host consumers read from shared memory, a failure there does not prevent remote clients from connecting
+        if (_config.mEnableSharedMemoryTransport)
+            _networkServer->StartSharedMemoryTransport(_config.mSharedMemoryName, _config.mSharedMemorySize);
+
+        if (_config.mEnableMulticast)
+        {
+            _networkServer->StartMulticastTransport(
+                _config.mMulticastGroup, _config.mMulticastPort, _config.mMulticastTtl, _config.mMulticastMtu,
+                _config.mMulticastKeyframeInterval);
+        }
+
         // Set up server callbacks
         _networkServer->SetOnClientConnected(
             [](ProfilerClientID clientId, const ProfilerClientInfo& info)
@@ -407,6 +635,411 @@ namespace SparkyStudios::Audio::Amplitude
         return _networkServer != nullptr;
     }
 
+    bool ProfilerManager::StartRecording(const AmOsString& path)
+    {
+        _configMutex.Lock();
+        const AmSize chunkSize = _config.mRecordingChunkSize;
+        const eProfilerRecordingCompression compression = _config.mRecordingCompression;
+        const AmUInt32 compressionThreads = _config.mRecordingCompressionThreads;
+        const eProfilerDurability durability = _config.mRecordingDurability;
+        const AmUInt32 syncIntervalMs = _config.mRecordingSyncIntervalMs;
+        const AmUInt32 writeBuffers = _config.mRecordingWriteBuffers;
+        _configMutex.Unlock();
+
+        if (!_recordingWriter->Open(path, chunkSize, compression, compressionThreads, durability, syncIntervalMs, writeBuffers))
+        {
+            amLogError("[ProfilerManager] Failed to start recording");
+            return false;
+        }
+
+        amLogInfo("[ProfilerManager] Recording started: %s", std::filesystem::path(path).string().c_str());
+        return true;
+    }
+
+    void ProfilerManager::StopRecording()
+    {
+        if (!_recordingWriter->IsOpen())
+            return;
+
+        const AmUInt64 count = _recordingWriter->GetMessageCount();
+        _recordingWriter->Close();
+
+        amLogInfo("[ProfilerManager] Recording stopped after %llu messages", static_cast<unsigned long long>(count));
+
+        if (const AmUInt64 dropped = _recordingWriter->GetDroppedChunkCount(); dropped > 0)
+            amLogWarning(
+                "[ProfilerManager] %llu recording chunks were dropped because the disk could not keep up",
+                static_cast<unsigned long long>(dropped));
+    }
+
+    bool ProfilerManager::IsRecording() const
+    {
+        return _recordingWriter->IsOpen();
+    }
+
+    bool ProfilerManager::DumpFlightRecorder(const AmOsString& path) const
+    {
+        if (!_flightRecorder->IsInitialized())
+        {
+            amLogError("[ProfilerManager] The flight recorder is disabled");
+            return false;
+        }
+
+        return _flightRecorder->DumpToFile(path);
+    }
+
+    void ProfilerManager::ConfigureLogging(const ProfilerConfig& config)
+    {
+        ProfilerLogSink::Stop();
+        ProfilerLogSink::SetRateLimit(config.mLogRateLimit);
+
+        // Without a file, rate limited messages still go to the engine logger
+        if (config.mEnableLogging)
+            ProfilerLogSink::Start(std::filesystem::path(config.mLogFilePath).native(), config.mLoggingLevel, config.mLogRateLimit);
+    }
+
+    void ProfilerManager::ConfigureFlightRecorder(const ProfilerConfig& config)
+    {
+        _flightRecorder->Deinitialize();
+
+        if (!config.mEnableFlightRecorder)
+            return;
+
+        // A failure here does not prevent live profiling
+        if (!_flightRecorder->Initialize(config.mFlightRecorderSize))
+            return;
+
+        _flightRecorder->Prefault(config.mMemoryResidency);
+
+        if (!config.mFlightRecorderCrashPath.empty())
+            _flightRecorder->InstallCrashHandler(std::filesystem::path(config.mFlightRecorderCrashPath).native());
+    }
+
+    void ProfilerManager::PreallocateBuffers(const ProfilerConfig& config)
+    {
+        // Sized before the update thread starts, so capturing in the steady state does not allocate
+        if (!_messageQueue)
+        {
+            _messageQueue = AmUniquePtr<ProfilerMessageQueue, eMemoryPoolKind_IO>(
+                ampoolnew(eMemoryPoolKind_IO, ProfilerMessageQueue, config.mMaxQueuedMessages));
+        }
+        else
+        {
+            _messageQueue->SetCapacity(config.mMaxQueuedMessages);
+        }
+
+        _messageQueue->Prefault(config.mMemoryResidency);
+
+        _batch.reserve(config.mMaxMessagesPerFrame);
+        _lastEntityStates.reserve(config.mExpectedEntityCount);
+        _lastChannelStates.reserve(config.mExpectedChannelCount);
+        _lastListenerStates.reserve(config.mExpectedListenerCount);
+    }
+
+    AmUInt32 ProfilerManager::RegisterAudioThread(const AmString& name, AmReal64 bufferPeriodMs)
+    {
+        const AmUInt32 thread = _watchdog->RegisterThread(name, bufferPeriodMs);
+
+        // Registered even while sampling is disabled, so enabling it later covers the running threads
+        if (thread < _sampledThreads.size())
+            _sampledThreads[thread] = _sampler->RegisterThread(name);
+
+        // Counters are opened even while disabled for the same reason, the kernel does not count until they are enabled
+        if (thread < _countedThreads.size())
+        {
+            _countedThreads[thread] = _perf->RegisterThread(name);
+            _heartbeatCountersValid[thread] = false;
+        }
+
+        return thread;
+    }
+
+    void ProfilerManager::UnregisterAudioThread(AmUInt32 thread)
+    {
+        _watchdog->UnregisterThread(thread);
+
+        if (thread < _sampledThreads.size())
+        {
+            _sampler->UnregisterThread(_sampledThreads[thread]);
+            _sampledThreads[thread] = ProfilerStackSampler::kInvalidThread;
+        }
+
+        if (thread < _countedThreads.size())
+        {
+            _perf->UnregisterThread(_countedThreads[thread]);
+            _countedThreads[thread] = ProfilerPerfCounters::kInvalidThread;
+        }
+    }
+
+    void ProfilerManager::AudioHeartbeat(AmUInt32 thread)
+    {
+        _watchdog->Heartbeat(thread);
+
+        if (thread >= _countedThreads.size() || !_perf->IsEnabled())
+            return;
+
+        // Counters only run with their thread, so the work between two heartbeats is the work of one callback
+        ProfilerPerfSample counters;
+        if (!_perf->Read(_countedThreads[thread], counters))
+            return;
+
+        if (_heartbeatCountersValid[thread])
+            _perf->Accumulate(_countedThreads[thread], _audioCallbackScope, _heartbeatCounters[thread], counters);
+
+        _heartbeatCounters[thread] = counters;
+        _heartbeatCountersValid[thread] = true;
+    }
+
+    AmUInt32 ProfilerManager::GetAudioThreadCounters(AmUInt32 thread) const
+    {
+        return thread < _countedThreads.size() ? _countedThreads[thread] : ProfilerPerfCounters::kInvalidThread;
+    }
+
+    AmUInt32 ProfilerManager::RegisterRealtimeThread(const AmString& name)
+    {
+        _configMutex.Lock();
+        const AmUInt32 capacity = _config.mRealtimeRingCapacity;
+        const AmUInt32 residency = _config.mMemoryResidency;
+        _configMutex.Unlock();
+
+        return _realtime->RegisterThread(name, capacity, residency);
+    }
+
+    void ProfilerManager::UnregisterRealtimeThread(AmUInt32 thread)
+    {
+        _realtime->UnregisterThread(thread);
+    }
+
+    AmUInt32 ProfilerManager::RegisterJobWorker(const AmString& name)
+    {
+        _configMutex.Lock();
+        const AmUInt32 capacity = _config.mRealtimeRingCapacity;
+        const AmUInt32 residency = _config.mMemoryResidency;
+        _configMutex.Unlock();
+
+        return _jobs->RegisterWorker(name, capacity, residency);
+    }
+
+    void ProfilerManager::UnregisterJobWorker(AmUInt32 worker)
+    {
+        _jobs->UnregisterWorker(worker);
+    }
+
+    AmUInt32 ProfilerManager::RegisterAudioBus(const AmString& name, AmUInt32 channels, AmUInt32 sampleRate)
+    {
+        _configMutex.Lock();
+        const AmUInt32 bufferMs = _config.mLevelMeteringBufferMs;
+        const AmUInt32 residency = _config.mMemoryResidency;
+        _configMutex.Unlock();
+
+        const auto capacity = static_cast<AmUInt32>(static_cast<AmUInt64>(sampleRate) * bufferMs / 1000);
+        return _levels->RegisterBus(name, channels, sampleRate, capacity, residency);
+    }
+
+    void ProfilerManager::UnregisterAudioBus(AmUInt32 bus)
+    {
+        _levels->UnregisterBus(bus);
+    }
+
+    void ProfilerManager::UpdateRealtimeCategoryMask()
+    {
+        // Real-time threads read the mask from an atomic instead of locking the configuration
+        _configMutex.Lock();
+        const AmUInt32 categoryMask = _enabled.load() ? _config.mCategoryMask : 0;
+        const bool jobTimeline = _config.mEnableJobProfiling && _config.mEnableJobTimeline;
+        _configMutex.Unlock();
+
+        _realtime->SetCategoryMask(categoryMask);
+
+        // Job workers check the timeline flag instead of the category mask
+        _jobs->SetTimelineEnabled(jobTimeline && (categoryMask & eProfilerCategory_Events) != 0);
+    }
+
+    void ProfilerManager::ConfigureLockProfiling(const ProfilerConfig& config)
+    {
+        ProfilerLockProfiler::SetEnabled(config.mEnableLockProfiling);
+    }
+
+    void ProfilerManager::ConfigureJobProfiling(const ProfilerConfig& config)
+    {
+        _jobs->SetEnabled(config.mEnableJobProfiling);
+    }
+
+    void ProfilerManager::ConfigurePerfCounters(const ProfilerConfig& config)
+    {
+        _perf->SetEnabled(config.mEnablePerfCounters);
+    }
+
+    void ProfilerManager::ConfigureLevelMetering(const ProfilerConfig& config)
+    {
+        _levels->SetEnabled(config.mEnableLevelMetering);
+    }
+
+    void ProfilerManager::ConfigureWatchdog(const ProfilerConfig& config)
+    {
+        _watchdog->Stop();
+
+        if (!config.mEnableWatchdog)
+            return;
+
+        _watchdog->Start(
+            config.mWatchdogStallPeriods,
+            [this](const ProfilerStallReport& report, bool ended)
+            {
+                OnAudioThreadStall(report, ended);
+            });
+    }
+
+    void ProfilerManager::ConfigureStackSampling(const ProfilerConfig& config)
+    {
+        _sampler->Stop();
+
+        if (!config.mEnableStackSampling)
+            return;
+
+        _sampler->Start(config.mStackSamplingRateHz);
+    }
+
+    void ProfilerManager::ConfigureAggregator(const ProfilerConfig& config)
+    {
+        _aggregator->Clear();
+
+        if (config.mEnableAggregation)
+            _aggregator->Configure(config.mAggregateFields, config.mAggregateWindowMs, config.mAggregateStepMs);
+    }
+
+    void ProfilerManager::ConfigureAlerts(const ProfilerConfig& config)
+    {
+        if (config.mAlertRules.empty())
+        {
+            _alerts->Clear();
+            return;
+        }
+
+        _alerts->Configure(
+            config.mAlertRules,
+            [this](const ProfilerAlertRule& rule, const ProfilerDataVariant& message, AmUInt64 fireCount)
+            {
+                OnAlertFired(rule, message, fireCount);
+            });
+    }
+
+    void ProfilerManager::ConfigureAnomalyDetector(const ProfilerConfig& config)
+    {
+        _anomalyDetector->Clear();
+
+        if (!config.mEnableAnomalyDetection)
+            return;
+
+        ProfilerAnomalySettings settings;
+        settings.mFields = config.mAnomalyFields;
+        settings.mGrowthFields = config.mAnomalyGrowthFields;
+        settings.mSceneMarker = config.mAnomalySceneMarker;
+        settings.mAlpha = config.mAnomalyAlpha;
+        settings.mWarmupSamples = config.mAnomalyWarmupSamples;
+        settings.mSpikeThreshold = config.mAnomalySpikeThreshold;
+        settings.mShiftThreshold = config.mAnomalyShiftThreshold;
+
+        _anomalyDetector->Configure(settings);
+    }
+
+    void ProfilerManager::OnAlertFired(const ProfilerAlertRule& rule, const ProfilerDataVariant& message, AmUInt64 fireCount)
+    {
+        // Called from the update thread
+        amProfilerLogWarning("[ProfilerManager] Alert rule '%s' fired (%s)", rule.mName, rule.mCondition);
+
+        ProfilerEvent event(ProfilerAlertEvaluator::kEventName, "Alert rule '" + rule.mName + "' fired");
+        event.mPriority = eProfilerPriority_Critical;
+        event.mParameters["rule"] = rule.mName;
+        event.mParameters["condition"] = rule.mCondition;
+        event.mParameters["fire_count"] = std::to_string(fireCount);
+        event.mParameters["message_id"] = std::to_string(std::visit(
+            [](const auto& arg)
+            {
+                return arg.mMessageId;
+            },
+            message));
+
+        if (rule.mActions & eProfilerAlertAction_Boost)
+        {
+            const auto boostEnd = std::chrono::high_resolution_clock::now() + std::chrono::milliseconds(rule.mBoostDurationMs);
+            _boostInterval = 1.0f / rule.mBoostFrequencyHz;
+            _boostEndNs = std::chrono::duration_cast<std::chrono::nanoseconds>(boostEnd.time_since_epoch()).count();
+            event.mParameters["boost_frequency_hz"] = std::to_string(rule.mBoostFrequencyHz);
+        }
+
+        if (rule.mActions & eProfilerAlertAction_Dump)
+        {
+            _configMutex.Lock();
+            const AmUInt32 maxDumps = _config.mAlertMaxDumps;
+            const AmString dumpPath = _config.mAlertDumpPath;
+            _configMutex.Unlock();
+
+            // Keep what led to the alert, before the ring moves on
+            if (_flightRecorder->IsInitialized() && !dumpPath.empty())
+            {
+                if (const AmUInt32 index = _alertDumpCount.fetch_add(1); index < maxDumps)
+                {
+                    // Written by the dump thread, so the alert evaluation does not wait for the disk
+                    const AmString path = dumpPath + "_" + rule.mName + "_" + std::to_string(index) + ".amrec";
+                    if (QueueFlightRecorderDump(path))
+                        event.mParameters["snapshot"] = path;
+                }
+            }
+        }
+
+        if (rule.mActions & eProfilerAlertAction_Event)
+            CaptureEvent(event);
+    }
+
+    void ProfilerManager::OnAudioThreadStall(const ProfilerStallReport& report, bool ended)
+    {
+        // Called from the watchdog thread
+        _configMutex.Lock();
+        const AmUInt32 maxDumps = _config.mWatchdogMaxDumps;
+        const AmString dumpPath = _config.mWatchdogDumpPath;
+        _configMutex.Unlock();
+
+        ProfilerEvent event(ended ? "AudioThreadStallEnded" : "AudioThreadStall");
+        event.mPriority = ended ? eProfilerPriority_High : eProfilerPriority_Critical;
+        event.mParameters["thread"] = report.mThreadName;
+        event.mParameters["thread_id"] = std::to_string(report.mThreadId);
+        event.mParameters["buffer_period_ms"] = std::to_string(report.mBufferPeriodMs);
+        event.mParameters[ended ? "duration_ms" : "late_ms"] = std::to_string(report.mLateMs);
+
+        if (ended)
+        {
+            event.mDescription = "Audio thread '" + report.mThreadName + "' resumed";
+            amLogInfo("[ProfilerManager] Audio thread '%s' resumed after %.2f ms", report.mThreadName.c_str(), report.mLateMs);
+            CaptureEvent(event);
+            return;
+        }
+
+        event.mDescription = "Audio thread '" + report.mThreadName + "' stalled";
+        event.mParameters["state"] = report.mState;
+        event.mParameters["wchan"] = report.mWaitChannel;
+        event.mParameters["syscall"] = report.mSyscall;
+        event.mParameters["stack"] = report.mStack;
+
+        // Keep what led to the stall, before the ring moves on
+        if (_flightRecorder->IsInitialized() && !dumpPath.empty())
+        {
+            if (const AmUInt32 index = _stallDumpCount.fetch_add(1); index < maxDumps)
+            {
+                const AmString path = dumpPath + "_" + std::to_string(index) + ".amrec";
+                if (QueueFlightRecorderDump(path))
+                    event.mParameters["snapshot"] = path;
+            }
+        }
+
+        amLogWarning(
+            "[ProfilerManager] Audio thread '%s' stalled: no heartbeat for %.2f ms (state %s, wchan %s)", report.mThreadName.c_str(),
+            report.mLateMs, report.mState.empty() ? "unknown" : report.mState.c_str(),
+            report.mWaitChannel.empty() ? "none" : report.mWaitChannel.c_str());
+
+        CaptureEvent(event);
+    }
+
     AmUInt32 ProfilerManager::GetConnectedClientCount() const
     {
         return _networkServer ? _networkServer->GetClientCount() : 0;
@@ -414,32 +1047,70 @@ namespace SparkyStudios::Audio::Amplitude
 
     ProfilerManager::Statistics ProfilerManager::GetStatistics() const
     {
-        Thread::LockMutex(_statisticsMutex);
-        Statistics stats = _statistics;
-        Thread::UnlockMutex(_statisticsMutex);
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
+
+        Statistics stats = {};
+        stats.totalMessagesSent = _messageRate.GetTotal();
+        stats.messagesDropped = _droppedRate.GetTotal();
+        stats.currentUpdateRate = static_cast<AmReal32>(_updateRate.GetRate(now));
+        stats.messagesPerSecond = static_cast<AmReal32>(_messageRate.GetRate(now));
+        stats.droppedMessagesPerSecond = static_cast<AmReal32>(_droppedRate.GetRate(now));
+
+        for (AmUInt32 i = 0; i < kProfilerCategoryCount; ++i)
+            stats.categoryMessagesPerSecond[i] = static_cast<AmReal32>(_categoryRates[i].GetRate(now));
+
+        _configMutex.Lock();
+        stats.configuredUpdateRate = _config.mUpdateMode == eProfilerUpdateMode_Timed ? 1.0f / _updateInterval : 0.0f;
+        _configMutex.Unlock();
+
+        if (_messageQueue)
+        {
+            stats.queuedMessages = static_cast<AmUInt32>(_messageQueue->Size());
+            stats.queueCapacity = static_cast<AmUInt32>(_messageQueue->Capacity());
+        }
+
+        stats.realtimeRecordsDropped = _realtime->GetDroppedCount();
+
+        if (_networkServer)
+        {
+            const ProfilerServer::Statistics serverStats = _networkServer->GetStatistics();
+            stats.bytesTransmitted = serverStats.mTotalBytesTransmitted;
+            stats.averageMessageSizeBytes = serverStats.mAverageMessageSize;
+            stats.bytesPerSecond = serverStats.mBytesPerSecond;
+            stats.categoryBytesPerSecond = serverStats.mCategoryBytesPerSecond;
+            stats.activeClients = _networkServer->GetClientCount();
+        }
+
         return stats;
     }
 
     void ProfilerManager::ResetStatistics()
     {
-        Thread::LockMutex(_statisticsMutex);
-        _statistics = {};
-        Thread::UnlockMutex(_statisticsMutex);
+        _messageRate.Reset();
+        _droppedRate.Reset();
+        _updateRate.Reset();
+
+        for (ProfilerRateMeter& rate : _categoryRates)
+            rate.Reset();
+
+        if (_networkServer)
+            _networkServer->ResetStatistics();
+
         amLogInfo("[ProfilerManager] Statistics reset");
     }
 
     void ProfilerManager::RegisterMessageCallback(const MessageCallback& callback)
     {
-        Thread::LockMutex(_callbackMutex);
+        _callbackMutex.Lock();
         _localCallback = callback;
-        Thread::UnlockMutex(_callbackMutex);
+        _callbackMutex.Unlock();
     }
 
     void ProfilerManager::UnregisterMessageCallback()
     {
-        Thread::LockMutex(_callbackMutex);
+        _callbackMutex.Lock();
         _localCallback = nullptr;
-        Thread::UnlockMutex(_callbackMutex);
+        _callbackMutex.Unlock();
     }
 
     void ProfilerManager::UpdateLoop()
@@ -451,10 +1122,21 @@ namespace SparkyStudios::Audio::Amplitude
             auto currentTime = std::chrono::high_resolution_clock::now();
             auto deltaTime = std::chrono::duration<AmReal32>(currentTime - _lastUpdate).count();
 
-            Thread::LockMutex(_configMutex);
+            _configMutex.Lock();
             eProfilerUpdateMode updateMode = _config.mUpdateMode;
             AmReal32 interval = _updateInterval;
-            Thread::UnlockMutex(_configMutex);
+            AmUInt32 statisticsIntervalMs = _config.mSelfStatsIntervalMs;
+            AmUInt32 lockStatsIntervalMs = _config.mEnableLockProfiling ? _config.mLockStatsIntervalMs : 0;
+            AmUInt32 lockStatsTopCount = _config.mLockStatsTopCount;
+            AmUInt32 stackSamplesIntervalMs = _config.mEnableStackSampling ? _config.mStackSamplingIntervalMs : 0;
+            AmUInt32 stackSamplesMaxStacks = _config.mStackSamplingMaxStacks;
+            AmUInt32 perfCountersIntervalMs = _config.mEnablePerfCounters ? _config.mPerfCountersIntervalMs : 0;
+            AmUInt32 audioLevelsIntervalMs = _config.mEnableLevelMetering ? _config.mLevelMeteringIntervalMs : 0;
+            _configMutex.Unlock();
+
+            // Alerts can raise the update frequency for a while
+            if (std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime.time_since_epoch()).count() < _boostEndNs.load())
+                interval = std::min(interval, _boostInterval.load());
 
             bool shouldUpdate = false;
             switch (updateMode)
@@ -476,9 +1158,52 @@ namespace SparkyStudios::Audio::Amplitude
             if (shouldUpdate)
             {
                 CollectTimedUpdates();
+                _updateRate.Add(1, currentTime);
                 _lastUpdate = currentTime;
             }
 
+            if (statisticsIntervalMs > 0 && currentTime >= _nextStatisticsEvent)
+            {
+                EmitStatistics();
+                _nextStatisticsEvent = currentTime + std::chrono::milliseconds(statisticsIntervalMs);
+            }
+
+            if (lockStatsIntervalMs > 0 && currentTime >= _nextLockStatsEvent)
+            {
+                EmitLockStatistics(lockStatsTopCount);
+                _nextLockStatsEvent = currentTime + std::chrono::milliseconds(lockStatsIntervalMs);
+            }
+
+            if (stackSamplesIntervalMs > 0)
+            {
+                // Drained at every iteration, the rings only hold a fraction of a second of samples
+                _sampler->Collect();
+
+                if (currentTime >= _nextStackSamplesEvent)
+                {
+                    EmitStackSamples(stackSamplesMaxStacks);
+                    _nextStackSamplesEvent = currentTime + std::chrono::milliseconds(stackSamplesIntervalMs);
+                }
+            }
+
+            if (perfCountersIntervalMs > 0 && currentTime >= _nextPerfCountersEvent)
+            {
+                EmitPerfCounters();
+                _nextPerfCountersEvent = currentTime + std::chrono::milliseconds(perfCountersIntervalMs);
+            }
+
+            if (audioLevelsIntervalMs > 0)
+            {
+                // Measured at every iteration, the taps only buffer a fraction of a second of audio
+                _levels->Process();
+
+                if (currentTime >= _nextAudioLevelsEvent)
+                {
+                    EmitAudioLevels();
+                    _nextAudioLevelsEvent = currentTime + std::chrono::milliseconds(audioLevelsIntervalMs);
+                }
+            }
+
             ProcessQueuedMessages();
 
             // Sleep for a short time to prevent busy waiting
@@ -490,14 +1215,46 @@ namespace SparkyStudios::Audio::Amplitude
 
     void ProfilerManager::ProcessQueuedMessages()
     {
-        Thread::LockMutex(_configMutex);
+        _configMutex.Lock();
         AmUInt32 maxMessages = _config.mMaxMessagesPerFrame;
-        Thread::UnlockMutex(_configMutex);
+        _configMutex.Unlock();
 
-        auto messages = _messageQueue->PopMessages(maxMessages);
+        DrainRealtimeCapture();
+        _messageQueue->PopMessages(maxMessages, _batch);
+
+        const std::vector<ProfilerDataVariant>& messages = _batch;
         for (const auto& message : messages)
         {
             DistributeMessage(message);
+            _recordingWriter->Write(message);
+            _flightRecorder->Record(message);
+        }
+
+        // Send to network clients, as a batch so client filters are evaluated column by column
+        if (_networkServer && !messages.empty())
+            _networkServer->BroadcastProfilerData(messages);
+
+        _alerts->Evaluate(messages);
+
+        _anomalies.clear();
+        _anomalyDetector->Observe(messages, _anomalies);
+
+        for (const ProfilerEvent& anomaly : _anomalies)
+        {
+            amProfilerLogWarning("[ProfilerManager] Performance anomaly: %s", anomaly.mDescription);
+            CaptureEvent(anomaly);
+        }
+
+        // Aggregates are queued like any other message, and distributed with the next batch
+        _aggregator->Observe(messages);
+
+        _aggregates.clear();
+        _aggregator->Update(std::chrono::high_resolution_clock::now(), _aggregates);
+
+        if (!_aggregates.empty() && ShouldCaptureCategory(eProfilerCategory_Aggregate))
+        {
+            for (auto& aggregate : _aggregates)
+                QueueMessage(std::move(aggregate));
         }
     }
 
@@ -506,13 +1263,14 @@ namespace SparkyStudios::Audio::Amplitude
         if (!_enabled.load())
             return;
 
-        Thread::LockMutex(_configMutex);
+        _configMutex.Lock();
         bool captureEngine = _config.mCaptureEngineState;
         bool captureEntities = _config.mCaptureEntityStates;
         bool captureChannels = _config.mCaptureChannelStates;
         bool captureListeners = _config.mCaptureListenerStates;
         bool capturePerformance = _config.mCapturePerformanceMetrics;
-        Thread::UnlockMutex(_configMutex);
+        bool captureJobs = _config.mEnableJobProfiling;
+        _configMutex.Unlock();
 
         if (captureEngine)
             CaptureEngineState();
@@ -524,6 +1282,8 @@ namespace SparkyStudios::Audio::Amplitude
             CaptureAllListeners();
         if (capturePerformance)
             CapturePerformanceMetrics();
+        if (captureJobs)
+            EmitJobStatistics();
     }
 
     void ProfilerManager::CollectOnChangeUpdates()
@@ -535,9 +1295,11 @@ namespace SparkyStudios::Audio::Amplitude
 
     bool ProfilerManager::ShouldCaptureCategory(eProfilerCategory category) const
     {
-        Thread::LockMutex(_configMutex);
+        AM_PROFILER_ASSERT_NOT_REALTIME();
+
+        _configMutex.Lock();
         bool shouldCapture = (_config.mCategoryMask & static_cast<AmUInt32>(category)) != 0;
-        Thread::UnlockMutex(_configMutex);
+        _configMutex.Unlock();
         return shouldCapture;
     }
 
@@ -549,35 +1311,257 @@ namespace SparkyStudios::Audio::Amplitude
 
     void ProfilerManager::QueueMessage(ProfilerDataVariant&& message)
     {
+        AM_PROFILER_ASSERT_NOT_REALTIME();
+
+        // Queue is full, the queue logs the drop through the rate-limited profiler log
         if (!_messageQueue->PushMessage(std::move(message)))
-        {
-            // Queue is full, increment dropped message counter
-            Thread::LockMutex(_statisticsMutex);
-            _statistics.messagesDropped++;
-            Thread::UnlockMutex(_statisticsMutex);
+            _droppedRate.Add(1, std::chrono::high_resolution_clock::now());
+    }
 
-            amLogWarning("[ProfilerManager] Message queue full, dropping message");
-        }
+    void ProfilerManager::DrainRealtimeCapture()
+    {
+        _realtimeEvents.clear();
+        _realtime->Drain(_realtimeEvents);
+        _jobs->DrainTimeline(_realtimeEvents);
+
+        // Queued like any other message, so they are recorded, filtered and sent in the same batches
+        for (ProfilerEvent& event : _realtimeEvents)
+            QueueMessage(std::move(event));
     }
 
     void ProfilerManager::DistributeMessage(const ProfilerDataVariant& message)
     {
         // Update statistics
-        Thread::LockMutex(_statisticsMutex);
-        _statistics.totalMessagesSent++;
-        Thread::UnlockMutex(_statisticsMutex);
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
+        _messageRate.Add(1, now);
+
+        if (const AmUInt32 index = GetProfilerCategoryIndex(GetMessageCategory(message)); index < kProfilerCategoryCount)
+            _categoryRates[index].Add(1, now);
 
         // Send to local callback
-        Thread::LockMutex(_callbackMutex);
+        _callbackMutex.Lock();
         if (_localCallback)
         {
             _localCallback(message);
         }
-        Thread::UnlockMutex(_callbackMutex);
+        _callbackMutex.Unlock();
+    }
+
+    void ProfilerManager::EmitStatistics()
+    {
+        const Statistics stats = GetStatistics();
+
+        ProfilerEvent event(kStatisticsEventName, "Profiler statistics");
+        event.mPriority = eProfilerPriority_Low;
+        event.mParameters["messages_per_second"] = std::to_string(stats.messagesPerSecond);
+        event.mParameters["dropped_messages_per_second"] = std::to_string(stats.droppedMessagesPerSecond);
+        event.mParameters["bytes_per_second"] = std::to_string(stats.bytesPerSecond);
+        event.mParameters["update_rate"] = std::to_string(stats.currentUpdateRate);
+        event.mParameters["configured_update_rate"] = std::to_string(stats.configuredUpdateRate);
+        event.mParameters["queued_messages"] = std::to_string(stats.queuedMessages);
+        event.mParameters["queue_capacity"] = std::to_string(stats.queueCapacity);
+        event.mParameters["active_clients"] = std::to_string(stats.activeClients);
+        event.mParameters["realtime_records_dropped"] = std::to_string(stats.realtimeRecordsDropped);
+
+        // Only the categories which were sent, so the event stays small
+        for (AmUInt32 i = 0; i < kProfilerCategoryCount; ++i)
+        {
+            const AmString name = kCategoryNames[i];
+
+            if (stats.categoryMessagesPerSecond[i] > 0.0f)
+                event.mParameters[name + "_messages_per_second"] = std::to_string(stats.categoryMessagesPerSecond[i]);
+
+            if (stats.categoryBytesPerSecond[i] > 0.0f)
+                event.mParameters[name + "_bytes_per_second"] = std::to_string(stats.categoryBytesPerSecond[i]);
+        }
 
-        // Send to network clients
-        if (_networkServer)
-            _networkServer->BroadcastProfilerData(message);
+        CaptureEvent(event);
+    }
+
+    void ProfilerManager::EmitLockStatistics(AmUInt32 topCount)
+    {
+        std::vector<ProfilerLockStats> totals;
+        ProfilerLockProfiler::Collect(totals);
+
+        std::vector<ProfilerLockStats> intervals;
+        intervals.reserve(totals.size());
+
+        for (AmSize i = 0; i < totals.size(); ++i)
+        {
+            ProfilerLockStats interval = GetLockInterval(totals[i], i < _lockStats.size() ? &_lockStats[i] : nullptr);
+            if (interval.mContentions > 0)
+                intervals.push_back(std::move(interval));
+        }
+
+        _lockStats = std::move(totals);
+
+        // Most time spent waiting first
+        const AmSize count = std::min<AmSize>(topCount, intervals.size());
+        std::partial_sort(
+            intervals.begin(), intervals.begin() + count, intervals.end(),
+            [](const ProfilerLockStats& a, const ProfilerLockStats& b)
+            {
+                return a.mWaitNs > b.mWaitNs;
+            });
+
+        for (AmSize i = 0; i < count; ++i)
+        {
+            const ProfilerLockStats& lock = intervals[i];
+
+            // Non-empty buckets of the wait time histogram, as "upper bound in ns:count" pairs
+            AmString histogram;
+            for (AmSize b = 0; b < ProfilerLockStats::kWaitBucketCount; ++b)
+            {
+                if (lock.mWaitBuckets[b] == 0)
+                    continue;
+
+                if (!histogram.empty())
+                    histogram += ',';
+
+                histogram += std::to_string(ProfilerLockStats::GetWaitBucketUpperBoundNs(b)) + ':' + std::to_string(lock.mWaitBuckets[b]);
+            }
+
+            ProfilerEvent event(kLockContentionEventName, lock.mName);
+            event.mPriority = eProfilerPriority_Low;
+            event.mParameters["lock"] = lock.mName;
+            event.mParameters["rank"] = std::to_string(i + 1);
+            event.mParameters["acquisitions"] = std::to_string(lock.mAcquisitions);
+            event.mParameters["contentions"] = std::to_string(lock.mContentions);
+            event.mParameters["wait_ms"] = std::to_string(static_cast<AmReal64>(lock.mWaitNs) / 1e6);
+            event.mParameters["hold_ms"] = std::to_string(static_cast<AmReal64>(lock.mHoldNs) / 1e6);
+            event.mParameters["max_wait_ms"] = std::to_string(static_cast<AmReal64>(lock.mMaxWaitNs) / 1e6);
+            event.mParameters["max_hold_ms"] = std::to_string(static_cast<AmReal64>(lock.mMaxHoldNs) / 1e6);
+            event.mParameters["wait_p50_us"] = std::to_string(static_cast<AmReal64>(lock.GetWaitPercentileNs(50.0)) / 1e3);
+            event.mParameters["wait_p95_us"] = std::to_string(static_cast<AmReal64>(lock.GetWaitPercentileNs(95.0)) / 1e3);
+            event.mParameters["wait_p99_us"] = std::to_string(static_cast<AmReal64>(lock.GetWaitPercentileNs(99.0)) / 1e3);
+            event.mParameters["top_waiter_thread"] = std::to_string(lock.mTopWaiterThread);
+            event.mParameters["top_holder_thread"] = std::to_string(lock.mTopHolderThread);
+            event.mParameters["wait_histogram_ns"] = histogram;
+
+            CaptureEvent(event);
+        }
+    }
+
+    void ProfilerManager::EmitJobStatistics()
+    {
+        _jobStats.clear();
+        _jobs->Collect(_jobStats);
+
+        if (_jobStats.empty())
+            return;
+
+        ProfilerJobWorkerStats total;
+        AmReal64 utilization = 0.0;
+
+        ProfilerEvent event(kJobSystemEventName);
+        event.mPriority = eProfilerPriority_Low;
+
+        for (const ProfilerJobWorkerStats& worker : _jobStats)
+        {
+            total.mJobs += worker.mJobs;
+            total.mSteals += worker.mSteals;
+            total.mWaitNs += worker.mWaitNs;
+            total.mExecNs += worker.mExecNs;
+            total.mMaxWaitNs = std::max(total.mMaxWaitNs, worker.mMaxWaitNs);
+            total.mMaxExecNs = std::max(total.mMaxExecNs, worker.mMaxExecNs);
+            utilization += worker.mUtilization;
+
+            event.mParameters[worker.mName + ".jobs"] = std::to_string(worker.mJobs);
+            event.mParameters[worker.mName + ".steals"] = std::to_string(worker.mSteals);
+            event.mParameters[worker.mName + ".utilization"] = std::to_string(worker.mUtilization);
+        }
+
+        // A queue wait much longer than the execution time means the workers are starved, not slow
+        event.mParameters["workers"] = std::to_string(_jobStats.size());
+        event.mParameters["queued"] = std::to_string(_jobs->GetQueuedCount());
+        event.mParameters["jobs"] = std::to_string(total.mJobs);
+        event.mParameters["steals"] = std::to_string(total.mSteals);
+        event.mParameters["queue_wait_ms"] = std::to_string(static_cast<AmReal64>(total.mWaitNs) / 1e6);
+        event.mParameters["max_queue_wait_ms"] = std::to_string(static_cast<AmReal64>(total.mMaxWaitNs) / 1e6);
+        event.mParameters["exec_ms"] = std::to_string(static_cast<AmReal64>(total.mExecNs) / 1e6);
+        event.mParameters["max_exec_ms"] = std::to_string(static_cast<AmReal64>(total.mMaxExecNs) / 1e6);
+        event.mParameters["utilization"] = std::to_string(utilization / static_cast<AmReal64>(_jobStats.size()));
+
+        CaptureEvent(event);
+    }
+
+    void ProfilerManager::EmitStackSamples(AmUInt32 maxStacks)
+    {
+        _stackEvents.clear();
+        _sampler->Flush(maxStacks, _stackEvents);
+
+        for (const ProfilerEvent& event : _stackEvents)
+            CaptureEvent(event);
+    }
+
+    void ProfilerManager::EmitPerfCounters()
+    {
+        _perfStats.clear();
+        _perf->Collect(_perfStats);
+
+        for (const ProfilerPerfScopeStats& scope : _perfStats)
+        {
+            ProfilerEvent event(kPerfCountersEventName, scope.mScope);
+            event.mPriority = eProfilerPriority_Low;
+            event.mParameters["thread"] = scope.mThread;
+            event.mParameters["scope"] = scope.mScope;
+            event.mParameters["source"] = ProfilerPerfScopeStats::GetSourceName(scope.mSource);
+            event.mParameters["calls"] = std::to_string(scope.mCalls);
+
+            // Counters the thread could not open are left out, rather than reported as 0
+            for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+            {
+                const auto counter = static_cast<eProfilerPerfCounter>(i);
+                if (scope.Has(counter))
+                    event.mParameters[ProfilerPerfScopeStats::GetCounterName(counter)] = std::to_string(scope.mValues[i]);
+            }
+
+            // A low IPC with many cache misses per instruction means the DSP waits for memory rather than computing
+            if (scope.Has(eProfilerPerfCounter_Cycles) && scope.Has(eProfilerPerfCounter_Instructions))
+                event.mParameters["ipc"] = std::to_string(scope.GetInstructionsPerCycle());
+
+            if (scope.Has(eProfilerPerfCounter_CacheMisses) && scope.Has(eProfilerPerfCounter_Instructions))
+                event.mParameters["cache_mpki"] = std::to_string(scope.GetPerKiloInstructions(eProfilerPerfCounter_CacheMisses));
+
+            if (scope.Has(eProfilerPerfCounter_BranchMisses) && scope.Has(eProfilerPerfCounter_Instructions))
+                event.mParameters["branch_mpki"] = std::to_string(scope.GetPerKiloInstructions(eProfilerPerfCounter_BranchMisses));
+
+            if (scope.Has(eProfilerPerfCounter_TaskClock))
+            {
+                const AmReal64 cpuMs = static_cast<AmReal64>(scope.mValues[eProfilerPerfCounter_TaskClock]) / 1e6;
+                event.mParameters["cpu_ms_per_call"] = std::to_string(cpuMs / static_cast<AmReal64>(scope.mCalls));
+            }
+
+            CaptureEvent(event);
+        }
+    }
+
+    void ProfilerManager::EmitAudioLevels()
+    {
+        _busLevels.clear();
+        _levels->Collect(_busLevels);
+
+        for (const ProfilerBusLevels& bus : _busLevels)
+        {
+            ProfilerEvent event(kAudioLevelsEventName, bus.mName);
+            event.mPriority = eProfilerPriority_Low;
+            event.mParameters["bus"] = bus.mName;
+            event.mParameters["channels"] = std::to_string(bus.mChannels);
+            event.mParameters["frames"] = std::to_string(bus.mFrames);
+            event.mParameters["peak_dbfs"] = std::to_string(bus.GetPeakDbfs());
+            event.mParameters["rms_dbfs"] = std::to_string(bus.GetRmsDbfs());
+            event.mParameters["lufs_short_term"] = std::to_string(bus.mLoudnessShortTerm);
+            event.mParameters["clipped"] = std::to_string(bus.mClippedSamples);
+            event.mParameters["dropped_frames"] = std::to_string(bus.mDroppedFrames);
+
+            for (AmUInt32 c = 0; c < bus.mChannels; ++c)
+            {
+                event.mParameters["ch" + std::to_string(c) + ".peak_dbfs"] = std::to_string(bus.mPeakDbfs[c]);
+                event.mParameters["ch" + std::to_string(c) + ".rms_dbfs"] = std::to_string(bus.mRmsDbfs[c]);
+            }
+
+            CaptureEvent(event);
+        }
     }
 
     void ProfilerManager::StartUpdateThread()
@@ -612,4 +1596,73 @@ namespace SparkyStudios::Audio::Amplitude
         amLogDebug("[ProfilerManager] Update thread stopped");
     }
 
+    void ProfilerManager::StartDumpThread()
+    {
+        if (_dumpThread)
+            return;
+
+        _dumpRunning = true;
+        _dumpThread = Thread::CreateThread(
+            [](AmVoidPtr userData)
+            {
+                ProfilerManager* manager = static_cast<ProfilerManager*>(userData);
+                manager->DumpLoop();
+            },
+            this);
+    }
+
+    void ProfilerManager::StopDumpThread()
+    {
+        if (!_dumpThread)
+            return;
+
+        // Dumps queued before stopping are still written
+        _dumpRunning = false;
+        Thread::Wait(_dumpThread);
+        Thread::Release(_dumpThread);
+        _dumpThread = nullptr;
+    }
+
+    bool ProfilerManager::QueueFlightRecorderDump(const AmString& path)
+    {
+        constexpr AmSize kMaxPendingDumps = 8;
+
+        _dumpMutex.Lock();
+        const bool queued = _dumpRunning.load() && _pendingDumps.size() < kMaxPendingDumps;
+        if (queued)
+            _pendingDumps.push_back(path);
+        _dumpMutex.Unlock();
+
+        if (!queued)
+            amProfilerLogWarning("[ProfilerManager] Too many flight recorder dumps pending, skipping %s", path.c_str());
+
+        return queued;
+    }
+
+    void ProfilerManager::DumpLoop()
+    {
+        std::vector<AmString> paths;
+
+        while (true)
+        {
+            // Read before taking the queue, so the dumps queued before stopping are taken by the last iteration
+            const bool running = _dumpRunning.load();
+
+            _dumpMutex.Lock();
+            paths.swap(_pendingDumps);
+            _dumpMutex.Unlock();
+
+            for (const AmString& path : paths)
+                _flightRecorder->DumpToFile(std::filesystem::path(path).native());
+
+            if (!running)
+                break;
+
+            if (paths.empty())
+                Thread::Sleep(10);
+
+            paths.clear();
+        }
+    }
+
 } // namespace SparkyStudios::Audio::Amplitude
@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LogSink.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Messaging.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Residency.h>
+
+#include <algorithm>
 
 namespace SparkyStudios::Audio::Amplitude
 {
@@ -67,7 +71,11 @@ namespace SparkyStudios::Audio::Amplitude
 
     // ProfilerMessageQueue implementation
     ProfilerMessageQueue::ProfilerMessageQueue(AmSize maxSize)
-        : _maxSize(maxSize)
+        : _ring(std::max<AmSize>(maxSize, 1))
+        , _head(0)
+        , _count(0)
+        , _residency(eProfilerMemoryResidency_None)
+        , _maxSize(std::max<AmSize>(maxSize, 1))
         , _currentSize(0)
         , _droppedMessages(0)
     {
@@ -75,20 +83,28 @@ namespace SparkyStudios::Audio::Amplitude
         amLogDebug("[ProfilerMessageQueue] Created message queue with max size: %zu", maxSize);
     }
 
+    ProfilerMessageQueue::~ProfilerMessageQueue()
+    {
+        ProfilerMemoryResidency::Release(_ring.data(), _ring.size() * sizeof(ProfilerDataVariant), _residency);
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
     bool ProfilerMessageQueue::PushMessage(ProfilerDataVariant&& message)
     {
         Thread::LockMutex(_mutex);
 
-        if (_queue.size() >= _maxSize)
+        if (_count >= _maxSize)
         {
             _droppedMessages++;
             Thread::UnlockMutex(_mutex);
-            amLogWarning("[ProfilerMessageQueue] Queue full, dropping message (total dropped: %zu)", _droppedMessages.load());
+            amProfilerLogWarning("[ProfilerMessageQueue] Queue full, dropping message (total dropped: %zu)", _droppedMessages.load());
             return false;
         }
 
-        _queue.push(std::move(message));
-        _currentSize = _queue.size();
+        _ring[(_head + _count) % _maxSize] = std::move(message);
+        _currentSize = ++_count;
 
         Thread::UnlockMutex(_mutex);
         return true;
@@ -98,15 +114,15 @@ namespace SparkyStudios::Audio::Amplitude
     {
         Thread::LockMutex(_mutex);
 
-        if (_queue.empty())
+        if (_count == 0)
         {
             Thread::UnlockMutex(_mutex);
             return std::nullopt;
         }
 
-        ProfilerDataVariant message = std::move(_queue.front());
-        _queue.pop();
-        _currentSize = _queue.size();
+        ProfilerDataVariant message = std::move(_ring[_head]);
+        _head = (_head + 1) % _maxSize;
+        _currentSize = --_count;
 
         Thread::UnlockMutex(_mutex);
         return message;
@@ -117,26 +133,31 @@ namespace SparkyStudios::Audio::Amplitude
         std::vector<ProfilerDataVariant> messages;
         messages.reserve(maxCount);
 
+        PopMessages(maxCount, messages);
+        return messages;
+    }
+
+    void ProfilerMessageQueue::PopMessages(AmSize maxCount, std::vector<ProfilerDataVariant>& messages)
+    {
+        messages.clear();
+
         Thread::LockMutex(_mutex);
 
-        AmSize count = 0;
-        while (!_queue.empty() && count < maxCount)
+        while (_count > 0 && messages.size() < maxCount)
         {
-            messages.push_back(std::move(_queue.front()));
-            _queue.pop();
-            count++;
+            messages.push_back(std::move(_ring[_head]));
+            _head = (_head + 1) % _maxSize;
+            _count--;
         }
 
-        _currentSize = _queue.size();
+        _currentSize = _count;
 
         Thread::UnlockMutex(_mutex);
 
         if (!messages.empty())
         {
-            amLogDebug("[ProfilerMessageQueue] Popped %zu messages from queue", messages.size());
+            amProfilerLogDebug("[ProfilerMessageQueue] Popped %zu messages from queue", messages.size());
         }
-
-        return messages;
     }
 
     AmSize ProfilerMessageQueue::Size() const
@@ -144,6 +165,61 @@ namespace SparkyStudios::Audio::Amplitude
         return _currentSize.load();
     }
 
+    AmSize ProfilerMessageQueue::Capacity() const
+    {
+        Thread::LockMutex(_mutex);
+        const AmSize capacity = _maxSize;
+        Thread::UnlockMutex(_mutex);
+
+        return capacity;
+    }
+
+    void ProfilerMessageQueue::SetCapacity(AmSize maxSize)
+    {
+        maxSize = std::max<AmSize>(maxSize, 1);
+
+        // Allocated outside of the lock, producers only wait for the messages to be moved
+        std::vector<ProfilerDataVariant> ring(maxSize);
+
+        Thread::LockMutex(_mutex);
+
+        if (maxSize == _maxSize)
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+        const AmSize kept = std::min(_count, maxSize);
+        for (AmSize i = 0; i < kept; ++i)
+            ring[i] = std::move(_ring[(_head + i) % _maxSize]);
+
+        _droppedMessages += _count - kept;
+
+        ProfilerMemoryResidency::Release(_ring.data(), _ring.size() * sizeof(ProfilerDataVariant), _residency);
+        _residency = eProfilerMemoryResidency_None;
+
+        _ring.swap(ring);
+        _head = 0;
+        _count = kept;
+        _maxSize = maxSize;
+        _currentSize = kept;
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogDebug("[ProfilerMessageQueue] Resized message queue to max size: %zu", maxSize);
+    }
+
+    void ProfilerMessageQueue::Prefault(AmUInt32 residency)
+    {
+        Thread::LockMutex(_mutex);
+
+        ProfilerMemoryResidency::Release(_ring.data(), _ring.size() * sizeof(ProfilerDataVariant), _residency);
+        ProfilerMemoryResidency::Acquire(_ring.data(), _ring.size() * sizeof(ProfilerDataVariant), residency);
+        _residency = residency;
+
+        Thread::UnlockMutex(_mutex);
+    }
+
     bool ProfilerMessageQueue::Empty() const
     {
         return _currentSize.load() == 0;
@@ -153,11 +229,9 @@ namespace SparkyStudios::Audio::Amplitude
     {
         Thread::LockMutex(_mutex);
 
-        AmSize clearedCount = _queue.size();
-        while (!_queue.empty())
-        {
-            _queue.pop();
-        }
+        AmSize clearedCount = _count;
+        _head = 0;
+        _count = 0;
         _currentSize = 0;
 
         Thread::UnlockMutex(_mutex);
@@ -0,0 +1,608 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Multicast.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Serialization.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if AM_PLATFORM_WINDOWS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        constexpr AmUInt64 kInvalidSocket = ~static_cast<AmUInt64>(0);
+        constexpr AmUInt32 kMinMtu = 256;
+        constexpr AmUInt32 kMaxMtu = 65507;
+        constexpr AmUInt32 kKeyframeExpiryIntervals = 4;
+
+#if AM_PLATFORM_WINDOWS
+        using NativeSocket = SOCKET;
+#else
+        using NativeSocket = int;
+#endif
+
+        NativeSocket ToNative(AmUInt64 socket)
+        {
+            return static_cast<NativeSocket>(socket);
+        }
+
+        AmUInt64 OpenSocket()
+        {
+#if AM_PLATFORM_WINDOWS
+            WSADATA wsaData;
+            if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+                return kInvalidSocket;
+
+            const SOCKET socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+            if (socket == INVALID_SOCKET)
+            {
+                WSACleanup();
+                return kInvalidSocket;
+            }
+
+            u_long nonBlocking = 1;
+            ioctlsocket(socket, FIONBIO, &nonBlocking);
+
+            return static_cast<AmUInt64>(socket);
+#else
+            const int socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+            if (socket < 0)
+                return kInvalidSocket;
+
+            fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+
+            return static_cast<AmUInt64>(socket);
+#endif
+        }
+
+        void CloseSocket(AmUInt64 socket)
+        {
+#if AM_PLATFORM_WINDOWS
+            closesocket(ToNative(socket));
+            WSACleanup();
+#else
+            close(ToNative(socket));
+#endif
+        }
+
+        bool ParseAddress(const AmString& address, AmUInt32& result)
+        {
+            in_addr parsed{};
+            if (inet_pton(AF_INET, address.c_str(), &parsed) != 1)
+                return false;
+
+            result = parsed.s_addr;
+            return true;
+        }
+
+        // Keyframes keep one state per object, events and aggregates are transient and never part of a keyframe
+        bool GetKeyframeObjectId(const ProfilerDataVariant& data, AmUInt64& objectId)
+        {
+            return std::visit(
+                [&objectId](const auto& arg) -> bool
+                {
+                    using T = std::decay_t<decltype(arg)>;
+
+                    objectId = 0;
+
+                    if constexpr (std::is_same_v<T, ProfilerEntityData>)
+                        objectId = arg.mEntityId;
+                    else if constexpr (std::is_same_v<T, ProfilerChannelData>)
+                        objectId = arg.mChannelId;
+                    else if constexpr (std::is_same_v<T, ProfilerListenerData>)
+                        objectId = arg.mListenerId;
+                    else if constexpr (std::is_same_v<T, ProfilerEvent> || std::is_same_v<T, ProfilerAggregateData>)
+                        return false;
+
+                    return true;
+                },
+                data);
+        }
+
+        void WriteHeader(AmUInt8* data, const ProfilerMulticastHeader& header)
+        {
+            std::memcpy(data + 0, &header.mMagic, sizeof(header.mMagic));
+            std::memcpy(data + 4, &header.mVersion, sizeof(header.mVersion));
+            std::memcpy(data + 6, &header.mFlags, sizeof(header.mFlags));
+            std::memcpy(data + 8, &header.mSequence, sizeof(header.mSequence));
+            std::memcpy(data + 12, &header.mBatchId, sizeof(header.mBatchId));
+            std::memcpy(data + 16, &header.mFragmentIndex, sizeof(header.mFragmentIndex));
+            std::memcpy(data + 18, &header.mFragmentCount, sizeof(header.mFragmentCount));
+        }
+
+        void ReadHeader(const AmUInt8* data, ProfilerMulticastHeader& header)
+        {
+            std::memcpy(&header.mMagic, data + 0, sizeof(header.mMagic));
+            std::memcpy(&header.mVersion, data + 4, sizeof(header.mVersion));
+            std::memcpy(&header.mFlags, data + 6, sizeof(header.mFlags));
+            std::memcpy(&header.mSequence, data + 8, sizeof(header.mSequence));
+            std::memcpy(&header.mBatchId, data + 12, sizeof(header.mBatchId));
+            std::memcpy(&header.mFragmentIndex, data + 16, sizeof(header.mFragmentIndex));
+            std::memcpy(&header.mFragmentCount, data + 18, sizeof(header.mFragmentCount));
+        }
+    } // namespace
+
+    ProfilerMulticastSender::ProfilerMulticastSender()
+        : _socket(kInvalidSocket)
+        , _groupAddress(0)
+        , _port(0)
+        , _mtu(1400)
+        , _keyframeInterval(0.0f)
+        , _sequence(0)
+        , _batchId(0)
+        , _datagramsSent(0)
+        , _sendFailures(0)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerMulticastSender::~ProfilerMulticastSender()
+    {
+        Close();
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerMulticastSender::Open(const AmString& group, AmUInt16 port, AmUInt8 ttl, AmUInt32 mtu, AmReal32 keyframeIntervalSeconds)
+    {
+        Close();
+
+        AmUInt32 groupAddress = 0;
+        if (!ParseAddress(group, groupAddress))
+        {
+            amLogError("[ProfilerMulticastSender] Invalid multicast group address: %s", group.c_str());
+            return false;
+        }
+
+        const AmUInt64 socket = OpenSocket();
+        if (socket == kInvalidSocket)
+        {
+            amLogError("[ProfilerMulticastSender] Failed to create UDP socket");
+            return false;
+        }
+
+        // Loopback is kept enabled so receivers on the same host, and tests, get the stream too
+        const auto multicastTtl = static_cast<int>(ttl);
+        const int multicastLoop = 1;
+        setsockopt(
+            ToNative(socket), IPPROTO_IP, IP_MULTICAST_TTL, reinterpret_cast<const char*>(&multicastTtl), sizeof(multicastTtl));
+        setsockopt(
+            ToNative(socket), IPPROTO_IP, IP_MULTICAST_LOOP, reinterpret_cast<const char*>(&multicastLoop), sizeof(multicastLoop));
+
+        Thread::LockMutex(_mutex);
+
+        _socket = socket;
+        _groupAddress = groupAddress;
+        _port = htons(port);
+        _mtu = std::clamp(mtu, kMinMtu, kMaxMtu);
+        _keyframeInterval = keyframeIntervalSeconds;
+        _lastKeyframe = std::chrono::high_resolution_clock::now();
+        _sequence = 0;
+        _batchId = 0;
+        _datagramsSent = 0;
+        _sendFailures = 0;
+        _batch.clear();
+        _keyframe.clear();
+        _datagram.resize(_mtu);
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogInfo("[ProfilerMulticastSender] Sending to %s:%d (mtu: %u, ttl: %d)", group.c_str(), port, _mtu, ttl);
+        return true;
+    }
+
+    void ProfilerMulticastSender::Close()
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_socket != kInvalidSocket)
+        {
+            CloseSocket(_socket);
+            _socket = kInvalidSocket;
+        }
+
+        _batch.clear();
+        _keyframe.clear();
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerMulticastSender::IsOpen() const
+    {
+        return _socket != kInvalidSocket;
+    }
+
+    void ProfilerMulticastSender::Enqueue(const ProfilerDataVariant& data)
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_socket == kInvalidSocket)
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+        // Each record is prefixed by its size, patched once the message is encoded
+        const AmSize offset = _batch.size();
+        _batch.resize(offset + sizeof(AmUInt32));
+        ProfilerBinarySerializer::Encode(data, _batch);
+
+        const auto size = static_cast<AmUInt32>(_batch.size() - offset - sizeof(AmUInt32));
+        std::memcpy(_batch.data() + offset, &size, sizeof(size));
+
+        if (_keyframeInterval > 0.0f)
+            _updateKeyframe(data, _batch, offset);
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    AmUInt32 ProfilerMulticastSender::Flush()
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_socket == kInvalidSocket)
+        {
+            Thread::UnlockMutex(_mutex);
+            return 0;
+        }
+
+        AmUInt32 sent = 0;
+
+        if (!_batch.empty())
+        {
+            sent += _sendBatch(_batch, eProfilerMulticastFlags_None);
+            _batch.clear();
+        }
+
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
+        const AmReal32 elapsed = std::chrono::duration<AmReal32>(now - _lastKeyframe).count();
+
+        if (_keyframeInterval > 0.0f && elapsed >= _keyframeInterval && !_keyframe.empty())
+        {
+            const auto expiry = std::chrono::duration_cast<ProfilerTime::duration>(
+                std::chrono::duration<AmReal32>(_keyframeInterval * kKeyframeExpiryIntervals));
+
+            std::vector<AmUInt8> keyframe;
+            for (auto it = _keyframe.begin(); it != _keyframe.end();)
+            {
+                // Objects which stopped being reported are gone, do not resend them forever
+                if (now - it->second.mUpdated > expiry)
+                {
+                    it = _keyframe.erase(it);
+                    continue;
+                }
+
+                keyframe.insert(keyframe.end(), it->second.mPayload.begin(), it->second.mPayload.end());
+                ++it;
+            }
+
+            if (!keyframe.empty())
+                sent += _sendBatch(keyframe, eProfilerMulticastFlags_Keyframe);
+
+            _lastKeyframe = now;
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        return sent;
+    }
+
+    AmUInt64 ProfilerMulticastSender::GetDatagramsSent() const
+    {
+        return _datagramsSent;
+    }
+
+    AmUInt64 ProfilerMulticastSender::GetSendFailures() const
+    {
+        return _sendFailures;
+    }
+
+    void ProfilerMulticastSender::_updateKeyframe(const ProfilerDataVariant& data, const std::vector<AmUInt8>& payload, AmSize offset)
+    {
+        AmUInt64 objectId = 0;
+        if (!GetKeyframeObjectId(data, objectId))
+            return;
+
+        KeyframeEntry& entry = _keyframe[{ data.index(), objectId }];
+        entry.mPayload.assign(payload.begin() + static_cast<std::ptrdiff_t>(offset), payload.end());
+        entry.mUpdated = std::chrono::high_resolution_clock::now();
+    }
+
+    AmUInt32 ProfilerMulticastSender::_sendBatch(const std::vector<AmUInt8>& batch, AmUInt16 flags)
+    {
+        const AmSize maxPayload = _mtu - ProfilerMulticastHeader::kSize;
+        const AmSize fragmentCount = (batch.size() + maxPayload - 1) / maxPayload;
+
+        if (fragmentCount > 0xFFFF)
+        {
+            amLogWarning("[ProfilerMulticastSender] Batch of %zu bytes is too large to be sent, dropping it", batch.size());
+            return 0;
+        }
+
+        sockaddr_in destination{};
+        destination.sin_family = AF_INET;
+        destination.sin_port = _port;
+        destination.sin_addr.s_addr = _groupAddress;
+
+        ProfilerMulticastHeader header{};
+        header.mMagic = ProfilerMulticastHeader::kMagic;
+        header.mVersion = ProfilerMulticastHeader::kVersion;
+        header.mFlags = flags;
+        header.mBatchId = _batchId++;
+        header.mFragmentCount = static_cast<AmUInt16>(fragmentCount);
+
+        AmUInt32 sent = 0;
+
+        for (AmSize i = 0; i < fragmentCount; ++i)
+        {
+            const AmSize offset = i * maxPayload;
+            const AmSize size = std::min(maxPayload, batch.size() - offset);
+
+            // Lost datagrams are detected from gaps, so every datagram consumes a sequence number
+            header.mSequence = _sequence++;
+            header.mFragmentIndex = static_cast<AmUInt16>(i);
+
+            WriteHeader(_datagram.data(), header);
+            std::memcpy(_datagram.data() + ProfilerMulticastHeader::kSize, batch.data() + offset, size);
+
+            const auto result = sendto(
+                ToNative(_socket), reinterpret_cast<const char*>(_datagram.data()),
+                static_cast<int>(ProfilerMulticastHeader::kSize + size), 0, reinterpret_cast<const sockaddr*>(&destination),
+                sizeof(destination));
+
+            if (result < 0)
+            {
+                _sendFailures++;
+                continue;
+            }
+
+            _datagramsSent++;
+            sent++;
+        }
+
+        return sent;
+    }
+
+    ProfilerMulticastReceiver::ProfilerMulticastReceiver()
+        : _socket(kInvalidSocket)
+        , _groupAddress(0)
+        , _interfaceAddress(0)
+        , _hasSequence(false)
+        , _expectedSequence(0)
+        , _batchId(0)
+        , _batchFlags(0)
+        , _nextFragment(0)
+        , _fragmentCount(0)
+        , _lostDatagrams(0)
+        , _droppedBatches(0)
+        , _datagramsReceived(0)
+    {}
+
+    ProfilerMulticastReceiver::~ProfilerMulticastReceiver()
+    {
+        Close();
+    }
+
+    bool ProfilerMulticastReceiver::Open(const AmString& group, AmUInt16 port, const AmString& interfaceAddress)
+    {
+        Close();
+
+        AmUInt32 groupAddress = 0;
+        AmUInt32 localAddress = 0;
+        if (!ParseAddress(group, groupAddress) || !ParseAddress(interfaceAddress, localAddress))
+        {
+            amLogError("[ProfilerMulticastReceiver] Invalid address: %s on %s", group.c_str(), interfaceAddress.c_str());
+            return false;
+        }
+
+        const AmUInt64 socket = OpenSocket();
+        if (socket == kInvalidSocket)
+        {
+            amLogError("[ProfilerMulticastReceiver] Failed to create UDP socket");
+            return false;
+        }
+
+        // Several receivers on the same host can listen to the same group
+        const int reuse = 1;
+        setsockopt(ToNative(socket), SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+#if defined(SO_REUSEPORT)
+        setsockopt(ToNative(socket), SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+#endif
+
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(port);
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+
+        if (bind(ToNative(socket), reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0)
+        {
+            amLogError("[ProfilerMulticastReceiver] Failed to bind port %d", port);
+            CloseSocket(socket);
+            return false;
+        }
+
+        ip_mreq membership{};
+        membership.imr_multiaddr.s_addr = groupAddress;
+        membership.imr_interface.s_addr = localAddress;
+
+        if (setsockopt(
+                ToNative(socket), IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<const char*>(&membership), sizeof(membership)) != 0)
+        {
+            amLogError("[ProfilerMulticastReceiver] Failed to join multicast group %s", group.c_str());
+            CloseSocket(socket);
+            return false;
+        }
+
+        _socket = socket;
+        _groupAddress = groupAddress;
+        _interfaceAddress = localAddress;
+        _datagram.resize(kMaxMtu);
+        _hasSequence = false;
+        _fragmentCount = 0;
+        _batch.clear();
+        _lostDatagrams = 0;
+        _droppedBatches = 0;
+        _datagramsReceived = 0;
+
+        return true;
+    }
+
+    void ProfilerMulticastReceiver::Close()
+    {
+        if (_socket == kInvalidSocket)
+            return;
+
+        ip_mreq membership{};
+        membership.imr_multiaddr.s_addr = _groupAddress;
+        membership.imr_interface.s_addr = _interfaceAddress;
+        setsockopt(ToNative(_socket), IPPROTO_IP, IP_DROP_MEMBERSHIP, reinterpret_cast<const char*>(&membership), sizeof(membership));
+
+        CloseSocket(_socket);
+        _socket = kInvalidSocket;
+    }
+
+    bool ProfilerMulticastReceiver::IsOpen() const
+    {
+        return _socket != kInvalidSocket;
+    }
+
+    AmUInt32 ProfilerMulticastReceiver::Poll(const MessageCallback& callback, AmUInt32 timeoutMs)
+    {
+        if (_socket == kInvalidSocket)
+            return 0;
+
+        if (timeoutMs > 0)
+        {
+#if AM_PLATFORM_WINDOWS
+            WSAPOLLFD descriptor{ ToNative(_socket), POLLIN, 0 };
+            WSAPoll(&descriptor, 1, static_cast<INT>(timeoutMs));
+#else
+            pollfd descriptor{ ToNative(_socket), POLLIN, 0 };
+            poll(&descriptor, 1, static_cast<int>(timeoutMs));
+#endif
+        }
+
+        AmUInt32 count = 0;
+
+        while (true)
+        {
+            const auto received =
+                recv(ToNative(_socket), reinterpret_cast<char*>(_datagram.data()), static_cast<int>(_datagram.size()), 0);
+
+            if (received <= 0)
+                break;
+
+            count += _handleDatagram(_datagram.data(), static_cast<AmSize>(received), callback);
+        }
+
+        return count;
+    }
+
+    AmUInt32 ProfilerMulticastReceiver::_handleDatagram(const AmUInt8* data, AmSize size, const MessageCallback& callback)
+    {
+        if (size < ProfilerMulticastHeader::kSize)
+            return 0;
+
+        ProfilerMulticastHeader header{};
+        ReadHeader(data, header);
+
+        if (header.mMagic != ProfilerMulticastHeader::kMagic || header.mVersion != ProfilerMulticastHeader::kVersion ||
+            header.mFragmentCount == 0 || header.mFragmentIndex >= header.mFragmentCount)
+            return 0;
+
+        _datagramsReceived++;
+
+        // Late datagrams, with a sequence number behind the expected one, are not counted as lost
+        const AmUInt32 gap = header.mSequence - _expectedSequence;
+        if (_hasSequence && gap != 0 && gap < 0x80000000u)
+            _lostDatagrams += gap;
+
+        _expectedSequence = header.mSequence + 1;
+        _hasSequence = true;
+
+        if (header.mFragmentIndex == 0)
+        {
+            if (_fragmentCount > 0)
+                _droppedBatches++;
+
+            _batchId = header.mBatchId;
+            _batchFlags = header.mFlags;
+            _fragmentCount = header.mFragmentCount;
+            _nextFragment = 0;
+            _batch.clear();
+        }
+
+        if (_fragmentCount == 0)
+            return 0;
+
+        if (header.mBatchId != _batchId || header.mFragmentIndex != _nextFragment)
+        {
+            // A fragment of the current batch is missing
+            _droppedBatches++;
+            _fragmentCount = 0;
+            return 0;
+        }
+
+        _batch.insert(_batch.end(), data + ProfilerMulticastHeader::kSize, data + size);
+        _nextFragment++;
+
+        if (_nextFragment < _fragmentCount)
+            return 0;
+
+        _fragmentCount = 0;
+        return _decodeBatch((_batchFlags & eProfilerMulticastFlags_Keyframe) != 0, callback);
+    }
+
+    AmUInt32 ProfilerMulticastReceiver::_decodeBatch(bool keyframe, const MessageCallback& callback)
+    {
+        AmUInt32 count = 0;
+        AmSize offset = 0;
+
+        while (_batch.size() - offset >= sizeof(AmUInt32))
+        {
+            AmUInt32 size = 0;
+            std::memcpy(&size, _batch.data() + offset, sizeof(size));
+            offset += sizeof(size);
+
+            if (size > _batch.size() - offset)
+                break;
+
+            ProfilerDataVariant message;
+            if (ProfilerBinarySerializer::Decode(_batch.data() + offset, size, message))
+            {
+                callback(message, keyframe);
+                count++;
+            }
+
+            offset += size;
+        }
+
+        return count;
+    }
+} // namespace SparkyStudios::Audio::Amplitude
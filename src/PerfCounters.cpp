@@ -0,0 +1,471 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/PerfCounters.h>
+
+#include <cstring>
+
+#if AM_PLATFORM_LINUX
+#include <cerrno>
+#include <ctime>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        void Add(std::atomic<AmUInt64>& counter, AmUInt64 value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+#if AM_PLATFORM_LINUX
+        struct PerfEventType
+        {
+            AmUInt32 mType;
+            AmUInt64 mConfig;
+        };
+
+        // Indexed by counter
+        constexpr PerfEventType kPerfEvents[eProfilerPerfCounter_Count] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },      { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+        };
+
+        // Group reading of PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+        struct PerfGroupReading
+        {
+            AmUInt64 mCount;
+            AmUInt64 mTimeEnabled;
+            AmUInt64 mTimeRunning;
+            AmUInt64 mValues[eProfilerPerfCounter_Count];
+        };
+
+        AmInt32 OpenPerfEvent(eProfilerPerfCounter counter, AmInt32 group, bool enabled)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = kPerfEvents[counter].mType;
+            attr.config = kPerfEvents[counter].mConfig;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.disabled = group == -1 && !enabled ? 1 : 0; // Members follow their leader
+            attr.exclude_hv = 1;
+
+            // Context switches happen in the kernel, so count it when allowed, and fall back to user space only
+            auto fd = static_cast<AmInt32>(syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC));
+            if (fd == -1 && (errno == EACCES || errno == EPERM))
+            {
+                attr.exclude_kernel = 1;
+                fd = static_cast<AmInt32>(syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC));
+            }
+
+            return fd;
+        }
+#endif
+    } // namespace
+
+    AmReal64 ProfilerPerfScopeStats::GetInstructionsPerCycle() const
+    {
+        if (!Has(eProfilerPerfCounter_Cycles) || !Has(eProfilerPerfCounter_Instructions) || mValues[eProfilerPerfCounter_Cycles] == 0)
+            return 0.0;
+
+        return static_cast<AmReal64>(mValues[eProfilerPerfCounter_Instructions]) /
+            static_cast<AmReal64>(mValues[eProfilerPerfCounter_Cycles]);
+    }
+
+    AmReal64 ProfilerPerfScopeStats::GetPerKiloInstructions(eProfilerPerfCounter counter) const
+    {
+        if (!Has(counter) || !Has(eProfilerPerfCounter_Instructions) || mValues[eProfilerPerfCounter_Instructions] == 0)
+            return 0.0;
+
+        return static_cast<AmReal64>(mValues[counter]) * 1000.0 / static_cast<AmReal64>(mValues[eProfilerPerfCounter_Instructions]);
+    }
+
+    const char* ProfilerPerfScopeStats::GetCounterName(eProfilerPerfCounter counter)
+    {
+        switch (counter)
+        {
+        case eProfilerPerfCounter_Cycles:
+            return "cycles";
+        case eProfilerPerfCounter_Instructions:
+            return "instructions";
+        case eProfilerPerfCounter_CacheMisses:
+            return "cache_misses";
+        case eProfilerPerfCounter_BranchMisses:
+            return "branch_misses";
+        case eProfilerPerfCounter_TaskClock:
+            return "task_clock_ns";
+        case eProfilerPerfCounter_PageFaults:
+            return "page_faults";
+        case eProfilerPerfCounter_ContextSwitches:
+            return "context_switches";
+        default:
+            return "unknown";
+        }
+    }
+
+    const char* ProfilerPerfScopeStats::GetSourceName(eProfilerPerfSource source)
+    {
+        switch (source)
+        {
+        case eProfilerPerfSource_Hardware:
+            return "hardware";
+        case eProfilerPerfSource_Software:
+            return "software";
+        case eProfilerPerfSource_Rusage:
+            return "rusage";
+        default:
+            return "none";
+        }
+    }
+
+    ProfilerPerfCounters::ProfilerPerfCounters()
+        : _enabled(false)
+        , _scopeNames()
+        , _scopeCount(0)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerPerfCounters::~ProfilerPerfCounters()
+    {
+        for (CountedThread& thread : _threads)
+        {
+            if (thread.mState.load(std::memory_order_relaxed) != eThreadState_Free)
+                _close(thread);
+        }
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    void ProfilerPerfCounters::SetEnabled(bool enabled)
+    {
+        Thread::LockMutex(_mutex);
+
+        _enabled.store(enabled, std::memory_order_relaxed);
+
+#if AM_PLATFORM_LINUX
+        // Disabled counters are not scheduled on the PMU, so they cost nothing at context switches
+        for (CountedThread& thread : _threads)
+        {
+            if (thread.mState.load(std::memory_order_relaxed) != eThreadState_Free && thread.mLeader != -1)
+                ioctl(thread.mLeader, enabled ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    AmUInt32 ProfilerPerfCounters::RegisterThread(const AmString& name)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (AmUInt32 i = 0; i < kMaxThreads; ++i)
+        {
+            CountedThread& thread = _threads[i];
+            if (thread.mState.load(std::memory_order_relaxed) != eThreadState_Free)
+                continue;
+
+            if (!_open(thread, _enabled.load(std::memory_order_relaxed)))
+            {
+                Thread::UnlockMutex(_mutex);
+
+                amLogWarning("[ProfilerPerfCounters] Cannot read the counters of thread '%s'", name.c_str());
+                return kInvalidThread;
+            }
+
+            thread.mName = name;
+
+            for (AmUInt32 s = 0; s < kMaxScopes; ++s)
+            {
+                thread.mTotals[s].mCalls.store(0, std::memory_order_relaxed);
+                for (auto& value : thread.mTotals[s].mValues)
+                    value.store(0, std::memory_order_relaxed);
+
+                thread.mCollected[s] = ScopeCollected();
+            }
+
+            amLogDebug(
+                "[ProfilerPerfCounters] Registered thread '%s' with %s counters", name.c_str(),
+                ProfilerPerfScopeStats::GetSourceName(thread.mSource));
+
+            thread.mState.store(eThreadState_Active, std::memory_order_release);
+            Thread::UnlockMutex(_mutex);
+            return i;
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogWarning("[ProfilerPerfCounters] Cannot register thread '%s': %u threads already read counters", name.c_str(), kMaxThreads);
+        return kInvalidThread;
+    }
+
+    void ProfilerPerfCounters::UnregisterThread(AmUInt32 thread)
+    {
+        if (thread >= kMaxThreads)
+            return;
+
+        Thread::LockMutex(_mutex);
+
+        // The counters are closed by the next collection, once their last totals are read
+        eThreadState expected = eThreadState_Active;
+        _threads[thread].mState.compare_exchange_strong(expected, eThreadState_Closing, std::memory_order_acq_rel);
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    AmUInt32 ProfilerPerfCounters::RegisterScope(const char* name)
+    {
+        Thread::LockMutex(_mutex);
+
+        const AmUInt32 count = _scopeCount.load(std::memory_order_relaxed);
+        for (AmUInt32 i = 0; i < count; ++i)
+        {
+            if (std::strncmp(_scopeNames[i], name, sizeof(_scopeNames[i]) - 1) == 0)
+            {
+                Thread::UnlockMutex(_mutex);
+                return i;
+            }
+        }
+
+        if (count == kMaxScopes)
+        {
+            Thread::UnlockMutex(_mutex);
+
+            amLogWarning("[ProfilerPerfCounters] Cannot register scope '%s': %u scopes already registered", name, kMaxScopes);
+            return kInvalidScope;
+        }
+
+        std::strncpy(_scopeNames[count], name, sizeof(_scopeNames[count]) - 1);
+        _scopeCount.store(count + 1, std::memory_order_release);
+
+        Thread::UnlockMutex(_mutex);
+        return count;
+    }
+
+    bool ProfilerPerfCounters::Read(AmUInt32 thread, ProfilerPerfSample& sample) noexcept
+    {
+        if (thread >= kMaxThreads || !IsEnabled())
+            return false;
+
+        const CountedThread& counted = _threads[thread];
+        if (counted.mState.load(std::memory_order_acquire) != eThreadState_Active)
+            return false;
+
+        return _read(counted, sample);
+    }
+
+    void ProfilerPerfCounters::Accumulate(
+        AmUInt32 thread, AmUInt32 scope, const ProfilerPerfSample& begin, const ProfilerPerfSample& end) noexcept
+    {
+        if (thread >= kMaxThreads || scope >= kMaxScopes)
+            return;
+
+        ScopeTotals& totals = _threads[thread].mTotals[scope];
+
+        Add(totals.mCalls, 1);
+        for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+        {
+            // Scaled readings of multiplexed counters can go slightly backwards
+            if (end.mValues[i] > begin.mValues[i])
+                Add(totals.mValues[i], end.mValues[i] - begin.mValues[i]);
+        }
+    }
+
+    void ProfilerPerfCounters::Record(AmUInt32 thread, AmUInt32 scope, const ProfilerPerfSample& begin) noexcept
+    {
+        ProfilerPerfSample end;
+        if (Read(thread, end))
+            Accumulate(thread, scope, begin, end);
+    }
+
+    void ProfilerPerfCounters::Collect(std::vector<ProfilerPerfScopeStats>& stats)
+    {
+        Thread::LockMutex(_mutex);
+
+        const AmUInt32 scopeCount = _scopeCount.load(std::memory_order_acquire);
+
+        for (CountedThread& thread : _threads)
+        {
+            const eThreadState state = thread.mState.load(std::memory_order_acquire);
+            if (state == eThreadState_Free)
+                continue;
+
+            for (AmUInt32 s = 0; s < scopeCount; ++s)
+            {
+                const ScopeTotals& totals = thread.mTotals[s];
+                ScopeCollected& collected = thread.mCollected[s];
+
+                const AmUInt64 calls = totals.mCalls.load(std::memory_order_relaxed);
+                if (calls == collected.mCalls)
+                    continue;
+
+                ProfilerPerfScopeStats& scope = stats.emplace_back();
+                scope.mThread = thread.mName;
+                scope.mScope = _scopeNames[s];
+                scope.mSource = thread.mSource;
+                scope.mAvailable = thread.mAvailable;
+                scope.mCalls = calls - collected.mCalls;
+
+                for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+                {
+                    const AmUInt64 value = totals.mValues[i].load(std::memory_order_relaxed);
+                    scope.mValues[i] = value - collected.mValues[i];
+                    collected.mValues[i] = value;
+                }
+
+                collected.mCalls = calls;
+            }
+
+            if (state == eThreadState_Closing)
+            {
+                _close(thread);
+
+                thread.mName.clear();
+                thread.mState.store(eThreadState_Free, std::memory_order_release);
+            }
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerPerfCounters::_open(CountedThread& thread, bool enabled)
+    {
+        thread.mSource = eProfilerPerfSource_None;
+        thread.mAvailable = 0;
+        thread.mLeader = -1;
+
+        for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+        {
+            thread.mFds[i] = -1;
+            thread.mGroupIndex[i] = -1;
+        }
+
+#if AM_PLATFORM_LINUX
+        AmInt8 groupSize = 0;
+
+        // The first counter opened leads the group, cycles when the PMU is exposed, otherwise the task clock
+        for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+        {
+            const auto counter = static_cast<eProfilerPerfCounter>(i);
+            if (kPerfEvents[i].mType == PERF_TYPE_HARDWARE && thread.mLeader == -1 && counter != eProfilerPerfCounter_Cycles)
+                continue;
+
+            const AmInt32 fd = OpenPerfEvent(counter, thread.mLeader, enabled);
+            if (fd == -1)
+                continue;
+
+            if (thread.mLeader == -1)
+            {
+                thread.mLeader = fd;
+                thread.mSource = counter == eProfilerPerfCounter_Cycles ? eProfilerPerfSource_Hardware : eProfilerPerfSource_Software;
+            }
+
+            thread.mFds[i] = fd;
+            thread.mGroupIndex[i] = groupSize++;
+            thread.mAvailable |= 1u << i;
+        }
+
+        if (thread.mLeader != -1)
+            return true;
+
+        amLogInfo("[ProfilerPerfCounters] Perf events are not available (%s), reading the resource usage instead", std::strerror(errno));
+
+        thread.mSource = eProfilerPerfSource_Rusage;
+        thread.mAvailable = (1u << eProfilerPerfCounter_TaskClock) | (1u << eProfilerPerfCounter_PageFaults) |
+            (1u << eProfilerPerfCounter_ContextSwitches);
+        return true;
+#else
+        amLogWarning("[ProfilerPerfCounters] Performance counters are only available on Linux");
+        return false;
+#endif
+    }
+
+    void ProfilerPerfCounters::_close(CountedThread& thread)
+    {
+#if AM_PLATFORM_LINUX
+        // Members first, the leader last
+        for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+        {
+            if (thread.mFds[i] != -1 && thread.mFds[i] != thread.mLeader)
+                close(thread.mFds[i]);
+        }
+
+        if (thread.mLeader != -1)
+            close(thread.mLeader);
+#endif
+
+        for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+            thread.mFds[i] = -1;
+
+        thread.mLeader = -1;
+        thread.mSource = eProfilerPerfSource_None;
+        thread.mAvailable = 0;
+    }
+
+    bool ProfilerPerfCounters::_read(const CountedThread& thread, ProfilerPerfSample& sample) noexcept
+    {
+        sample = ProfilerPerfSample();
+
+#if AM_PLATFORM_LINUX
+        if (thread.mSource == eProfilerPerfSource_Rusage)
+        {
+            rusage usage;
+            timespec clock;
+            if (getrusage(RUSAGE_THREAD, &usage) != 0 || clock_gettime(CLOCK_THREAD_CPUTIME_ID, &clock) != 0)
+                return false;
+
+            sample.mValues[eProfilerPerfCounter_TaskClock] =
+                static_cast<AmUInt64>(clock.tv_sec) * 1000000000ull + static_cast<AmUInt64>(clock.tv_nsec);
+            sample.mValues[eProfilerPerfCounter_PageFaults] = static_cast<AmUInt64>(usage.ru_minflt + usage.ru_majflt);
+            sample.mValues[eProfilerPerfCounter_ContextSwitches] = static_cast<AmUInt64>(usage.ru_nvcsw + usage.ru_nivcsw);
+            return true;
+        }
+
+        // One system call reads the whole group, so every counter covers the same instructions
+        PerfGroupReading reading;
+        if (read(thread.mLeader, &reading, sizeof(reading)) <= 0)
+            return false;
+
+        // Counters are multiplexed when the group does not fit on the PMU, so scale them to the whole time
+        const bool scaled = reading.mTimeRunning > 0 && reading.mTimeRunning < reading.mTimeEnabled;
+        const AmReal64 scale = scaled ? static_cast<AmReal64>(reading.mTimeEnabled) / static_cast<AmReal64>(reading.mTimeRunning) : 1.0;
+
+        for (AmUInt32 i = 0; i < eProfilerPerfCounter_Count; ++i)
+        {
+            const AmInt8 index = thread.mGroupIndex[i];
+            if (index < 0 || static_cast<AmUInt64>(index) >= reading.mCount)
+                continue;
+
+            const AmUInt64 value = reading.mValues[index];
+            sample.mValues[i] = scaled ? static_cast<AmUInt64>(static_cast<AmReal64>(value) * scale) : value;
+        }
+
+        return true;
+#else
+        AM_UNUSED(thread);
+        return false;
+#endif
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,67 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Profiler/RateLimiter.h>
+
+#include <algorithm>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    ProfilerTokenBucket::ProfilerTokenBucket()
+        : _rate(0.0)
+        , _capacity(0.0)
+        , _tokens(0.0)
+        , _lastRefill(std::chrono::high_resolution_clock::now())
+    {}
+
+    ProfilerTokenBucket::ProfilerTokenBucket(AmReal64 ratePerSecond, AmReal64 capacity)
+        : ProfilerTokenBucket()
+    {
+        Configure(ratePerSecond, capacity);
+    }
+
+    void ProfilerTokenBucket::Configure(AmReal64 ratePerSecond, AmReal64 capacity)
+    {
+        _rate = std::max(ratePerSecond, 0.0);
+        _capacity = std::max(capacity, 0.0);
+        _tokens = _capacity;
+        _lastRefill = std::chrono::high_resolution_clock::now();
+    }
+
+    void ProfilerTokenBucket::Refill(ProfilerTime now)
+    {
+        if (IsUnlimited())
+            return;
+
+        const AmReal64 elapsed = std::chrono::duration<AmReal64>(now - _lastRefill).count();
+        if (elapsed <= 0.0)
+            return;
+
+        _tokens = std::min(_capacity, _tokens + elapsed * _rate);
+        _lastRefill = now;
+    }
+
+    bool ProfilerTokenBucket::CanConsume(AmReal64 amount) const
+    {
+        return IsUnlimited() || _tokens >= std::min(amount, _capacity);
+    }
+
+    void ProfilerTokenBucket::Consume(AmReal64 amount)
+    {
+        if (IsUnlimited())
+            return;
+
+        _tokens = std::max(_tokens - amount, -_capacity);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,110 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Profiler/RateMeter.h>
+
+#include <algorithm>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        // A bucket packs the time slice it counts, modulo 2^24, and an amount of up to 2^40
+        constexpr AmUInt32 kAmountBits = 40;
+        constexpr AmUInt64 kAmountMask = (1ull << kAmountBits) - 1;
+        constexpr AmUInt64 kSliceMask = (1ull << (64 - kAmountBits)) - 1;
+
+        AmUInt64 GetNanoseconds(ProfilerTime time)
+        {
+            return static_cast<AmUInt64>(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+        }
+    } // namespace
+
+    ProfilerRateMeter::ProfilerRateMeter(AmUInt32 windowMs)
+        : _bucketNs(std::max<AmUInt64>(static_cast<AmUInt64>(windowMs) * 1000000 / kBucketCount, 1))
+        , _total(0)
+    {
+        for (auto& bucket : _buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+
+    ProfilerRateMeter::ProfilerRateMeter(const ProfilerRateMeter& other)
+        : _bucketNs(other._bucketNs)
+        , _total(other._total.load(std::memory_order_relaxed))
+    {
+        for (AmUInt32 i = 0; i < kBucketCount; ++i)
+            _buckets[i].store(other._buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    ProfilerRateMeter& ProfilerRateMeter::operator=(const ProfilerRateMeter& other)
+    {
+        if (this == &other)
+            return *this;
+
+        _bucketNs = other._bucketNs;
+        _total.store(other._total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        for (AmUInt32 i = 0; i < kBucketCount; ++i)
+            _buckets[i].store(other._buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        return *this;
+    }
+
+    void ProfilerRateMeter::Add(AmUInt64 amount, ProfilerTime now)
+    {
+        const AmUInt64 slice = GetNanoseconds(now) / _bucketNs;
+        const AmUInt64 tag = slice & kSliceMask;
+        std::atomic<AmUInt64>& bucket = _buckets[slice % kBucketCount];
+
+        AmUInt64 current = bucket.load(std::memory_order_relaxed);
+        AmUInt64 next;
+
+        do
+        {
+            // The first addition of a new slice recycles the bucket, amounts saturate instead of overflowing into the tag
+            if ((current >> kAmountBits) == tag)
+                next = current + std::min(amount, kAmountMask - (current & kAmountMask));
+            else
+                next = (tag << kAmountBits) | std::min(amount, kAmountMask);
+        } while (!bucket.compare_exchange_weak(current, next, std::memory_order_relaxed));
+
+        _total.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    AmReal64 ProfilerRateMeter::GetRate(ProfilerTime now) const
+    {
+        const AmUInt64 ns = GetNanoseconds(now);
+        const AmUInt64 slice = ns / _bucketNs;
+
+        AmUInt64 amount = 0;
+        for (AmUInt64 i = 0; i < kBucketCount && i <= slice; ++i)
+        {
+            const AmUInt64 value = _buckets[(slice - i) % kBucketCount].load(std::memory_order_relaxed);
+            if ((value >> kAmountBits) == ((slice - i) & kSliceMask))
+                amount += value & kAmountMask;
+        }
+
+        // The current slice has only started, the window ends now
+        const AmUInt64 elapsed = (kBucketCount - 1) * _bucketNs + (ns - slice * _bucketNs);
+        return static_cast<AmReal64>(amount) * 1e9 / static_cast<AmReal64>(std::max<AmUInt64>(elapsed, 1));
+    }
+
+    void ProfilerRateMeter::Reset()
+    {
+        for (auto& bucket : _buckets)
+            bucket.store(0, std::memory_order_relaxed);
+
+        _total.store(0, std::memory_order_relaxed);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
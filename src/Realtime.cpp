@@ -0,0 +1,247 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Realtime.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Residency.h>
+
+#include <cstring>
+#include <string>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        thread_local bool gRealtimeThread = false;
+
+        ProfilerTime ToProfilerTime(AmInt64 timestampNs)
+        {
+            return ProfilerTime(std::chrono::duration_cast<ProfilerTime::duration>(std::chrono::nanoseconds(timestampNs)));
+        }
+    } // namespace
+
+    bool ProfilerRealtimeGuard::Enter() noexcept
+    {
+        const bool previous = gRealtimeThread;
+        gRealtimeThread = true;
+        return previous;
+    }
+
+    void ProfilerRealtimeGuard::Leave(bool previous) noexcept
+    {
+        gRealtimeThread = previous;
+    }
+
+    bool ProfilerRealtimeGuard::IsRealtimeThread() noexcept
+    {
+        return gRealtimeThread;
+    }
+
+    void ProfilerRealtimeGuard::Check(const char* function)
+    {
+        if (!gRealtimeThread)
+            return;
+
+        amLogCritical("[ProfilerRealtimeGuard] %s locks or allocates, and was called from a real-time thread", function);
+        AMPLITUDE_ASSERT(false);
+    }
+
+    ProfilerRealtimeRing::ProfilerRealtimeRing(AmUInt32 capacity, AmUInt32 residency)
+        : _records(nullptr)
+        , _mask(0)
+        , _residency(residency)
+        , _write(0)
+        , _cachedRead(0)
+        , _dropped(0)
+        , _read(0)
+    {
+        AmUInt64 size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        _mask = size - 1;
+        _records = static_cast<ProfilerRealtimeRecord*>(
+            ampoolmalign(eMemoryPoolKind_IO, size * sizeof(ProfilerRealtimeRecord), alignof(ProfilerRealtimeRecord)));
+
+        // Touched even without residency settings, so the first pushes do not page-fault
+        std::memset(static_cast<void*>(_records), 0, size * sizeof(ProfilerRealtimeRecord));
+        ProfilerMemoryResidency::Acquire(_records, size * sizeof(ProfilerRealtimeRecord), _residency);
+    }
+
+    ProfilerRealtimeRing::~ProfilerRealtimeRing()
+    {
+        ProfilerMemoryResidency::Release(_records, Capacity() * sizeof(ProfilerRealtimeRecord), _residency);
+        ampoolfree(eMemoryPoolKind_IO, _records);
+    }
+
+    AmSize ProfilerRealtimeRing::Pop(std::vector<ProfilerRealtimeRecord>& records)
+    {
+        const AmUInt64 read = _read.load(std::memory_order_relaxed);
+        const AmUInt64 write = _write.load(std::memory_order_acquire);
+
+        for (AmUInt64 position = read; position != write; ++position)
+            records.push_back(_records[position & _mask]);
+
+        _read.store(write, std::memory_order_release);
+        return static_cast<AmSize>(write - read);
+    }
+
+    ProfilerRealtimeCapture::ProfilerRealtimeCapture()
+        : _categoryMask(0)
+        , _releasedDropped(0)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerRealtimeCapture::~ProfilerRealtimeCapture()
+    {
+        for (Slot& slot : _slots)
+        {
+            if (slot.mRing != nullptr)
+                ampooldelete(eMemoryPoolKind_IO, ProfilerRealtimeRing, slot.mRing);
+        }
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    AmUInt32 ProfilerRealtimeCapture::RegisterThread(const AmString& name, AmUInt32 capacity, AmUInt32 residency)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (AmUInt32 i = 0; i < kMaxThreads; ++i)
+        {
+            Slot& slot = _slots[i];
+            if (slot.mState.load(std::memory_order_relaxed) != eSlotState_Free)
+                continue;
+
+            slot.mRing = ampoolnew(eMemoryPoolKind_IO, ProfilerRealtimeRing, capacity, residency);
+            slot.mName = name;
+            slot.mThreadId = Thread::GetCurrentThreadId();
+            slot.mWasRealtime = ProfilerRealtimeGuard::Enter();
+
+            // Rings are drained one at a time, so draining does not allocate either
+            _records.reserve(slot.mRing->Capacity());
+
+            amLogDebug("[ProfilerRealtimeCapture] Registered thread '%s' with %u records", name.c_str(), slot.mRing->Capacity());
+
+            slot.mState.store(eSlotState_Active, std::memory_order_release);
+            Thread::UnlockMutex(_mutex);
+            return i;
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogWarning("[ProfilerRealtimeCapture] Cannot register thread '%s': %u threads already capture", name.c_str(), kMaxThreads);
+        return kInvalidThread;
+    }
+
+    void ProfilerRealtimeCapture::UnregisterThread(AmUInt32 thread)
+    {
+        if (thread >= kMaxThreads)
+            return;
+
+        Thread::LockMutex(_mutex);
+
+        // The ring is released by the next drain, once its last records are read
+        Slot& slot = _slots[thread];
+        eSlotState expected = eSlotState_Active;
+        const bool unregistered = slot.mState.compare_exchange_strong(expected, eSlotState_Closing, std::memory_order_acq_rel);
+        const bool self = unregistered && slot.mThreadId == Thread::GetCurrentThreadId();
+        const bool wasRealtime = slot.mWasRealtime;
+
+        Thread::UnlockMutex(_mutex);
+
+        if (self)
+            ProfilerRealtimeGuard::Leave(wasRealtime);
+    }
+
+    void ProfilerRealtimeCapture::Drain(std::vector<ProfilerEvent>& events)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (Slot& slot : _slots)
+        {
+            const eSlotState state = slot.mState.load(std::memory_order_acquire);
+            if (state == eSlotState_Free)
+                continue;
+
+            _drain(slot, events);
+
+            if (state == eSlotState_Closing)
+            {
+                _releasedDropped += slot.mRing->GetDroppedCount();
+                ampooldelete(eMemoryPoolKind_IO, ProfilerRealtimeRing, slot.mRing);
+
+                slot.mRing = nullptr;
+                slot.mName.clear();
+                slot.mState.store(eSlotState_Free, std::memory_order_release);
+            }
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    AmUInt64 ProfilerRealtimeCapture::GetDroppedCount() const
+    {
+        Thread::LockMutex(_mutex);
+
+        AmUInt64 dropped = _releasedDropped;
+        for (const Slot& slot : _slots)
+        {
+            if (slot.mRing != nullptr)
+                dropped += slot.mRing->GetDroppedCount();
+        }
+
+        Thread::UnlockMutex(_mutex);
+        return dropped;
+    }
+
+    void ProfilerRealtimeCapture::_drain(Slot& slot, std::vector<ProfilerEvent>& events)
+    {
+        _records.clear();
+        slot.mRing->Pop(_records);
+
+        for (const ProfilerRealtimeRecord& record : _records)
+        {
+            ProfilerEvent& event = events.emplace_back(record.mName);
+            event.mTimestamp = ToProfilerTime(record.mTimestampNs);
+            event.mCategory = record.mCategory;
+            event.mParameters["thread"] = slot.mName;
+
+            if (record.mId != 0)
+                event.mParameters["id"] = std::to_string(record.mId);
+
+            switch (record.mKind)
+            {
+            case eProfilerRealtimeRecordKind_Event:
+                event.mParameters["kind"] = "event";
+                for (AmUInt32 i = 0; i < record.mValueCount; ++i)
+                    event.mParameters["value" + std::to_string(i)] = std::to_string(record.mValues[i]);
+                break;
+            case eProfilerRealtimeRecordKind_Counter:
+                event.mParameters["kind"] = "counter";
+                event.mParameters["value"] = std::to_string(record.mValues[0]);
+                break;
+            case eProfilerRealtimeRecordKind_Span:
+                // Spans are placed at their start
+                event.mTimestamp = ToProfilerTime(record.mTimestampNs - static_cast<AmInt64>(record.mValues[0]));
+                event.mParameters["kind"] = "span";
+                event.mParameters["duration_ms"] = std::to_string(record.mValues[0] / 1e6);
+                break;
+            }
+        }
+    }
+} // namespace SparkyStudios::Audio::Amplitude
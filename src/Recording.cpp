@@ -0,0 +1,1231 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Recording.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Serialization.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+
+#include <lz4.h>
+#include <zstd.h>
+
+#if AM_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        // Upper bound of the decompressed size of a chunk, so a damaged table cannot trigger huge allocations
+        constexpr AmUInt64 kMaxChunkSize = 1ull << 30;
+
+        template<typename T>
+        void Put(AmUInt8* data, AmSize offset, T value)
+        {
+            std::memcpy(data + offset, &value, sizeof(T));
+        }
+
+        AmInt64 GetTimestampNs(const ProfilerDataVariant& data)
+        {
+            return std::visit(
+                [](const auto& arg) -> AmInt64
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(arg.mTimestamp.time_since_epoch()).count();
+                },
+                data);
+        }
+
+        template<typename T>
+        T Get(const AmUInt8* data, AmSize offset)
+        {
+            T value;
+            std::memcpy(&value, data + offset, sizeof(T));
+            return value;
+        }
+
+        void EncodeFileHeader(AmUInt8* data, const ProfilerRecordingHeader& header)
+        {
+            std::memset(data, 0, ProfilerRecordingHeader::kSize);
+            Put(data, 0, header.mMagic);
+            Put(data, 4, header.mVersion);
+            Put(data, 6, header.mFormatVersion);
+            Put(data, 8, header.mFlags);
+            Put(data, 16, header.mStartTime);
+        }
+
+        void EncodeChunkHeader(AmUInt8* data, const ProfilerRecordingChunkInfo& chunk)
+        {
+            std::memset(data, 0, ProfilerRecordingChunkInfo::kHeaderSize);
+            Put(data, 0, ProfilerRecordingChunkInfo::kMagic);
+            Put(data, 4, chunk.mMessageCount);
+            Put(data, 8, chunk.mStoredSize);
+            Put(data, 16, chunk.mUncompressedSize);
+            Put(data, 24, chunk.mCompression);
+            Put(data, 32, chunk.mFirstTimestamp);
+            Put(data, 40, chunk.mLastTimestamp);
+        }
+
+        void EncodeTableEntry(AmUInt8* data, const ProfilerRecordingChunkInfo& chunk)
+        {
+            std::memset(data, 0, ProfilerRecordingChunkInfo::kTableEntrySize);
+            Put(data, 0, chunk.mOffset);
+            Put(data, 8, chunk.mStoredSize);
+            Put(data, 16, chunk.mUncompressedSize);
+            Put(data, 24, chunk.mMessageCount);
+            Put(data, 28, chunk.mCompression);
+            Put(data, 32, chunk.mFirstTimestamp);
+            Put(data, 40, chunk.mLastTimestamp);
+        }
+
+        void EncodeTrailer(AmUInt8* data, const ProfilerRecordingTrailer& trailer)
+        {
+            std::memset(data, 0, ProfilerRecordingTrailer::kSize);
+            Put(data, 0, trailer.mTableOffset);
+            Put(data, 8, trailer.mIndexOffset);
+            Put(data, 24, trailer.mChunkCount);
+            Put(data, 28, trailer.mMagic);
+        }
+
+        AmVoidPtr CreateCompressionContext(eProfilerRecordingCompression compression)
+        {
+            return compression == eProfilerRecordingCompression_Zstd ? ZSTD_createCCtx() : nullptr;
+        }
+
+        void DestroyCompressionContext(eProfilerRecordingCompression compression, AmVoidPtr context)
+        {
+            if (compression == eProfilerRecordingCompression_Zstd && context != nullptr)
+                ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(context));
+        }
+
+        bool CompressBuffer(
+            eProfilerRecordingCompression compression, AmVoidPtr context, const std::vector<AmUInt8>& source, std::vector<AmUInt8>& destination)
+        {
+            switch (compression)
+            {
+            case eProfilerRecordingCompression_Zstd:
+                {
+                    destination.resize(ZSTD_compressBound(source.size()));
+                    const AmSize size = ZSTD_compressCCtx(
+                        static_cast<ZSTD_CCtx*>(context), destination.data(), destination.size(), source.data(), source.size(),
+                        ProfilerRecordingWriter::kZstdLevel);
+
+                    if (ZSTD_isError(size))
+                        return false;
+
+                    destination.resize(size);
+                    return true;
+                }
+
+            case eProfilerRecordingCompression_LZ4:
+                {
+                    if (source.size() > LZ4_MAX_INPUT_SIZE)
+                        return false;
+
+                    destination.resize(static_cast<AmSize>(LZ4_compressBound(static_cast<int>(source.size()))));
+                    const int size = LZ4_compress_default(
+                        reinterpret_cast<const char*>(source.data()), reinterpret_cast<char*>(destination.data()),
+                        static_cast<int>(source.size()), static_cast<int>(destination.size()));
+
+                    if (size <= 0)
+                        return false;
+
+                    destination.resize(static_cast<AmSize>(size));
+                    return true;
+                }
+
+            default:
+                return false;
+            }
+        }
+
+        bool DecompressBuffer(AmUInt8 compression, const AmUInt8* source, AmSize sourceSize, std::vector<AmUInt8>& destination)
+        {
+            switch (compression)
+            {
+            case eProfilerRecordingCompression_Zstd:
+                {
+                    const AmSize size = ZSTD_decompress(destination.data(), destination.size(), source, sourceSize);
+                    return !ZSTD_isError(size) && size == destination.size();
+                }
+
+            case eProfilerRecordingCompression_LZ4:
+                {
+                    if (sourceSize > LZ4_MAX_INPUT_SIZE || destination.size() > LZ4_MAX_INPUT_SIZE)
+                        return false;
+
+                    const int size = LZ4_decompress_safe(
+                        reinterpret_cast<const char*>(source), reinterpret_cast<char*>(destination.data()), static_cast<int>(sourceSize),
+                        static_cast<int>(destination.size()));
+
+                    return size >= 0 && static_cast<AmSize>(size) == destination.size();
+                }
+
+            default:
+                return false;
+            }
+        }
+
+        void AddChunkToRuns(std::vector<ProfilerRecordingIndex::ChunkRun>& runs, AmUInt32 chunk)
+        {
+            if (!runs.empty() && runs.back().second + 1 == chunk)
+                runs.back().second = chunk;
+            else
+                runs.emplace_back(chunk, chunk);
+        }
+
+        void EncodeRuns(std::vector<AmUInt8>& buffer, const std::vector<ProfilerRecordingIndex::ChunkRun>& runs)
+        {
+            for (const auto& [first, last] : runs)
+            {
+                const AmSize offset = buffer.size();
+                buffer.resize(offset + ProfilerRecordingIndex::kRunSize);
+                Put(buffer.data(), offset, first);
+                Put(buffer.data(), offset + 4, last);
+            }
+        }
+
+        ProfilerRecordingHeader DecodeFileHeader(const AmUInt8* data)
+        {
+            ProfilerRecordingHeader header{};
+            header.mMagic = Get<AmUInt32>(data, 0);
+            header.mVersion = Get<AmUInt16>(data, 4);
+            header.mFormatVersion = Get<AmUInt16>(data, 6);
+            header.mFlags = Get<AmUInt32>(data, 8);
+            header.mStartTime = Get<AmInt64>(data, 16);
+            return header;
+        }
+
+        ProfilerRecordingChunkInfo DecodeChunkHeader(const AmUInt8* data, AmUInt64 offset)
+        {
+            ProfilerRecordingChunkInfo chunk{};
+            chunk.mOffset = offset + ProfilerRecordingChunkInfo::kHeaderSize;
+            chunk.mMessageCount = Get<AmUInt32>(data, 4);
+            chunk.mStoredSize = Get<AmUInt64>(data, 8);
+            chunk.mUncompressedSize = Get<AmUInt64>(data, 16);
+            chunk.mCompression = Get<AmUInt8>(data, 24);
+            chunk.mFirstTimestamp = Get<AmInt64>(data, 32);
+            chunk.mLastTimestamp = Get<AmInt64>(data, 40);
+            return chunk;
+        }
+
+        ProfilerRecordingChunkInfo DecodeTableEntry(const AmUInt8* data)
+        {
+            ProfilerRecordingChunkInfo chunk{};
+            chunk.mOffset = Get<AmUInt64>(data, 0);
+            chunk.mStoredSize = Get<AmUInt64>(data, 8);
+            chunk.mUncompressedSize = Get<AmUInt64>(data, 16);
+            chunk.mMessageCount = Get<AmUInt32>(data, 24);
+            chunk.mCompression = Get<AmUInt8>(data, 28);
+            chunk.mFirstTimestamp = Get<AmInt64>(data, 32);
+            chunk.mLastTimestamp = Get<AmInt64>(data, 40);
+            return chunk;
+        }
+
+        const AmUInt8* MapFile(const AmOsString& path, AmSize& size, AmVoidPtr& handle)
+        {
+            handle = nullptr;
+            size = 0;
+
+#if AM_PLATFORM_WINDOWS
+            HANDLE file = CreateFileW(
+                std::filesystem::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return nullptr;
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+            {
+                CloseHandle(file);
+                return nullptr;
+            }
+
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+
+            if (mapping == nullptr)
+                return nullptr;
+
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view == nullptr)
+            {
+                CloseHandle(mapping);
+                return nullptr;
+            }
+
+            handle = mapping;
+            size = static_cast<AmSize>(fileSize.QuadPart);
+            return static_cast<const AmUInt8*>(view);
+#else
+            const int fd = open(std::filesystem::path(path).c_str(), O_RDONLY);
+            if (fd < 0)
+                return nullptr;
+
+            struct stat info = {};
+            if (fstat(fd, &info) != 0 || info.st_size <= 0)
+            {
+                close(fd);
+                return nullptr;
+            }
+
+            void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+
+            if (view == MAP_FAILED)
+                return nullptr;
+
+            // Chunks are mostly read front to back
+            madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+            size = static_cast<AmSize>(info.st_size);
+            return static_cast<const AmUInt8*>(view);
+#endif
+        }
+
+        void UnmapFile(const AmUInt8* data, AmSize size, AmVoidPtr handle)
+        {
+#if AM_PLATFORM_WINDOWS
+            UnmapViewOfFile(data);
+            CloseHandle(static_cast<HANDLE>(handle));
+#else
+            AM_UNUSED(handle);
+            munmap(const_cast<AmUInt8*>(data), size);
+#endif
+        }
+    } // namespace
+
+    void ProfilerRecordingHeader::Encode(AmUInt8* data) const
+    {
+        EncodeFileHeader(data, *this);
+    }
+
+    void ProfilerRecordingChunkInfo::EncodeHeader(AmUInt8* data) const
+    {
+        EncodeChunkHeader(data, *this);
+    }
+
+    ProfilerRecordingWriter::ProfilerRecordingWriter()
+        : _open(false)
+        , _chunkSize(kDefaultChunkSize)
+        , _currentChunk()
+        , _nextSequence(0)
+        , _messageCount(0)
+        , _compression(eProfilerRecordingCompression_None)
+        , _compressionContext(nullptr)
+        , _chunkMinTimestamp(std::numeric_limits<AmInt64>::max())
+        , _chunkMaxTimestamp(std::numeric_limits<AmInt64>::lowest())
+        , _workersRunning(false)
+        , _pendingChunks(0)
+        , _fileOffset(0)
+        , _uncompressedBytes(0)
+        , _droppedChunks(0)
+        , _nextToWrite(0)
+    {
+        _mutex = Thread::CreateMutex();
+        _queueMutex = Thread::CreateMutex();
+        _fileMutex = Thread::CreateMutex();
+    }
+
+    ProfilerRecordingWriter::~ProfilerRecordingWriter()
+    {
+        Close();
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+        if (_queueMutex)
+            Thread::DestroyMutex(_queueMutex);
+        if (_fileMutex)
+            Thread::DestroyMutex(_fileMutex);
+    }
+
+    bool ProfilerRecordingWriter::Open(
+        const AmOsString& path,
+        AmSize chunkSize,
+        eProfilerRecordingCompression compression,
+        AmUInt32 compressionThreads,
+        eProfilerDurability durability,
+        AmUInt32 syncIntervalMs,
+        AmUInt32 writeBuffers)
+    {
+        Close();
+
+        Thread::LockMutex(_mutex);
+        Thread::LockMutex(_fileMutex);
+
+        if (!_file.Open(path, durability, syncIntervalMs, writeBuffers))
+        {
+            Thread::UnlockMutex(_fileMutex);
+            Thread::UnlockMutex(_mutex);
+            amLogError("[ProfilerRecordingWriter] Failed to create recording file: %s", std::filesystem::path(path).string().c_str());
+            return false;
+        }
+
+        ProfilerRecordingHeader header{};
+        header.mMagic = ProfilerRecordingHeader::kMagic;
+        header.mVersion = ProfilerRecordingHeader::kVersion;
+        header.mFormatVersion = ProfilerBinarySerializer::kFormatVersion;
+        header.mStartTime =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+
+        ProfilerAsyncFileWriter::Buffer* buffer = _file.AcquireBuffer(ProfilerRecordingHeader::kSize, true);
+        EncodeFileHeader(buffer->mData, header);
+        _file.Submit(buffer, 0);
+
+        _fileOffset = ProfilerRecordingHeader::kSize;
+        _uncompressedBytes = 0;
+        _droppedChunks = 0;
+        _chunks.clear();
+        _completed.clear();
+        _nextToWrite = 0;
+
+        Thread::UnlockMutex(_fileMutex);
+
+        _open = true;
+        _chunkSize = chunkSize > 0 ? chunkSize : kDefaultChunkSize;
+        _chunk.clear();
+        _chunk.reserve(_chunkSize + _chunkSize / 4);
+        _currentChunk = {};
+        _nextSequence = 0;
+        _messageCount = 0;
+
+        _chunkObjects.clear();
+        _chunkEvents.clear();
+        _chunkMinTimestamp = std::numeric_limits<AmInt64>::max();
+        _chunkMaxTimestamp = std::numeric_limits<AmInt64>::lowest();
+        _objectRuns.clear();
+        _eventRuns.clear();
+        _chunkTimes.clear();
+
+        _compression = compression;
+        _compressionContext = CreateCompressionContext(compression);
+
+        if (compression != eProfilerRecordingCompression_None)
+        {
+            _workersRunning = true;
+            for (AmUInt32 i = 0; i < compressionThreads; ++i)
+                _workers.push_back(Thread::CreateThread(&ProfilerRecordingWriter::_workerLoop, this));
+        }
+
+        Thread::UnlockMutex(_mutex);
+        return true;
+    }
+
+    void ProfilerRecordingWriter::Close()
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_open)
+        {
+            _flushChunk();
+            _waitForPendingChunks();
+            _stopWorkers();
+
+            Thread::LockMutex(_fileMutex);
+            _writeFooter();
+            _file.Close();
+            Thread::UnlockMutex(_fileMutex);
+
+            DestroyCompressionContext(_compression, _compressionContext);
+            _compressionContext = nullptr;
+            _open = false;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerRecordingWriter::IsOpen() const
+    {
+        Thread::LockMutex(_mutex);
+        const bool open = _open;
+        Thread::UnlockMutex(_mutex);
+
+        return open;
+    }
+
+    void ProfilerRecordingWriter::Write(const ProfilerDataVariant& data)
+    {
+        Thread::LockMutex(_mutex);
+
+        if (!_open)
+        {
+            Thread::UnlockMutex(_mutex);
+            return;
+        }
+
+        const AmInt64 timestamp = GetTimestampNs(data);
+        if (_currentChunk.mMessageCount == 0)
+            _currentChunk.mFirstTimestamp = timestamp;
+
+        _currentChunk.mLastTimestamp = timestamp;
+        _currentChunk.mMessageCount++;
+
+        _indexMessage(data, timestamp);
+
+        // Each record is prefixed by its size, patched once the message is encoded
+        const AmSize offset = _chunk.size();
+        _chunk.resize(offset + sizeof(AmUInt32));
+        ProfilerBinarySerializer::Encode(data, _chunk);
+        Put(_chunk.data(), offset, static_cast<AmUInt32>(_chunk.size() - offset - sizeof(AmUInt32)));
+
+        _messageCount++;
+
+        if (_chunk.size() >= _chunkSize)
+            _flushChunk();
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerRecordingWriter::Flush()
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_open)
+        {
+            _flushChunk();
+            _waitForPendingChunks();
+            _file.Drain();
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    AmUInt64 ProfilerRecordingWriter::GetMessageCount() const
+    {
+        Thread::LockMutex(_mutex);
+        const AmUInt64 count = _messageCount;
+        Thread::UnlockMutex(_mutex);
+
+        return count;
+    }
+
+    void ProfilerRecordingWriter::GetSizes(AmUInt64& storedBytes, AmUInt64& uncompressedBytes) const
+    {
+        Thread::LockMutex(_fileMutex);
+        storedBytes = _fileOffset;
+        uncompressedBytes = _uncompressedBytes;
+        Thread::UnlockMutex(_fileMutex);
+    }
+
+    AmUInt64 ProfilerRecordingWriter::GetDroppedChunkCount() const
+    {
+        Thread::LockMutex(_fileMutex);
+        const AmUInt64 dropped = _droppedChunks;
+        Thread::UnlockMutex(_fileMutex);
+
+        return dropped;
+    }
+
+    void ProfilerRecordingWriter::_workerLoop(AmVoidPtr userData)
+    {
+        auto* writer = static_cast<ProfilerRecordingWriter*>(userData);
+        AmVoidPtr context = CreateCompressionContext(writer->_compression);
+
+        while (true)
+        {
+            Thread::LockMutex(writer->_queueMutex);
+
+            PendingChunkPtr chunk;
+            if (!writer->_queue.empty())
+            {
+                chunk = std::move(writer->_queue.front());
+                writer->_queue.pop_front();
+            }
+
+            Thread::UnlockMutex(writer->_queueMutex);
+
+            if (chunk)
+            {
+                writer->_compressChunk(*chunk, context);
+                writer->_completeChunk(std::move(chunk));
+                continue;
+            }
+
+            if (!writer->_workersRunning.load())
+                break;
+
+            Thread::Sleep(1);
+        }
+
+        DestroyCompressionContext(writer->_compression, context);
+    }
+
+    void ProfilerRecordingWriter::_flushChunk()
+    {
+        if (_currentChunk.mMessageCount == 0)
+            return;
+
+        PendingChunkPtr chunk(ampoolnew(eMemoryPoolKind_IO, PendingChunk));
+        chunk->mSequence = _nextSequence++;
+        chunk->mInfo = _currentChunk;
+        chunk->mData.swap(_chunk);
+
+        // Chunks are written in sequence order, so the sequence is the index of the chunk in the file
+        const auto chunkIndex = static_cast<AmUInt32>(chunk->mSequence);
+
+        for (const auto& key : _chunkObjects)
+            AddChunkToRuns(_objectRuns[key], chunkIndex);
+
+        for (const auto& name : _chunkEvents)
+            AddChunkToRuns(_eventRuns[name], chunkIndex);
+
+        _chunkTimes.emplace_back(_chunkMinTimestamp, _chunkMaxTimestamp);
+
+        _chunk.clear();
+        _chunk.reserve(_chunkSize + _chunkSize / 4);
+        _currentChunk = {};
+        _chunkObjects.clear();
+        _chunkEvents.clear();
+        _chunkMinTimestamp = std::numeric_limits<AmInt64>::max();
+        _chunkMaxTimestamp = std::numeric_limits<AmInt64>::lowest();
+
+        _pendingChunks++;
+
+        // Hand the chunk to the pool, unless it is already saturated
+        if (!_workers.empty())
+        {
+            Thread::LockMutex(_queueMutex);
+            const bool queued = _queue.size() < _workers.size() * 4;
+            if (queued)
+                _queue.push_back(std::move(chunk));
+            Thread::UnlockMutex(_queueMutex);
+
+            if (queued)
+                return;
+        }
+
+        _compressChunk(*chunk, _compressionContext);
+        _completeChunk(std::move(chunk));
+    }
+
+    void ProfilerRecordingWriter::_compressChunk(PendingChunk& chunk, AmVoidPtr context) const
+    {
+        chunk.mInfo.mUncompressedSize = chunk.mData.size();
+        chunk.mInfo.mStoredSize = chunk.mData.size();
+        chunk.mInfo.mCompression = eProfilerRecordingCompression_None;
+
+        if (_compression == eProfilerRecordingCompression_None)
+            return;
+
+        // Chunks which do not shrink are stored as-is
+        if (CompressBuffer(_compression, context, chunk.mData, chunk.mCompressed) && chunk.mCompressed.size() < chunk.mData.size())
+        {
+            chunk.mInfo.mStoredSize = chunk.mCompressed.size();
+            chunk.mInfo.mCompression = _compression;
+        }
+    }
+
+    void ProfilerRecordingWriter::_completeChunk(PendingChunkPtr chunk)
+    {
+        Thread::LockMutex(_fileMutex);
+
+        _completed.emplace(chunk->mSequence, std::move(chunk));
+
+        // Write every chunk which is next in line
+        for (auto it = _completed.find(_nextToWrite); it != _completed.end(); it = _completed.find(_nextToWrite))
+        {
+            PendingChunk& ready = *it->second;
+            const std::vector<AmUInt8>& data = ready.mInfo.mCompression != eProfilerRecordingCompression_None ? ready.mCompressed : ready.mData;
+
+            const AmSize size = ProfilerRecordingChunkInfo::kHeaderSize + data.size();
+
+            // Never wait for the disk here: without a free buffer the chunk is dropped, and kept in
+            // the table as an empty chunk so chunk indices in the secondary indexes stay valid
+            if (ProfilerAsyncFileWriter::Buffer* buffer = _file.AcquireBuffer(size, false); buffer != nullptr)
+            {
+                ready.mInfo.mOffset = _fileOffset + ProfilerRecordingChunkInfo::kHeaderSize;
+
+                EncodeChunkHeader(buffer->mData, ready.mInfo);
+                std::memcpy(buffer->mData + ProfilerRecordingChunkInfo::kHeaderSize, data.data(), data.size());
+                _file.Submit(buffer, _fileOffset);
+
+                _fileOffset += size;
+                _uncompressedBytes += ready.mInfo.mUncompressedSize;
+            }
+            else
+            {
+                ready.mInfo.mOffset = _fileOffset;
+                ready.mInfo.mStoredSize = 0;
+                ready.mInfo.mUncompressedSize = 0;
+                ready.mInfo.mMessageCount = 0;
+                ready.mInfo.mCompression = eProfilerRecordingCompression_None;
+                _droppedChunks++;
+            }
+
+            _chunks.push_back(ready.mInfo);
+
+            _completed.erase(it);
+            _nextToWrite++;
+            _pendingChunks--;
+        }
+
+        Thread::UnlockMutex(_fileMutex);
+    }
+
+    void ProfilerRecordingWriter::_waitForPendingChunks() const
+    {
+        while (_pendingChunks.load() > 0)
+            Thread::Sleep(1);
+    }
+
+    void ProfilerRecordingWriter::_stopWorkers()
+    {
+        _workersRunning = false;
+
+        for (auto& worker : _workers)
+        {
+            Thread::Wait(worker);
+            Thread::Release(worker);
+        }
+
+        _workers.clear();
+    }
+
+    void ProfilerRecordingWriter::_indexMessage(const ProfilerDataVariant& data, AmInt64 timestamp)
+    {
+        // Messages are not always written in time order, so the range of a chunk is tracked separately
+        _chunkMinTimestamp = std::min(_chunkMinTimestamp, timestamp);
+        _chunkMaxTimestamp = std::max(_chunkMaxTimestamp, timestamp);
+
+        if (const auto* entity = std::get_if<ProfilerEntityData>(&data))
+            _chunkObjects.emplace(eProfilerCategory_Entity, entity->mSourceId, entity->mEntityId);
+        else if (const auto* channel = std::get_if<ProfilerChannelData>(&data))
+            _chunkObjects.emplace(eProfilerCategory_Channel, channel->mSourceId, channel->mChannelId);
+        else if (const auto* listener = std::get_if<ProfilerListenerData>(&data))
+            _chunkObjects.emplace(eProfilerCategory_Listener, listener->mSourceId, listener->mListenerId);
+        else if (const auto* event = std::get_if<ProfilerEvent>(&data))
+            _chunkEvents.insert(event->mEventName);
+    }
+
+    void ProfilerRecordingWriter::_writeFooter()
+    {
+        // The whole footer is written at once, after every chunk
+        std::vector<AmUInt8> footer(_chunks.size() * ProfilerRecordingChunkInfo::kTableEntrySize);
+
+        for (AmSize i = 0, l = _chunks.size(); i < l; ++i)
+            EncodeTableEntry(footer.data() + i * ProfilerRecordingChunkInfo::kTableEntrySize, _chunks[i]);
+
+        ProfilerRecordingTrailer trailer{};
+        trailer.mTableOffset = _fileOffset;
+        trailer.mIndexOffset = _fileOffset + footer.size();
+        trailer.mChunkCount = static_cast<AmUInt32>(_chunks.size());
+        trailer.mMagic = ProfilerRecordingTrailer::kMagic;
+
+        _encodeIndex(footer, trailer.mIndexOffset);
+
+        const AmSize trailerOffset = footer.size();
+        footer.resize(trailerOffset + ProfilerRecordingTrailer::kSize);
+        EncodeTrailer(footer.data() + trailerOffset, trailer);
+
+        ProfilerAsyncFileWriter::Buffer* buffer = _file.AcquireBuffer(footer.size(), true);
+        std::memcpy(buffer->mData, footer.data(), footer.size());
+        _file.Submit(buffer, _fileOffset);
+
+        _fileOffset += footer.size();
+    }
+
+    void ProfilerRecordingWriter::_encodeIndex(std::vector<AmUInt8>& output, AmUInt64 indexOffset) const
+    {
+        std::vector<AmUInt8> objects(_objectRuns.size() * ProfilerRecordingIndex::kObjectEntrySize);
+        std::vector<AmUInt8> events(_eventRuns.size() * ProfilerRecordingIndex::kEventEntrySize);
+        std::vector<AmUInt8> names;
+        std::vector<AmUInt8> runs;
+
+        // Maps are ordered, so entries are written sorted by key
+        AmSize entry = 0;
+        for (const auto& [key, chunkRuns] : _objectRuns)
+        {
+            AmUInt8* data = objects.data() + entry++ * ProfilerRecordingIndex::kObjectEntrySize;
+            Put(data, 0, std::get<2>(key));
+            Put(data, 8, std::get<0>(key));
+            Put(data, 12, std::get<1>(key));
+            Put(data, 16, static_cast<AmUInt32>(runs.size() / ProfilerRecordingIndex::kRunSize));
+            Put(data, 20, static_cast<AmUInt32>(chunkRuns.size()));
+            EncodeRuns(runs, chunkRuns);
+        }
+
+        entry = 0;
+        for (const auto& [name, chunkRuns] : _eventRuns)
+        {
+            AmUInt8* data = events.data() + entry++ * ProfilerRecordingIndex::kEventEntrySize;
+            Put(data, 0, static_cast<AmUInt32>(names.size()));
+            Put(data, 4, static_cast<AmUInt32>(name.size()));
+            Put(data, 8, static_cast<AmUInt32>(runs.size() / ProfilerRecordingIndex::kRunSize));
+            Put(data, 12, static_cast<AmUInt32>(chunkRuns.size()));
+            EncodeRuns(runs, chunkRuns);
+            names.insert(names.end(), name.begin(), name.end());
+        }
+
+        std::vector<AmUInt8> times(_chunkTimes.size() * ProfilerRecordingIndex::kTimeEntrySize);
+        for (AmSize i = 0, l = _chunkTimes.size(); i < l; ++i)
+        {
+            Put(times.data(), i * ProfilerRecordingIndex::kTimeEntrySize, _chunkTimes[i].first);
+            Put(times.data(), i * ProfilerRecordingIndex::kTimeEntrySize + 8, _chunkTimes[i].second);
+        }
+
+        const AmUInt64 objectsOffset = indexOffset + ProfilerRecordingIndex::kHeaderSize;
+        const AmUInt64 eventsOffset = objectsOffset + objects.size();
+        const AmUInt64 namesOffset = eventsOffset + events.size();
+        const AmUInt64 runsOffset = namesOffset + names.size();
+        const AmUInt64 timesOffset = runsOffset + runs.size();
+
+        AmUInt8 header[ProfilerRecordingIndex::kHeaderSize] = {};
+        Put(header, 0, ProfilerRecordingIndex::kMagic);
+        Put(header, 4, static_cast<AmUInt32>(_objectRuns.size()));
+        Put(header, 8, static_cast<AmUInt32>(_eventRuns.size()));
+        Put(header, 12, static_cast<AmUInt32>(runs.size() / ProfilerRecordingIndex::kRunSize));
+        Put(header, 16, static_cast<AmUInt32>(_chunkTimes.size()));
+        Put(header, 24, objectsOffset);
+        Put(header, 32, eventsOffset);
+        Put(header, 40, namesOffset);
+        Put(header, 48, runsOffset);
+        Put(header, 56, timesOffset);
+
+        output.insert(output.end(), header, header + sizeof(header));
+        for (const auto* section : { &objects, &events, &names, &runs, &times })
+            output.insert(output.end(), section->begin(), section->end());
+    }
+
+    ProfilerRecordingReader::ProfilerRecordingReader()
+        : _handle(nullptr)
+        , _data(nullptr)
+        , _size(0)
+        , _header()
+        , _recovered(false)
+    {}
+
+    ProfilerRecordingReader::~ProfilerRecordingReader()
+    {
+        Close();
+    }
+
+    bool ProfilerRecordingReader::Open(const AmOsString& path)
+    {
+        Close();
+
+        _data = MapFile(path, _size, _handle);
+        if (_data == nullptr)
+        {
+            amLogError("[ProfilerRecordingReader] Failed to map recording file: %s", std::filesystem::path(path).string().c_str());
+            return false;
+        }
+
+        if (_size < ProfilerRecordingHeader::kSize)
+        {
+            amLogError("[ProfilerRecordingReader] File is too small to be a recording: %s", std::filesystem::path(path).string().c_str());
+            Close();
+            return false;
+        }
+
+        _header = DecodeFileHeader(_data);
+        if (_header.mMagic != ProfilerRecordingHeader::kMagic || _header.mVersion == 0 ||
+            _header.mVersion > ProfilerRecordingHeader::kVersion)
+        {
+            amLogError("[ProfilerRecordingReader] File is not a supported recording: %s", std::filesystem::path(path).string().c_str());
+            Close();
+            return false;
+        }
+
+        if (_header.mFormatVersion != ProfilerBinarySerializer::kFormatVersion)
+        {
+            amLogError(
+                "[ProfilerRecordingReader] Recording uses message format %u, expected %u", static_cast<AmUInt32>(_header.mFormatVersion),
+                static_cast<AmUInt32>(ProfilerBinarySerializer::kFormatVersion));
+            Close();
+            return false;
+        }
+
+        if (!_readFooter())
+        {
+            amLogWarning("[ProfilerRecordingReader] Recording has no valid footer, scanning chunks");
+            _scanChunks();
+            _recovered = true;
+        }
+
+        return true;
+    }
+
+    void ProfilerRecordingReader::Close()
+    {
+        if (_data != nullptr)
+            UnmapFile(_data, _size, _handle);
+
+        _handle = nullptr;
+        _data = nullptr;
+        _size = 0;
+        _header = {};
+        _chunks.clear();
+        _index = {};
+        _recovered = false;
+    }
+
+    AmUInt64 ProfilerRecordingReader::GetMessageCount() const
+    {
+        AmUInt64 count = 0;
+        for (const auto& chunk : _chunks)
+            count += chunk.mMessageCount;
+
+        return count;
+    }
+
+    bool ProfilerRecordingReader::ReadChunk(AmSize index, const MessageCallback& callback) const
+    {
+        if (index >= _chunks.size())
+            return false;
+
+        const ProfilerRecordingChunkInfo& chunk = _chunks[index];
+
+        const AmUInt8* data = _data + chunk.mOffset;
+        AmSize size = chunk.mStoredSize;
+
+        // Only the chunks which are read are decompressed, each into its own buffer so
+        // several threads can read chunks at once
+        std::vector<AmUInt8> decompressed;
+        if (chunk.mCompression != eProfilerRecordingCompression_None)
+        {
+            if (chunk.mUncompressedSize > kMaxChunkSize)
+                return false;
+
+            decompressed.resize(chunk.mUncompressedSize);
+            if (!DecompressBuffer(chunk.mCompression, data, size, decompressed))
+                return false;
+
+            data = decompressed.data();
+            size = decompressed.size();
+        }
+
+        ProfilerDataVariant message;
+        AmSize offset = 0;
+        AmUInt32 count = 0;
+
+        while (offset + sizeof(AmUInt32) <= size)
+        {
+            const auto recordSize = Get<AmUInt32>(data, offset);
+            offset += sizeof(AmUInt32);
+
+            if (recordSize > size - offset || !ProfilerBinarySerializer::Decode(data + offset, recordSize, message))
+                return false;
+
+            callback(message);
+
+            offset += recordSize;
+            count++;
+        }
+
+        return offset == size && count == chunk.mMessageCount;
+    }
+
+    std::vector<AmSize> ProfilerRecordingReader::FindChunks(AmInt64 fromNs, AmInt64 toNs) const
+    {
+        std::vector<AmSize> chunks;
+        for (AmSize i = 0, l = _chunks.size(); i < l; ++i)
+        {
+            if (_isChunkInRange(i, fromNs, toNs))
+                chunks.push_back(i);
+        }
+
+        return chunks;
+    }
+
+    std::vector<AmSize> ProfilerRecordingReader::FindObjectChunks(
+        eProfilerCategory category, AmObjectID id, AmUInt32 sourceId, AmInt64 fromNs, AmInt64 toNs) const
+    {
+        if (!HasIndex())
+            return FindChunks(fromNs, toNs);
+
+        const ProfilerRecordingIndex::ObjectKey key(static_cast<AmUInt32>(category), sourceId, id);
+
+        // Binary search of the sorted object entries, directly in the mapped file
+        AmUInt32 low = 0, high = _index.mObjectCount;
+        while (low < high)
+        {
+            const AmUInt32 middle = low + (high - low) / 2;
+            const AmUInt8* entry = _index.mObjects + static_cast<AmSize>(middle) * ProfilerRecordingIndex::kObjectEntrySize;
+            const ProfilerRecordingIndex::ObjectKey entryKey(Get<AmUInt32>(entry, 8), Get<AmUInt32>(entry, 12), Get<AmObjectID>(entry, 0));
+
+            if (entryKey < key)
+                low = middle + 1;
+            else if (key < entryKey)
+                high = middle;
+            else
+                return _expandRuns(Get<AmUInt32>(entry, 16), Get<AmUInt32>(entry, 20), fromNs, toNs);
+        }
+
+        return {};
+    }
+
+    std::vector<AmSize> ProfilerRecordingReader::FindEventChunks(const AmString& name, AmInt64 fromNs, AmInt64 toNs) const
+    {
+        if (!HasIndex())
+            return FindChunks(fromNs, toNs);
+
+        AmUInt32 low = 0, high = _index.mEventCount;
+        while (low < high)
+        {
+            const AmUInt32 middle = low + (high - low) / 2;
+            const AmUInt8* entry = _index.mEvents + static_cast<AmSize>(middle) * ProfilerRecordingIndex::kEventEntrySize;
+
+            const auto nameOffset = Get<AmUInt32>(entry, 0);
+            const auto nameLength = Get<AmUInt32>(entry, 4);
+            if (static_cast<AmUInt64>(nameOffset) + nameLength > _index.mNamesSize)
+                return {};
+
+            const std::string_view entryName(reinterpret_cast<const char*>(_index.mNames + nameOffset), nameLength);
+            const int order = entryName.compare(name);
+
+            if (order < 0)
+                low = middle + 1;
+            else if (order > 0)
+                high = middle;
+            else
+                return _expandRuns(Get<AmUInt32>(entry, 8), Get<AmUInt32>(entry, 12), fromNs, toNs);
+        }
+
+        return {};
+    }
+
+    bool ProfilerRecordingReader::ReadObject(
+        eProfilerCategory category,
+        AmObjectID id,
+        AmUInt32 sourceId,
+        AmInt64 fromNs,
+        AmInt64 toNs,
+        const MessageCallback& callback) const
+    {
+        const auto matches = [category, id, sourceId](const ProfilerDataVariant& message)
+        {
+            if (category == eProfilerCategory_Entity)
+            {
+                const auto* entity = std::get_if<ProfilerEntityData>(&message);
+                return entity != nullptr && entity->mEntityId == id && entity->mSourceId == sourceId;
+            }
+
+            if (category == eProfilerCategory_Channel)
+            {
+                const auto* channel = std::get_if<ProfilerChannelData>(&message);
+                return channel != nullptr && channel->mChannelId == id && channel->mSourceId == sourceId;
+            }
+
+            if (category == eProfilerCategory_Listener)
+            {
+                const auto* listener = std::get_if<ProfilerListenerData>(&message);
+                return listener != nullptr && listener->mListenerId == id && listener->mSourceId == sourceId;
+            }
+
+            return false;
+        };
+
+        bool valid = true;
+        for (const AmSize chunk : FindObjectChunks(category, id, sourceId, fromNs, toNs))
+        {
+            valid &= ReadChunk(
+                chunk,
+                [&](const ProfilerDataVariant& message)
+                {
+                    const AmInt64 timestamp = GetTimestampNs(message);
+                    if (timestamp >= fromNs && timestamp <= toNs && matches(message))
+                        callback(message);
+                });
+        }
+
+        return valid;
+    }
+
+    bool ProfilerRecordingReader::ReadEvents(const AmString& name, AmInt64 fromNs, AmInt64 toNs, const MessageCallback& callback) const
+    {
+        bool valid = true;
+        for (const AmSize chunk : FindEventChunks(name, fromNs, toNs))
+        {
+            valid &= ReadChunk(
+                chunk,
+                [&](const ProfilerDataVariant& message)
+                {
+                    const auto* event = std::get_if<ProfilerEvent>(&message);
+                    if (event == nullptr || event->mEventName != name)
+                        return;
+
+                    const AmInt64 timestamp = GetTimestampNs(message);
+                    if (timestamp >= fromNs && timestamp <= toNs)
+                        callback(message);
+                });
+        }
+
+        return valid;
+    }
+
+    bool ProfilerRecordingReader::_readFooter()
+    {
+        const AmSize trailerSize = _header.mVersion >= 2 ? ProfilerRecordingTrailer::kSize : ProfilerRecordingTrailer::kVersion1Size;
+        if (_size < ProfilerRecordingHeader::kSize + trailerSize)
+            return false;
+
+        const AmUInt8* data = _data + _size - trailerSize;
+
+        ProfilerRecordingTrailer trailer{};
+        if (_header.mVersion >= 2)
+        {
+            trailer.mTableOffset = Get<AmUInt64>(data, 0);
+            trailer.mIndexOffset = Get<AmUInt64>(data, 8);
+            trailer.mChunkCount = Get<AmUInt32>(data, 24);
+            trailer.mMagic = Get<AmUInt32>(data, 28);
+        }
+        else
+        {
+            trailer.mTableOffset = Get<AmUInt64>(data, 0);
+            trailer.mChunkCount = Get<AmUInt32>(data, 8);
+            trailer.mMagic = Get<AmUInt32>(data, 12);
+        }
+
+        if (trailer.mMagic != ProfilerRecordingTrailer::kMagic)
+            return false;
+
+        // Version 1 recordings end with the chunk table, later ones with the indexes
+        const AmUInt64 tableSize = static_cast<AmUInt64>(trailer.mChunkCount) * ProfilerRecordingChunkInfo::kTableEntrySize;
+        const AmUInt64 tableEnd = _header.mVersion >= 2 ? trailer.mIndexOffset : _size - trailerSize;
+        if (trailer.mTableOffset < ProfilerRecordingHeader::kSize || tableEnd > _size - trailerSize || trailer.mTableOffset > tableEnd ||
+            tableEnd - trailer.mTableOffset != tableSize)
+            return false;
+
+        std::vector<ProfilerRecordingChunkInfo> chunks;
+        chunks.reserve(trailer.mChunkCount);
+
+        for (AmUInt32 i = 0; i < trailer.mChunkCount; ++i)
+        {
+            const auto chunk = DecodeTableEntry(_data + trailer.mTableOffset + i * ProfilerRecordingChunkInfo::kTableEntrySize);
+            if (chunk.mOffset > trailer.mTableOffset || chunk.mStoredSize > trailer.mTableOffset - chunk.mOffset)
+                return false;
+
+            chunks.push_back(chunk);
+        }
+
+        _chunks = std::move(chunks);
+
+        // A damaged index only slows queries down, the chunks are still readable
+        if (_header.mVersion >= 2 && !_readIndex(trailer.mIndexOffset, _size - trailerSize))
+        {
+            amLogWarning("[ProfilerRecordingReader] Recording indexes are invalid, queries will scan every chunk");
+            _index = {};
+        }
+
+        return true;
+    }
+
+    bool ProfilerRecordingReader::_readIndex(AmUInt64 offset, AmUInt64 end)
+    {
+        if (offset > end || end - offset < ProfilerRecordingIndex::kHeaderSize)
+            return false;
+
+        const AmUInt8* header = _data + offset;
+        if (Get<AmUInt32>(header, 0) != ProfilerRecordingIndex::kMagic || Get<AmUInt32>(header, 16) != _chunks.size())
+            return false;
+
+        const auto objectCount = Get<AmUInt32>(header, 4);
+        const auto eventCount = Get<AmUInt32>(header, 8);
+        const auto runCount = Get<AmUInt32>(header, 12);
+        const auto objectsOffset = Get<AmUInt64>(header, 24);
+        const auto eventsOffset = Get<AmUInt64>(header, 32);
+        const auto namesOffset = Get<AmUInt64>(header, 40);
+        const auto runsOffset = Get<AmUInt64>(header, 48);
+        const auto timesOffset = Get<AmUInt64>(header, 56);
+
+        // Sections follow each other, each must fit before the next one
+        const auto fits = [](AmUInt64 start, AmUInt64 size, AmUInt64 next)
+        {
+            return start <= next && next - start >= size;
+        };
+
+        if (objectsOffset != offset + ProfilerRecordingIndex::kHeaderSize ||
+            !fits(objectsOffset, static_cast<AmUInt64>(objectCount) * ProfilerRecordingIndex::kObjectEntrySize, eventsOffset) ||
+            !fits(eventsOffset, static_cast<AmUInt64>(eventCount) * ProfilerRecordingIndex::kEventEntrySize, namesOffset) ||
+            !fits(namesOffset, 0, runsOffset) ||
+            !fits(runsOffset, static_cast<AmUInt64>(runCount) * ProfilerRecordingIndex::kRunSize, timesOffset) ||
+            !fits(timesOffset, static_cast<AmUInt64>(_chunks.size()) * ProfilerRecordingIndex::kTimeEntrySize, end))
+            return false;
+
+        _index.mObjects = _data + objectsOffset;
+        _index.mObjectCount = objectCount;
+        _index.mEvents = _data + eventsOffset;
+        _index.mEventCount = eventCount;
+        _index.mNames = _data + namesOffset;
+        _index.mNamesSize = runsOffset - namesOffset;
+        _index.mRuns = _data + runsOffset;
+        _index.mRunCount = runCount;
+        _index.mTimes = _data + timesOffset;
+
+        return true;
+    }
+
+    void ProfilerRecordingReader::_scanChunks()
+    {
+        _chunks.clear();
+
+        AmUInt64 offset = ProfilerRecordingHeader::kSize;
+        while (offset + ProfilerRecordingChunkInfo::kHeaderSize <= _size)
+        {
+            const AmUInt8* data = _data + offset;
+            if (Get<AmUInt32>(data, 0) != ProfilerRecordingChunkInfo::kMagic)
+                break;
+
+            const auto chunk = DecodeChunkHeader(data, offset);
+
+            // The last chunk may have been partially written when the recording stopped
+            if (chunk.mStoredSize > _size - chunk.mOffset)
+                break;
+
+            _chunks.push_back(chunk);
+            offset = chunk.mOffset + chunk.mStoredSize;
+        }
+    }
+
+    bool ProfilerRecordingReader::_isChunkInRange(AmSize index, AmInt64 fromNs, AmInt64 toNs) const
+    {
+        // Without indexes the time range of a chunk is unknown, as messages may be out of order
+        if (!HasIndex())
+            return true;
+
+        const AmUInt8* entry = _index.mTimes + index * ProfilerRecordingIndex::kTimeEntrySize;
+        return Get<AmInt64>(entry, 0) <= toNs && Get<AmInt64>(entry, 8) >= fromNs;
+    }
+
+    std::vector<AmSize> ProfilerRecordingReader::_expandRuns(AmUInt32 runOffset, AmUInt32 runCount, AmInt64 fromNs, AmInt64 toNs) const
+    {
+        std::vector<AmSize> chunks;
+        if (static_cast<AmUInt64>(runOffset) + runCount > _index.mRunCount)
+            return chunks;
+
+        for (AmUInt32 i = 0; i < runCount; ++i)
+        {
+            const AmUInt8* run = _index.mRuns + static_cast<AmSize>(runOffset + i) * ProfilerRecordingIndex::kRunSize;
+            const auto first = Get<AmUInt32>(run, 0);
+            const auto last = std::min<AmUInt32>(Get<AmUInt32>(run, 4), static_cast<AmUInt32>(_chunks.size()) - 1);
+
+            for (AmUInt32 chunk = first; chunk <= last && chunk < _chunks.size(); ++chunk)
+            {
+                if (_isChunkInRange(chunk, fromNs, toNs))
+                    chunks.push_back(chunk);
+            }
+        }
+
+        return chunks;
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,110 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Residency.h>
+
+#include <cerrno>
+#include <cstring>
+
+#if AM_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        // Huge pages only help buffers spanning several of them
+        constexpr AmSize kHugePageSize = 2 * 1024 * 1024;
+    } // namespace
+
+    bool ProfilerMemoryResidency::Acquire(void* data, AmSize size, AmUInt32 residency)
+    {
+        if (data == nullptr || size == 0 || residency == eProfilerMemoryResidency_None)
+            return true;
+
+        const AmSize pageSize = GetPageSize();
+
+#if AM_PLATFORM_LINUX && defined(MADV_HUGEPAGE)
+        // Must be advised before the pages are touched, only the whole pages inside the buffer are advised
+        if ((residency & eProfilerMemoryResidency_HugePages) && size >= 2 * kHugePageSize)
+        {
+            const auto address = reinterpret_cast<AmSize>(data);
+            const AmSize begin = (address + pageSize - 1) & ~(pageSize - 1);
+            const AmSize end = (address + size) & ~(pageSize - 1);
+
+            if (end > begin && madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) != 0)
+                amLogDebug("[ProfilerMemoryResidency] Transparent huge pages unavailable: %s", std::strerror(errno));
+        }
+#else
+        AM_UNUSED(kHugePageSize);
+#endif
+
+        // Writing a byte back maps the page without changing the buffer
+        if (residency & (eProfilerMemoryResidency_Prefault | eProfilerMemoryResidency_Lock))
+        {
+            volatile AmUInt8* bytes = static_cast<volatile AmUInt8*>(data);
+            for (AmSize offset = 0; offset < size; offset += pageSize)
+                bytes[offset] = bytes[offset];
+
+            bytes[size - 1] = bytes[size - 1];
+        }
+
+        if (!(residency & eProfilerMemoryResidency_Lock))
+            return true;
+
+#if AM_PLATFORM_WINDOWS
+        if (!VirtualLock(data, size))
+        {
+            amLogWarning("[ProfilerMemoryResidency] Failed to lock %zu bytes in memory (error %lu)", size, GetLastError());
+            return false;
+        }
+#else
+        if (mlock(data, size) != 0)
+        {
+            amLogWarning("[ProfilerMemoryResidency] Failed to lock %zu bytes in memory: %s", size, std::strerror(errno));
+            return false;
+        }
+#endif
+
+        return true;
+    }
+
+    void ProfilerMemoryResidency::Release(void* data, AmSize size, AmUInt32 residency)
+    {
+        if (data == nullptr || size == 0 || !(residency & eProfilerMemoryResidency_Lock))
+            return;
+
+#if AM_PLATFORM_WINDOWS
+        VirtualUnlock(data, size);
+#else
+        munlock(data, size);
+#endif
+    }
+
+    AmSize ProfilerMemoryResidency::GetPageSize()
+    {
+#if AM_PLATFORM_WINDOWS
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<AmSize>(info.dwPageSize);
+#else
+        return static_cast<AmSize>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+} // namespace SparkyStudios::Audio::Amplitude
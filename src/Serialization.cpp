@@ -0,0 +1,549 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Profiler/Serialization.h>
+
+#include <cstring>
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        // All supported platforms are little-endian, values are copied as-is.
+        class BinaryWriter
+        {
+        public:
+            explicit BinaryWriter(std::vector<AmUInt8>& buffer)
+                : _buffer(buffer)
+            {}
+
+            template<typename T>
+            void Write(T value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const AmSize offset = _buffer.size();
+                _buffer.resize(offset + sizeof(T));
+                std::memcpy(_buffer.data() + offset, &value, sizeof(T));
+            }
+
+            void WriteString(const AmString& value)
+            {
+                Write(static_cast<AmUInt32>(value.size()));
+                _buffer.insert(_buffer.end(), value.begin(), value.end());
+            }
+
+            void WriteVector3(const AmVector3& value)
+            {
+                Write<AmReal32>(value[0]);
+                Write<AmReal32>(value[1]);
+                Write<AmReal32>(value[2]);
+            }
+
+            void WriteTime(const ProfilerTime& value)
+            {
+                Write<AmInt64>(std::chrono::duration_cast<std::chrono::nanoseconds>(value.time_since_epoch()).count());
+            }
+
+            void WriteStrings(const std::vector<AmString>& values)
+            {
+                Write(static_cast<AmUInt32>(values.size()));
+                for (const auto& value : values)
+                    WriteString(value);
+            }
+
+            template<typename Map, typename Key, typename Value>
+            void WriteMap(const Map& values)
+            {
+                Write(static_cast<AmUInt32>(values.size()));
+                for (const auto& [key, value] : values)
+                {
+                    if constexpr (std::is_same_v<Key, AmString>)
+                        WriteString(key);
+                    else
+                        Write<Key>(key);
+
+                    if constexpr (std::is_same_v<Value, AmString>)
+                        WriteString(value);
+                    else
+                        Write<Value>(value);
+                }
+            }
+
+        private:
+            std::vector<AmUInt8>& _buffer;
+        };
+
+        class BinaryReader
+        {
+        public:
+            BinaryReader(const AmUInt8* data, AmSize size)
+                : _data(data)
+                , _size(size)
+                , _offset(0)
+                , _valid(true)
+            {}
+
+            template<typename T>
+            T Read()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value{};
+
+                if (!_valid || _size - _offset < sizeof(T))
+                {
+                    _valid = false;
+                    return value;
+                }
+
+                std::memcpy(&value, _data + _offset, sizeof(T));
+                _offset += sizeof(T);
+                return value;
+            }
+
+            AmString ReadString()
+            {
+                const auto length = Read<AmUInt32>();
+                if (!_valid || _size - _offset < length)
+                {
+                    _valid = false;
+                    return {};
+                }
+
+                AmString value(reinterpret_cast<const char*>(_data + _offset), length);
+                _offset += length;
+                return value;
+            }
+
+            AmVector3 ReadVector3()
+            {
+                AmVector3 value = kVector3Zero;
+                value[0] = Read<AmReal32>();
+                value[1] = Read<AmReal32>();
+                value[2] = Read<AmReal32>();
+                return value;
+            }
+
+            ProfilerTime ReadTime()
+            {
+                const std::chrono::nanoseconds ns(Read<AmInt64>());
+                return ProfilerTime(std::chrono::duration_cast<ProfilerTime::duration>(ns));
+            }
+
+            std::vector<AmString> ReadStrings()
+            {
+                std::vector<AmString> values;
+                const auto count = ReadCount(sizeof(AmUInt32));
+                values.reserve(count);
+
+                for (AmUInt32 i = 0; i < count && _valid; ++i)
+                    values.push_back(ReadString());
+
+                return values;
+            }
+
+            template<typename Map, typename Key, typename Value>
+            Map ReadMap()
+            {
+                Map values;
+                const auto count = ReadCount(sizeof(AmUInt32) * 2);
+
+                for (AmUInt32 i = 0; i < count && _valid; ++i)
+                {
+                    Key key;
+                    if constexpr (std::is_same_v<Key, AmString>)
+                        key = ReadString();
+                    else
+                        key = Read<Key>();
+
+                    if constexpr (std::is_same_v<Value, AmString>)
+                        values[key] = ReadString();
+                    else
+                        values[key] = Read<Value>();
+                }
+
+                return values;
+            }
+
+            // Reads an element count, rejecting counts which cannot fit in the remaining data
+            AmUInt32 ReadCount(AmSize minElementSize)
+            {
+                const auto count = Read<AmUInt32>();
+                if (!_valid || count > (_size - _offset) / minElementSize)
+                {
+                    _valid = false;
+                    return 0;
+                }
+
+                return count;
+            }
+
+            [[nodiscard]] bool IsValid() const
+            {
+                return _valid;
+            }
+
+        private:
+            const AmUInt8* _data;
+            AmSize _size;
+            AmSize _offset;
+            bool _valid;
+        };
+
+        void WriteSnapshot(BinaryWriter& writer, const ProfilerDataSnapshot& snapshot)
+        {
+            writer.WriteTime(snapshot.mTimestamp);
+            writer.Write<AmUInt64>(snapshot.mMessageId);
+            writer.Write<AmUInt32>(snapshot.mCategory);
+            writer.Write<AmUInt8>(snapshot.mPriority);
+            writer.Write<AmUInt32>(snapshot.mSourceId);
+        }
+
+        void ReadSnapshot(BinaryReader& reader, ProfilerDataSnapshot& snapshot)
+        {
+            snapshot.mTimestamp = reader.ReadTime();
+            snapshot.mMessageId = reader.Read<AmUInt64>();
+            snapshot.mCategory = static_cast<eProfilerCategory>(reader.Read<AmUInt32>());
+            snapshot.mPriority = static_cast<eProfilerPriority>(reader.Read<AmUInt8>());
+            snapshot.mSourceId = reader.Read<AmUInt32>();
+        }
+
+        void WriteData(BinaryWriter& writer, const ProfilerEngineData& data)
+        {
+            writer.Write<AmUInt8>(data.mIsInitialized);
+            writer.Write<AmReal64>(data.mEngineUptime);
+            writer.WriteString(data.mConfigFile);
+            writer.Write<AmUInt32>(data.mTotalEntityCount);
+            writer.Write<AmUInt32>(data.mActiveEntityCount);
+            writer.Write<AmUInt32>(data.mTotalChannelCount);
+            writer.Write<AmUInt32>(data.mActiveChannelCount);
+            writer.Write<AmUInt32>(data.mTotalListenerCount);
+            writer.Write<AmUInt32>(data.mActiveListenerCount);
+            writer.Write<AmUInt32>(data.mTotalEnvironmentCount);
+            writer.Write<AmUInt32>(data.mActiveEnvironmentCount);
+            writer.Write<AmUInt32>(data.mTotalRoomCount);
+            writer.Write<AmUInt32>(data.mActiveRoomCount);
+            writer.Write<AmReal32>(data.mCpuUsagePercent);
+            writer.Write<AmUInt64>(data.mMemoryUsageBytes);
+            writer.Write<AmUInt64>(data.mMemoryPeakBytes);
+            writer.Write<AmUInt32>(data.mActiveVoiceCount);
+            writer.Write<AmUInt32>(data.mMaxVoiceCount);
+            writer.Write<AmUInt32>(data.mSampleRate);
+            writer.Write<AmUInt16>(data.mChannelCount);
+            writer.Write<AmUInt16>(data.mFrameCount);
+            writer.Write<AmReal32>(data.mMasterGain);
+            writer.WriteStrings(data.mLoadedSoundBanks);
+            writer.WriteStrings(data.mLoadedPlugins);
+            writer.WriteMap<decltype(data.mAssetCounts), AmString, AmUInt32>(data.mAssetCounts);
+        }
+
+        void ReadData(BinaryReader& reader, ProfilerEngineData& data)
+        {
+            data.mIsInitialized = reader.Read<AmUInt8>() != 0;
+            data.mEngineUptime = reader.Read<AmReal64>();
+            data.mConfigFile = reader.ReadString();
+            data.mTotalEntityCount = reader.Read<AmUInt32>();
+            data.mActiveEntityCount = reader.Read<AmUInt32>();
+            data.mTotalChannelCount = reader.Read<AmUInt32>();
+            data.mActiveChannelCount = reader.Read<AmUInt32>();
+            data.mTotalListenerCount = reader.Read<AmUInt32>();
+            data.mActiveListenerCount = reader.Read<AmUInt32>();
+            data.mTotalEnvironmentCount = reader.Read<AmUInt32>();
+            data.mActiveEnvironmentCount = reader.Read<AmUInt32>();
+            data.mTotalRoomCount = reader.Read<AmUInt32>();
+            data.mActiveRoomCount = reader.Read<AmUInt32>();
+            data.mCpuUsagePercent = reader.Read<AmReal32>();
+            data.mMemoryUsageBytes = reader.Read<AmUInt64>();
+            data.mMemoryPeakBytes = reader.Read<AmUInt64>();
+            data.mActiveVoiceCount = reader.Read<AmUInt32>();
+            data.mMaxVoiceCount = reader.Read<AmUInt32>();
+            data.mSampleRate = reader.Read<AmUInt32>();
+            data.mChannelCount = reader.Read<AmUInt16>();
+            data.mFrameCount = reader.Read<AmUInt16>();
+            data.mMasterGain = reader.Read<AmReal32>();
+            data.mLoadedSoundBanks = reader.ReadStrings();
+            data.mLoadedPlugins = reader.ReadStrings();
+            data.mAssetCounts = reader.ReadMap<decltype(data.mAssetCounts), AmString, AmUInt32>();
+        }
+
+        void WriteData(BinaryWriter& writer, const ProfilerEntityData& data)
+        {
+            writer.Write<AmUInt64>(data.mEntityId);
+            writer.WriteVector3(data.mPosition);
+            writer.WriteVector3(data.mLastPosition);
+            writer.WriteVector3(data.mVelocity);
+            writer.WriteVector3(data.mForward);
+            writer.WriteVector3(data.mUp);
+            writer.Write<AmUInt32>(data.mActiveChannelCount);
+            writer.Write<AmReal32>(data.mDistanceToListener);
+            writer.Write<AmReal32>(data.mObstruction);
+            writer.Write<AmReal32>(data.mOcclusion);
+            writer.Write<AmReal32>(data.mDirectivity);
+            writer.Write<AmReal32>(data.mDirectivitySharpness);
+            writer.Write<AmReal32>(data.mAzimuth);
+            writer.Write<AmReal32>(data.mElevation);
+            writer.Write<AmReal32>(data.mAttenuationFactor);
+
+            writer.Write(static_cast<AmUInt32>(data.mChannelIds.size()));
+            for (AmChannelID channelId : data.mChannelIds)
+                writer.Write<AmUInt64>(channelId);
+
+            writer.WriteMap<decltype(data.mEnvironmentEffects), AmUInt64, AmReal32>(data.mEnvironmentEffects);
+        }
+
+        void ReadData(BinaryReader& reader, ProfilerEntityData& data)
+        {
+            data.mEntityId = reader.Read<AmUInt64>();
+            data.mPosition = reader.ReadVector3();
+            data.mLastPosition = reader.ReadVector3();
+            data.mVelocity = reader.ReadVector3();
+            data.mForward = reader.ReadVector3();
+            data.mUp = reader.ReadVector3();
+            data.mActiveChannelCount = reader.Read<AmUInt32>();
+            data.mDistanceToListener = reader.Read<AmReal32>();
+            data.mObstruction = reader.Read<AmReal32>();
+            data.mOcclusion = reader.Read<AmReal32>();
+            data.mDirectivity = reader.Read<AmReal32>();
+            data.mDirectivitySharpness = reader.Read<AmReal32>();
+            data.mAzimuth = reader.Read<AmReal32>();
+            data.mElevation = reader.Read<AmReal32>();
+            data.mAttenuationFactor = reader.Read<AmReal32>();
+
+            const auto channelCount = reader.ReadCount(sizeof(AmUInt64));
+            data.mChannelIds.resize(channelCount);
+            for (AmUInt32 i = 0; i < channelCount; ++i)
+                data.mChannelIds[i] = reader.Read<AmUInt64>();
+
+            data.mEnvironmentEffects = reader.ReadMap<decltype(data.mEnvironmentEffects), AmUInt64, AmReal32>();
+        }
+
+        void WriteData(BinaryWriter& writer, const ProfilerChannelData& data)
+        {
+            writer.Write<AmUInt64>(data.mChannelId);
+            writer.Write<AmUInt32>(data.mPlaybackState);
+            writer.Write<AmUInt64>(data.mSourceEntityId);
+            writer.WriteString(data.mSoundName);
+            writer.WriteString(data.mSoundBankName);
+            writer.WriteString(data.mCollectionName);
+            writer.Write<AmReal64>(data.mPlaybackPosition);
+            writer.Write<AmReal64>(data.mTotalDuration);
+            writer.Write<AmUInt32>(data.mLoopCount);
+            writer.Write<AmUInt32>(data.mCurrentLoop);
+            writer.Write<AmReal32>(data.mGain);
+            writer.WriteVector3(data.mPosition);
+            writer.Write<AmReal32>(data.mDistanceToListener);
+            writer.Write<AmReal32>(data.mDopplerFactor);
+            writer.Write<AmReal32>(data.mOcclusionFactor);
+            writer.Write<AmReal32>(data.mObstructionFactor);
+            writer.WriteStrings(data.mActiveEffects);
+            writer.WriteMap<decltype(data.mEffectParameters), AmString, AmReal32>(data.mEffectParameters);
+        }
+
+        void ReadData(BinaryReader& reader, ProfilerChannelData& data)
+        {
+            data.mChannelId = reader.Read<AmUInt64>();
+            data.mPlaybackState = static_cast<eChannelPlaybackState>(reader.Read<AmUInt32>());
+            data.mSourceEntityId = reader.Read<AmUInt64>();
+            data.mSoundName = reader.ReadString();
+            data.mSoundBankName = reader.ReadString();
+            data.mCollectionName = reader.ReadString();
+            data.mPlaybackPosition = reader.Read<AmReal64>();
+            data.mTotalDuration = reader.Read<AmReal64>();
+            data.mLoopCount = reader.Read<AmUInt32>();
+            data.mCurrentLoop = reader.Read<AmUInt32>();
+            data.mGain = reader.Read<AmReal32>();
+            data.mPosition = reader.ReadVector3();
+            data.mDistanceToListener = reader.Read<AmReal32>();
+            data.mDopplerFactor = reader.Read<AmReal32>();
+            data.mOcclusionFactor = reader.Read<AmReal32>();
+            data.mObstructionFactor = reader.Read<AmReal32>();
+            data.mActiveEffects = reader.ReadStrings();
+            data.mEffectParameters = reader.ReadMap<decltype(data.mEffectParameters), AmString, AmReal32>();
+        }
+
+        void WriteData(BinaryWriter& writer, const ProfilerListenerData& data)
+        {
+            writer.Write<AmUInt64>(data.mListenerId);
+            writer.WriteVector3(data.mPosition);
+            writer.WriteVector3(data.mLastPosition);
+            writer.WriteVector3(data.mVelocity);
+            writer.WriteVector3(data.mForward);
+            writer.WriteVector3(data.mUp);
+            writer.Write<AmReal32>(data.mGain);
+            writer.WriteString(data.mCurrentEnvironment);
+            writer.WriteMap<decltype(data.mEnvironmentParameters), AmString, AmReal32>(data.mEnvironmentParameters);
+        }
+
+        void ReadData(BinaryReader& reader, ProfilerListenerData& data)
+        {
+            data.mListenerId = reader.Read<AmUInt64>();
+            data.mPosition = reader.ReadVector3();
+            data.mLastPosition = reader.ReadVector3();
+            data.mVelocity = reader.ReadVector3();
+            data.mForward = reader.ReadVector3();
+            data.mUp = reader.ReadVector3();
+            data.mGain = reader.Read<AmReal32>();
+            data.mCurrentEnvironment = reader.ReadString();
+            data.mEnvironmentParameters = reader.ReadMap<decltype(data.mEnvironmentParameters), AmString, AmReal32>();
+        }
+
+        void WriteData(BinaryWriter& writer, const ProfilerPerformanceData& data)
+        {
+            writer.Write<AmReal32>(data.mTotalCpuUsage);
+            writer.Write<AmReal32>(data.mMixerCpuUsage);
+            writer.Write<AmReal32>(data.mDspCpuUsage);
+            writer.Write<AmReal32>(data.mStreamingCpuUsage);
+            writer.Write<AmUInt64>(data.mTotalAllocatedMemory);
+            writer.Write<AmUInt64>(data.mEngineMemory);
+            writer.Write<AmUInt64>(data.mAudioBufferMemory);
+            writer.Write<AmUInt64>(data.mAssetMemory);
+            writer.Write<AmUInt32>(data.mProcessedSamples);
+            writer.Write<AmUInt32>(data.mUnderruns);
+            writer.Write<AmUInt32>(data.mOverruns);
+            writer.Write<AmReal32>(data.mLatencyMs);
+            writer.Write<AmUInt32>(data.mActiveThreadCount);
+            writer.WriteMap<decltype(data.mThreadCpuUsage), AmString, AmReal32>(data.mThreadCpuUsage);
+
+            writer.Write(static_cast<AmUInt32>(data.mThreadScheduling.size()));
+            for (const auto& [thread, scheduling] : data.mThreadScheduling)
+            {
+                writer.WriteString(thread);
+                writer.Write<AmUInt32>(scheduling.mWakeups);
+                writer.Write<AmReal32>(scheduling.mLatencyP50Ms);
+                writer.Write<AmReal32>(scheduling.mLatencyP99Ms);
+                writer.Write<AmReal32>(scheduling.mLatencyMaxMs);
+                writer.Write<AmUInt32>(scheduling.mVoluntarySwitches);
+                writer.Write<AmUInt32>(scheduling.mInvoluntarySwitches);
+
+                for (const AmUInt32 count : scheduling.mLatencyBuckets)
+                    writer.Write<AmUInt32>(count);
+            }
+        }
+
+        void ReadData(BinaryReader& reader, ProfilerPerformanceData& data)
+        {
+            data.mTotalCpuUsage = reader.Read<AmReal32>();
+            data.mMixerCpuUsage = reader.Read<AmReal32>();
+            data.mDspCpuUsage = reader.Read<AmReal32>();
+            data.mStreamingCpuUsage = reader.Read<AmReal32>();
+            data.mTotalAllocatedMemory = reader.Read<AmUInt64>();
+            data.mEngineMemory = reader.Read<AmUInt64>();
+            data.mAudioBufferMemory = reader.Read<AmUInt64>();
+            data.mAssetMemory = reader.Read<AmUInt64>();
+            data.mProcessedSamples = reader.Read<AmUInt32>();
+            data.mUnderruns = reader.Read<AmUInt32>();
+            data.mOverruns = reader.Read<AmUInt32>();
+            data.mLatencyMs = reader.Read<AmReal32>();
+            data.mActiveThreadCount = reader.Read<AmUInt32>();
+            data.mThreadCpuUsage = reader.ReadMap<decltype(data.mThreadCpuUsage), AmString, AmReal32>();
+
+            const auto schedulingCount =
+                reader.ReadCount(sizeof(AmUInt32) * (ProfilerThreadScheduling::kLatencyBucketCount + 7));
+            for (AmUInt32 i = 0; i < schedulingCount && reader.IsValid(); ++i)
+            {
+                ProfilerThreadScheduling& scheduling = data.mThreadScheduling[reader.ReadString()];
+                scheduling.mWakeups = reader.Read<AmUInt32>();
+                scheduling.mLatencyP50Ms = reader.Read<AmReal32>();
+                scheduling.mLatencyP99Ms = reader.Read<AmReal32>();
+                scheduling.mLatencyMaxMs = reader.Read<AmReal32>();
+                scheduling.mVoluntarySwitches = reader.Read<AmUInt32>();
+                scheduling.mInvoluntarySwitches = reader.Read<AmUInt32>();
+
+                for (AmUInt32& count : scheduling.mLatencyBuckets)
+                    count = reader.Read<AmUInt32>();
+            }
+        }
+
+        void WriteData(BinaryWriter& writer, const ProfilerEvent& data)
+        {
+            writer.WriteString(data.mEventName);
+            writer.WriteString(data.mDescription);
+            writer.WriteMap<decltype(data.mParameters), AmString, AmString>(data.mParameters);
+        }
+
+        void ReadData(BinaryReader& reader, ProfilerEvent& data)
+        {
+            data.mEventName = reader.ReadString();
+            data.mDescription = reader.ReadString();
+            data.mParameters = reader.ReadMap<decltype(data.mParameters), AmString, AmString>();
+        }
+
+        void WriteData(BinaryWriter& writer, const ProfilerAggregateData& data)
+        {
+            writer.WriteString(data.mField);
+            writer.Write<AmReal64>(data.mWindowSeconds);
+            writer.Write<AmUInt64>(data.mCount);
+            writer.Write<AmReal64>(data.mMin);
+            writer.Write<AmReal64>(data.mMax);
+            writer.Write<AmReal64>(data.mMean);
+            writer.Write<AmReal64>(data.mP50);
+            writer.Write<AmReal64>(data.mP95);
+            writer.Write<AmReal64>(data.mP99);
+        }
+
+        void ReadData(BinaryReader& reader, ProfilerAggregateData& data)
+        {
+            data.mField = reader.ReadString();
+            data.mWindowSeconds = reader.Read<AmReal64>();
+            data.mCount = reader.Read<AmUInt64>();
+            data.mMin = reader.Read<AmReal64>();
+            data.mMax = reader.Read<AmReal64>();
+            data.mMean = reader.Read<AmReal64>();
+            data.mP50 = reader.Read<AmReal64>();
+            data.mP95 = reader.Read<AmReal64>();
+            data.mP99 = reader.Read<AmReal64>();
+        }
+
+        template<AmSize Index>
+        bool DecodeAlternative(AmUInt8 type, BinaryReader& reader, ProfilerDataVariant& message)
+        {
+            if constexpr (Index < std::variant_size_v<ProfilerDataVariant>)
+            {
+                if (type != Index)
+                    return DecodeAlternative<Index + 1>(type, reader, message);
+
+                auto& data = message.emplace<Index>();
+                ReadSnapshot(reader, data);
+                ReadData(reader, data);
+                return reader.IsValid();
+            }
+            else
+            {
+                return false;
+            }
+        }
+    } // namespace
+
+    void ProfilerBinarySerializer::Encode(const ProfilerDataVariant& data, std::vector<AmUInt8>& buffer)
+    {
+        BinaryWriter writer(buffer);
+        writer.Write<AmUInt8>(static_cast<AmUInt8>(data.index()));
+
+        std::visit(
+            [&writer](const auto& arg)
+            {
+                WriteSnapshot(writer, arg);
+                WriteData(writer, arg);
+            },
+            data);
+    }
+
+    bool ProfilerBinarySerializer::Decode(const AmUInt8* data, AmSize size, ProfilerDataVariant& message)
+    {
+        if (data == nullptr || size == 0)
+            return false;
+
+        BinaryReader reader(data, size);
+        return DecodeAlternative<0>(reader.Read<AmUInt8>(), reader, message);
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -14,12 +14,15 @@
 
 #include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
 #include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/LogSink.h>
 #include <SparkyStudios/Audio/Amplitude/Profiler/Server.h>
 
 #include <json/reader.h>
 #include <json/writer.h>
 #include <uwebsockets/App.h>
 
+#include <algorithm>
+
 namespace SparkyStudios::Audio::Amplitude
 {
     struct WebSocketUserData
@@ -30,6 +33,43 @@ namespace SparkyStudios::Audio::Amplitude
     static AmUniquePtr<uWS::App, eMemoryPoolKind_IO> gSocket = nullptr;
     static uWS::Loop* gLoop = nullptr;
 
+    namespace
+    {
+        eProfilerPriority GetMessagePriority(const ProfilerDataVariant& data)
+        {
+            return std::visit(
+                [](const auto& arg)
+                {
+                    return arg.mPriority;
+                },
+                data);
+        }
+
+        eProfilerCategory GetMessageCategory(const ProfilerDataVariant& data)
+        {
+            return std::visit(
+                [](const auto& arg)
+                {
+                    return arg.mCategory;
+                },
+                data);
+        }
+
+        bool StringToQoSClass(const AmString& str, eProfilerQoSClass& qosClass)
+        {
+            if (str == "realtime")
+                qosClass = eProfilerQoSClass_Realtime;
+            else if (str == "interactive")
+                qosClass = eProfilerQoSClass_Interactive;
+            else if (str == "bulk")
+                qosClass = eProfilerQoSClass_Bulk;
+            else
+                return false;
+
+            return true;
+        }
+    } // namespace
+
     ProfilerServer::ProfilerServer()
         : _running(false)
         , _initialized(false)
@@ -38,17 +78,21 @@ namespace SparkyStudios::Audio::Amplitude
         , _bindAddress("127.0.0.1")
         , _maxClients(8)
         , _acceptThread(nullptr)
+        , _clientsMutex("ProfilerServer::Clients")
+        , _statisticsMutex("ProfilerServer::Statistics")
+        , _callbacksMutex("ProfilerServer::Callbacks")
         , _nextClientId(1)
+        , _pendingSends(0)
+        , _busyThreshold(0)
+        , _maxBackpressure(kProfilerMessageBufferSize)
+        , _defaultMessagesPerSecond(0.0)
+        , _defaultBytesPerSecond(0.0)
     {
-        _clientsMutex = Thread::CreateMutex();
-        _statisticsMutex = Thread::CreateMutex();
-        _callbacksMutex = Thread::CreateMutex();
-
         // Initialize statistics
-        Thread::LockMutex(_statisticsMutex);
+        _statisticsMutex.Lock();
         _statistics = {};
         _statistics.mServerStartTime = std::chrono::high_resolution_clock::now();
-        Thread::UnlockMutex(_statisticsMutex);
+        _statisticsMutex.Unlock();
 
         amLogInfo("[ProfilerServer] Created profiler server");
     }
@@ -57,13 +101,6 @@ namespace SparkyStudios::Audio::Amplitude
     {
         Stop();
 
-        if (_clientsMutex)
-            Thread::DestroyMutex(_clientsMutex);
-        if (_statisticsMutex)
-            Thread::DestroyMutex(_statisticsMutex);
-        if (_callbacksMutex)
-            Thread::DestroyMutex(_callbacksMutex);
-
         amLogInfo("[ProfilerServer] Destroyed profiler server");
     }
 
@@ -133,6 +170,9 @@ namespace SparkyStudios::Audio::Amplitude
 
     void ProfilerServer::Stop()
     {
+        StopSharedMemoryTransport();
+        StopMulticastTransport();
+
         if (!_running.load())
             return;
 
@@ -178,9 +218,9 @@ namespace SparkyStudios::Audio::Amplitude
 
     AmUInt32 ProfilerServer::GetClientCount() const
     {
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
         AmUInt32 count = static_cast<AmUInt32>(_clients.size());
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
         return count;
     }
 
@@ -192,8 +232,9 @@ namespace SparkyStudios::Audio::Amplitude
     AmUInt32 ProfilerServer::BroadcastMessage(const AmString& jsonMessage)
     {
         AmUInt32 sentCount = 0;
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
 
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
 
         for (auto& pair : _clients)
         {
@@ -203,26 +244,26 @@ namespace SparkyStudios::Audio::Amplitude
                 sentCount++;
                 client.mMessagesSent++;
                 client.mBytesTransmitted += jsonMessage.length();
-                _updateStatistics(client.mClientId, jsonMessage.length());
+                _updateStatistics(client, jsonMessage.length(), eProfilerCategory_None, now);
             }
         }
 
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
 
         if (sentCount > 0)
-            amLogInfo("[ProfilerServer] Broadcast message to %d clients (%zu bytes)", sentCount, jsonMessage.length());
+            amProfilerLogInfo("[ProfilerServer] Broadcast message to %d clients (%zu bytes)", sentCount, jsonMessage.length());
 
         return sentCount;
     }
 
     bool ProfilerServer::SendMessageToClient(ProfilerClientID clientId, const AmString& jsonMessage)
     {
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
 
         auto it = _clients.find(clientId);
         if (it == _clients.end() || !it->second.mIsConnected)
         {
-            Thread::UnlockMutex(_clientsMutex);
+            _clientsMutex.Unlock();
             return false;
         }
 
@@ -233,30 +274,323 @@ namespace SparkyStudios::Audio::Amplitude
         {
             client.mMessagesSent++;
             client.mBytesTransmitted += jsonMessage.length();
-            _updateStatistics(clientId, jsonMessage.length());
+            _updateStatistics(client, jsonMessage.length(), eProfilerCategory_None, std::chrono::high_resolution_clock::now());
         }
 
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
 
         return success;
     }
 
     AmUInt32 ProfilerServer::BroadcastProfilerData(const ProfilerDataVariant& data)
     {
-        AmString jsonMessage = _serializeProfilerData(data);
-        return BroadcastMessage(jsonMessage);
+        AmUInt32 sentCount = 0;
+        AmString jsonMessage;
+
+        const eProfilerPriority priority = GetMessagePriority(data);
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
+
+        if (_sharedMemoryWriter)
+            _sharedMemoryWriter->Publish(data);
+
+        if (_multicastSender)
+        {
+            _multicastSender->Enqueue(data);
+            _multicastSender->Flush();
+        }
+
+        _clientsMutex.Lock();
+
+        for (ProfilerClientInfo* client : _clientsByQoSClass)
+        {
+            auto filterIt = _clientFilters.find(client->mClientId);
+            if (filterIt != _clientFilters.end() && !filterIt->second->Evaluate(data))
+            {
+                client->mMessagesFiltered++;
+                continue;
+            }
+
+            if (_shouldShed(*client, priority, _pendingSends.load(std::memory_order_relaxed)))
+                continue;
+
+            // Only encode messages at least one client is interested in
+            if (jsonMessage.empty())
+                jsonMessage = _serializeProfilerData(data);
+
+            if (!_consumeTokens(*client, priority, jsonMessage.length(), now))
+                continue;
+
+            if (_sendToSocket(client->mSocket, jsonMessage))
+            {
+                sentCount++;
+                client->mMessagesSent++;
+                client->mBytesTransmitted += jsonMessage.length();
+                _updateStatistics(*client, jsonMessage.length(), GetMessageCategory(data), now);
+            }
+        }
+
+        _clientsMutex.Unlock();
+
+        return sentCount;
+    }
+
+    AmUInt32 ProfilerServer::BroadcastProfilerData(const std::vector<ProfilerDataVariant>& messages)
+    {
+        if (messages.empty())
+            return 0;
+
+        AmUInt32 sentCount = 0;
+        std::vector<AmString> jsonMessages(messages.size());
+        std::vector<AmUInt8> matches;
+
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
+
+        if (_sharedMemoryWriter)
+        {
+            for (const auto& message : messages)
+                _sharedMemoryWriter->Publish(message);
+        }
+
+        // The whole batch goes out at once, split in as few datagrams as possible
+        if (_multicastSender)
+        {
+            for (const auto& message : messages)
+                _multicastSender->Enqueue(message);
+
+            _multicastSender->Flush();
+        }
+
+        _clientsMutex.Lock();
+
+        // Higher classes are queued on the event loop first, so they are also served first
+        for (ProfilerClientInfo* client : _clientsByQoSClass)
+        {
+            auto filterIt = _clientFilters.find(client->mClientId);
+            if (filterIt != _clientFilters.end())
+                filterIt->second->EvaluateBatch(messages, matches);
+            else
+                matches.assign(messages.size(), 1);
+
+            for (AmSize i = 0, l = messages.size(); i < l; ++i)
+            {
+                if (!matches[i])
+                {
+                    client->mMessagesFiltered++;
+                    continue;
+                }
+
+                const eProfilerPriority priority = GetMessagePriority(messages[i]);
+                if (_shouldShed(*client, priority, _pendingSends.load(std::memory_order_relaxed)))
+                    continue;
+
+                if (jsonMessages[i].empty())
+                    jsonMessages[i] = _serializeProfilerData(messages[i]);
+
+                if (!_consumeTokens(*client, priority, jsonMessages[i].length(), now))
+                    continue;
+
+                if (_sendToSocket(client->mSocket, jsonMessages[i]))
+                {
+                    sentCount++;
+                    client->mMessagesSent++;
+                    client->mBytesTransmitted += jsonMessages[i].length();
+                    _updateStatistics(*client, jsonMessages[i].length(), GetMessageCategory(messages[i]), now);
+                }
+            }
+        }
+
+        _clientsMutex.Unlock();
+
+        return sentCount;
+    }
+
+    bool ProfilerServer::StartSharedMemoryTransport(const AmString& name, AmSize capacity)
+    {
+        if (_sharedMemoryWriter)
+        {
+            amLogWarning("[ProfilerServer] Shared memory transport is already running");
+            return true;
+        }
+
+        auto writer = AmUniquePtr<ProfilerSharedMemoryWriter, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerSharedMemoryWriter));
+        if (!writer->Open(name, capacity))
+        {
+            amLogError("[ProfilerServer] Failed to start shared memory transport '%s'", name.c_str());
+            return false;
+        }
+
+        _sharedMemoryWriter = std::move(writer);
+        amLogInfo("[ProfilerServer] Shared memory transport started on '%s'", name.c_str());
+
+        return true;
+    }
+
+    void ProfilerServer::StopSharedMemoryTransport()
+    {
+        if (!_sharedMemoryWriter)
+            return;
+
+        _sharedMemoryWriter->Close();
+        _sharedMemoryWriter.reset();
+
+        amLogInfo("[ProfilerServer] Shared memory transport stopped");
+    }
+
+    bool ProfilerServer::IsSharedMemoryTransportRunning() const
+    {
+        return _sharedMemoryWriter != nullptr;
+    }
+
+    bool ProfilerServer::StartMulticastTransport(
+        const AmString& group, AmUInt16 port, AmUInt8 ttl, AmUInt32 mtu, AmReal32 keyframeIntervalSeconds)
+    {
+        if (_multicastSender)
+        {
+            amLogWarning("[ProfilerServer] Multicast transport is already running");
+            return true;
+        }
+
+        auto sender = AmUniquePtr<ProfilerMulticastSender, eMemoryPoolKind_IO>(ampoolnew(eMemoryPoolKind_IO, ProfilerMulticastSender));
+        if (!sender->Open(group, port, ttl, mtu, keyframeIntervalSeconds))
+        {
+            amLogError("[ProfilerServer] Failed to start multicast transport on %s:%d", group.c_str(), port);
+            return false;
+        }
+
+        _multicastSender = std::move(sender);
+        amLogInfo("[ProfilerServer] Multicast transport started on %s:%d", group.c_str(), port);
+
+        return true;
+    }
+
+    void ProfilerServer::StopMulticastTransport()
+    {
+        if (!_multicastSender)
+            return;
+
+        _multicastSender->Close();
+        _multicastSender.reset();
+
+        amLogInfo("[ProfilerServer] Multicast transport stopped");
+    }
+
+    bool ProfilerServer::IsMulticastTransportRunning() const
+    {
+        return _multicastSender != nullptr;
+    }
+
+    bool ProfilerServer::SetClientFilter(ProfilerClientID clientId, const AmString& expression, AmString* error)
+    {
+        if (expression.empty())
+        {
+            ClearClientFilter(clientId);
+            return true;
+        }
+
+        // Compile outside the lock, broadcasting only ever sees fully compiled programs
+        AmUniquePtr<ProfilerFilter, eMemoryPoolKind_IO> filter(ampoolnew(eMemoryPoolKind_IO, ProfilerFilter));
+        if (!filter->Compile(expression, error))
+            return false;
+
+        _clientsMutex.Lock();
+
+        auto it = _clients.find(clientId);
+        if (it == _clients.end())
+        {
+            _clientsMutex.Unlock();
+
+            if (error)
+                *error = "Unknown client";
+
+            return false;
+        }
+
+        it->second.mFilterExpression = expression;
+        _clientFilters[clientId] = std::move(filter);
+
+        _clientsMutex.Unlock();
+
+        amLogInfo("[ProfilerServer] Client %d filter set to: %s", clientId, expression.c_str());
+        return true;
+    }
+
+    void ProfilerServer::ClearClientFilter(ProfilerClientID clientId)
+    {
+        _clientsMutex.Lock();
+
+        auto it = _clients.find(clientId);
+        if (it != _clients.end())
+            it->second.mFilterExpression.clear();
+
+        _clientFilters.erase(clientId);
+
+        _clientsMutex.Unlock();
+    }
+
+    bool ProfilerServer::SetClientQoSClass(ProfilerClientID clientId, eProfilerQoSClass qosClass)
+    {
+        _clientsMutex.Lock();
+
+        auto it = _clients.find(clientId);
+        const bool found = it != _clients.end();
+        if (found && it->second.mQoSClass != qosClass)
+        {
+            _eraseClientByQoSClass(&it->second);
+            it->second.mQoSClass = qosClass;
+            _insertClientByQoSClass(&it->second);
+        }
+
+        _clientsMutex.Unlock();
+        return found;
+    }
+
+    bool ProfilerServer::SetClientRateLimits(ProfilerClientID clientId, AmReal64 maxMessagesPerSecond, AmReal64 maxBytesPerSecond)
+    {
+        _clientsMutex.Lock();
+
+        auto it = _clients.find(clientId);
+        const bool found = it != _clients.end();
+        if (found)
+        {
+            // Buckets hold one second worth of tokens, which allows short bursts
+            it->second.mMessageBucket.Configure(maxMessagesPerSecond, maxMessagesPerSecond);
+            it->second.mByteBucket.Configure(maxBytesPerSecond, maxBytesPerSecond);
+        }
+
+        _clientsMutex.Unlock();
+        return found;
+    }
+
+    void ProfilerServer::SetDefaultRateLimits(AmReal64 maxMessagesPerSecond, AmReal64 maxBytesPerSecond)
+    {
+        _clientsMutex.Lock();
+        _defaultMessagesPerSecond = maxMessagesPerSecond;
+        _defaultBytesPerSecond = maxBytesPerSecond;
+        _clientsMutex.Unlock();
+    }
+
+    void ProfilerServer::SetBusyThreshold(AmUInt32 pendingSends)
+    {
+        _clientsMutex.Lock();
+        _busyThreshold = pendingSends;
+        _clientsMutex.Unlock();
+    }
+
+    void ProfilerServer::SetMaxBackpressure(AmUInt32 bytes)
+    {
+        _maxBackpressure = bytes;
     }
 
     bool ProfilerServer::DisconnectClient(ProfilerClientID clientId)
     {
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
 
         auto clientIt = _clients.find(clientId);
         auto threadIt = _clientThreads.find(clientId);
 
         if (clientIt == _clients.end())
         {
-            Thread::UnlockMutex(_clientsMutex);
+            _clientsMutex.Unlock();
             return false;
         }
 
@@ -276,26 +610,28 @@ namespace SparkyStudios::Audio::Amplitude
         }
 
         // Remove from client list
+        _eraseClientByQoSClass(&clientIt->second);
         _clients.erase(clientIt);
+        _clientFilters.erase(clientId);
 
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
 
         // Update statistics
-        Thread::LockMutex(_statisticsMutex);
+        _statisticsMutex.Lock();
         _statistics.mTotalDisconnections++;
         _statistics.mActiveConnections = static_cast<AmUInt32>(_clients.size());
-        Thread::UnlockMutex(_statisticsMutex);
+        _statisticsMutex.Unlock();
 
         // Trigger disconnection callback
         _triggerEvent(
             [this, clientId, clientInfo]()
             {
-                Thread::LockMutex(_callbacksMutex);
+                _callbacksMutex.Lock();
                 if (_onClientDisconnected)
                 {
                     _onClientDisconnected(clientId, clientInfo);
                 }
-                Thread::UnlockMutex(_callbacksMutex);
+                _callbacksMutex.Unlock();
             });
 
         amLogInfo("[ProfilerServer] Client %d removed", clientId);
@@ -305,12 +641,12 @@ namespace SparkyStudios::Audio::Amplitude
 
     const ProfilerClientInfo* ProfilerServer::GetClientInfo(ProfilerClientID clientId) const
     {
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
 
         auto it = _clients.find(clientId);
         const ProfilerClientInfo* info = (it != _clients.end()) ? &it->second : nullptr;
 
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
         return info;
     }
 
@@ -318,7 +654,7 @@ namespace SparkyStudios::Audio::Amplitude
     {
         std::vector<ProfilerClientInfo> clients;
 
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
         clients.reserve(_clients.size());
 
         for (const auto& pair : _clients)
@@ -326,54 +662,74 @@ namespace SparkyStudios::Audio::Amplitude
             clients.push_back(pair.second);
         }
 
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
         return clients;
     }
 
     ProfilerServer::Statistics ProfilerServer::GetStatistics() const
     {
-        Thread::LockMutex(_statisticsMutex);
+        _statisticsMutex.Lock();
         Statistics stats = _statistics;
-        Thread::UnlockMutex(_statisticsMutex);
+        _statisticsMutex.Unlock();
+
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
+        stats.mMessagesPerSecond = static_cast<AmReal32>(_messageRate.GetRate(now));
+        stats.mBytesPerSecond = static_cast<AmReal32>(_byteRate.GetRate(now));
+
+        for (AmUInt32 i = 0; i < kProfilerCategoryCount; ++i)
+        {
+            stats.mCategoryMessagesPerSecond[i] = static_cast<AmReal32>(_categoryMessageRates[i].GetRate(now));
+            stats.mCategoryBytesPerSecond[i] = static_cast<AmReal32>(_categoryByteRates[i].GetRate(now));
+        }
+
         return stats;
     }
 
     void ProfilerServer::ResetStatistics()
     {
-        Thread::LockMutex(_statisticsMutex);
+        _statisticsMutex.Lock();
         _statistics = {};
         _statistics.mServerStartTime = std::chrono::high_resolution_clock::now();
-        Thread::UnlockMutex(_statisticsMutex);
+        _statisticsMutex.Unlock();
+
+        _messageRate.Reset();
+        _byteRate.Reset();
+
+        for (AmUInt32 i = 0; i < kProfilerCategoryCount; ++i)
+        {
+            _categoryMessageRates[i].Reset();
+            _categoryByteRates[i].Reset();
+        }
 
         amLogInfo("[ProfilerServer] Statistics reset");
     }
 
     void ProfilerServer::SetOnClientConnected(const ClientEventCallback& callback)
     {
-        Thread::LockMutex(_callbacksMutex);
+        _callbacksMutex.Lock();
         _onClientConnected = callback;
-        Thread::UnlockMutex(_callbacksMutex);
+        _callbacksMutex.Unlock();
     }
 
     void ProfilerServer::SetOnClientDisconnected(const ClientEventCallback& callback)
     {
-        Thread::LockMutex(_callbacksMutex);
+        _callbacksMutex.Lock();
         _onClientDisconnected = callback;
-        Thread::UnlockMutex(_callbacksMutex);
+        _callbacksMutex.Unlock();
     }
 
     void ProfilerServer::SetOnMessageReceived(const MessageEventCallback& callback)
     {
-        Thread::LockMutex(_callbacksMutex);
+        _callbacksMutex.Lock();
         _onMessageReceived = callback;
-        Thread::UnlockMutex(_callbacksMutex);
+        _callbacksMutex.Unlock();
     }
 
     void ProfilerServer::SetOnError(const ErrorEventCallback& callback)
     {
-        Thread::LockMutex(_callbacksMutex);
+        _callbacksMutex.Lock();
         _onError = callback;
-        Thread::UnlockMutex(_callbacksMutex);
+        _callbacksMutex.Unlock();
     }
 
     bool ProfilerServer::_initializeNetworking()
@@ -397,7 +753,7 @@ namespace SparkyStudios::Audio::Amplitude
             { .compression = uWS::SHARED_COMPRESSOR,
               .maxPayloadLength = static_cast<unsigned int>(kMaxMessageSize),
               .idleTimeout = 120,
-              .maxBackpressure = 1 * 1024 * 1024,
+              .maxBackpressure = _maxBackpressure,
 
               .open =
                   [self](auto* ws)
@@ -430,19 +786,22 @@ namespace SparkyStudios::Audio::Amplitude
 
                   AmString messageStr(message.data(), message.length());
 
+                  // Handle server-side commands such as filters
+                  self->_handleClientCommand(clientId, messageStr);
+
                   // Trigger message received callback
                   self->_triggerEvent(
                       [self, clientId, messageStr]()
                       {
-                          Thread::LockMutex(self->_callbacksMutex);
+                          self->_callbacksMutex.Lock();
                           if (self->_onMessageReceived)
                           {
                               self->_onMessageReceived(clientId, messageStr);
                           }
-                          Thread::UnlockMutex(self->_callbacksMutex);
+                          self->_callbacksMutex.Unlock();
                       });
 
-                  amLogInfo("[ProfilerServer] Received message from client %d (%zu bytes)", clientId, message.length());
+                  amProfilerLogDebug("[ProfilerServer] Received message from client %d (%zu bytes)", clientId, message.length());
               },
 
               .drain =
@@ -457,7 +816,7 @@ namespace SparkyStudios::Audio::Amplitude
                   WebSocketUserData* userData = ws->getUserData();
                   ProfilerClientID clientId = userData->clientId;
 
-                  Thread::LockMutex(self->_clientsMutex);
+                  self->_clientsMutex.Lock();
 
                   auto it = self->_clients.find(clientId);
                   if (it != self->_clients.end())
@@ -465,33 +824,35 @@ namespace SparkyStudios::Audio::Amplitude
                       ProfilerClientInfo clientInfo = it->second;
                       clientInfo.mIsConnected = false;
 
+                      self->_eraseClientByQoSClass(&it->second);
                       self->_clients.erase(it);
+                      self->_clientFilters.erase(clientId);
 
-                      Thread::UnlockMutex(self->_clientsMutex);
+                      self->_clientsMutex.Unlock();
 
                       // Update statistics
-                      Thread::LockMutex(self->_statisticsMutex);
+                      self->_statisticsMutex.Lock();
                       self->_statistics.mTotalDisconnections++;
                       self->_statistics.mActiveConnections = static_cast<AmUInt32>(self->_clients.size());
-                      Thread::UnlockMutex(self->_statisticsMutex);
+                      self->_statisticsMutex.Unlock();
 
                       // Trigger disconnection callback
                       self->_triggerEvent(
                           [self, clientId, clientInfo]()
                           {
-                              Thread::LockMutex(self->_callbacksMutex);
+                              self->_callbacksMutex.Lock();
                               if (self->_onClientDisconnected)
                               {
                                   self->_onClientDisconnected(clientId, clientInfo);
                               }
-                              Thread::UnlockMutex(self->_callbacksMutex);
+                              self->_callbacksMutex.Unlock();
                           });
 
                       amLogInfo("[ProfilerServer] Client %d disconnected (code: %d)", clientId, code);
                   }
                   else
                   {
-                      Thread::UnlockMutex(self->_clientsMutex);
+                      self->_clientsMutex.Unlock();
                   }
               } });
 
@@ -534,12 +895,12 @@ namespace SparkyStudios::Audio::Amplitude
                         self->_triggerEvent(
                             [self]()
                             {
-                                Thread::LockMutex(self->_callbacksMutex);
+                                self->_callbacksMutex.Lock();
                                 if (self->_onError)
                                 {
                                     self->_onError("Failed to bind to port");
                                 }
-                                Thread::UnlockMutex(self->_callbacksMutex);
+                                self->_callbacksMutex.Unlock();
                             });
                     }
                 });
@@ -590,12 +951,12 @@ namespace SparkyStudios::Audio::Amplitude
             clientId = userData->clientId;
         }
 
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
 
         // Check if max clients reached
         if (_clients.size() >= _maxClients)
         {
-            Thread::UnlockMutex(_clientsMutex);
+            _clientsMutex.Unlock();
             amLogWarning("[ProfilerServer] Max clients reached, rejecting connection");
 
             // Close the socket
@@ -617,27 +978,31 @@ namespace SparkyStudios::Audio::Amplitude
         info.mMessagesSent = 0;
         info.mBytesTransmitted = 0;
         info.mIsConnected = true;
+        info.mMessageBucket.Configure(_defaultMessagesPerSecond, _defaultMessagesPerSecond);
+        info.mByteBucket.Configure(_defaultBytesPerSecond, _defaultBytesPerSecond);
 
-        _clients[clientId] = info;
+        auto [it, inserted] = _clients.insert_or_assign(clientId, info);
+        if (inserted)
+            _insertClientByQoSClass(&it->second);
 
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
 
         // Update statistics
-        Thread::LockMutex(_statisticsMutex);
+        _statisticsMutex.Lock();
         _statistics.mTotalConnections++;
         _statistics.mActiveConnections = static_cast<AmUInt32>(_clients.size());
-        Thread::UnlockMutex(_statisticsMutex);
+        _statisticsMutex.Unlock();
 
         // Trigger connection callback
         _triggerEvent(
             [this, clientId, info]()
             {
-                Thread::LockMutex(_callbacksMutex);
+                _callbacksMutex.Lock();
                 if (_onClientConnected)
                 {
                     _onClientConnected(clientId, info);
                 }
-                Thread::UnlockMutex(_callbacksMutex);
+                _callbacksMutex.Unlock();
             });
     }
 
@@ -652,7 +1017,7 @@ namespace SparkyStudios::Audio::Amplitude
 
     void ProfilerServer::_disconnectAllClients()
     {
-        Thread::LockMutex(_clientsMutex);
+        _clientsMutex.Lock();
 
         std::vector<SocketHandle> socketsToClose;
         for (auto& pair : _clients)
@@ -664,8 +1029,10 @@ namespace SparkyStudios::Audio::Amplitude
         }
 
         _clients.clear();
+        _clientsByQoSClass.clear();
+        _clientFilters.clear();
 
-        Thread::UnlockMutex(_clientsMutex);
+        _clientsMutex.Unlock();
 
         // Close all sockets
         for (auto socket : socketsToClose)
@@ -689,20 +1056,29 @@ namespace SparkyStudios::Audio::Amplitude
         if (socket == AM_INVALID_SOCKET || message.empty())
             return false;
 
-        bool success = false;
+        if (!gLoop)
+            return false;
 
-        if (gLoop)
-        {
-            gLoop->defer(
-                [socket, message, &success]()
+        // The send itself happens on the event loop thread, a message is considered sent once it is queued there.
+        // The number of queued sends tells how far the event loop is lagging behind.
+        _pendingSends.fetch_add(1, std::memory_order_relaxed);
+
+        gLoop->defer(
+            [this, socket, message]()
+            {
+                auto* ws = static_cast<uWS::WebSocket<false, true, WebSocketUserData>*>(socket);
+                auto result = ws->send(message, uWS::OpCode::TEXT);
+                _pendingSends.fetch_sub(1, std::memory_order_relaxed);
+
+                if (result == uWS::WebSocket<false, true, WebSocketUserData>::DROPPED)
                 {
-                    auto* ws = static_cast<uWS::WebSocket<false, true, WebSocketUserData>*>(socket);
-                    auto result = ws->send(message, uWS::OpCode::TEXT);
-                    success = (result != uWS::WebSocket<false, true, WebSocketUserData>::DROPPED);
-                });
-        }
+                    _statisticsMutex.Lock();
+                    _statistics.mFailedSends++;
+                    _statisticsMutex.Unlock();
+                }
+            });
 
-        return success;
+        return true;
     }
 
     AmString ProfilerServer::_receiveFromSocket(SocketHandle socket)
@@ -711,6 +1087,67 @@ namespace SparkyStudios::Audio::Amplitude
         return "";
     }
 
+    void ProfilerServer::_handleClientCommand(ProfilerClientID clientId, const AmString& message)
+    {
+        Json::Value json;
+        Json::CharReaderBuilder builder;
+        builder["collectComments"] = false;
+
+        std::string errors;
+        const std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        if (!reader->parse(message.data(), message.data() + message.size(), &json, &errors) || !json.isObject() ||
+            !json.isMember("command"))
+            return;
+
+        const AmString command = json["command"].asString();
+
+        Json::Value response;
+        response["type"] = "command_result";
+        response["command"] = command;
+
+        if (command == "set_filter")
+        {
+            AmString error = "Filter expression is too long";
+            const AmString expression = json.get("expression", "").asString();
+            const bool success = expression.size() <= kMaxFilterLength && SetClientFilter(clientId, expression, &error);
+
+            response["success"] = success;
+            if (!success)
+                response["error"] = error;
+        }
+        else if (command == "clear_filter")
+        {
+            ClearClientFilter(clientId);
+            response["success"] = true;
+        }
+        else if (command == "set_qos")
+        {
+            // Missing settings are left unchanged
+            eProfilerQoSClass qosClass = eProfilerQoSClass_Bulk;
+            const bool hasClass = json.isMember("class");
+
+            const AmReal64 maxMessagesPerSecond = json.get("max_messages_per_second", -1.0).asDouble();
+            const AmReal64 maxBytesPerSecond = json.get("max_bytes_per_second", -1.0).asDouble();
+
+            const bool success = (!hasClass || StringToQoSClass(json["class"].asString(), qosClass)) &&
+                _restrictClientQoS(clientId, hasClass ? &qosClass : nullptr, maxMessagesPerSecond, maxBytesPerSecond);
+
+            response["success"] = success;
+            if (!success)
+                response["error"] = "Invalid QoS settings, clients can only lower their class and rates";
+        }
+        else
+        {
+            // Other commands are left to the message received callback
+            return;
+        }
+
+        Json::StreamWriterBuilder writer;
+        writer["indentation"] = "";
+
+        SendMessageToClient(clientId, Json::writeString(writer, response));
+    }
+
     AmString ProfilerServer::_serializeProfilerData(const ProfilerDataVariant& data)
     {
         Json::Value root;
@@ -727,6 +1164,7 @@ namespace SparkyStudios::Audio::Amplitude
                 root["messageId"] = static_cast<Json::UInt64>(arg.mMessageId);
                 root["category"] = static_cast<int>(arg.mCategory);
                 root["priority"] = static_cast<int>(arg.mPriority);
+                root["sourceId"] = arg.mSourceId;
 
                 if constexpr (std::is_same_v<T, ProfilerEngineData>)
                 {
@@ -795,6 +1233,25 @@ namespace SparkyStudios::Audio::Amplitude
                     root["engineMemory"] = static_cast<Json::UInt64>(arg.mEngineMemory);
                     root["processedSamples"] = arg.mProcessedSamples;
                     root["latencyMs"] = arg.mLatencyMs;
+
+                    Json::Value scheduling(Json::objectValue);
+                    for (const auto& [thread, stats] : arg.mThreadScheduling)
+                    {
+                        Json::Value& entry = scheduling[thread];
+                        entry["wakeups"] = stats.mWakeups;
+                        entry["wakeupLatencyP50Ms"] = stats.mLatencyP50Ms;
+                        entry["wakeupLatencyP99Ms"] = stats.mLatencyP99Ms;
+                        entry["wakeupLatencyMaxMs"] = stats.mLatencyMaxMs;
+                        entry["voluntarySwitches"] = stats.mVoluntarySwitches;
+                        entry["involuntarySwitches"] = stats.mInvoluntarySwitches;
+
+                        // Counts per bucket, bucket i holding latencies below 2^i microseconds
+                        Json::Value& histogram = entry["wakeupLatencyHistogram"];
+                        histogram = Json::Value(Json::arrayValue);
+                        for (const AmUInt32 count : stats.mLatencyBuckets)
+                            histogram.append(count);
+                    }
+                    root["threadScheduling"] = scheduling;
                 }
                 else if constexpr (std::is_same_v<T, ProfilerEvent>)
                 {
@@ -809,6 +1266,19 @@ namespace SparkyStudios::Audio::Amplitude
                     }
                     root["parameters"] = params;
                 }
+                else if constexpr (std::is_same_v<T, ProfilerAggregateData>)
+                {
+                    root["type"] = "aggregate";
+                    root["field"] = arg.mField;
+                    root["windowSeconds"] = arg.mWindowSeconds;
+                    root["count"] = static_cast<Json::UInt64>(arg.mCount);
+                    root["min"] = arg.mMin;
+                    root["max"] = arg.mMax;
+                    root["mean"] = arg.mMean;
+                    root["p50"] = arg.mP50;
+                    root["p95"] = arg.mP95;
+                    root["p99"] = arg.mP99;
+                }
             },
             data);
 
@@ -827,9 +1297,121 @@ namespace SparkyStudios::Audio::Amplitude
         return AmString(remoteAddr.data(), remoteAddr.length());
     }
 
-    void ProfilerServer::_updateStatistics(ProfilerClientID clientId, AmSize messageSize)
+    bool ProfilerServer::_restrictClientQoS(
+        ProfilerClientID clientId, const eProfilerQoSClass* qosClass, AmReal64 maxMessagesPerSecond, AmReal64 maxBytesPerSecond)
+    {
+        // A negative rate keeps the current one, 0 would remove the limit
+        const auto lowers = [](const ProfilerTokenBucket& bucket, AmReal64 rate)
+        {
+            return rate < 0.0 || (rate > 0.0 && (bucket.IsUnlimited() || rate <= bucket.GetRate()));
+        };
+
+        _clientsMutex.Lock();
+
+        auto it = _clients.find(clientId);
+        if (it == _clients.end())
+        {
+            _clientsMutex.Unlock();
+            return false;
+        }
+
+        ProfilerClientInfo& client = it->second;
+        const bool allowed = (qosClass == nullptr || *qosClass >= client.mQoSClass) &&
+            lowers(client.mMessageBucket, maxMessagesPerSecond) && lowers(client.mByteBucket, maxBytesPerSecond);
+
+        if (allowed)
+        {
+            if (qosClass != nullptr && *qosClass != client.mQoSClass)
+            {
+                _eraseClientByQoSClass(&client);
+                client.mQoSClass = *qosClass;
+                _insertClientByQoSClass(&client);
+            }
+
+            // Reconfiguring refills the bucket, so an unchanged rate is left alone
+            if (maxMessagesPerSecond >= 0.0 && maxMessagesPerSecond != client.mMessageBucket.GetRate())
+                client.mMessageBucket.Configure(maxMessagesPerSecond, maxMessagesPerSecond);
+
+            if (maxBytesPerSecond >= 0.0 && maxBytesPerSecond != client.mByteBucket.GetRate())
+                client.mByteBucket.Configure(maxBytesPerSecond, maxBytesPerSecond);
+        }
+
+        _clientsMutex.Unlock();
+        return allowed;
+    }
+
+    void ProfilerServer::_insertClientByQoSClass(ProfilerClientInfo* client)
     {
-        Thread::LockMutex(_statisticsMutex);
+        // After the clients of the same class, so they keep their connection order
+        const auto it = std::upper_bound(
+            _clientsByQoSClass.begin(), _clientsByQoSClass.end(), client,
+            [](const ProfilerClientInfo* a, const ProfilerClientInfo* b)
+            {
+                return a->mQoSClass < b->mQoSClass;
+            });
+
+        _clientsByQoSClass.insert(it, client);
+    }
+
+    void ProfilerServer::_eraseClientByQoSClass(const ProfilerClientInfo* client)
+    {
+        const auto it = std::find(_clientsByQoSClass.begin(), _clientsByQoSClass.end(), client);
+        if (it != _clientsByQoSClass.end())
+            _clientsByQoSClass.erase(it);
+    }
+
+    bool ProfilerServer::_shouldShed(ProfilerClientInfo& client, eProfilerPriority priority, AmUInt32 pendingSends)
+    {
+        if (_busyThreshold == 0 || priority == eProfilerPriority_Critical)
+            return false;
+
+        const bool busy = pendingSends >= _busyThreshold;
+        const bool overloaded = pendingSends >= _busyThreshold * 2;
+
+        if ((client.mQoSClass == eProfilerQoSClass_Bulk && busy) || (client.mQoSClass == eProfilerQoSClass_Interactive && overloaded))
+        {
+            client.mMessagesShed++;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ProfilerServer::_consumeTokens(ProfilerClientInfo& client, eProfilerPriority priority, AmSize messageSize, ProfilerTime now)
+    {
+        client.mMessageBucket.Refill(now);
+        client.mByteBucket.Refill(now);
+
+        const AmReal64 bytes = static_cast<AmReal64>(messageSize);
+
+        // Critical messages always go through, they still consume tokens so the client pays them back later
+        if (priority != eProfilerPriority_Critical && (!client.mMessageBucket.CanConsume(1.0) || !client.mByteBucket.CanConsume(bytes)))
+        {
+            client.mMessagesThrottled++;
+            client.mBytesThrottled += messageSize;
+            return false;
+        }
+
+        client.mMessageBucket.Consume(1.0);
+        client.mByteBucket.Consume(bytes);
+        return true;
+    }
+
+    void ProfilerServer::_updateStatistics(ProfilerClientInfo& client, AmSize messageSize, eProfilerCategory category, ProfilerTime now)
+    {
+        client.mMessageRate.Add(1, now);
+        client.mByteRate.Add(messageSize, now);
+
+        _messageRate.Add(1, now);
+        _byteRate.Add(messageSize, now);
+
+        if (const AmUInt32 index = GetProfilerCategoryIndex(category); index < kProfilerCategoryCount)
+        {
+            _categoryMessageRates[index].Add(1, now);
+            _categoryByteRates[index].Add(messageSize, now);
+        }
+
+        _statisticsMutex.Lock();
 
         _statistics.mTotalMessagesSent++;
         _statistics.mTotalBytesTransmitted += messageSize;
@@ -840,7 +1422,7 @@ namespace SparkyStudios::Audio::Amplitude
                 static_cast<AmReal32>(_statistics.mTotalBytesTransmitted) / static_cast<AmReal32>(_statistics.mTotalMessagesSent);
         }
 
-        Thread::UnlockMutex(_statisticsMutex);
+        _statisticsMutex.Unlock();
     }
 
     void ProfilerServer::_triggerEvent(const std::function<void()>& eventFunction)
@@ -0,0 +1,461 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Serialization.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/SharedMemory.h>
+
+#include <cstring>
+
+#if AM_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        constexpr AmSize kMinCapacity = 64 * 1024;
+        constexpr AmSize kDataOffset = sizeof(ProfilerSharedMemoryHeader);
+
+        AmSize AlignRecord(AmSize size)
+        {
+            return (size + 7) & ~static_cast<AmSize>(7);
+        }
+
+        AmSize NextPowerOfTwo(AmSize value)
+        {
+            AmSize result = kMinCapacity;
+            while (result < value)
+                result <<= 1;
+
+            return result;
+        }
+
+#if !AM_PLATFORM_WINDOWS
+        AmString GetPosixName(const AmString& name)
+        {
+            return name.empty() || name[0] != '/' ? "/" + name : name;
+        }
+#endif
+
+        AmUInt8* MapRegion(const AmString& name, AmSize& size, bool create, AmVoidPtr& handle)
+        {
+            handle = nullptr;
+
+#if AM_PLATFORM_WINDOWS
+            HANDLE mapping = nullptr;
+            if (create)
+            {
+                const auto size64 = static_cast<AmUInt64>(size);
+                mapping = CreateFileMappingA(
+                    INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32),
+                    static_cast<DWORD>(size64 & 0xFFFFFFFF), name.c_str());
+            }
+            else
+            {
+                mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+            }
+
+            if (mapping == nullptr)
+                return nullptr;
+
+            void* view = MapViewOfFile(mapping, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, create ? size : 0);
+            if (view == nullptr)
+            {
+                CloseHandle(mapping);
+                return nullptr;
+            }
+
+            if (!create)
+            {
+                MEMORY_BASIC_INFORMATION info;
+                VirtualQuery(view, &info, sizeof(info));
+                size = info.RegionSize;
+            }
+
+            handle = mapping;
+            return static_cast<AmUInt8*>(view);
+#else
+            const AmString posixName = GetPosixName(name);
+            const int fd = create ? shm_open(posixName.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644) : shm_open(posixName.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                return nullptr;
+
+            if (create)
+            {
+                if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+                {
+                    close(fd);
+                    shm_unlink(posixName.c_str());
+                    return nullptr;
+                }
+            }
+            else
+            {
+                struct stat info;
+                if (fstat(fd, &info) != 0)
+                {
+                    close(fd);
+                    return nullptr;
+                }
+
+                size = static_cast<AmSize>(info.st_size);
+            }
+
+            void* view = mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+
+            if (view == MAP_FAILED)
+            {
+                if (create)
+                    shm_unlink(posixName.c_str());
+
+                return nullptr;
+            }
+
+            return static_cast<AmUInt8*>(view);
+#endif
+        }
+
+        void UnmapRegion(const void* view, AmSize size, AmVoidPtr handle)
+        {
+#if AM_PLATFORM_WINDOWS
+            AM_UNUSED(size);
+            UnmapViewOfFile(view);
+            CloseHandle(static_cast<HANDLE>(handle));
+#else
+            AM_UNUSED(handle);
+            munmap(const_cast<void*>(view), size);
+#endif
+        }
+    } // namespace
+
+    ProfilerSharedMemoryWriter::ProfilerSharedMemoryWriter()
+        : _handle(nullptr)
+        , _mappedSize(0)
+        , _header(nullptr)
+        , _data(nullptr)
+        , _sequence(0)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerSharedMemoryWriter::~ProfilerSharedMemoryWriter()
+    {
+        Close();
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerSharedMemoryWriter::Open(const AmString& name, AmSize capacity)
+    {
+        Close();
+
+        const AmSize ringCapacity = NextPowerOfTwo(capacity);
+        AmSize mappedSize = kDataOffset + ringCapacity;
+
+        AmUInt8* region = MapRegion(name, mappedSize, true, _handle);
+        if (region == nullptr)
+        {
+            amLogError("[ProfilerSharedMemoryWriter] Failed to create shared memory region '%s'", name.c_str());
+            return false;
+        }
+
+        Thread::LockMutex(_mutex);
+
+        _name = name;
+        _mappedSize = mappedSize;
+        _data = region + kDataOffset;
+        _sequence = 0;
+
+        auto* header = new (region) ProfilerSharedMemoryHeader();
+        header->mMagic = ProfilerSharedMemoryHeader::kMagic;
+        header->mVersion = ProfilerSharedMemoryHeader::kVersion;
+        header->mFormatVersion = ProfilerBinarySerializer::kFormatVersion;
+        header->mCapacity = ringCapacity;
+        header->mReserveCursor.store(0, std::memory_order_relaxed);
+        header->mMessageCount.store(0, std::memory_order_relaxed);
+        header->mWriteCursor.store(0, std::memory_order_release);
+        _header = header;
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogInfo("[ProfilerSharedMemoryWriter] Created shared memory region '%s' (%zu bytes)", name.c_str(), ringCapacity);
+        return true;
+    }
+
+    void ProfilerSharedMemoryWriter::Close()
+    {
+        Thread::LockMutex(_mutex);
+
+        if (_header != nullptr)
+        {
+            UnmapRegion(_header, _mappedSize, _handle);
+
+#if !AM_PLATFORM_WINDOWS
+            shm_unlink(GetPosixName(_name).c_str());
+#endif
+
+            _header = nullptr;
+            _data = nullptr;
+            _handle = nullptr;
+            _mappedSize = 0;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerSharedMemoryWriter::Publish(const ProfilerDataVariant& data)
+    {
+        Thread::LockMutex(_mutex);
+
+        _encodeBuffer.clear();
+        ProfilerBinarySerializer::Encode(data, _encodeBuffer);
+        const bool published = _write(_encodeBuffer.data(), _encodeBuffer.size());
+
+        Thread::UnlockMutex(_mutex);
+        return published;
+    }
+
+    bool ProfilerSharedMemoryWriter::Publish(const AmUInt8* payload, AmSize size)
+    {
+        Thread::LockMutex(_mutex);
+        const bool published = _write(payload, size);
+        Thread::UnlockMutex(_mutex);
+
+        return published;
+    }
+
+    AmUInt64 ProfilerSharedMemoryWriter::GetPublishedCount() const
+    {
+        return _header != nullptr ? _header->mMessageCount.load(std::memory_order_relaxed) : 0;
+    }
+
+    bool ProfilerSharedMemoryWriter::_write(const AmUInt8* payload, AmSize size)
+    {
+        if (_header == nullptr)
+            return false;
+
+        const AmUInt64 capacity = _header->mCapacity;
+        const AmSize recordSize = AlignRecord(ProfilerSharedMemoryHeader::kRecordHeaderSize + size);
+
+        // Keep at least two records in the ring so readers can make progress
+        if (recordSize > capacity / 2)
+            return false;
+
+        const AmUInt64 cursor = _header->mWriteCursor.load(std::memory_order_relaxed);
+        AmUInt64 position = cursor & (capacity - 1);
+
+        // Records never wrap: skip the end of the ring when the record does not fit
+        const AmUInt64 padding = capacity - position < recordSize ? capacity - position : 0;
+        const AmUInt64 end = cursor + padding + recordSize;
+
+        // Announce the region about to be overwritten before touching it, so readers
+        // copying from it can detect the overwrite once they are done
+        _header->mReserveCursor.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if (padding > 0)
+        {
+            const AmUInt32 marker = ProfilerSharedMemoryHeader::kPaddingRecord;
+            std::memcpy(_data + position, &marker, sizeof(marker));
+            position = 0;
+        }
+
+        const auto payloadSize = static_cast<AmUInt32>(size);
+        const AmUInt32 sequence = _sequence++;
+        std::memcpy(_data + position, &payloadSize, sizeof(payloadSize));
+        std::memcpy(_data + position + sizeof(payloadSize), &sequence, sizeof(sequence));
+        std::memcpy(_data + position + ProfilerSharedMemoryHeader::kRecordHeaderSize, payload, size);
+
+        _header->mMessageCount.fetch_add(1, std::memory_order_relaxed);
+        _header->mWriteCursor.store(end, std::memory_order_release);
+
+        return true;
+    }
+
+    ProfilerSharedMemoryReader::ProfilerSharedMemoryReader()
+        : _handle(nullptr)
+        , _mappedSize(0)
+        , _header(nullptr)
+        , _data(nullptr)
+        , _readCursor(0)
+        , _expectedSequence(0)
+        , _hasSequence(false)
+        , _lostMessages(0)
+        , _resyncCount(0)
+        , _producerRestarted(false)
+    {}
+
+    ProfilerSharedMemoryReader::~ProfilerSharedMemoryReader()
+    {
+        Close();
+    }
+
+    bool ProfilerSharedMemoryReader::Open(const AmString& name)
+    {
+        Close();
+
+        AmSize mappedSize = 0;
+        const AmUInt8* region = MapRegion(name, mappedSize, false, _handle);
+        if (region == nullptr)
+        {
+            amLogWarning("[ProfilerSharedMemoryReader] Shared memory region '%s' not found", name.c_str());
+            return false;
+        }
+
+        const auto* header = reinterpret_cast<const ProfilerSharedMemoryHeader*>(region);
+        const AmUInt64 capacity = mappedSize >= kDataOffset ? header->mCapacity : 0;
+
+        if (mappedSize < kDataOffset || header->mMagic != ProfilerSharedMemoryHeader::kMagic ||
+            header->mVersion != ProfilerSharedMemoryHeader::kVersion ||
+            header->mFormatVersion != ProfilerBinarySerializer::kFormatVersion || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+            mappedSize < kDataOffset + capacity)
+        {
+            amLogError("[ProfilerSharedMemoryReader] Shared memory region '%s' is not a compatible profiler ring", name.c_str());
+            UnmapRegion(region, mappedSize, _handle);
+            _handle = nullptr;
+            return false;
+        }
+
+        _header = header;
+        _data = region + kDataOffset;
+        _mappedSize = mappedSize;
+        _readCursor = header->mWriteCursor.load(std::memory_order_acquire);
+        _hasSequence = false;
+        _lostMessages = 0;
+        _resyncCount = 0;
+        _producerRestarted = false;
+
+        return true;
+    }
+
+    void ProfilerSharedMemoryReader::Close()
+    {
+        if (_header == nullptr)
+            return;
+
+        UnmapRegion(_header, _mappedSize, _handle);
+
+        _header = nullptr;
+        _data = nullptr;
+        _handle = nullptr;
+        _mappedSize = 0;
+    }
+
+    AmUInt32 ProfilerSharedMemoryReader::Poll(const MessageCallback& callback, AmUInt32 maxMessages)
+    {
+        if (_header == nullptr || _producerRestarted)
+            return 0;
+
+        const AmUInt64 capacity = _header->mCapacity;
+        AmUInt32 count = 0;
+
+        while (maxMessages == 0 || count < maxMessages)
+        {
+            const AmUInt64 writeCursor = _header->mWriteCursor.load(std::memory_order_acquire);
+            if (_readCursor == writeCursor)
+                break;
+
+            // Cursors only grow, unless the producer recreated the ring over the same mapping
+            if (writeCursor < _readCursor)
+            {
+                _producerRestarted = true;
+                break;
+            }
+
+            // The producer lapped us
+            if (writeCursor - _readCursor > capacity)
+            {
+                _resync();
+                continue;
+            }
+
+            const AmUInt64 position = _readCursor & (capacity - 1);
+
+            AmUInt32 payloadSize = 0;
+            AmUInt32 sequence = 0;
+            std::memcpy(&payloadSize, _data + position, sizeof(payloadSize));
+            std::memcpy(&sequence, _data + position + sizeof(payloadSize), sizeof(sequence));
+
+            const bool isPadding = payloadSize == ProfilerSharedMemoryHeader::kPaddingRecord;
+            const AmSize recordSize = AlignRecord(ProfilerSharedMemoryHeader::kRecordHeaderSize + payloadSize);
+
+            if (!isPadding && recordSize <= capacity - position)
+                _recordBuffer.assign(
+                    _data + position + ProfilerSharedMemoryHeader::kRecordHeaderSize,
+                    _data + position + ProfilerSharedMemoryHeader::kRecordHeaderSize + payloadSize);
+
+            // Everything copied above is only valid if the producer did not start
+            // overwriting it in the meantime
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const AmUInt64 reserveCursor = _header->mReserveCursor.load(std::memory_order_relaxed);
+            if (reserveCursor < _readCursor)
+            {
+                _producerRestarted = true;
+                break;
+            }
+
+            if (reserveCursor - _readCursor > capacity)
+            {
+                _resync();
+                continue;
+            }
+
+            if (isPadding)
+            {
+                _readCursor += capacity - position;
+                continue;
+            }
+
+            if (recordSize > capacity - position)
+            {
+                // Not torn, so the ring itself is corrupted
+                _resync();
+                continue;
+            }
+
+            _readCursor += recordSize;
+
+            if (_hasSequence && sequence != _expectedSequence)
+                _lostMessages += static_cast<AmUInt32>(sequence - _expectedSequence);
+
+            _expectedSequence = sequence + 1;
+            _hasSequence = true;
+
+            ProfilerDataVariant message;
+            if (ProfilerBinarySerializer::Decode(_recordBuffer.data(), _recordBuffer.size(), message))
+            {
+                callback(message);
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    void ProfilerSharedMemoryReader::_resync()
+    {
+        // Lost messages are accounted from the sequence gap on the next record
+        _readCursor = _header->mWriteCursor.load(std::memory_order_acquire);
+        ++_resyncCount;
+    }
+} // namespace SparkyStudios::Audio::Amplitude
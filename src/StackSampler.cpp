@@ -0,0 +1,566 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/StackSampler.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if AM_PLATFORM_LINUX
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    /**
+     * @brief Samples of a thread, written by the signal handler and read by the update thread.
+     */
+    struct ProfilerStackSampleRing
+    {
+        struct Sample
+        {
+            AmUInt64 mDepth;
+            AmUInt64 mFrames[ProfilerStackSampler::kMaxFrames]; // Interrupted instruction first, then return addresses
+        };
+
+        std::atomic<bool> mActive = false; // Cleared before the ring is released
+        std::atomic<bool> mInHandler = false; // Set while the signal handler uses the ring
+        AmUInt64 mStackLow = 0;
+        AmUInt64 mStackHigh = 0;
+
+        Sample mSamples[ProfilerStackSampler::kRingCapacity];
+
+        alignas(64) std::atomic<AmUInt64> mWrite = 0;
+        std::atomic<AmUInt64> mDropped = 0; // Written by the signal handler only
+
+        alignas(64) std::atomic<AmUInt64> mRead = 0;
+    };
+
+    namespace
+    {
+        constexpr AmSize kMaxCachedSymbols = 65536;
+
+#if AM_PLATFORM_LINUX
+        constexpr int kSampleSignal = SIGPROF;
+
+        // The signal handler state is global, as signal handlers have no user data
+        struct sigaction gPreviousAction;
+        std::atomic<bool> gSignalOwned = false;
+
+        void ForwardSignal(int signal, siginfo_t* info, void* context)
+        {
+            if ((gPreviousAction.sa_flags & SA_SIGINFO) != 0)
+            {
+                if (gPreviousAction.sa_sigaction != nullptr)
+                    gPreviousAction.sa_sigaction(signal, info, context);
+            }
+            else if (gPreviousAction.sa_handler != SIG_DFL && gPreviousAction.sa_handler != SIG_IGN)
+            {
+                gPreviousAction.sa_handler(signal);
+            }
+        }
+
+        // Async-signal-safe: only reads the interrupted registers and the stack of the thread
+        void CaptureSample(ProfilerStackSampleRing& ring, const void* context)
+        {
+            const AmUInt64 write = ring.mWrite.load(std::memory_order_relaxed);
+            if (write - ring.mRead.load(std::memory_order_acquire) >= ProfilerStackSampler::kRingCapacity)
+            {
+                ring.mDropped.store(ring.mDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+
+            const auto* state = static_cast<const ucontext_t*>(context);
+
+#if defined(__x86_64__)
+            const auto pc = static_cast<AmUInt64>(state->uc_mcontext.gregs[REG_RIP]);
+            auto fp = static_cast<AmUInt64>(state->uc_mcontext.gregs[REG_RBP]);
+#elif defined(__aarch64__)
+            const auto pc = static_cast<AmUInt64>(state->uc_mcontext.pc);
+            auto fp = static_cast<AmUInt64>(state->uc_mcontext.regs[29]);
+#else
+            const AmUInt64 pc = 0;
+            AmUInt64 fp = 0;
+            AM_UNUSED(state);
+#endif
+
+            ProfilerStackSampleRing::Sample& sample = ring.mSamples[write % ProfilerStackSampler::kRingCapacity];
+            sample.mFrames[0] = pc;
+
+            // Each frame record holds the caller's frame pointer, then the return address
+            AmUInt64 depth = 1;
+            while (depth < ProfilerStackSampler::kMaxFrames && fp % sizeof(AmUInt64) == 0 && fp >= ring.mStackLow &&
+                   fp + 2 * sizeof(AmUInt64) <= ring.mStackHigh)
+            {
+                const auto* record = reinterpret_cast<const AmUInt64*>(fp);
+                const AmUInt64 caller = record[0];
+                const AmUInt64 returnAddress = record[1];
+
+                if (returnAddress == 0)
+                    break;
+
+                sample.mFrames[depth++] = returnAddress;
+
+                // Callers live higher on the stack, anything else is not a frame record
+                if (caller <= fp)
+                    break;
+
+                fp = caller;
+            }
+
+            sample.mDepth = depth;
+            ring.mWrite.store(write + 1, std::memory_order_release);
+        }
+
+        void HandleSampleSignal(int signal, siginfo_t* info, void* context)
+        {
+            // Timers of other libraries may use the same signal
+            if (info == nullptr || info->si_code != SI_TIMER || info->si_value.sival_ptr == nullptr)
+            {
+                ForwardSignal(signal, info, context);
+                return;
+            }
+
+            auto* ring = static_cast<ProfilerStackSampleRing*>(info->si_value.sival_ptr);
+
+            // Ordered with the release of the ring, which waits until no handler uses it
+            ring->mInHandler.store(true, std::memory_order_seq_cst);
+            if (ring->mActive.load(std::memory_order_seq_cst))
+                CaptureSample(*ring, context);
+            ring->mInHandler.store(false, std::memory_order_release);
+        }
+#endif
+
+        AmString ToHex(AmUInt64 value)
+        {
+            char buffer[24];
+            std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value));
+            return buffer;
+        }
+    } // namespace
+
+    ProfilerStackSampler::ProfilerStackSampler()
+        : _rateHz(0)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerStackSampler::~ProfilerStackSampler()
+    {
+        Stop();
+
+        for (SampledThread& thread : _threads)
+        {
+            if (thread.mRing != nullptr)
+                ampooldelete(eMemoryPoolKind_IO, ProfilerStackSampleRing, thread.mRing);
+        }
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerStackSampler::Start(AmUInt32 rateHz)
+    {
+#if AM_PLATFORM_LINUX
+        Stop();
+
+        if (rateHz == 0 || rateHz > 10000)
+        {
+            amLogError("[ProfilerStackSampler] Invalid sampling rate: %u Hz", rateHz);
+            return false;
+        }
+
+        bool expected = false;
+        if (!gSignalOwned.compare_exchange_strong(expected, true))
+        {
+            amLogError("[ProfilerStackSampler] Another sampler is already running");
+            return false;
+        }
+
+        struct sigaction action = {};
+        action.sa_sigaction = HandleSampleSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(kSampleSignal, &action, &gPreviousAction) != 0)
+        {
+            amLogError("[ProfilerStackSampler] Cannot install the signal handler: %s", std::strerror(errno));
+            gSignalOwned = false;
+            return false;
+        }
+
+        Thread::LockMutex(_mutex);
+
+        _rateHz = rateHz;
+        for (SampledThread& thread : _threads)
+        {
+            if (thread.mState == eThreadState_Active)
+                _startTimer(thread);
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogInfo("[ProfilerStackSampler] Sampling at %u Hz", rateHz);
+        return true;
+#else
+        AM_UNUSED(rateHz);
+        amLogWarning("[ProfilerStackSampler] Stack sampling is only available on Linux");
+        return false;
+#endif
+    }
+
+    void ProfilerStackSampler::Stop()
+    {
+#if AM_PLATFORM_LINUX
+        Thread::LockMutex(_mutex);
+
+        const bool running = _rateHz.exchange(0) != 0;
+        for (SampledThread& thread : _threads)
+            _stopTimer(thread);
+
+        Thread::UnlockMutex(_mutex);
+
+        if (!running)
+            return;
+
+        // Deleting a timer discards its pending signal, so the previous handler can be restored safely
+        sigaction(kSampleSignal, &gPreviousAction, nullptr);
+        gSignalOwned = false;
+#endif
+    }
+
+    AmUInt32 ProfilerStackSampler::RegisterThread(const AmString& name)
+    {
+#if AM_PLATFORM_LINUX
+        Thread::LockMutex(_mutex);
+
+        for (AmUInt32 i = 0; i < kMaxThreads; ++i)
+        {
+            SampledThread& thread = _threads[i];
+            if (thread.mState != eThreadState_Free)
+                continue;
+
+            // Touched now, so the signal handler does not page-fault on the audio thread
+            auto* ring = ampoolnew(eMemoryPoolKind_IO, ProfilerStackSampleRing);
+            std::memset(static_cast<void*>(ring->mSamples), 0, sizeof(ring->mSamples));
+
+            pthread_attr_t attributes;
+            if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+            {
+                void* stack = nullptr;
+                AmSize stackSize = 0;
+                if (pthread_attr_getstack(&attributes, &stack, &stackSize) == 0)
+                {
+                    ring->mStackLow = reinterpret_cast<AmUInt64>(stack);
+                    ring->mStackHigh = ring->mStackLow + stackSize;
+                }
+
+                pthread_attr_destroy(&attributes);
+            }
+
+            clockid_t clock = CLOCK_MONOTONIC;
+            pthread_getcpuclockid(pthread_self(), &clock);
+
+            thread.mRing = ring;
+            thread.mThreadId = static_cast<AmUInt64>(syscall(SYS_gettid));
+            thread.mClockId = static_cast<AmInt32>(clock);
+            thread.mName = name;
+            thread.mStacks.clear();
+            thread.mSampleCount = 0;
+            thread.mDroppedCount = 0;
+            thread.mReportedDropped = 0;
+            thread.mState = eThreadState_Active;
+
+            ring->mActive.store(true, std::memory_order_seq_cst);
+
+            if (_rateHz.load() != 0)
+                _startTimer(thread);
+
+            Thread::UnlockMutex(_mutex);
+
+            amLogDebug("[ProfilerStackSampler] Registered thread '%s'", name.c_str());
+            return i;
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogWarning("[ProfilerStackSampler] Cannot sample thread '%s': %u threads are already sampled", name.c_str(), kMaxThreads);
+#else
+        AM_UNUSED(name);
+#endif
+
+        return kInvalidThread;
+    }
+
+    void ProfilerStackSampler::UnregisterThread(AmUInt32 thread)
+    {
+        if (thread >= kMaxThreads)
+            return;
+
+        Thread::LockMutex(_mutex);
+
+        SampledThread& sampled = _threads[thread];
+        if (sampled.mState == eThreadState_Active)
+        {
+            _stopTimer(sampled);
+
+            // The ring is released by the next collection, once its last samples are read
+            sampled.mRing->mActive.store(false, std::memory_order_seq_cst);
+            sampled.mState = eThreadState_Closing;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerStackSampler::Collect()
+    {
+        Thread::LockMutex(_mutex);
+
+        for (SampledThread& thread : _threads)
+        {
+            if (thread.mRing == nullptr)
+                continue;
+
+            _drain(thread);
+
+            if (thread.mState == eThreadState_Closing && !thread.mRing->mInHandler.load(std::memory_order_seq_cst))
+            {
+                // No handler can write anymore, read what the last one wrote during the first drain
+                _drain(thread);
+
+                ampooldelete(eMemoryPoolKind_IO, ProfilerStackSampleRing, thread.mRing);
+                thread.mRing = nullptr;
+            }
+        }
+
+        // Leaf addresses are cached by instruction, so the cache is bounded by the code which was sampled
+        if (_symbols.size() > kMaxCachedSymbols)
+            _symbols.clear();
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerStackSampler::Flush(AmUInt32 maxStacks, std::vector<ProfilerEvent>& events)
+    {
+        Thread::LockMutex(_mutex);
+
+        std::vector<std::pair<const AmString*, AmUInt64>> stacks;
+
+        for (SampledThread& thread : _threads)
+        {
+            if (thread.mState == eThreadState_Free)
+                continue;
+
+            const AmUInt64 dropped = thread.mDroppedCount;
+
+            if (thread.mSampleCount > 0 || dropped != thread.mReportedDropped)
+            {
+                stacks.clear();
+                for (const auto& [stack, count] : thread.mStacks)
+                    stacks.emplace_back(&stack, count);
+
+                // Most sampled first
+                const AmSize kept = std::min<AmSize>(maxStacks, stacks.size());
+                std::partial_sort(
+                    stacks.begin(), stacks.begin() + kept, stacks.end(),
+                    [](const auto& a, const auto& b)
+                    {
+                        return a.second > b.second;
+                    });
+
+                AmString folded;
+                for (AmSize i = 0; i < kept; ++i)
+                    folded += *stacks[i].first + ' ' + std::to_string(stacks[i].second) + '\n';
+
+                AmUInt64 others = 0;
+                for (AmSize i = kept; i < stacks.size(); ++i)
+                    others += stacks[i].second;
+
+                if (others > 0)
+                    folded += "[other] " + std::to_string(others) + '\n';
+
+                ProfilerEvent& event = events.emplace_back(kEventName);
+                event.mCategory = eProfilerCategory_Performance;
+                event.mPriority = eProfilerPriority_Low;
+                event.mParameters["thread"] = thread.mName;
+                event.mParameters["rate_hz"] = std::to_string(_rateHz.load());
+                event.mParameters["samples"] = std::to_string(thread.mSampleCount);
+                event.mParameters["stacks"] = std::to_string(stacks.size());
+                event.mParameters["dropped"] = std::to_string(dropped - thread.mReportedDropped);
+                event.mParameters["folded"] = folded;
+
+                thread.mStacks.clear();
+                thread.mSampleCount = 0;
+                thread.mReportedDropped = dropped;
+            }
+
+            if (thread.mState == eThreadState_Closing && thread.mRing == nullptr)
+            {
+                thread.mName.clear();
+                thread.mState = eThreadState_Free;
+            }
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    bool ProfilerStackSampler::_startTimer(SampledThread& thread)
+    {
+#if AM_PLATFORM_LINUX
+        const AmUInt32 rateHz = _rateHz.load();
+        if (thread.mTimer != nullptr || rateHz == 0)
+            return false;
+
+        sigevent notification = {};
+        notification.sigev_notify = SIGEV_THREAD_ID;
+        notification.sigev_signo = kSampleSignal;
+        notification.sigev_value.sival_ptr = thread.mRing;
+#ifdef sigev_notify_thread_id
+        notification.sigev_notify_thread_id = static_cast<pid_t>(thread.mThreadId);
+#else
+        notification._sigev_un._tid = static_cast<pid_t>(thread.mThreadId);
+#endif
+
+        timer_t timer = nullptr;
+        if (timer_create(static_cast<clockid_t>(thread.mClockId), &notification, &timer) != 0)
+        {
+            amLogError("[ProfilerStackSampler] Cannot create the timer of thread '%s': %s", thread.mName.c_str(), std::strerror(errno));
+            return false;
+        }
+
+        itimerspec period = {};
+        period.it_interval.tv_sec = 0;
+        period.it_interval.tv_nsec = static_cast<long>(1000000000ull / rateHz);
+        if (rateHz == 1)
+        {
+            period.it_interval.tv_sec = 1;
+            period.it_interval.tv_nsec = 0;
+        }
+        period.it_value = period.it_interval;
+
+        if (timer_settime(timer, 0, &period, nullptr) != 0)
+        {
+            amLogError("[ProfilerStackSampler] Cannot start the timer of thread '%s': %s", thread.mName.c_str(), std::strerror(errno));
+            timer_delete(timer);
+            return false;
+        }
+
+        static_assert(sizeof(timer_t) <= sizeof(AmVoidPtr), "timer_t must fit in a pointer");
+        std::memcpy(&thread.mTimer, &timer, sizeof(timer_t));
+        return true;
+#else
+        AM_UNUSED(thread);
+        return false;
+#endif
+    }
+
+    void ProfilerStackSampler::_stopTimer(SampledThread& thread)
+    {
+#if AM_PLATFORM_LINUX
+        if (thread.mTimer == nullptr)
+            return;
+
+        timer_t timer = nullptr;
+        std::memcpy(&timer, &thread.mTimer, sizeof(timer_t));
+        timer_delete(timer);
+
+        thread.mTimer = nullptr;
+#else
+        AM_UNUSED(thread);
+#endif
+    }
+
+    void ProfilerStackSampler::_drain(SampledThread& thread)
+    {
+        ProfilerStackSampleRing& ring = *thread.mRing;
+
+        const AmUInt64 read = ring.mRead.load(std::memory_order_relaxed);
+        const AmUInt64 write = ring.mWrite.load(std::memory_order_acquire);
+
+        for (AmUInt64 position = read; position != write; ++position)
+        {
+            const ProfilerStackSampleRing::Sample& sample = ring.mSamples[position % kRingCapacity];
+            const AmUInt64 depth = std::min<AmUInt64>(sample.mDepth, kMaxFrames);
+
+            // Folded stacks start at the root
+            _stack.clear();
+            for (AmUInt64 i = depth; i-- > 0;)
+            {
+                if (!_stack.empty())
+                    _stack += ';';
+
+                _stack += _symbolize(sample.mFrames[i], i > 0);
+            }
+
+            thread.mStacks[_stack]++;
+            thread.mSampleCount++;
+        }
+
+        ring.mRead.store(write, std::memory_order_release);
+        thread.mDroppedCount = ring.mDropped.load(std::memory_order_relaxed);
+    }
+
+    const AmString& ProfilerStackSampler::_symbolize(AmUInt64 address, bool returnAddress)
+    {
+        // A return address points after the call, which may already be the next function
+        const AmUInt64 lookup = returnAddress ? address - 1 : address;
+
+        auto [it, inserted] = _symbols.try_emplace(lookup);
+        if (!inserted)
+            return it->second;
+
+        AmString& symbol = it->second;
+
+#if AM_PLATFORM_LINUX
+        Dl_info info = {};
+        if (dladdr(reinterpret_cast<void*>(lookup), &info) != 0)
+        {
+            if (info.dli_sname != nullptr)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                symbol = status == 0 && demangled != nullptr ? demangled : info.dli_sname;
+                std::free(demangled);
+            }
+            else if (info.dli_fname != nullptr)
+            {
+                // Static functions are not exported, the module and offset can still be resolved offline
+                const char* module = std::strrchr(info.dli_fname, '/');
+                symbol = AmString(module != nullptr ? module + 1 : info.dli_fname) + '+' +
+                    ToHex(lookup - reinterpret_cast<AmUInt64>(info.dli_fbase));
+            }
+        }
+#endif
+
+        if (symbol.empty())
+            symbol = ToHex(lookup);
+
+        // Semicolons separate the frames of folded stacks
+        std::replace(symbol.begin(), symbol.end(), ';', ',');
+        return symbol;
+    }
+} // namespace SparkyStudios::Audio::Amplitude
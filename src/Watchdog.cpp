@@ -0,0 +1,357 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Watchdog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if AM_PLATFORM_WINDOWS
+#include <windows.h>
+#elif AM_PLATFORM_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif AM_PLATFORM_APPLE
+#include <pthread.h>
+#endif
+
+namespace SparkyStudios::Audio::Amplitude
+{
+    namespace
+    {
+        AmInt64 GetSteadyTimeNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        AmUInt64 GetKernelThreadId()
+        {
+#if AM_PLATFORM_WINDOWS
+            return GetCurrentThreadId();
+#elif AM_PLATFORM_LINUX
+            return static_cast<AmUInt64>(syscall(SYS_gettid));
+#elif AM_PLATFORM_APPLE
+            uint64_t id = 0;
+            pthread_threadid_np(nullptr, &id);
+            return id;
+#else
+            return 0;
+#endif
+        }
+
+#if AM_PLATFORM_LINUX
+        AmString ReadTaskFile(AmUInt64 threadId, const char* name)
+        {
+            std::ifstream file("/proc/self/task/" + std::to_string(threadId) + "/" + name);
+            if (!file.is_open())
+                return {};
+
+            std::stringstream content;
+            content << file.rdbuf();
+
+            AmString value = content.str();
+            while (!value.empty() && (value.back() == '\n' || value.back() == ' '))
+                value.pop_back();
+
+            return value;
+        }
+#endif
+    } // namespace
+
+    ProfilerWatchdog::ProfilerWatchdog()
+        : _stallPeriods(4.0)
+        , _thread(nullptr)
+        , _running(false)
+        , _stallCount(0)
+    {
+        _mutex = Thread::CreateMutex();
+    }
+
+    ProfilerWatchdog::~ProfilerWatchdog()
+    {
+        Stop();
+
+        if (_mutex)
+            Thread::DestroyMutex(_mutex);
+    }
+
+    bool ProfilerWatchdog::Start(AmReal64 stallPeriods, StallCallback callback)
+    {
+        Stop();
+
+        if (stallPeriods <= 0.0)
+        {
+            amLogError("[ProfilerWatchdog] Invalid stall threshold: %f buffer periods", stallPeriods);
+            return false;
+        }
+
+        _stallPeriods = stallPeriods;
+        _callback = std::move(callback);
+        _stallCount = 0;
+
+        _running = true;
+        _thread = Thread::CreateThread(&ProfilerWatchdog::_watchLoop, this);
+
+        return true;
+    }
+
+    void ProfilerWatchdog::Stop()
+    {
+        if (!_running.exchange(false))
+            return;
+
+        Thread::Wait(_thread);
+        Thread::Release(_thread);
+        _thread = nullptr;
+    }
+
+    AmUInt32 ProfilerWatchdog::RegisterThread(const AmString& name, AmReal64 bufferPeriodMs)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (AmUInt32 i = 0; i < kMaxThreads; ++i)
+        {
+            MonitoredThread& thread = _threads[i];
+            if (thread.mActive.load(std::memory_order_relaxed))
+                continue;
+
+            thread.mName = name;
+            thread.mBufferPeriodMs = bufferPeriodMs;
+            thread.mBufferPeriodNs = static_cast<AmInt64>(bufferPeriodMs * 1e6);
+            thread.mThreadId = GetKernelThreadId();
+            thread.mLastHeartbeatNs.store(0, std::memory_order_relaxed);
+            thread.mStalledHeartbeatNs = 0;
+
+            for (auto& bucket : thread.mLatencyBuckets)
+                bucket.store(0, std::memory_order_relaxed);
+
+            thread.mMaxLatencyNs.store(0, std::memory_order_relaxed);
+            thread.mCollectedBuckets.fill(0);
+
+            // Switches made before the registration are not reported
+            _readContextSwitches(thread.mThreadId, thread.mCollectedVoluntarySwitches, thread.mCollectedInvoluntarySwitches);
+
+            thread.mActive.store(true, std::memory_order_release);
+
+            Thread::UnlockMutex(_mutex);
+            return i;
+        }
+
+        Thread::UnlockMutex(_mutex);
+
+        amLogWarning("[ProfilerWatchdog] Cannot monitor thread '%s', %u threads are already monitored", name.c_str(), kMaxThreads);
+        return kInvalidThread;
+    }
+
+    void ProfilerWatchdog::UnregisterThread(AmUInt32 thread)
+    {
+        if (thread >= kMaxThreads)
+            return;
+
+        Thread::LockMutex(_mutex);
+        _threads[thread].mActive.store(false, std::memory_order_release);
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerWatchdog::Heartbeat(AmUInt32 thread)
+    {
+        if (thread >= kMaxThreads)
+            return;
+
+        MonitoredThread& monitored = _threads[thread];
+
+        const AmInt64 now = GetSteadyTimeNs();
+        const AmInt64 previous = monitored.mLastHeartbeatNs.load(std::memory_order_relaxed);
+        monitored.mLastHeartbeatNs.store(now, std::memory_order_release);
+
+        if (previous == 0)
+            return;
+
+        // Only this thread writes the histogram, so the counters need no read-modify-write
+        const auto latency = static_cast<AmUInt64>(std::max<AmInt64>(0, now - previous - monitored.mBufferPeriodNs));
+        std::atomic<AmUInt32>& bucket = monitored.mLatencyBuckets[ProfilerThreadScheduling::GetLatencyBucket(latency)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // The collecting thread resets the maximum, so it is raised with a compare-exchange
+        AmUInt64 max = monitored.mMaxLatencyNs.load(std::memory_order_relaxed);
+        while (latency > max && !monitored.mMaxLatencyNs.compare_exchange_weak(max, latency, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void ProfilerWatchdog::CollectScheduling(std::unordered_map<AmString, ProfilerThreadScheduling>& scheduling)
+    {
+        Thread::LockMutex(_mutex);
+
+        for (auto& thread : _threads)
+        {
+            if (!thread.mActive.load(std::memory_order_acquire))
+                continue;
+
+            ProfilerThreadScheduling& stats = scheduling[thread.mName];
+
+            for (AmSize i = 0; i < ProfilerThreadScheduling::kLatencyBucketCount; ++i)
+            {
+                const AmUInt32 total = thread.mLatencyBuckets[i].load(std::memory_order_relaxed);
+                stats.mLatencyBuckets[i] = total - thread.mCollectedBuckets[i];
+                stats.mWakeups += stats.mLatencyBuckets[i];
+                thread.mCollectedBuckets[i] = total;
+            }
+
+            stats.mLatencyMaxMs = static_cast<AmReal32>(thread.mMaxLatencyNs.exchange(0, std::memory_order_relaxed) / 1e6);
+            stats.mLatencyP50Ms = static_cast<AmReal32>(stats.GetLatencyPercentileMs(50.0));
+            stats.mLatencyP99Ms = static_cast<AmReal32>(stats.GetLatencyPercentileMs(99.0));
+
+            AmUInt64 voluntary = thread.mCollectedVoluntarySwitches;
+            AmUInt64 involuntary = thread.mCollectedInvoluntarySwitches;
+            _readContextSwitches(thread.mThreadId, voluntary, involuntary);
+
+            stats.mVoluntarySwitches = static_cast<AmUInt32>(voluntary - thread.mCollectedVoluntarySwitches);
+            stats.mInvoluntarySwitches = static_cast<AmUInt32>(involuntary - thread.mCollectedInvoluntarySwitches);
+            thread.mCollectedVoluntarySwitches = voluntary;
+            thread.mCollectedInvoluntarySwitches = involuntary;
+        }
+
+        Thread::UnlockMutex(_mutex);
+    }
+
+    void ProfilerWatchdog::_watchLoop(AmVoidPtr userData)
+    {
+        auto* watchdog = static_cast<ProfilerWatchdog*>(userData);
+
+        // Reports are made once the lock is released, so a slow callback never blocks registration nor collection
+        ProfilerStallReport reports[kMaxThreads];
+        bool ended[kMaxThreads];
+
+        while (watchdog->_running.load(std::memory_order_acquire))
+        {
+            AmUInt32 count = 0;
+
+            Thread::LockMutex(watchdog->_mutex);
+
+            const AmInt64 now = GetSteadyTimeNs();
+            for (auto& thread : watchdog->_threads)
+            {
+                if (thread.mActive.load(std::memory_order_acquire) && watchdog->_check(thread, now, reports[count], ended[count]))
+                    ++count;
+            }
+
+            Thread::UnlockMutex(watchdog->_mutex);
+
+            for (AmUInt32 i = 0; i < count; ++i)
+            {
+                if (!ended[i])
+                    _readThreadState(reports[i]);
+
+                if (watchdog->_callback)
+                    watchdog->_callback(reports[i], ended[i]);
+            }
+
+            Thread::Sleep(1);
+        }
+    }
+
+    bool ProfilerWatchdog::_check(MonitoredThread& thread, AmInt64 nowNs, ProfilerStallReport& report, bool& ended)
+    {
+        const AmInt64 lastHeartbeat = thread.mLastHeartbeatNs.load(std::memory_order_acquire);
+        if (lastHeartbeat == 0)
+            return false;
+
+        if (thread.mStalledHeartbeatNs != 0)
+        {
+            if (lastHeartbeat == thread.mStalledHeartbeatNs)
+                return false;
+
+            // The thread called back again, report how long it was gone
+            report = ProfilerStallReport();
+            report.mThreadName = thread.mName;
+            report.mThreadId = thread.mThreadId;
+            report.mBufferPeriodMs = thread.mBufferPeriodMs;
+            report.mLateMs = static_cast<AmReal64>(lastHeartbeat - thread.mStalledHeartbeatNs) / 1e6;
+            thread.mStalledHeartbeatNs = 0;
+
+            ended = true;
+            return true;
+        }
+
+        const AmReal64 lateMs = static_cast<AmReal64>(nowNs - lastHeartbeat) / 1e6;
+        if (lateMs <= _stallPeriods * thread.mBufferPeriodMs)
+            return false;
+
+        thread.mStalledHeartbeatNs = lastHeartbeat;
+        _stallCount++;
+
+        report = ProfilerStallReport();
+        report.mThreadName = thread.mName;
+        report.mThreadId = thread.mThreadId;
+        report.mBufferPeriodMs = thread.mBufferPeriodMs;
+        report.mLateMs = lateMs;
+
+        ended = false;
+        return true;
+    }
+
+    void ProfilerWatchdog::_readThreadState(ProfilerStallReport& report)
+    {
+#if AM_PLATFORM_LINUX
+        if (report.mThreadId == 0)
+            return;
+
+        // The state follows the command name, which is in parentheses and may itself contain spaces
+        const AmString stat = ReadTaskFile(report.mThreadId, "stat");
+        if (const AmSize end = stat.rfind(')'); end != AmString::npos && end + 2 < stat.size())
+            report.mState = stat.substr(end + 2, 1);
+
+        report.mWaitChannel = ReadTaskFile(report.mThreadId, "wchan");
+        if (report.mWaitChannel == "0")
+            report.mWaitChannel.clear();
+
+        report.mSyscall = ReadTaskFile(report.mThreadId, "syscall");
+        if (report.mSyscall == "running")
+            report.mSyscall.clear();
+
+        // Usually only readable with elevated privileges
+        report.mStack = ReadTaskFile(report.mThreadId, "stack");
+#else
+        AM_UNUSED(report);
+#endif
+    }
+
+    void ProfilerWatchdog::_readContextSwitches(AmUInt64 threadId, AmUInt64& voluntary, AmUInt64& involuntary)
+    {
+#if AM_PLATFORM_LINUX
+        if (threadId == 0)
+            return;
+
+        // Left unchanged when the thread exited, so no switches are reported for it
+        std::istringstream status(ReadTaskFile(threadId, "status"));
+        for (AmString line; std::getline(status, line);)
+        {
+            if (line.starts_with("voluntary_ctxt_switches:"))
+                voluntary = std::strtoull(line.c_str() + sizeof("voluntary_ctxt_switches:") - 1, nullptr, 10);
+            else if (line.starts_with("nonvoluntary_ctxt_switches:"))
+                involuntary = std::strtoull(line.c_str() + sizeof("nonvoluntary_ctxt_switches:") - 1, nullptr, 10);
+        }
+#else
+        AM_UNUSED(threadId);
+        AM_UNUSED(voluntary);
+        AM_UNUSED(involuntary);
+#endif
+    }
+} // namespace SparkyStudios::Audio::Amplitude
@@ -0,0 +1,539 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Summarizes a recording made by the profiler (see the `enable_recording` setting) or by
+// the relay. The recording is memory-mapped and read in a single pass: its chunks are
+// shared between worker threads, each of them building partial results which are merged
+// once every chunk has been read. The report is written as JSON.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Histogram.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Recording.h>
+
+#include <json/writer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <thread>
+
+using namespace SparkyStudios::Audio::Amplitude;
+
+namespace
+{
+    constexpr AmReal64 kReportedPercentiles[] = { 50.0, 90.0, 95.0, 99.0, 99.9 };
+
+    struct AnalyzerOptions
+    {
+        AmOsString mRecordingPath;
+        AmString mOutputPath;
+        AmUInt32 mTopCount = 10;
+        AmUInt32 mThreadCount = 0;
+        AmReal64 mTimelineBucketSeconds = 1.0;
+    };
+
+    struct ChannelSummary
+    {
+        AmString mSoundName;
+        AmReal32 mMaxGain = 0.0f;
+        AmInt64 mFirstSeen = std::numeric_limits<AmInt64>::max();
+        AmInt64 mLastSeen = std::numeric_limits<AmInt64>::lowest();
+        AmUInt64 mSnapshotCount = 0;
+
+        [[nodiscard]] AmInt64 GetLifetime() const
+        {
+            return mLastSeen - mFirstSeen;
+        }
+    };
+
+    // First and last underrun counters of a source in a chunk, used to count the underruns
+    // happening between two chunks read by different threads.
+    struct UnderrunCounter
+    {
+        AmUInt32 mFirst = 0;
+        AmInt64 mFirstTimestamp = 0;
+        AmUInt32 mLast = 0;
+    };
+
+    using UnderrunCounters = std::map<AmUInt32, UnderrunCounter>; // Keyed by source
+
+    struct AnalyzerResult
+    {
+        AmUInt64 mMessageCount = 0;
+        AmUInt64 mMessagesPerType[std::variant_size_v<ProfilerDataVariant>] = {};
+        AmInt64 mFirstTimestamp = std::numeric_limits<AmInt64>::max();
+        AmInt64 mLastTimestamp = std::numeric_limits<AmInt64>::lowest();
+
+        ProfilerHistogram mTotalCpu;
+        ProfilerHistogram mMixerCpu;
+        ProfilerHistogram mLatency;
+        ProfilerHistogram mWakeupLatency; // Of every audio thread callback, in milliseconds
+        ProfilerHistogram mVoices;
+        AmUInt64 mInvoluntarySwitches = 0;
+
+        std::map<std::pair<AmUInt32, AmChannelID>, ChannelSummary> mChannels;
+        std::map<AmString, AmUInt64> mEvents;
+
+        std::map<AmInt64, AmUInt64> mUnderrunTimeline; // Underruns per timeline bucket
+        AmUInt64 mUnderrunCount = 0;
+    };
+
+    void PrintUsage(const char* program)
+    {
+        std::printf(
+            "Usage: %s [options] <recording>\n"
+            "\n"
+            "Summarizes a profiler recording as a JSON report.\n"
+            "\n"
+            "Options:\n"
+            "  --output <path>           Write the report to a file instead of the standard output\n"
+            "  --top <count>             Number of channels listed in the top channel tables (default: 10)\n"
+            "  --threads <count>         Number of worker threads, 0 uses every core (default: 0)\n"
+            "  --timeline-bucket <sec>   Duration of a bucket of the underrun timeline (default: 1)\n",
+            program);
+    }
+
+    bool ParseOptions(int argc, char* argv[], AnalyzerOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const AmString arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h")
+                return false;
+
+            if (arg.rfind("--", 0) != 0)
+            {
+                options.mRecordingPath = std::filesystem::path(arg).native();
+                continue;
+            }
+
+            if (!hasValue)
+            {
+                std::fprintf(stderr, "Missing value for option %s\n", arg.c_str());
+                return false;
+            }
+
+            const AmString value = argv[++i];
+
+            if (arg == "--output")
+                options.mOutputPath = value;
+            else if (arg == "--top")
+                options.mTopCount = static_cast<AmUInt32>(std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--threads")
+                options.mThreadCount = static_cast<AmUInt32>(std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--timeline-bucket")
+                options.mTimelineBucketSeconds = std::strtod(value.c_str(), nullptr);
+            else
+            {
+                std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        if (options.mTimelineBucketSeconds <= 0.0)
+        {
+            std::fprintf(stderr, "The timeline bucket duration must be positive\n");
+            return false;
+        }
+
+        return !options.mRecordingPath.empty();
+    }
+
+    AmInt64 ToNanoseconds(const ProfilerTime& time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    void AddUnderruns(AnalyzerResult& result, AmUInt64 count, AmInt64 timestamp, AmInt64 startTime, AmInt64 bucketNs)
+    {
+        if (count == 0)
+            return;
+
+        result.mUnderrunTimeline[(timestamp - startTime) / bucketNs] += count;
+        result.mUnderrunCount += count;
+    }
+
+    // The underrun counter is cumulative, it only goes back when the engine restarts
+    AmUInt32 GetUnderrunDelta(AmUInt32 previous, AmUInt32 current)
+    {
+        return current >= previous ? current - previous : current;
+    }
+
+    class ChunkAnalyzer
+    {
+    public:
+        ChunkAnalyzer(AnalyzerResult& result, UnderrunCounters& counters, AmInt64 startTime, AmInt64 bucketNs)
+            : _result(result)
+            , _counters(counters)
+            , _startTime(startTime)
+            , _bucketNs(bucketNs)
+        {}
+
+        void operator()(const ProfilerDataVariant& message)
+        {
+            const AmInt64 timestamp = std::visit(
+                [](const auto& arg)
+                {
+                    return ToNanoseconds(arg.mTimestamp);
+                },
+                message);
+
+            _result.mMessageCount++;
+            _result.mMessagesPerType[message.index()]++;
+            _result.mFirstTimestamp = std::min(_result.mFirstTimestamp, timestamp);
+            _result.mLastTimestamp = std::max(_result.mLastTimestamp, timestamp);
+
+            if (const auto* engine = std::get_if<ProfilerEngineData>(&message))
+            {
+                _result.mVoices.Record(engine->mActiveVoiceCount);
+            }
+            else if (const auto* performance = std::get_if<ProfilerPerformanceData>(&message))
+            {
+                _result.mTotalCpu.Record(performance->mTotalCpuUsage);
+                _result.mMixerCpu.Record(performance->mMixerCpuUsage);
+                _result.mLatency.Record(performance->mLatencyMs);
+
+                for (const auto& [thread, scheduling] : performance->mThreadScheduling)
+                {
+                    // Callbacks are only known by bucket, each one is counted at its bucket bound
+                    for (AmSize i = 0; i < ProfilerThreadScheduling::kLatencyBucketCount; ++i)
+                    {
+                        _result.mWakeupLatency.Record(
+                            std::min<AmReal64>(ProfilerThreadScheduling::GetLatencyBucketUpperBoundMs(i), scheduling.mLatencyMaxMs),
+                            scheduling.mLatencyBuckets[i]);
+                    }
+
+                    _result.mInvoluntarySwitches += scheduling.mInvoluntarySwitches;
+                }
+
+                _countUnderruns(performance->mSourceId, performance->mUnderruns, timestamp);
+            }
+            else if (const auto* channel = std::get_if<ProfilerChannelData>(&message))
+            {
+                ChannelSummary& summary = _result.mChannels[{ channel->mSourceId, channel->mChannelId }];
+                if (!channel->mSoundName.empty())
+                    summary.mSoundName = channel->mSoundName;
+
+                summary.mMaxGain = std::max(summary.mMaxGain, channel->mGain);
+                summary.mFirstSeen = std::min(summary.mFirstSeen, timestamp);
+                summary.mLastSeen = std::max(summary.mLastSeen, timestamp);
+                summary.mSnapshotCount++;
+            }
+            else if (const auto* event = std::get_if<ProfilerEvent>(&message))
+            {
+                _result.mEvents[event->mEventName]++;
+            }
+        }
+
+    private:
+        void _countUnderruns(AmUInt32 sourceId, AmUInt32 underruns, AmInt64 timestamp)
+        {
+            auto it = _counters.find(sourceId);
+            if (it == _counters.end())
+            {
+                _counters[sourceId] = { underruns, timestamp, underruns };
+                return;
+            }
+
+            AddUnderruns(_result, GetUnderrunDelta(it->second.mLast, underruns), timestamp, _startTime, _bucketNs);
+            it->second.mLast = underruns;
+        }
+
+        AnalyzerResult& _result;
+        UnderrunCounters& _counters;
+        AmInt64 _startTime;
+        AmInt64 _bucketNs;
+    };
+
+    // Merge the partial result of a worker thread
+    void MergeResult(AnalyzerResult& target, AnalyzerResult& partial)
+    {
+        target.mMessageCount += partial.mMessageCount;
+        for (AmSize i = 0; i < std::variant_size_v<ProfilerDataVariant>; ++i)
+            target.mMessagesPerType[i] += partial.mMessagesPerType[i];
+
+        target.mFirstTimestamp = std::min(target.mFirstTimestamp, partial.mFirstTimestamp);
+        target.mLastTimestamp = std::max(target.mLastTimestamp, partial.mLastTimestamp);
+
+        target.mTotalCpu.Merge(partial.mTotalCpu);
+        target.mMixerCpu.Merge(partial.mMixerCpu);
+        target.mLatency.Merge(partial.mLatency);
+        target.mWakeupLatency.Merge(partial.mWakeupLatency);
+        target.mInvoluntarySwitches += partial.mInvoluntarySwitches;
+        target.mVoices.Merge(partial.mVoices);
+
+        for (auto& [key, summary] : partial.mChannels)
+        {
+            ChannelSummary& merged = target.mChannels[key];
+            if (!summary.mSoundName.empty())
+                merged.mSoundName = std::move(summary.mSoundName);
+
+            merged.mMaxGain = std::max(merged.mMaxGain, summary.mMaxGain);
+            merged.mFirstSeen = std::min(merged.mFirstSeen, summary.mFirstSeen);
+            merged.mLastSeen = std::max(merged.mLastSeen, summary.mLastSeen);
+            merged.mSnapshotCount += summary.mSnapshotCount;
+        }
+
+        for (const auto& [name, count] : partial.mEvents)
+            target.mEvents[name] += count;
+
+        for (const auto& [bucket, count] : partial.mUnderrunTimeline)
+            target.mUnderrunTimeline[bucket] += count;
+
+        target.mUnderrunCount += partial.mUnderrunCount;
+    }
+
+    // Count the underruns happening between two chunks, which were read by different threads
+    void CountChunkBoundaryUnderruns(AnalyzerResult& result, const std::vector<UnderrunCounters>& chunks, AmInt64 startTime, AmInt64 bucketNs)
+    {
+        UnderrunCounters last;
+        for (const auto& counters : chunks)
+        {
+            for (const auto& [sourceId, counter] : counters)
+            {
+                auto it = last.find(sourceId);
+                if (it != last.end())
+                    AddUnderruns(result, GetUnderrunDelta(it->second.mLast, counter.mFirst), counter.mFirstTimestamp, startTime, bucketNs);
+
+                last[sourceId] = counter;
+            }
+        }
+    }
+
+    Json::Value WriteHistogram(const ProfilerHistogram& histogram)
+    {
+        Json::Value json(Json::objectValue);
+        json["count"] = static_cast<Json::UInt64>(histogram.GetCount());
+        json["min"] = histogram.GetMin();
+        json["max"] = histogram.GetMax();
+        json["mean"] = histogram.GetMean();
+
+        for (const AmReal64 percentile : kReportedPercentiles)
+        {
+            char name[16];
+            std::snprintf(name, sizeof(name), "p%g", percentile);
+            json[name] = histogram.GetPercentile(percentile);
+        }
+
+        return json;
+    }
+
+    template<typename Compare>
+    Json::Value WriteTopChannels(const AnalyzerResult& result, AmUInt32 count, Compare compare)
+    {
+        using Entry = std::pair<std::pair<AmUInt32, AmChannelID>, const ChannelSummary*>;
+
+        std::vector<Entry> entries;
+        entries.reserve(result.mChannels.size());
+        for (const auto& [key, summary] : result.mChannels)
+            entries.emplace_back(key, &summary);
+
+        const AmSize top = std::min<AmSize>(count, entries.size());
+        std::partial_sort(
+            entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(top), entries.end(),
+            [&compare](const Entry& a, const Entry& b)
+            {
+                return compare(*a.second, *b.second);
+            });
+
+        Json::Value json(Json::arrayValue);
+        for (AmSize i = 0; i < top; ++i)
+        {
+            const auto& [key, summary] = entries[i];
+
+            Json::Value channel(Json::objectValue);
+            channel["sourceId"] = key.first;
+            channel["channelId"] = static_cast<Json::UInt64>(key.second);
+            channel["soundName"] = summary->mSoundName;
+            channel["maxGain"] = summary->mMaxGain;
+            channel["lifetimeSeconds"] = static_cast<AmReal64>(summary->GetLifetime()) / 1e9;
+            channel["snapshots"] = static_cast<Json::UInt64>(summary->mSnapshotCount);
+            json.append(channel);
+        }
+
+        return json;
+    }
+
+    Json::Value WriteReport(
+        const ProfilerRecordingReader& reader, const AnalyzerResult& result, const AnalyzerOptions& options, AmUInt64 invalidChunks)
+    {
+        static constexpr const char* kTypeNames[] = { "engine", "entity", "channel", "listener", "performance", "event", "aggregate" };
+        static_assert(std::size(kTypeNames) == std::variant_size_v<ProfilerDataVariant>, "Every message type needs a name");
+
+        Json::Value report(Json::objectValue);
+
+        Json::Value& recording = report["recording"];
+        recording["path"] = std::filesystem::path(options.mRecordingPath).string();
+        recording["chunks"] = static_cast<Json::UInt64>(reader.GetChunks().size());
+        recording["invalidChunks"] = static_cast<Json::UInt64>(invalidChunks);
+        recording["recovered"] = reader.IsRecovered();
+        recording["messages"] = static_cast<Json::UInt64>(result.mMessageCount);
+        recording["durationSeconds"] =
+            result.mMessageCount > 0 ? static_cast<AmReal64>(result.mLastTimestamp - result.mFirstTimestamp) / 1e9 : 0.0;
+
+        Json::Value& messages = recording["messagesPerType"];
+        for (AmSize i = 0; i < std::size(kTypeNames); ++i)
+            messages[kTypeNames[i]] = static_cast<Json::UInt64>(result.mMessagesPerType[i]);
+
+        Json::Value& percentiles = report["percentiles"];
+        percentiles["totalCpu"] = WriteHistogram(result.mTotalCpu);
+        percentiles["mixerCpu"] = WriteHistogram(result.mMixerCpu);
+        percentiles["latencyMs"] = WriteHistogram(result.mLatency);
+        percentiles["wakeupLatencyMs"] = WriteHistogram(result.mWakeupLatency);
+        percentiles["activeVoices"] = WriteHistogram(result.mVoices);
+
+        // Preemptions of the audio threads, to tell late scheduling apart from slow mixing
+        report["involuntarySwitches"] = static_cast<Json::UInt64>(result.mInvoluntarySwitches);
+
+        report["loudestChannels"] = WriteTopChannels(
+            result, options.mTopCount,
+            [](const ChannelSummary& a, const ChannelSummary& b)
+            {
+                return a.mMaxGain > b.mMaxGain;
+            });
+
+        report["longestChannels"] = WriteTopChannels(
+            result, options.mTopCount,
+            [](const ChannelSummary& a, const ChannelSummary& b)
+            {
+                return a.GetLifetime() > b.GetLifetime();
+            });
+
+        std::vector<std::pair<AmString, AmUInt64>> events(result.mEvents.begin(), result.mEvents.end());
+        std::stable_sort(
+            events.begin(), events.end(),
+            [](const auto& a, const auto& b)
+            {
+                return a.second > b.second;
+            });
+
+        Json::Value& eventTable = report["events"];
+        eventTable = Json::Value(Json::arrayValue);
+        for (const auto& [name, count] : events)
+        {
+            Json::Value event(Json::objectValue);
+            event["name"] = name;
+            event["count"] = static_cast<Json::UInt64>(count);
+            eventTable.append(event);
+        }
+
+        Json::Value& underruns = report["underruns"];
+        underruns["total"] = static_cast<Json::UInt64>(result.mUnderrunCount);
+        underruns["bucketSeconds"] = options.mTimelineBucketSeconds;
+
+        Json::Value& timeline = underruns["timeline"];
+        timeline = Json::Value(Json::arrayValue);
+        for (const auto& [bucket, count] : result.mUnderrunTimeline)
+        {
+            Json::Value entry(Json::objectValue);
+            entry["time"] = static_cast<AmReal64>(bucket) * options.mTimelineBucketSeconds;
+            entry["count"] = static_cast<Json::UInt64>(count);
+            timeline.append(entry);
+        }
+
+        return report;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    AnalyzerOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    MemoryManager::Initialize(MemoryManagerConfig());
+
+    ConsoleLogger logger;
+    Logger::SetLogger(&logger);
+
+    ProfilerRecordingReader reader;
+    if (!reader.Open(options.mRecordingPath))
+        return 1;
+
+    const AmSize chunkCount = reader.GetChunks().size();
+    const AmInt64 startTime = reader.GetHeader().mStartTime;
+    const auto bucketNs = std::max<AmInt64>(1, static_cast<AmInt64>(options.mTimelineBucketSeconds * 1e9));
+
+    AmSize threadCount = options.mThreadCount > 0 ? options.mThreadCount : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::max<AmSize>(1, std::min(threadCount, chunkCount));
+
+    // Workers take the next unread chunk until none is left. Each of them has its own
+    // result, and the underrun counters are kept per chunk to be joined in recording order.
+    std::vector<AnalyzerResult> partials(threadCount);
+    std::vector<UnderrunCounters> chunkCounters(chunkCount);
+    std::atomic<AmSize> nextChunk{ 0 };
+    std::atomic<AmUInt64> invalidChunks{ 0 };
+
+    const auto worker = [&](AnalyzerResult& partial)
+    {
+        for (AmSize index = nextChunk.fetch_add(1); index < chunkCount; index = nextChunk.fetch_add(1))
+        {
+            ChunkAnalyzer analyzer(partial, chunkCounters[index], startTime, bucketNs);
+            if (!reader.ReadChunk(index, std::ref(analyzer)))
+                invalidChunks.fetch_add(1);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (AmSize i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker, std::ref(partials[i]));
+
+    worker(partials[0]);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    AnalyzerResult result;
+    for (auto& partial : partials)
+        MergeResult(result, partial);
+
+    CountChunkBoundaryUnderruns(result, chunkCounters, startTime, bucketNs);
+
+    if (invalidChunks.load() > 0)
+        std::fprintf(stderr, "%llu chunk(s) could not be fully decoded\n", static_cast<unsigned long long>(invalidChunks.load()));
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+
+    const AmString report = Json::writeString(builder, WriteReport(reader, result, options, invalidChunks.load()));
+
+    if (options.mOutputPath.empty())
+    {
+        std::cout << report << std::endl;
+        return 0;
+    }
+
+    std::ofstream file(std::filesystem::path(options.mOutputPath));
+    if (!file.is_open())
+    {
+        std::fprintf(stderr, "Failed to create the report file: %s\n", options.mOutputPath.c_str());
+        return 1;
+    }
+
+    file << report << std::endl;
+    return 0;
+}
@@ -0,0 +1,469 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares a candidate recording against a baseline recording. Both recordings are split
+// into scenarios by marker events, and the samples of every metric are compared scenario
+// by scenario with a Mann-Whitney U test. A metric regresses when the difference is
+// significant and its median grew past the threshold. The tool exits with code 2 when at
+// least one metric regressed, so it can gate continuous integration jobs, and with code 3
+// when the recordings could not be fully compared.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Recording.h>
+
+#include <json/writer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace SparkyStudios::Audio::Amplitude;
+
+namespace
+{
+    constexpr int kExitRegression = 2;
+    constexpr int kExitIncomplete = 3;
+
+    struct CompareOptions
+    {
+        AmOsString mBaselinePath;
+        AmOsString mCandidatePath;
+        AmString mOutputPath;
+        AmString mMarker;
+        AmReal64 mAlpha = 0.01;
+        AmReal64 mThreshold = 5.0; // Percent
+        std::map<AmString, AmReal64> mMetricThresholds;
+        AmSize mMinSamples = 20;
+        bool mAllowMissing = false;
+    };
+
+    // Samples of every metric, per scenario
+    using ScenarioSamples = std::map<AmString, std::map<AmString, std::vector<AmReal64>>>;
+
+    struct TestResult
+    {
+        AmReal64 mU = 0.0;
+        AmReal64 mZ = 0.0;
+        AmReal64 mPValue = 1.0;
+        AmReal64 mProbabilityOfIncrease = 0.5; // Probability that a candidate sample is above a baseline sample
+    };
+
+    void PrintUsage(const char* program)
+    {
+        std::printf(
+            "Usage: %s [options] <baseline> <candidate>\n"
+            "\n"
+            "Compares the metrics of two profiler recordings and reports regressions.\n"
+            "Exits with code %d when a metric regressed, and with code %d when a scenario is in only one recording,\n"
+            "or when no metric had enough samples to be compared.\n"
+            "\n"
+            "Options:\n"
+            "  --marker <event>               Split recordings into scenarios at this event. The scenario is named\n"
+            "                                 by the event's \"scenario\" parameter, or its description.\n"
+            "                                 Without a marker, whole recordings are compared.\n"
+            "  --alpha <p>                    Significance level of the statistical test (default: 0.01)\n"
+            "  --threshold <percent>          Median increase above which a metric regresses (default: 5)\n"
+            "  --metric-threshold <name=pct>  Threshold of a single metric, can be repeated\n"
+            "  --min-samples <count>          Samples needed on both sides to compare a metric (default: 20)\n"
+            "  --output <path>                Write the report to a file instead of the standard output\n"
+            "  --allow-missing                Do not fail when scenarios are missing or no metric was compared\n",
+            program, kExitRegression, kExitIncomplete);
+    }
+
+    bool ParseOptions(int argc, char* argv[], CompareOptions& options)
+    {
+        std::vector<AmString> paths;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            const AmString arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h")
+                return false;
+
+            if (arg.rfind("--", 0) != 0)
+            {
+                paths.push_back(arg);
+                continue;
+            }
+
+            if (arg == "--allow-missing")
+            {
+                options.mAllowMissing = true;
+                continue;
+            }
+
+            if (!hasValue)
+            {
+                std::fprintf(stderr, "Missing value for option %s\n", arg.c_str());
+                return false;
+            }
+
+            const AmString value = argv[++i];
+
+            if (arg == "--marker")
+                options.mMarker = value;
+            else if (arg == "--alpha")
+                options.mAlpha = std::strtod(value.c_str(), nullptr);
+            else if (arg == "--threshold")
+                options.mThreshold = std::strtod(value.c_str(), nullptr);
+            else if (arg == "--metric-threshold")
+            {
+                const AmSize separator = value.find('=');
+                if (separator == AmString::npos)
+                {
+                    std::fprintf(stderr, "Invalid metric threshold %s, expected <name>=<percent>\n", value.c_str());
+                    return false;
+                }
+
+                options.mMetricThresholds[value.substr(0, separator)] = std::strtod(value.c_str() + separator + 1, nullptr);
+            }
+            else if (arg == "--min-samples")
+                options.mMinSamples = std::max<AmSize>(1, std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--output")
+                options.mOutputPath = value;
+            else
+            {
+                std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        if (paths.size() != 2)
+            return false;
+
+        options.mBaselinePath = std::filesystem::path(paths[0]).native();
+        options.mCandidatePath = std::filesystem::path(paths[1]).native();
+        return true;
+    }
+
+    AmString GetScenarioName(const ProfilerEvent& event, std::map<AmString, AmUInt32>& occurrences)
+    {
+        if (const auto it = event.mParameters.find("scenario"); it != event.mParameters.end())
+            return it->second;
+
+        if (!event.mDescription.empty())
+            return event.mDescription;
+
+        // Unnamed markers are told apart by their order, which matches between two runs of the same scenario
+        return event.mEventName + "#" + std::to_string(occurrences[event.mEventName]++);
+    }
+
+    void AddSamples(const ProfilerDataVariant& message, std::map<AmString, std::vector<AmReal64>>& metrics)
+    {
+        if (const auto* performance = std::get_if<ProfilerPerformanceData>(&message))
+        {
+            metrics["cpu.total"].push_back(performance->mTotalCpuUsage);
+            metrics["cpu.mixer"].push_back(performance->mMixerCpuUsage);
+            metrics["cpu.dsp"].push_back(performance->mDspCpuUsage);
+            metrics["cpu.streaming"].push_back(performance->mStreamingCpuUsage);
+            metrics["latency"].push_back(performance->mLatencyMs);
+            metrics["memory.total"].push_back(static_cast<AmReal64>(performance->mTotalAllocatedMemory));
+            metrics["memory.engine"].push_back(static_cast<AmReal64>(performance->mEngineMemory));
+            metrics["memory.audio_buffers"].push_back(static_cast<AmReal64>(performance->mAudioBufferMemory));
+            metrics["memory.assets"].push_back(static_cast<AmReal64>(performance->mAssetMemory));
+
+            for (const auto& [thread, usage] : performance->mThreadCpuUsage)
+                metrics["cpu.thread." + thread].push_back(usage);
+
+            for (const auto& [thread, scheduling] : performance->mThreadScheduling)
+            {
+                metrics["wakeup_latency.p99." + thread].push_back(scheduling.mLatencyP99Ms);
+                metrics["wakeup_latency.max." + thread].push_back(scheduling.mLatencyMaxMs);
+                metrics["involuntary_switches." + thread].push_back(scheduling.mInvoluntarySwitches);
+            }
+        }
+        else if (const auto* engine = std::get_if<ProfilerEngineData>(&message))
+        {
+            metrics["voices"].push_back(engine->mActiveVoiceCount);
+        }
+    }
+
+    bool LoadRecording(const AmOsString& path, const CompareOptions& options, ScenarioSamples& scenarios)
+    {
+        ProfilerRecordingReader reader;
+        if (!reader.Open(path))
+            return false;
+
+        // Without a marker, the whole recording is a single scenario. With one, samples
+        // taken before the first marker belong to no scenario and are ignored.
+        AmString scenario = options.mMarker.empty() ? "all" : "";
+        std::map<AmString, AmUInt32> occurrences;
+
+        // Scenarios depend on the order of the messages, so chunks are read sequentially
+        for (AmSize i = 0, l = reader.GetChunks().size(); i < l; ++i)
+        {
+            const bool valid = reader.ReadChunk(
+                i,
+                [&](const ProfilerDataVariant& message)
+                {
+                    if (const auto* event = std::get_if<ProfilerEvent>(&message))
+                    {
+                        if (!options.mMarker.empty() && event->mEventName == options.mMarker)
+                            scenario = GetScenarioName(*event, occurrences);
+
+                        return;
+                    }
+
+                    if (!scenario.empty())
+                        AddSamples(message, scenarios[scenario]);
+                });
+
+            if (!valid)
+                std::fprintf(stderr, "Chunk %zu of %s could not be fully decoded\n", i, std::filesystem::path(path).string().c_str());
+        }
+
+        return true;
+    }
+
+    AmReal64 GetMedian(std::vector<AmReal64> values)
+    {
+        const AmSize middle = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle), values.end());
+
+        if (values.size() % 2 == 1)
+            return values[middle];
+
+        const AmReal64 upper = values[middle];
+        return (*std::max_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle)) + upper) / 2.0;
+    }
+
+    // Two-sided Mann-Whitney U test, using the normal approximation with tie correction
+    TestResult MannWhitneyU(const std::vector<AmReal64>& baseline, const std::vector<AmReal64>& candidate)
+    {
+        const auto n1 = static_cast<AmReal64>(baseline.size());
+        const auto n2 = static_cast<AmReal64>(candidate.size());
+        const auto n = n1 + n2;
+
+        std::vector<std::pair<AmReal64, bool>> values; // Value, and whether it comes from the candidate
+        values.reserve(baseline.size() + candidate.size());
+        for (const AmReal64 value : baseline)
+            values.emplace_back(value, false);
+        for (const AmReal64 value : candidate)
+            values.emplace_back(value, true);
+
+        std::sort(values.begin(), values.end());
+
+        // Tied values share the average of their ranks
+        AmReal64 candidateRanks = 0.0;
+        AmReal64 tieCorrection = 0.0;
+
+        for (AmSize i = 0, l = values.size(); i < l;)
+        {
+            AmSize j = i + 1;
+            while (j < l && values[j].first == values[i].first)
+                ++j;
+
+            const AmReal64 rank = (static_cast<AmReal64>(i + 1) + static_cast<AmReal64>(j)) / 2.0;
+            for (AmSize k = i; k < j; ++k)
+            {
+                if (values[k].second)
+                    candidateRanks += rank;
+            }
+
+            const auto ties = static_cast<AmReal64>(j - i);
+            tieCorrection += ties * ties * ties - ties;
+            i = j;
+        }
+
+        TestResult result;
+        result.mU = candidateRanks - n2 * (n2 + 1.0) / 2.0;
+        result.mProbabilityOfIncrease = result.mU / (n1 * n2);
+
+        const AmReal64 mean = n1 * n2 / 2.0;
+        const AmReal64 variance = n1 * n2 / 12.0 * ((n + 1.0) - tieCorrection / (n * (n - 1.0)));
+        if (variance <= 0.0)
+            return result; // Every sample has the same value
+
+        // Continuity correction towards the mean
+        const AmReal64 difference = result.mU - mean;
+        const AmReal64 corrected = difference > 0.0 ? difference - 0.5 : difference < 0.0 ? difference + 0.5 : 0.0;
+
+        result.mZ = corrected / std::sqrt(variance);
+        result.mPValue = std::erfc(std::abs(result.mZ) / std::sqrt(2.0));
+        return result;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    CompareOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    MemoryManager::Initialize(MemoryManagerConfig());
+
+    ConsoleLogger logger;
+    Logger::SetLogger(&logger);
+
+    ScenarioSamples baseline, candidate;
+    if (!LoadRecording(options.mBaselinePath, options, baseline) || !LoadRecording(options.mCandidatePath, options, candidate))
+        return 1;
+
+    Json::Value report(Json::objectValue);
+    report["baseline"] = std::filesystem::path(options.mBaselinePath).string();
+    report["candidate"] = std::filesystem::path(options.mCandidatePath).string();
+    report["alpha"] = options.mAlpha;
+    report["marker"] = options.mMarker;
+
+    Json::Value& scenarios = report["scenarios"];
+    scenarios = Json::Value(Json::arrayValue);
+
+    Json::Value& missing = report["missingScenarios"];
+    missing = Json::Value(Json::arrayValue);
+
+    AmUInt32 regressionCount = 0;
+    AmUInt32 improvementCount = 0;
+    AmUInt32 comparedCount = 0;
+
+    for (const auto& [scenario, baselineMetrics] : baseline)
+    {
+        const auto candidateScenario = candidate.find(scenario);
+        if (candidateScenario == candidate.end())
+        {
+            missing.append(scenario);
+            continue;
+        }
+
+        Json::Value scenarioReport(Json::objectValue);
+        scenarioReport["name"] = scenario;
+
+        Json::Value& metrics = scenarioReport["metrics"];
+        metrics = Json::Value(Json::arrayValue);
+
+        for (const auto& [metric, baselineSamples] : baselineMetrics)
+        {
+            const auto candidateMetric = candidateScenario->second.find(metric);
+            if (candidateMetric == candidateScenario->second.end())
+                continue;
+
+            const std::vector<AmReal64>& candidateSamples = candidateMetric->second;
+
+            Json::Value metricReport(Json::objectValue);
+            metricReport["name"] = metric;
+            metricReport["baselineSamples"] = static_cast<Json::UInt64>(baselineSamples.size());
+            metricReport["candidateSamples"] = static_cast<Json::UInt64>(candidateSamples.size());
+
+            if (baselineSamples.size() < options.mMinSamples || candidateSamples.size() < options.mMinSamples)
+            {
+                metricReport["status"] = "insufficient_samples";
+                metrics.append(metricReport);
+                continue;
+            }
+
+            const AmReal64 baselineMedian = GetMedian(baselineSamples);
+            const AmReal64 candidateMedian = GetMedian(candidateSamples);
+
+            // Every metric is a cost: an increase is a regression
+            AmReal64 change = 0.0;
+            if (baselineMedian != 0.0)
+                change = (candidateMedian - baselineMedian) / std::abs(baselineMedian) * 100.0;
+            else if (candidateMedian != 0.0)
+                change = candidateMedian > 0.0 ? 100.0 : -100.0;
+
+            const auto threshold = options.mMetricThresholds.find(metric);
+            const AmReal64 limit = threshold != options.mMetricThresholds.end() ? threshold->second : options.mThreshold;
+
+            const TestResult test = MannWhitneyU(baselineSamples, candidateSamples);
+            comparedCount++;
+            const bool significant = test.mPValue < options.mAlpha;
+
+            AmString status = "unchanged";
+            if (significant && change > limit)
+            {
+                status = "regressed";
+                regressionCount++;
+            }
+            else if (significant && change < -limit)
+            {
+                status = "improved";
+                improvementCount++;
+            }
+
+            metricReport["baselineMedian"] = baselineMedian;
+            metricReport["candidateMedian"] = candidateMedian;
+            metricReport["changePercent"] = change;
+            metricReport["thresholdPercent"] = limit;
+            metricReport["u"] = test.mU;
+            metricReport["z"] = test.mZ;
+            metricReport["pValue"] = test.mPValue;
+            metricReport["probabilityOfIncrease"] = test.mProbabilityOfIncrease;
+            metricReport["status"] = status;
+            metrics.append(metricReport);
+        }
+
+        scenarios.append(scenarioReport);
+    }
+
+    for (const auto& [scenario, metrics] : candidate)
+    {
+        if (baseline.find(scenario) == baseline.end())
+            missing.append(scenario);
+    }
+
+    report["compared"] = comparedCount;
+    report["regressions"] = regressionCount;
+    report["improvements"] = improvementCount;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+
+    const AmString output = Json::writeString(builder, report);
+
+    if (options.mOutputPath.empty())
+    {
+        std::cout << output << std::endl;
+    }
+    else
+    {
+        std::ofstream file(std::filesystem::path(options.mOutputPath));
+        if (!file.is_open())
+        {
+            std::fprintf(stderr, "Failed to create the report file: %s\n", options.mOutputPath.c_str());
+            return 1;
+        }
+
+        file << output << std::endl;
+    }
+
+    if (regressionCount > 0)
+    {
+        std::fprintf(stderr, "%u metric(s) regressed\n", regressionCount);
+        return kExitRegression;
+    }
+
+    // A gate which compared nothing would pass silently, e.g. with a misspelled marker
+    if (!options.mAllowMissing && (!missing.empty() || comparedCount == 0))
+    {
+        if (!missing.empty())
+            std::fprintf(stderr, "%u scenario(s) are missing from one of the recordings\n", missing.size());
+
+        if (comparedCount == 0)
+            std::fprintf(stderr, "No metric had enough samples to be compared\n");
+
+        return kExitIncomplete;
+    }
+
+    return 0;
+}
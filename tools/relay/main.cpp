@@ -0,0 +1,438 @@
+// Copyright (c) 2025-present Sparky Studios. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Merges the streams of several profiled processes running on the same host into a single
+// stream. Each process publishes its messages to its own shared memory ring (see the
+// `enable_shared_memory_transport` and `shared_memory_name` settings), and the relay tags,
+// aligns and re-serves them so one dashboard can watch the whole host.
+
+#include <SparkyStudios/Audio/Amplitude/Core/Memory.h>
+#include <SparkyStudios/Audio/Amplitude/IO/Log.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Filter.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Recording.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/Server.h>
+#include <SparkyStudios/Audio/Amplitude/Profiler/SharedMemory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <thread>
+
+using namespace SparkyStudios::Audio::Amplitude;
+
+namespace
+{
+    std::atomic<bool> gRunning{ true };
+
+    struct RelayOptions
+    {
+        std::vector<AmString> mSources;
+        AmUInt16 mPort = kDefaultProfilerPort + 10;
+        AmString mBindAddress = "127.0.0.1";
+        AmString mSharedMemoryName;
+        AmOsString mRecordPath;
+        eProfilerRecordingCompression mRecordCompression = eProfilerRecordingCompression_Zstd;
+        AmString mFilter;
+        AmUInt32 mPollIntervalMs = 5;
+        AmUInt32 mAggregateIntervalMs = 1000;
+        AmUInt32 mReconnectIntervalMs = 1000;
+        AmUInt32 mStaleTimeoutMs = 5000;
+    };
+
+    struct RelaySource
+    {
+        AmString mName;
+        AmUInt32 mSourceId = 0;
+        AmUniquePtr<ProfilerSharedMemoryReader, eMemoryPoolKind_IO> mReader;
+        ProfilerTime mLastAttempt;
+        ProfilerTime mLastMessage; // Since the source was attached, when nothing was received yet
+
+        // Smallest observed difference between the relay clock and the source clock. The
+        // smallest sample is the one with the least delivery delay, so it is the closest
+        // estimate of the clock offset.
+        AmInt64 mClockOffsetNs = std::numeric_limits<AmInt64>::max();
+
+        bool mHasPerformance = false;
+        ProfilerPerformanceData mLastPerformance;
+        AmUInt64 mMessagesReceived = 0;
+    };
+
+    void PrintUsage(const char* program)
+    {
+        std::printf(
+            "Usage: %s [options] <source>...\n"
+            "\n"
+            "Merges the profiler streams of several processes on this host.\n"
+            "Each <source> is the shared memory name of a profiled process.\n"
+            "\n"
+            "Options:\n"
+            "  --port <port>          Serve the merged stream over WebSocket on this port, 0 disables (default: %d)\n"
+            "  --bind <address>       Address to bind the WebSocket server to (default: 127.0.0.1)\n"
+            "  --shm <name>           Publish the merged stream to a shared memory ring\n"
+            "  --record <path>        Record the merged stream to a file\n"
+            "  --compress <codec>     Compression of the recording: none, zstd or lz4 (default: zstd)\n"
+            "  --filter <expression>  Only forward messages matching the filter expression\n"
+            "  --poll <ms>            Delay between two polls of the sources (default: 5)\n"
+            "  --aggregate <ms>       Delay between two host aggregates, 0 disables (default: 1000)\n"
+            "  --stale <ms>           Reattach to a source which sent nothing for this long, 0 disables (default: 5000)\n",
+            program, kDefaultProfilerPort + 10);
+    }
+
+    bool ParseOptions(int argc, char* argv[], RelayOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const AmString arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h")
+                return false;
+
+            if (arg.rfind("--", 0) != 0)
+            {
+                options.mSources.push_back(arg);
+                continue;
+            }
+
+            if (!hasValue)
+            {
+                std::fprintf(stderr, "Missing value for option %s\n", arg.c_str());
+                return false;
+            }
+
+            const AmString value = argv[++i];
+
+            if (arg == "--port")
+                options.mPort = static_cast<AmUInt16>(std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--bind")
+                options.mBindAddress = value;
+            else if (arg == "--shm")
+                options.mSharedMemoryName = value;
+            else if (arg == "--record")
+                options.mRecordPath = std::filesystem::path(value).native();
+            else if (arg == "--compress")
+            {
+                if (value == "none")
+                    options.mRecordCompression = eProfilerRecordingCompression_None;
+                else if (value == "zstd")
+                    options.mRecordCompression = eProfilerRecordingCompression_Zstd;
+                else if (value == "lz4")
+                    options.mRecordCompression = eProfilerRecordingCompression_LZ4;
+                else
+                {
+                    std::fprintf(stderr, "Unknown compression %s\n", value.c_str());
+                    return false;
+                }
+            }
+            else if (arg == "--filter")
+                options.mFilter = value;
+            else if (arg == "--poll")
+                options.mPollIntervalMs = static_cast<AmUInt32>(std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--aggregate")
+                options.mAggregateIntervalMs = static_cast<AmUInt32>(std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--stale")
+                options.mStaleTimeoutMs = static_cast<AmUInt32>(std::strtoul(value.c_str(), nullptr, 10));
+            else
+            {
+                std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        return !options.mSources.empty();
+    }
+
+    AmInt64 ToNanoseconds(const ProfilerTime& time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    ProfilerTime FromNanoseconds(AmInt64 ns)
+    {
+        return ProfilerTime(std::chrono::duration_cast<ProfilerTime::duration>(std::chrono::nanoseconds(ns)));
+    }
+
+    // Tag a message with its source and rebase its timestamp onto the relay clock
+    void AlignMessage(RelaySource& source, ProfilerDataVariant& message, ProfilerTime now)
+    {
+        std::visit(
+            [&source, now](auto& arg)
+            {
+                const AmInt64 timestamp = ToNanoseconds(arg.mTimestamp);
+                source.mClockOffsetNs = std::min(source.mClockOffsetNs, ToNanoseconds(now) - timestamp);
+
+                arg.mSourceId = source.mSourceId;
+                arg.mTimestamp = FromNanoseconds(timestamp + source.mClockOffsetNs);
+            },
+            message);
+
+        if (auto* performance = std::get_if<ProfilerPerformanceData>(&message))
+        {
+            source.mLastPerformance = *performance;
+            source.mHasPerformance = true;
+        }
+    }
+
+    // Sum the latest performance of every source into a host-wide message
+    void AppendHostAggregate(const std::vector<RelaySource>& sources, std::vector<ProfilerDataVariant>& batch)
+    {
+        ProfilerPerformanceData host;
+        host.mSourceId = 0;
+
+        ProfilerEvent summary("RelaySources", "Per source message and loss counters");
+        summary.mSourceId = 0;
+
+        AmUInt32 reporting = 0;
+
+        for (const auto& source : sources)
+        {
+            summary.mParameters[source.mName + ".messages"] = std::to_string(source.mMessagesReceived);
+            summary.mParameters[source.mName + ".lost"] = std::to_string(source.mReader ? source.mReader->GetLostCount() : 0);
+            summary.mParameters[source.mName + ".connected"] = source.mReader ? "true" : "false";
+
+            if (!source.mHasPerformance)
+                continue;
+
+            const ProfilerPerformanceData& data = source.mLastPerformance;
+
+            host.mTotalCpuUsage += data.mTotalCpuUsage;
+            host.mMixerCpuUsage += data.mMixerCpuUsage;
+            host.mDspCpuUsage += data.mDspCpuUsage;
+            host.mStreamingCpuUsage += data.mStreamingCpuUsage;
+            host.mTotalAllocatedMemory += data.mTotalAllocatedMemory;
+            host.mEngineMemory += data.mEngineMemory;
+            host.mAudioBufferMemory += data.mAudioBufferMemory;
+            host.mAssetMemory += data.mAssetMemory;
+            host.mProcessedSamples += data.mProcessedSamples;
+            host.mUnderruns += data.mUnderruns;
+            host.mOverruns += data.mOverruns;
+            host.mLatencyMs = std::max(host.mLatencyMs, data.mLatencyMs);
+            host.mActiveThreadCount += data.mActiveThreadCount;
+
+            for (const auto& [thread, usage] : data.mThreadCpuUsage)
+                host.mThreadCpuUsage[source.mName + "/" + thread] = usage;
+
+            for (const auto& [thread, scheduling] : data.mThreadScheduling)
+                host.mThreadScheduling[source.mName + "/" + thread] = scheduling;
+
+            reporting++;
+        }
+
+        if (reporting > 0)
+            batch.emplace_back(std::move(host));
+
+        batch.emplace_back(std::move(summary));
+    }
+
+    AmTime GetTimestampSeconds(const ProfilerDataVariant& message)
+    {
+        return std::visit(
+            [](const auto& arg) -> AmTime
+            {
+                return std::chrono::duration<AmTime>(arg.mTimestamp.time_since_epoch()).count();
+            },
+            message);
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    RelayOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    MemoryManager::Initialize(MemoryManagerConfig());
+
+    ConsoleLogger logger;
+    Logger::SetLogger(&logger);
+
+    std::signal(SIGINT, [](int) { gRunning = false; });
+    std::signal(SIGTERM, [](int) { gRunning = false; });
+
+    ProfilerFilter filter;
+    AmString filterError;
+    if (!options.mFilter.empty() && !filter.Compile(options.mFilter, &filterError))
+    {
+        std::fprintf(stderr, "Invalid filter expression: %s\n", filterError.c_str());
+        return 1;
+    }
+
+    std::vector<RelaySource> sources(options.mSources.size());
+    for (AmSize i = 0, l = sources.size(); i < l; ++i)
+    {
+        sources[i].mName = options.mSources[i];
+        sources[i].mSourceId = static_cast<AmUInt32>(i + 1);
+    }
+
+    // Outputs
+    AmUniquePtr<ProfilerServer, eMemoryPoolKind_IO> server;
+    if (options.mPort != 0)
+    {
+        server.reset(ampoolnew(eMemoryPoolKind_IO, ProfilerServer));
+        if (!server->Start(options.mPort, options.mBindAddress, kMaxProfilerClients))
+        {
+            std::fprintf(stderr, "Failed to start the relay server on %s:%d\n", options.mBindAddress.c_str(), options.mPort);
+            return 1;
+        }
+    }
+
+    AmUniquePtr<ProfilerSharedMemoryWriter, eMemoryPoolKind_IO> sharedMemory;
+    if (!options.mSharedMemoryName.empty())
+    {
+        sharedMemory.reset(ampoolnew(eMemoryPoolKind_IO, ProfilerSharedMemoryWriter));
+        if (!sharedMemory->Open(options.mSharedMemoryName, 16 * 1024 * 1024))
+            return 1;
+    }
+
+    AmUniquePtr<ProfilerRecordingWriter, eMemoryPoolKind_IO> recording;
+    if (!options.mRecordPath.empty())
+    {
+        recording.reset(ampoolnew(eMemoryPoolKind_IO, ProfilerRecordingWriter));
+        if (!recording->Open(options.mRecordPath, ProfilerRecordingWriter::kDefaultChunkSize, options.mRecordCompression))
+            return 1;
+    }
+
+    std::printf("Relaying %zu source(s)\n", sources.size());
+
+    const auto reconnectInterval = std::chrono::milliseconds(options.mReconnectIntervalMs);
+    const auto aggregateInterval = std::chrono::milliseconds(options.mAggregateIntervalMs);
+    const auto staleTimeout = std::chrono::milliseconds(options.mStaleTimeoutMs);
+    ProfilerTime lastAggregate = std::chrono::high_resolution_clock::now();
+
+    std::vector<ProfilerDataVariant> batch;
+    std::vector<AmUInt8> matches;
+
+    while (gRunning.load())
+    {
+        const ProfilerTime now = std::chrono::high_resolution_clock::now();
+        batch.clear();
+
+        for (auto& source : sources)
+        {
+            // Processes come and go, keep trying to attach to missing ones
+            if (!source.mReader)
+            {
+                if (now - source.mLastAttempt < reconnectInterval)
+                    continue;
+
+                source.mLastAttempt = now;
+
+                auto reader = AmUniquePtr<ProfilerSharedMemoryReader, eMemoryPoolKind_IO>(
+                    ampoolnew(eMemoryPoolKind_IO, ProfilerSharedMemoryReader));
+
+                if (!reader->Open(source.mName))
+                    continue;
+
+                source.mReader = std::move(reader);
+                source.mClockOffsetNs = std::numeric_limits<AmInt64>::max();
+                source.mLastMessage = now;
+                std::printf("Attached to source %u: %s\n", source.mSourceId, source.mName.c_str());
+            }
+
+            const AmUInt32 received = source.mReader->Poll(
+                [&source, &batch, now](const ProfilerDataVariant& message)
+                {
+                    batch.push_back(message);
+                    AlignMessage(source, batch.back(), now);
+                    source.mMessagesReceived++;
+                });
+
+            if (received > 0)
+                source.mLastMessage = now;
+
+            // A restarted process recreates its ring, and the mapping of a process which exited stays silent.
+            // Detaching lets the reconnection above attach to the new ring and measure its clock again.
+            const bool restarted = source.mReader->HasProducerRestarted();
+            if (restarted || (options.mStaleTimeoutMs > 0 && now - source.mLastMessage >= staleTimeout))
+            {
+                std::printf(
+                    "Detached from source %u: %s (%s)\n", source.mSourceId, source.mName.c_str(), restarted ? "restarted" : "no message");
+
+                source.mReader.reset();
+                source.mHasPerformance = false;
+                source.mLastAttempt = now - reconnectInterval;
+            }
+        }
+
+        if (options.mAggregateIntervalMs > 0 && now - lastAggregate >= aggregateInterval)
+        {
+            AppendHostAggregate(sources, batch);
+            lastAggregate = now;
+        }
+
+        if (!batch.empty())
+        {
+            // Interleave sources on the common clock
+            std::stable_sort(
+                batch.begin(), batch.end(),
+                [](const ProfilerDataVariant& a, const ProfilerDataVariant& b)
+                {
+                    return GetTimestampSeconds(a) < GetTimestampSeconds(b);
+                });
+
+            if (!filter.IsEmpty())
+            {
+                filter.EvaluateBatch(batch, matches);
+
+                AmSize kept = 0;
+                for (AmSize i = 0, l = batch.size(); i < l; ++i)
+                {
+                    if (matches[i])
+                        batch[kept++] = std::move(batch[i]);
+                }
+
+                batch.resize(kept);
+            }
+
+            if (server)
+                server->BroadcastProfilerData(batch);
+
+            for (const auto& message : batch)
+            {
+                if (sharedMemory)
+                    sharedMemory->Publish(message);
+
+                if (recording)
+                    recording->Write(message);
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.mPollIntervalMs));
+    }
+
+    std::printf("Stopping relay\n");
+
+    if (recording)
+        recording->Close();
+
+    if (server)
+        server->Stop();
+
+    recording.reset();
+    sharedMemory.reset();
+    server.reset();
+    sources.clear();
+
+    Logger::SetLogger(nullptr);
+    MemoryManager::Deinitialize();
+
+    return 0;
+}
@@ -35,6 +35,12 @@ add_requires("amplitudeaudiosdk fix/release-stabilization")
 add_requires("uwebsockets")
 add_requires("protobuf-cpp")
 add_requires("jsoncpp")
+add_requires("zstd")
+add_requires("lz4")
+
+if is_plat("linux") then
+  add_requires("liburing", { optional = true })
+end
 
 target("AmplitudeProfiler")
   set_kind("shared")
@@ -45,19 +51,40 @@ target("AmplitudeProfiler")
     add_syslinks("pthread", "dl")
   end
 
+  if is_plat("linux") or is_plat("android") then
+    add_syslinks("rt")
+  end
+
+  if is_plat("windows", "mingw") then
+    add_syslinks("ws2_32")
+  end
+
   if is_plat("macosx") or is_plat("iphoneos") then
     add_frameworks("CoreFoundation")
   end
 
   if is_mode("debug") then
     set_suffixname("_d")
+
+    -- Assert when a capture function which locks or allocates is called from a real-time thread
+    add_defines("AM_PROFILER_REALTIME_GUARD", { public = false })
   end
 
   if not has_config("as_package") then
     set_prefixdir("/", { libdir = "lib/$(arch)-$(plat)/shared", bindir = "lib/$(arch)-$(plat)/shared" })
   end
 
-  add_packages("amplitudeaudiosdk", "uwebsockets", "protobuf-cpp", "jsoncpp")
+  add_packages("amplitudeaudiosdk", "uwebsockets", "protobuf-cpp", "jsoncpp", "zstd", "lz4")
+
+  -- Asynchronous recording writes go through io_uring when liburing is available
+  if is_plat("linux") then
+    add_packages("liburing")
+    on_config(function (target)
+      if target:pkg("liburing") then
+        target:add("defines", "AM_PROFILER_HAS_IO_URING")
+      end
+    end)
+  end
 
   -- Include paths
   add_includedirs("$(projectdir)", { public = false })
@@ -74,3 +101,36 @@ target("AmplitudeProfiler")
 
   add_headerfiles("$(projectdir)/include/(**.h)")
 target_end()
+
+target("AmplitudeProfilerRelay")
+  set_kind("binary")
+  set_default(false)
+  set_basename("amprofiler-relay")
+
+  add_deps("AmplitudeProfiler")
+  add_packages("amplitudeaudiosdk", "uwebsockets", "jsoncpp")
+
+  add_files("tools/relay/*.cpp")
+target_end()
+
+target("AmplitudeProfilerAnalyzer")
+  set_kind("binary")
+  set_default(false)
+  set_basename("amprofiler-analyzer")
+
+  add_deps("AmplitudeProfiler")
+  add_packages("amplitudeaudiosdk", "jsoncpp")
+
+  add_files("tools/analyzer/*.cpp")
+target_end()
+
+target("AmplitudeProfilerCompare")
+  set_kind("binary")
+  set_default(false)
+  set_basename("amprofiler-compare")
+
+  add_deps("AmplitudeProfiler")
+  add_packages("amplitudeaudiosdk", "jsoncpp")
+
+  add_files("tools/compare/*.cpp")
+target_end()